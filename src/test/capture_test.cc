@@ -0,0 +1,130 @@
+//------------------------------------------------------------------------------
+//  capture_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/core/capture.h"
+#include <string.h>
+#include <stdlib.h>
+
+using namespace YAKC;
+
+static const char* video_path = "yakc_capture_test.y4m";
+static const char* audio_path = "yakc_capture_test.wav";
+
+//------------------------------------------------------------------------------
+static int
+load(const char* path, uint8_t* buf, int buf_size) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return -1;
+    }
+    int size = (int) fread(buf, 1, buf_size, fp);
+    fclose(fp);
+    return size;
+}
+
+//------------------------------------------------------------------------------
+static uint32_t
+u32(const uint8_t* ptr) {
+    return ptr[0] | (ptr[1]<<8) | (ptr[2]<<16) | (ptr[3]<<24);
+}
+
+//------------------------------------------------------------------------------
+TEST(capture_y4m_wav) {
+    func.malloc_func = malloc;
+    func.free_func = free;
+
+    static uint32_t pixels[16*8];
+    for (int i = 0; i < 16*8; i++) {
+        pixels[i] = 0xFF000000 | i;
+    }
+    static float samples[1500];
+    for (int i = 0; i < 1500; i++) {
+        samples[i] = (i & 1) ? 0.5f : -0.5f;
+    }
+
+    capture cap;
+    cap.blocking = true;
+    CHECK(cap.start(video_path, audio_path, capture::video_format::y4m, 50));
+    CHECK(cap.is_active());
+    for (int i = 0; i < 10; i++) {
+        cap.push_frame(pixels, 8, 4);
+    }
+    // a different size is padded or cropped to the first frame's size
+    cap.push_frame(pixels, 4, 2);
+    cap.push_frame(pixels, 16, 8);
+    cap.push_audio(samples, 1500);
+    cap.push_audio(samples, 1500);
+    cap.stop();
+    CHECK(!cap.is_active());
+    CHECK(cap.frame_width == 8);
+    CHECK(cap.frame_height == 4);
+    CHECK(cap.frames_written == 12);
+    CHECK(cap.frames_dropped == 0);
+    CHECK(cap.frames_resized == 2);
+    CHECK(cap.samples_written == 3000);
+    CHECK(cap.samples_dropped == 0);
+
+    static uint8_t buf[64 * 1024];
+    const char* header = "YUV4MPEG2 W8 H4 F50:1 Ip A1:1 C444\n";
+    const int header_len = (int) strlen(header);
+    const int frame_len = 6 + 8*4*3;
+    int size = load(video_path, buf, sizeof(buf));
+    CHECK(size == header_len + 12 * frame_len);
+    CHECK(0 == memcmp(buf, header, header_len));
+    CHECK(0 == memcmp(buf + header_len, "FRAME\n", 6));
+    CHECK(0 == memcmp(buf + header_len + 11 * frame_len, "FRAME\n", 6));
+
+    size = load(audio_path, buf, sizeof(buf));
+    CHECK(size == 44 + 3000 * 2);
+    CHECK(0 == memcmp(buf, "RIFF", 4));
+    CHECK(u32(buf + 4) == uint32_t(size - 8));
+    CHECK(0 == memcmp(buf + 8, "WAVE", 4));
+    CHECK(0 == memcmp(buf + 36, "data", 4));
+    CHECK(u32(buf + 40) == 3000 * 2);
+
+    remove(video_path);
+    remove(audio_path);
+}
+
+//------------------------------------------------------------------------------
+TEST(capture_raw_resize) {
+    func.malloc_func = malloc;
+    func.free_func = free;
+
+    static uint32_t pixels[16*8];
+    for (int i = 0; i < 16*8; i++) {
+        pixels[i] = 0xFF000000 | i;
+    }
+
+    capture cap;
+    cap.blocking = true;
+    CHECK(cap.start(video_path, nullptr, capture::video_format::rgba8, 50));
+    cap.push_frame(pixels, 8, 4);
+    cap.push_frame(pixels, 4, 2);
+    cap.push_frame(pixels, 16, 8);
+    cap.stop();
+    CHECK(cap.frames_written == 3);
+    CHECK(cap.frames_resized == 2);
+
+    static uint32_t buf[3 * 8*4];
+    const int size = load(video_path, (uint8_t*) buf, sizeof(buf));
+    CHECK(size == 3 * 8*4 * 4);
+    // unchanged size
+    CHECK(0 == memcmp(buf, pixels, 8*4*4));
+    // padded
+    const uint32_t* f = buf + 8*4;
+    CHECK(f[0] == pixels[0]);
+    CHECK(f[3] == pixels[3]);
+    CHECK(f[4] == 0xFF000000);
+    CHECK(f[8+3] == pixels[4+3]);
+    CHECK(f[2*8] == 0xFF000000);
+    CHECK(f[3*8+7] == 0xFF000000);
+    // cropped
+    f = buf + 2*8*4;
+    CHECK(f[7] == pixels[7]);
+    CHECK(f[8] == pixels[16]);
+    CHECK(f[3*8+7] == pixels[3*16+7]);
+
+    remove(video_path);
+}
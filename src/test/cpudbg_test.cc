@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+//  cpudbg_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/chips/cpudbg.h"
+#include "yakc/core/system_bus.h"
+
+using namespace YAKC;
+
+static ubyte ram[0x4000];
+static system_bus bus;
+
+static void init_cpu(z80& cpu, const ubyte* prog, int num_bytes) {
+    memset(ram, 0, sizeof(ram));
+    cpu.mem.unmap_all();
+    cpu.mem.map(0, 0x0000, sizeof(ram), ram, true);
+    cpu.init();
+    cpu.mem.write(0x0000, prog, num_bytes);
+}
+
+// step the CPU, then the debugger with the new PC
+static bool step(cpudbg& dbg, z80& cpu) {
+    uint32_t ticks = cpu.step(&bus);
+    return dbg.step(cpu.PC, ticks);
+}
+
+TEST(cpudbg_breakpoints) {
+    cpudbg dbg;
+    CHECK(0 == dbg.num_breakpoints());
+    dbg.enable_breakpoint(0x0000);
+    dbg.enable_breakpoint(0x1234);
+    dbg.enable_breakpoint(0xFFFF);
+    CHECK(3 == dbg.num_breakpoints());
+    CHECK(dbg.is_breakpoint(0x0000));
+    CHECK(dbg.is_breakpoint(0x1234));
+    CHECK(dbg.is_breakpoint(0xFFFF));
+    CHECK(!dbg.is_breakpoint(0x1235));
+    dbg.toggle_breakpoint(0x1234);
+    CHECK(!dbg.is_breakpoint(0x1234));
+    dbg.toggle_breakpoint(0x4321);
+    CHECK(dbg.is_breakpoint(0x4321));
+    CHECK(!dbg.step(0x1234, 4));
+    CHECK(!dbg.active);
+    CHECK(dbg.step(0x4321, 4));
+    CHECK(dbg.active);
+    dbg.clear_breakpoints();
+    CHECK(0 == dbg.num_breakpoints());
+    CHECK(!dbg.step(0x4321, 4));
+}
+
+TEST(cpudbg_conditions) {
+    z80 cpu;
+    ubyte prog[] = {
+        0xAF,               // XOR A
+        0x3C,               // loop: INC A
+        0x18, 0xFD,         // JR loop
+    };
+    init_cpu(cpu, prog, sizeof(prog));
+    cpudbg dbg;
+    dbg.attach_cpu(&cpu);
+    CHECK(dbg.add_condition(0x0001, cpudbg::reg::A, cpudbg::cmp::eq, 3));
+    int num_steps = 0;
+    while (!step(dbg, cpu) && (num_steps < 100)) {
+        num_steps++;
+    }
+    CHECK(cpu.PC == 0x0001);
+    CHECK(cpu.A == 3);
+    dbg.clear_conditions();
+    CHECK(!dbg.step(0x0001, 4));
+}
+
+TEST(cpudbg_watchpoints) {
+    z80 cpu;
+    ubyte prog[] = {
+        0x3E, 0x11,         // LD A,0x11
+        0x32, 0x00, 0x20,   // LD (0x2000),A
+        0x32, 0x01, 0x20,   // LD (0x2001),A
+        0x3A, 0x01, 0x20,   // LD A,(0x2001)
+        0x3A, 0x00, 0x20,   // LD A,(0x2000)
+        0x00,               // NOP
+        0x00,               // NOP
+    };
+    init_cpu(cpu, prog, sizeof(prog));
+    cpudbg dbg;
+    dbg.attach_cpu(&cpu);
+    CHECK(dbg.add_watchpoint(0x2001, 1, cpudbg::watch_write));
+    CHECK(dbg.add_watchpoint(0x2000, 1, cpudbg::watch_read));
+    CHECK(dbg.add_watchpoint(0x000F, 1, cpudbg::watch_exec));
+    CHECK(cpu.mem.trapped_pages == (uint64_t(1)<<(0x2000>>10)));
+
+    // LD A,0x11
+    CHECK(!step(dbg, cpu));
+    // LD (0x2000),A: no write watchpoint on 0x2000
+    CHECK(!step(dbg, cpu));
+    CHECK(ram[0x2000] == 0x11);
+    // LD (0x2001),A: write watchpoint
+    CHECK(step(dbg, cpu));
+    CHECK(ram[0x2001] == 0x11);
+    CHECK(dbg.last_watch_hit.mode == cpudbg::watch_write);
+    CHECK(dbg.last_watch_hit.addr == 0x2001);
+    CHECK(dbg.last_watch_hit.pc == 0x0005);
+    // LD A,(0x2001): no read watchpoint on 0x2001
+    CHECK(!step(dbg, cpu));
+    // LD A,(0x2000): read watchpoint
+    CHECK(step(dbg, cpu));
+    CHECK(cpu.A == 0x11);
+    CHECK(dbg.last_watch_hit.mode == cpudbg::watch_read);
+    CHECK(dbg.last_watch_hit.addr == 0x2000);
+    // NOP: execute watchpoint is hit when PC arrives at 0x000F
+    CHECK(step(dbg, cpu));
+    CHECK(dbg.last_watch_hit.mode == cpudbg::watch_exec);
+    CHECK(cpu.PC == 0x000F);
+
+    dbg.clear_watchpoints();
+    CHECK(cpu.mem.trapped_pages == 0);
+    CHECK(cpu.mem.r8(0x2000) == 0x11);
+}
+
+TEST(cpudbg_watch_near_pc) {
+    z80 cpu;
+    ubyte prog[] = {
+        0x3A, 0x03, 0x00,   // LD A,(0x0003)
+        0x00,               // NOP (read-watched)
+        0x3A, 0x03, 0x00,   // LD A,(0x0003)
+    };
+    init_cpu(cpu, prog, sizeof(prog));
+    cpudbg dbg;
+    dbg.attach_cpu(&cpu);
+    CHECK(dbg.add_watchpoint(0x0003, 1, cpudbg::watch_read));
+    // a data read right behind the instruction is not an operand fetch
+    CHECK(step(dbg, cpu));
+    CHECK(dbg.last_watch_hit.mode == cpudbg::watch_read);
+    CHECK(dbg.last_watch_hit.addr == 0x0003);
+    CHECK(dbg.last_watch_hit.pc == 0x0000);
+    // the opcode fetch of the NOP is not a data read
+    CHECK(!step(dbg, cpu));
+    CHECK(step(dbg, cpu));
+    CHECK(dbg.last_watch_hit.pc == 0x0004);
+}
+
+TEST(cpudbg_multiple) {
+    // each debugger gets its own trap callbacks
+    static ubyte ram2[0x4000];
+    z80 cpu0, cpu1;
+    ubyte prog[] = {
+        0x32, 0x00, 0x20,   // LD (0x2000),A
+        0x00,               // NOP
+    };
+    init_cpu(cpu0, prog, sizeof(prog));
+    memcpy(ram2, ram, sizeof(ram2));
+    cpu1.mem.map(0, 0x0000, sizeof(ram2), ram2, true);
+    cpu1.init();
+    cpudbg dbg0, dbg1;
+    dbg0.attach_cpu(&cpu0);
+    dbg1.attach_cpu(&cpu1);
+    CHECK(dbg0.add_watchpoint(0x2000, 1, cpudbg::watch_write));
+    CHECK(dbg1.add_watchpoint(0x2000, 1, cpudbg::watch_write));
+    CHECK(step(dbg0, cpu0));
+    CHECK(dbg0.last_watch_hit.addr == 0x2000);
+    CHECK(step(dbg1, cpu1));
+    CHECK(dbg1.last_watch_hit.addr == 0x2000);
+    CHECK(!step(dbg0, cpu0));
+    CHECK(!step(dbg1, cpu1));
+}
+
+TEST(cpudbg_heatmap) {
+    func.malloc_func = malloc;
+    func.free_func = free;
+    z80 cpu;
+    ubyte prog[] = {
+        0x21, 0x00, 0x10,   // LD HL,0x1000
+        0x77,               // loop: LD (HL),A
+        0x7E,               // LD A,(HL)
+        0x18, 0xFC,         // JR loop
+    };
+    init_cpu(cpu, prog, sizeof(prog));
+    cpudbg dbg;
+    dbg.attach_cpu(&cpu);
+    CHECK(nullptr == cpu.mem.heat);
+    dbg.start_heatmap(true);
+    CHECK(&dbg.heat == cpu.mem.heat);
+    CHECK(dbg.heat.has_addr_counters());
+    // accesses are counted in the trap callback
+    CHECK(cpu.mem.trapped_pages == ~uint64_t(0));
+    for (int i = 0; i < 4; i++) {
+        // no watchpoints are triggered
+        CHECK(!step(dbg, cpu));
+    }
+    // opcode and operand fetches are counted as reads
+    CHECK(dbg.heat.page_count(heatmap::read, 0) == 7);
+    CHECK(dbg.heat.page_count(heatmap::exec, 0) == 4);
+    CHECK(dbg.heat.page_count(heatmap::write, 0) == 0);
+    CHECK(dbg.heat.page_count(heatmap::read, 4) == 1);
+    CHECK(dbg.heat.page_count(heatmap::write, 4) == 1);
+    CHECK(dbg.heat.addr_count(heatmap::read, 0x1000) == 1);
+    CHECK(dbg.heat.addr_count(heatmap::write, 0x1000) == 1);
+    CHECK(dbg.heat.addr_count(heatmap::exec, 0x0003) == 1);
+    CHECK(dbg.heat.addr_count(heatmap::exec, 0x0006) == 0);
+
+    // only changes of the CPU-visible mapping are counted
+    static ubyte bank[0x400];
+    cpu.mem.map(1, 0x2000, sizeof(bank), bank, true);
+    CHECK(dbg.heat.page_count(heatmap::remap, 8) == 0);
+    cpu.mem.map(0, 0x2000, sizeof(bank), bank, true);
+    CHECK(dbg.heat.page_count(heatmap::remap, 8) == 1);
+
+    // counters are kept after stopping
+    dbg.stop_heatmap();
+    CHECK(nullptr == cpu.mem.heat);
+    CHECK(cpu.mem.trapped_pages == 0);
+    step(dbg, cpu);
+    CHECK(dbg.heat.page_count(heatmap::exec, 0) == 4);
+    dbg.heat.reset();
+    CHECK(!dbg.heat.has_addr_counters());
+    CHECK(dbg.heat.page_count(heatmap::read, 0) == 0);
+}
@@ -109,3 +109,176 @@ TEST(daisychain) {
     CHECK(bus.cpu.IFF2);
     CHECK(bus.cpu.PC == 0x0005);
 }
+
+//------------------------------------------------------------------------------
+TEST(daisychain_nested) {
+
+    system_bus bus;
+    z80int dev0;
+    z80int dev1;
+    z80int dev2;
+    dev0.connect_irq_device(&dev1);
+    dev1.connect_irq_device(&dev2);
+
+    // lowest priority device requests an interrupt and is acknowledged
+    CHECK(dev2.request_interrupt(&bus, 0xE4));
+    CHECK(dev0.int_enabled);
+    CHECK(dev1.int_enabled);
+    CHECK(!dev2.int_enabled);
+    CHECK(dev0.interrupt_acknowledged() == 0xE4);
+    CHECK(!dev2.int_requested);
+    CHECK(dev2.int_pending);
+
+    // a higher priority device interrupts the service routine
+    CHECK(dev0.request_interrupt(&bus, 0xE0));
+    CHECK(!dev1.int_enabled);
+    CHECK(!dev1.request_interrupt(&bus, 0xE2));
+    CHECK(dev0.interrupt_acknowledged() == 0xE0);
+    CHECK(dev0.int_pending);
+    CHECK(dev2.int_pending);
+
+    // RETI of the nested service routine
+    dev0.reti();
+    CHECK(!dev0.int_pending);
+    CHECK(dev0.int_enabled);
+    CHECK(dev1.int_enabled);
+    CHECK(dev2.int_pending);
+
+    // a middle priority request is served before the outer RETI
+    CHECK(dev1.request_interrupt(&bus, 0xE2));
+    CHECK(dev0.interrupt_acknowledged() == 0xE2);
+    dev0.reti();
+    CHECK(!dev1.int_pending);
+    CHECK(dev2.int_pending);
+
+    // RETI of the outer service routine
+    dev0.reti();
+    CHECK(!dev2.int_pending);
+    CHECK(dev0.int_enabled);
+    CHECK(dev1.int_enabled);
+    CHECK(dev2.int_enabled);
+
+    // re-linking the chain, the order is now dev2, dev0, dev1
+    dev1.connect_irq_device(nullptr);
+    dev2.connect_irq_device(&dev0);
+    CHECK(dev1.request_interrupt(&bus, 0xE2));
+    CHECK(dev2.request_interrupt(&bus, 0xE4));
+    CHECK(!dev0.int_enabled);
+    CHECK(!dev1.int_enabled);
+    CHECK(dev2.interrupt_acknowledged() == 0xE4);
+    dev2.reti();
+    CHECK(dev0.int_enabled);
+    CHECK(dev1.int_requested);
+    CHECK(dev2.interrupt_acknowledged() == 0xE2);
+    CHECK(dev1.int_pending);
+}
+
+// the recursive daisy chain implementation which z80int replaced,
+// as reference for the flattened chain
+struct recursive_int {
+    recursive_int* downstream_device = nullptr;
+    bool int_enabled = true;
+    bool int_requested = false;
+    uint8_t int_request_data = 0;
+    bool int_pending = false;
+
+    void reset() {
+        int_enabled = true;
+        int_requested = false;
+        int_request_data = 0;
+        int_pending = false;
+    }
+    bool request_interrupt(uint8_t data) {
+        if (int_enabled) {
+            int_enabled = false;
+            int_requested = true;
+            int_request_data = data;
+            if (downstream_device) {
+                downstream_device->disable_interrupt();
+            }
+            return true;
+        }
+        return false;
+    }
+    uint8_t interrupt_acknowledged() {
+        if (int_requested) {
+            int_requested = false;
+            int_pending = true;
+            return int_request_data;
+        }
+        return downstream_device ? downstream_device->interrupt_acknowledged() : 0;
+    }
+    void reti() {
+        int_enabled = true;
+        if (int_pending) {
+            int_pending = false;
+            if (downstream_device) {
+                downstream_device->enable_interrupt();
+            }
+        }
+        else if (downstream_device) {
+            downstream_device->reti();
+        }
+    }
+    void enable_interrupt() {
+        int_enabled = true;
+        if (!int_pending && downstream_device) {
+            downstream_device->enable_interrupt();
+        }
+    }
+    void disable_interrupt() {
+        int_enabled = false;
+        if (downstream_device) {
+            downstream_device->disable_interrupt();
+        }
+    }
+};
+
+TEST(daisychain_random) {
+    // random operations on the flattened chain must have the same
+    // effect as on the recursive reference implementation
+    srand(1);
+    for (int round = 0; round < 200; round++) {
+        const int num = 1 + rand() % 8;
+        z80int dev[8];
+        recursive_int ref[8];
+        for (int i = 0; i < (num - 1); i++) {
+            dev[i].connect_irq_device(&dev[i + 1]);
+            ref[i].downstream_device = &ref[i + 1];
+        }
+        for (int op = 0; op < 500; op++) {
+            const int i = rand() % num;
+            bool requested = false;
+            for (int k = i; k < num; k++) {
+                requested |= ref[k].int_requested;
+            }
+            switch (rand() % 6) {
+                case 0:
+                    {
+                        const uint8_t data = uint8_t(rand());
+                        CHECK_EQUAL(ref[i].request_interrupt(data), dev[i].request_interrupt(nullptr, data));
+                    }
+                    break;
+                case 1:
+                    if (requested) {
+                        CHECK_EQUAL(ref[i].interrupt_acknowledged(), dev[i].interrupt_acknowledged());
+                    }
+                    break;
+                case 2: ref[i].reti(); dev[i].reti(); break;
+                case 3: ref[i].enable_interrupt(); dev[i].enable_interrupt(); break;
+                case 4: ref[i].disable_interrupt(); dev[i].disable_interrupt(); break;
+                default:
+                    if (0 == (rand() % 8)) {
+                        ref[i].reset(); dev[i].reset();
+                    }
+                    break;
+            }
+            for (int k = 0; k < num; k++) {
+                CHECK_EQUAL(ref[k].int_enabled, dev[k].int_enabled);
+                CHECK_EQUAL(ref[k].int_requested, dev[k].int_requested);
+                CHECK_EQUAL(ref[k].int_request_data, dev[k].int_request_data);
+                CHECK_EQUAL(ref[k].int_pending, dev[k].int_pending);
+            }
+        }
+    }
+}
@@ -8,11 +8,17 @@ using namespace YAKC;
 
 TEST(filesystem) {
 
+    func.malloc_func = malloc;
+    func.free_func = free;
+
     filesystem fs;
-    for (const auto& block : fs.blocks) {
-        CHECK(block.free);
+    fs.init(16, 256);
+    CHECK(fs.num_free_blocks() == 256);
+    for (int i = 0; i < fs.max_num_blocks; i++) {
+        CHECK(fs.store[i] == nullptr);
     }
-    for (const auto& f : fs.files) {
+    for (int i = 0; i < fs.max_num_files; i++) {
+        const auto& f = fs.files[i];
         CHECK(f.name[0] == 0);
         CHECK(f.open_mode == filesystem::mode::none);
         CHECK(!f.valid);
@@ -109,5 +115,111 @@ TEST(filesystem) {
         }
     }
     fs.close(fp);
+
+    // deleting a file releases its block storage
+    CHECK(fs.store[0] != nullptr);
+    fs.rm("bla");
+    fs.rm("bla0");
+    fs.rm("bla1");
+    CHECK(fs.num_free_blocks() == 256);
+    for (int i = 0; i < fs.max_num_blocks; i++) {
+        CHECK(fs.store[i] == nullptr);
+    }
 }
 
+
+TEST(filesystem_external) {
+
+    func.malloc_func = malloc;
+    func.free_func = free;
+
+    // an external file larger than the whole block storage
+    static uint8_t data[256 * 1024];
+    for (int i = 0; i < int(sizeof(data)); i++) {
+        data[i] = uint8_t(i * 7);
+    }
+    filesystem fs;
+    fs.init(16, 32);
+    CHECK(fs.add_external("ext", data, sizeof(data)));
+    CHECK(fs.exists("ext"));
+    CHECK(!fs.add_external("ext", data, sizeof(data)));
+    CHECK(!fs.open("ext", filesystem::mode::write));
+    filesystem::file fp = fs.open("ext", filesystem::mode::read);
+    CHECK(fp);
+    CHECK(fs.size(fp) == int(sizeof(data)));
+    CHECK(fs.peek_u8(fp, 3) == data[3]);
+    uint8_t buf[5000];
+    CHECK(fs.read(fp, buf, sizeof(buf)) == int(sizeof(buf)));
+    CHECK(0 == memcmp(buf, data, sizeof(buf)));
+    CHECK(fs.set_pos(fp, sizeof(data) - 100));
+    CHECK(fs.read(fp, buf, sizeof(buf)) == 100);
+    CHECK(0 == memcmp(buf, data + sizeof(data) - 100, 100));
+    CHECK(fs.eof(fp));
+    fs.close(fp);
+
+    // no blocks are used by external files
+    CHECK(fs.num_free_blocks() == 32);
+    fs.rm("ext");
+    CHECK(!fs.exists("ext"));
+
+    // block reads across block boundaries
+    fp = fs.open("blk", filesystem::mode::write);
+    CHECK(fs.write(fp, data, 3 * filesystem::block::size + 10) == 3 * filesystem::block::size + 10);
+    fs.close(fp);
+    fp = fs.open("blk", filesystem::mode::read);
+    CHECK(fs.read(fp, buf, 10) == 10);
+    CHECK(fs.read(fp, buf, sizeof(buf)) == int(sizeof(buf)));
+    CHECK(0 == memcmp(buf, data + 10, sizeof(buf)));
+    fs.close_rm(fp);
+    CHECK(!fs.exists("blk"));
+}
+
+TEST(filesystem_many_files) {
+
+    func.malloc_func = malloc;
+    func.free_func = free;
+
+    // the default limits are used without an explicit init()
+    filesystem fs;
+    char name[32];
+    const int num_files = 200;
+    for (int i = 0; i < num_files; i++) {
+        snprintf(name, sizeof(name), "file%d.kcc", i);
+        filesystem::file fp = fs.open(name, filesystem::mode::write);
+        CHECK(fp);
+        // files of different sizes, the largest needs more than 32 blocks
+        static uint8_t data[40 * filesystem::block::size];
+        data[0] = uint8_t(i);
+        const int size = (i == 7) ? int(sizeof(data)) : (i + 1);
+        CHECK(fs.write(fp, data, size) == size);
+        fs.close(fp);
+    }
+    CHECK(fs.max_num_files == filesystem::default_max_num_files);
+    for (int i = 0; i < num_files; i++) {
+        snprintf(name, sizeof(name), "file%d.kcc", i);
+        filesystem::file fp = fs.open(name, filesystem::mode::read);
+        CHECK(fp);
+        CHECK(fs.size(fp) == ((i == 7) ? 40 * filesystem::block::size : (i + 1)));
+        CHECK(fs.peek_u8(fp, 0) == uint8_t(i));
+        fs.close(fp);
+    }
+    // delete every second file, the others must still be found
+    for (int i = 0; i < num_files; i += 2) {
+        snprintf(name, sizeof(name), "file%d.kcc", i);
+        fs.rm(name);
+    }
+    for (int i = 0; i < num_files; i++) {
+        snprintf(name, sizeof(name), "file%d.kcc", i);
+        CHECK(fs.exists(name) == (0 != (i & 1)));
+    }
+    // freed blocks are reused
+    const int num_free = fs.num_free_blocks();
+    filesystem::file fp = fs.open("new", filesystem::mode::write);
+    uint8_t byte = 0x33;
+    CHECK(fs.write(fp, &byte, 1) == 1);
+    fs.close(fp);
+    CHECK(fs.num_free_blocks() == num_free - 1);
+    fs.reset();
+    CHECK(fs.num_free_blocks() == filesystem::default_max_num_blocks);
+    CHECK(!fs.exists("new"));
+}
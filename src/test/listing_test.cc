@@ -0,0 +1,105 @@
+//------------------------------------------------------------------------------
+//  listing_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/chips/listing.h"
+#include <string.h>
+#include <stdlib.h>
+
+using namespace YAKC;
+
+//------------------------------------------------------------------------------
+TEST(listing_z80) {
+    func.malloc_func = malloc;
+    func.free_func = free;
+
+    const uint8_t rom[] = {
+        0x3E, 0x12,             // 0100: ld a,$12
+        0xCD, 0x0B, 0x01,       // 0102: call $010B
+        0x10, 0xFB,             // 0105: djnz $0102
+        0xC3, 0x00, 0x01,       // 0107: jp $0100
+        0xFF,                   // 010A: rst $38
+        0x21, 0x00, 0x01,       // 010B: ld hl,$0100
+        0xC9,                   // 010E: ret
+    };
+    listing l;
+    l.disassemble(cpu_model::z80, rom, sizeof(rom), 0x0100);
+    CHECK(l.num_lines() == 7);
+    CHECK(l.get_line(0).addr == 0x0100);
+    CHECK(l.get_line(0).num_bytes == 2);
+    CHECK(0 == strcmp(l.get_line(0).mnemonic, "ld"));
+    CHECK(0 == strcmp(l.get_line(0).operands, "a,$12"));
+    CHECK(l.get_line(0).target == -1);
+    CHECK(l.get_line(1).target == 0x010B);
+    CHECK(l.get_line(1).call);
+    CHECK(l.get_line(1).bytes[0] == 0xCD);
+    CHECK(l.get_line(1).bytes[2] == 0x01);
+    CHECK(l.get_line(2).target == 0x0102);
+    CHECK(!l.get_line(2).call);
+    CHECK(l.get_line(3).target == 0x0100);
+    CHECK(l.get_line(4).target == 0x0038);
+    CHECK(l.get_line(4).call);
+    CHECK(l.get_line(5).target == -1);
+    CHECK(l.get_line(6).addr == 0x010E);
+
+    // symbols in the supported formats
+    const char* syms =
+        "; a comment\n"
+        "0100 START\n"
+        "SUB = $010B   # subroutine\n"
+        "RST38: EQU 0038H\n"
+        "garbage line with too many tokens\n";
+    CHECK(l.parse_symbols(syms) == 3);
+    CHECK(l.num_symbols() == 3);
+    CHECK(0 == strcmp(l.find_symbol(0x0100), "START"));
+    CHECK(0 == strcmp(l.find_symbol(0x010B), "SUB"));
+    CHECK(0 == strcmp(l.find_symbol(0x0038), "RST38"));
+    CHECK(nullptr == l.find_symbol(0x0102));
+    CHECK(l.add_symbol(0x0100, "MAIN"));
+    CHECK(l.num_symbols() == 3);
+    CHECK(0 == strcmp(l.find_symbol(0x0100), "MAIN"));
+
+    FILE* fp = tmpfile();
+    l.write(fp);
+    rewind(fp);
+    char buf[1024] = { };
+    fread(buf, 1, sizeof(buf)-1, fp);
+    fclose(fp);
+    CHECK(nullptr != strstr(buf, "MAIN:\n0100  3E 12"));
+    CHECK(nullptr != strstr(buf, "call  SUB\n"));
+    CHECK(nullptr != strstr(buf, "jp    MAIN\n"));
+    CHECK(nullptr != strstr(buf, "ld    hl,MAIN\n"));
+    CHECK(nullptr != strstr(buf, "SUB:\n010B"));
+
+    l.clear_symbols();
+    CHECK(l.num_symbols() == 0);
+    l.clear();
+    CHECK(l.num_lines() == 0);
+}
+
+//------------------------------------------------------------------------------
+TEST(listing_6502) {
+    func.malloc_func = malloc;
+    func.free_func = free;
+
+    static uint8_t ram[0x1000];
+    memory mem;
+    mem.map(0, 0x0000, sizeof(ram), ram, true);
+    const uint8_t prog[] = {
+        0xA9, 0x00,             // 0200: lda #$00
+        0x20, 0x09, 0x02,       // 0202: jsr $0209
+        0xD0, 0xF9,             // 0205: bne $0200
+        0x4C, 0x00, 0x02,       // 0207: jmp $0200 (outside the range)
+    };
+    mem.write(0x0200, prog, sizeof(prog));
+    listing l;
+    l.disassemble(cpu_model::mos6502, mem, 0x0200, 7);
+    CHECK(l.num_lines() == 3);
+    CHECK(0 == strcmp(l.get_line(0).mnemonic, "lda"));
+    CHECK(0 == strcmp(l.get_line(0).operands, "#$00"));
+    CHECK(l.get_line(1).target == 0x0209);
+    CHECK(l.get_line(1).call);
+    CHECK(l.get_line(2).target == 0x0200);
+    CHECK(0 == strcmp(l.get_line(2).operands, "$0200"));
+    CHECK(!l.get_line(2).call);
+}
@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+//  mc6847_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/chips/mc6847.h"
+#include <stdlib.h>
+
+using namespace YAKC;
+
+static uint32_t fb0[mc6847::disp_width_with_border * mc6847::disp_height_with_border];
+static uint32_t fb1[mc6847::disp_width_with_border * mc6847::disp_height_with_border];
+
+static uint8_t read_vidmem(uint16_t addr) {
+    return uint8_t(addr * 7);
+}
+
+//------------------------------------------------------------------------------
+TEST(mc6847_bulk_step) {
+    // stepping by many ticks must have the same effect as single steps
+    mc6847 vdg0, vdg1;
+    vdg0.init(read_vidmem, fb0, 1000);
+    vdg1.init(read_vidmem, fb1, 1000);
+    vdg0.ag(true); vdg0.gm0(true); vdg0.css(true);
+    vdg1.ag(true); vdg1.gm0(true); vdg1.css(true);
+    srand(1);
+    for (int i = 0; i < 2000; i++) {
+        const int num_ticks = (rand() % 4) ? (1 + rand() % 300) : (1 + rand() % 40000);
+        int num_hsync = 0;
+        bool fsync_on = false;
+        bool fsync_off = false;
+        for (int t = 0; t < num_ticks; t++) {
+            vdg0.step();
+            num_hsync += vdg0.on(mc6847::HSYNC) ? 1 : 0;
+            fsync_on |= vdg0.on(mc6847::FSYNC);
+            fsync_off |= vdg0.off(mc6847::FSYNC);
+        }
+        CHECK_EQUAL(num_hsync, vdg1.step(num_ticks));
+        CHECK_EQUAL(fsync_on, vdg1.on(mc6847::FSYNC));
+        CHECK_EQUAL(fsync_off, vdg1.off(mc6847::FSYNC));
+        CHECK_EQUAL(vdg0.h_count, vdg1.h_count);
+        CHECK_EQUAL(vdg0.l_count, vdg1.l_count);
+        CHECK_EQUAL(vdg0.bits, vdg1.bits);
+    }
+    CHECK(0 == memcmp(fb0, fb1, sizeof(fb0)));
+}
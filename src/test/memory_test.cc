@@ -135,3 +135,151 @@ TEST(memory_mapped_io) {
     CHECK(0x1235 == last_addr);
 }
 
+TEST(memory_bulk) {
+    memory mem;
+    static uint8_t ram[0x8000];
+    static uint8_t rom[0x4000];
+    memset(ram, 0, sizeof(ram));
+    memset(rom, 3, sizeof(rom));
+    mem.map(0, 0x0000, 0x4000, ram, true);
+    mem.map(0, 0x4000, 0x4000, ram + 0x4000, true);
+    mem.map_io(0, 0x8000, 0x0400, mem_cb);
+    mem.map(0, 0xC000, 0x4000, rom, false);
+
+    // write across page boundaries
+    uint8_t src[3000];
+    for (int i = 0; i < int(sizeof(src)); i++) {
+        src[i] = uint8_t(i * 7);
+    }
+    mem.write(0x03F0, src, sizeof(src));
+    for (int i = 0; i < int(sizeof(src)); i++) {
+        CHECK(ram[0x03F0 + i] == src[i]);
+    }
+    uint8_t dst[3000];
+    mem.read(0x03F0, dst, sizeof(dst));
+    CHECK(0 == memcmp(src, dst, sizeof(src)));
+    CHECK(ram[0x03EF] == 0);
+    CHECK(ram[0x03F0 + sizeof(src)] == 0);
+
+    // fill, writes to ROM and unmapped memory are dropped
+    mem.fill(0x7F00, 0x55, 0x100);
+    CHECK(mem.r8(0x7EFF) == 0x00);
+    CHECK(mem.r8(0x7F00) == 0x55);
+    CHECK(mem.r8(0x7FFF) == 0x55);
+    mem.fill(0xBF00, 0x55, 0x200);
+    CHECK(mem.r8(0xBF00) == 0xFF);
+    CHECK(mem.r8(0xC000) == 3);
+    CHECK(mem.r8(0xC0FF) == 3);
+    mem.fill(0xFFF0, 0xAA, 0x20);
+    CHECK(mem.r8(0xFFEF) == 3);
+    CHECK(mem.r8(0xFFF0) == 3);
+    CHECK(mem.r8(0xFFFF) == 3);
+    CHECK(mem.r8(0x0000) == 0xAA);
+    CHECK(mem.r8(0x000F) == 0xAA);
+
+    // memory-mapped-io pages go through the callback
+    num_reads = num_writes = 0;
+    mem.write(0x83FE, src, 4);
+    CHECK(2 == num_writes);
+    CHECK(0x83FF == last_addr);
+    CHECK(src[1] == last_inval);
+    mem.read(0x83FC, dst, 8);
+    CHECK(4 == num_reads);
+    CHECK(dst[0] == 0x33);
+    CHECK(dst[3] == 0x33);
+    CHECK(dst[4] == 0xFF);
+}
+
+
+TEST(memory_dirty_pages) {
+    memory mem;
+    static uint8_t ram[0x10000];
+    mem.map(0, 0x0000, 0xC000, ram, true);
+    mem.map_io(0, 0xC000, 0x0400, mem_cb);
+    mem.map(0, 0xC400, 0x3C00, ram + 0xC400, true);
+
+    // disabled by default
+    mem.w8(0x0000, 1);
+    CHECK(0 == mem.dirty_pages);
+
+    mem.set_dirty_tracking(true);
+    mem.w8(0x0400, 1);
+    CHECK(mem.is_dirty(1));
+    CHECK(!mem.is_dirty(0));
+    mem.w16(0x0BFF, 0x1234);
+    CHECK(mem.is_dirty(2));
+    CHECK(mem.is_dirty(3));
+    mem.w8io(0x1000, 2);
+    CHECK(mem.is_dirty(4));
+    // memory-mapped-io pages are not tracked
+    mem.w8io(0xC000, 3);
+    CHECK(!mem.is_dirty(0xC000>>memory::page::shift));
+    CHECK(mem.take_dirty_pages() == 0x1E);
+    CHECK(0 == mem.dirty_pages);
+
+    // range writes
+    uint8_t buf[0x500] = { };
+    mem.write(0x23FF, buf, sizeof(buf));
+    CHECK(mem.take_dirty_pages() == (uint64_t(7)<<8));
+    mem.fill(0xFFFF, 0, 2);
+    CHECK(mem.take_dirty_pages() == ((uint64_t(1)<<63)|1));
+    mem.mark_dirty(0x8000, 0x401);
+    CHECK(mem.take_dirty_pages() == (uint64_t(3)<<32));
+
+    mem.set_dirty_tracking(false);
+    mem.w8(0x0000, 1);
+    mem.mark_dirty(0x0000, 1);
+    CHECK(0 == mem.dirty_pages);
+}
+
+TEST(memory_remap) {
+    memory mem;
+    static uint8_t ram0[0x4000];
+    static uint8_t ram1[0x4000];
+    static uint8_t rom[0x4000];
+    memset(ram0, 0x11, sizeof(ram0));
+    memset(ram1, 0x22, sizeof(ram1));
+    memset(rom, 0x33, sizeof(rom));
+
+    mem.map(1, 0x0000, 0x4000, ram1, true);
+    mem.map(0, 0x0000, 0x4000, rom, false);
+    CHECK(mem.layer_mask[0] == 3);
+    CHECK(mem.layer_mask[0x10] == 0);
+    CHECK(mem.r8(0x0000) == 0x33);
+
+    // changes inside a batch are not visible until end_remap()
+    mem.begin_remap();
+    mem.unmap_layer(0);
+    CHECK(mem.layer_mask[0] == 2);
+    CHECK(mem.r8(0x0000) == 0x33);
+    mem.begin_remap();
+    mem.map(0, 0x2000, 0x2000, ram0, true);
+    mem.end_remap();
+    CHECK(mem.r8(0x0000) == 0x33);
+    CHECK(mem.remap_pages == 0xFFFF);
+    mem.end_remap();
+    CHECK(mem.remap_pages == 0);
+    CHECK(mem.r8(0x0000) == 0x22);
+    CHECK(mem.r8(0x1FFF) == 0x22);
+    CHECK(mem.r8(0x2000) == 0x11);
+    CHECK(mem.r8(0x4000) == 0xFF);
+    mem.w8(0x2000, 0x44);
+    CHECK(ram0[0] == 0x44);
+
+    // remapping the same range again doesn't touch any pages
+    mem.begin_remap();
+    mem.map(0, 0x2000, 0x2000, ram0, true);
+    CHECK(mem.remap_pages == 0);
+    mem.end_remap();
+
+    // unmapping a layer only touches the pages it maps
+    mem.begin_remap();
+    mem.unmap_layer(1);
+    CHECK(mem.remap_pages == 0xFFFF);
+    mem.end_remap();
+    CHECK(mem.r8(0x0000) == 0xFF);
+    CHECK(mem.r8(0x2000) == 0x44);
+    mem.unmap_all();
+    CHECK(mem.layer_mask[8] == 0);
+    CHECK(mem.r8(0x2000) == 0xFF);
+}
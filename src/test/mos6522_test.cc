@@ -51,3 +51,86 @@ TEST(mos6522_test) {
     CHECK(via.read(&bus, mos6522::PB) == 0xBE);
 }
 
+
+//------------------------------------------------------------------------------
+class mos6522_irq_bus : public mos6522_test_bus {
+public:
+    virtual void irq(bool b) override {
+        irq_line = b;
+        num_irq_calls++;
+    }
+    bool irq_line = false;
+    int num_irq_calls = 0;
+};
+
+//------------------------------------------------------------------------------
+TEST(mos6522_timer) {
+    mos6522_irq_bus bus;
+    mos6522 via;
+    via.init(0);
+
+    // enable timer 1 and timer 2 interrupts
+    via.write(&bus, mos6522::IER, mos6522::IRQ_ANY|mos6522::IRQ_T1|mos6522::IRQ_T2);
+    CHECK(via.read(&bus, mos6522::IER) == (mos6522::IRQ_ANY|mos6522::IRQ_T1|mos6522::IRQ_T2));
+    CHECK(via.read(&bus, mos6522::IFR) == 0);
+
+    // timer 1 one-shot, 1000 ticks
+    via.write(&bus, mos6522::T1CL, 1000 & 0xFF);
+    via.write(&bus, mos6522::T1CH, 1000 >> 8);
+    CHECK(via.ticks_until_event() == 1000);
+    via.step(&bus, 400);
+    CHECK(via.read(&bus, mos6522::T1CH) == (600 >> 8));
+    via.step(&bus, 599);
+    CHECK(!bus.irq_line);
+    via.step(&bus, 1);
+    CHECK(bus.irq_line);
+    CHECK(via.read(&bus, mos6522::IFR) == (mos6522::IRQ_ANY|mos6522::IRQ_T1));
+    CHECK(!via.t1_active);
+
+    // reading T1CL clears the interrupt
+    via.read(&bus, mos6522::T1CL);
+    CHECK(!bus.irq_line);
+    CHECK(via.read(&bus, mos6522::IFR) == 0);
+
+    // a one-shot timer doesn't interrupt again after wrapping around
+    via.step(&bus, 0x10000 * 2);
+    CHECK(!bus.irq_line);
+
+    // timer 1 continuous with PB7 output, 100 ticks per period
+    via.write(&bus, mos6522::ACR, 0xC0);
+    via.write(&bus, mos6522::T1CL, 100);
+    via.write(&bus, mos6522::T1CH, 0);
+    CHECK((bus.out_val[mos6522::PORT_B] & 0x80) == 0);
+    via.step(&bus, 100);
+    CHECK(bus.irq_line);
+    CHECK((bus.out_val[mos6522::PORT_B] & 0x80) != 0);
+    via.write(&bus, mos6522::IFR, mos6522::IRQ_T1);
+    CHECK(!bus.irq_line);
+
+    // several periods in one step
+    via.step(&bus, 350);
+    CHECK(bus.irq_line);
+    CHECK((bus.out_val[mos6522::PORT_B] & 0x80) == 0);
+    CHECK(via.t1 == 50);
+    CHECK(via.ticks_until_event() == 50);
+
+    // disabling the interrupt drops the IRQ line, the flag remains set
+    via.write(&bus, mos6522::IER, mos6522::IRQ_T1);
+    CHECK(!bus.irq_line);
+    CHECK(via.read(&bus, mos6522::IFR) == mos6522::IRQ_T1);
+    via.write(&bus, mos6522::ACR, 0x00);
+    via.write(&bus, mos6522::IFR, 0x7F);
+
+    // timer 2 one-shot, 300 ticks
+    via.write(&bus, mos6522::T2CL, 300 & 0xFF);
+    via.write(&bus, mos6522::T2CH, 300 >> 8);
+    via.step(&bus, 299);
+    CHECK(!bus.irq_line);
+    CHECK(via.read(&bus, mos6522::T2CL) == 1);
+    via.step(&bus, 1);
+    CHECK(bus.irq_line);
+    CHECK((via.read(&bus, mos6522::IFR) & (mos6522::IRQ_ANY|mos6522::IRQ_T2)) == (mos6522::IRQ_ANY|mos6522::IRQ_T2));
+    via.write(&bus, mos6522::T2CH, 0x10);
+    CHECK(!bus.irq_line);
+    CHECK((via.read(&bus, mos6522::IFR) & (mos6522::IRQ_ANY|mos6522::IRQ_T2)) == 0);
+}
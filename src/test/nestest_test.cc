@@ -82,8 +82,16 @@ TEST(nestest) {
             CHECK(cpu.S == state.S);
             return;
         }
-        // and run the next instruction
-        cpu.step();
+        // and run the next instruction, the bus must be ticked once per cycle
+        int ticks = bus.ticks;
+        int cycles = cpu.step();
+        if (cycles != (bus.ticks - ticks)) {
+            printf("### NESTEST cycle mismatch at op %d (PC=0x%04X)!\n", i, state.PC);
+            CHECK(cycles == (bus.ticks - ticks));
+            return;
+        }
     }
     printf(">>> NESTEST OK (%d ops, %d cycles)\n\n", i, bus.ticks);
+    // total number of cycles in the official (documented) part of nestest.log
+    CHECK(bus.ticks == 26545);
 }
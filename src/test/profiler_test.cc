@@ -0,0 +1,220 @@
+//------------------------------------------------------------------------------
+//  profiler_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/chips/cpudbg.h"
+#include "yakc/core/system_bus.h"
+
+using namespace YAKC;
+
+static ubyte ram[0x10000];
+static system_bus bus;
+
+static void init_funcs() {
+    func.malloc_func = malloc;
+    func.free_func = free;
+}
+
+// step the CPU, then the debugger with the new PC
+static void step(cpudbg& dbg, z80& cpu) {
+    uint32_t ticks = cpu.step(&bus);
+    ticks += cpu.handle_irq(&bus);
+    dbg.step(cpu.PC, ticks);
+}
+
+static void step(cpudbg& dbg, mos6502& cpu) {
+    uint32_t ticks = cpu.step();
+    dbg.step(cpu.PC, ticks);
+}
+
+//------------------------------------------------------------------------------
+TEST(profiler_z80) {
+    init_funcs();
+    z80 cpu;
+    memset(ram, 0, sizeof(ram));
+    cpu.mem.map(0, 0x0000, 0x4000, ram, true);
+    cpu.init();
+    ubyte prog[] = {
+        0x31, 0x00, 0x01,   // LD SP,0x0100
+        0xCD, 0x10, 0x00,   // CALL 0x0010
+        0xCD, 0x10, 0x00,   // CALL 0x0010
+        0x18, 0xFE,         // JR $
+    };
+    ubyte sub0[] = {
+        0xCD, 0x20, 0x00,   // CALL 0x0020
+        0xC9,               // RET
+    };
+    ubyte sub1[] = {
+        0x00,               // NOP
+        0xC9,               // RET
+    };
+    cpu.mem.write(0x0000, prog, sizeof(prog));
+    cpu.mem.write(0x0010, sub0, sizeof(sub0));
+    cpu.mem.write(0x0020, sub1, sizeof(sub1));
+
+    cpudbg dbg;
+    dbg.attach_cpu(&cpu);
+    CHECK(!dbg.prof.enabled);
+    dbg.prof.start(cpu_model::z80);
+    CHECK(dbg.prof.enabled);
+    for (int i = 0; i < 12; i++) {
+        step(dbg, cpu);
+    }
+    dbg.prof.stop();
+    step(dbg, cpu);
+
+    // LD SP,nn: 10, CALL: 17, RET: 10, NOP: 4, JR: 12 cycles
+    CHECK(dbg.prof.total_cycles == 138);
+    CHECK(dbg.prof.depth() == 0);
+    CHECK(dbg.prof.addr_cycles(0x0003) == 17);
+    CHECK(dbg.prof.addr_cycles(0x0010) == 34);
+    CHECK(dbg.prof.addr_cycles(0x0009) == 12);
+    CHECK(dbg.prof.inclusive_cycles(0x0010) == 82);
+    CHECK(dbg.prof.inclusive_cycles(0x0020) == 28);
+    CHECK(dbg.prof.num_calls(0x0010) == 2);
+    CHECK(dbg.prof.num_calls(0x0020) == 2);
+    CHECK(dbg.prof.num_nodes() == 3);
+
+    profiler::hotspot items[2];
+    CHECK(dbg.prof.hotspots(items, 2) == 2);
+    CHECK((items[0].addr == 0x0010) && (items[0].cycles == 34));
+    CHECK((items[1].addr == 0x0013) && (items[1].cycles == 20));
+
+    // collapsed stacks
+    FILE* fp = tmpfile();
+    dbg.prof.write_collapsed(fp);
+    rewind(fp);
+    char buf[256] = { };
+    fread(buf, 1, sizeof(buf)-1, fp);
+    fclose(fp);
+    CHECK(0 == strcmp(buf, "root 56\nroot;0010 54\nroot;0010;0020 28\n"));
+
+    dbg.prof.reset();
+    CHECK(dbg.prof.total_cycles == 0);
+    CHECK(dbg.prof.num_nodes() == 0);
+}
+
+//------------------------------------------------------------------------------
+TEST(profiler_z80_irq) {
+    init_funcs();
+    z80 cpu;
+    memset(ram, 0, sizeof(ram));
+    cpu.mem.map(0, 0x0000, 0x4000, ram, true);
+    cpu.init();
+    ubyte prog[] = {
+        0x31, 0x00, 0x01,   // LD SP,0x0100
+        0xED, 0x56,         // IM 1
+        0xFB,               // EI
+        0xF3,               // DI
+        0xFB,               // EI
+        0x00,               // NOP
+        0x18, 0xFE,         // JR $
+    };
+    ubyte isr[] = {
+        0xFB,               // EI
+        0xC9,               // RET
+    };
+    cpu.mem.write(0x0000, prog, sizeof(prog));
+    cpu.mem.write(0x0038, isr, sizeof(isr));
+
+    cpudbg dbg;
+    dbg.attach_cpu(&cpu);
+    dbg.prof.start(cpu_model::z80);
+    for (int i = 0; i < 6; i++) {
+        step(dbg, cpu);
+    }
+    // DI is not an interrupt
+    CHECK(dbg.prof.num_nodes() == 1);
+    // the interrupt is accepted after the JR
+    cpu.irq(true);
+    step(dbg, cpu);
+    CHECK(cpu.PC == 0x0038);
+    CHECK(dbg.prof.depth() == 1);
+    step(dbg, cpu);
+    step(dbg, cpu);
+    CHECK(cpu.PC == 0x0009);
+    CHECK(dbg.prof.depth() == 0);
+    CHECK(dbg.prof.num_calls(0x0038) == 1);
+    // EI: 4, RET: 10 cycles
+    CHECK(dbg.prof.inclusive_cycles(0x0038) == 14);
+    CHECK(dbg.prof.num_nodes() == 2);
+}
+
+//------------------------------------------------------------------------------
+TEST(profiler_z80_prefix) {
+    init_funcs();
+    z80 cpu;
+    memset(ram, 0, sizeof(ram));
+    cpu.mem.map(0, 0x0000, 0x4000, ram, true);
+    cpu.init();
+    ubyte prog[] = {
+        0x31, 0x00, 0x01,       // LD SP,0x0100
+        0xAF,                   // XOR A
+        0xDD, 0xCD, 0x20, 0x00, // CALL 0x0020 behind a DD prefix
+        0xDD, 0xC4, 0x20, 0x00, // CALL NZ,0x0020 (not taken)
+        0xFD, 0xCC, 0x20, 0x00, // CALL Z,0x0020 (taken)
+        0x18, 0xFE,             // JR $
+    };
+    ubyte sub[] = {
+        0xC9,                   // RET
+    };
+    cpu.mem.write(0x0000, prog, sizeof(prog));
+    cpu.mem.write(0x0020, sub, sizeof(sub));
+
+    cpudbg dbg;
+    dbg.attach_cpu(&cpu);
+    dbg.prof.start(cpu_model::z80);
+    for (int i = 0; i < 4; i++) {
+        step(dbg, cpu);
+    }
+    CHECK(cpu.PC == 0x0008);
+    CHECK(dbg.prof.depth() == 0);
+    CHECK(dbg.prof.num_calls(0x0020) == 1);
+    step(dbg, cpu);
+    CHECK(cpu.PC == 0x000C);
+    CHECK(dbg.prof.depth() == 0);
+    step(dbg, cpu);
+    CHECK(cpu.PC == 0x0020);
+    CHECK(dbg.prof.depth() == 1);
+    step(dbg, cpu);
+    step(dbg, cpu);
+    CHECK(cpu.PC == 0x0010);
+    CHECK(dbg.prof.depth() == 0);
+    CHECK(dbg.prof.num_calls(0x0020) == 2);
+    CHECK(dbg.prof.num_nodes() == 2);
+}
+
+//------------------------------------------------------------------------------
+TEST(profiler_6502) {
+    init_funcs();
+    mos6502 cpu;
+    memset(ram, 0, sizeof(ram));
+    cpu.mem.map(0, 0x0000, sizeof(ram), ram, true);
+    cpu.mem.w16(0xFFFC, 0x0200);
+    cpu.init(&bus);
+    cpu.reset();
+    ubyte prog[] = {
+        0x20, 0x10, 0x02,   // JSR $0210
+        0x4C, 0x03, 0x02,   // JMP $0203
+    };
+    ubyte sub[] = {
+        0x48,               // PHA
+        0x68,               // PLA
+        0x60,               // RTS
+    };
+    cpu.mem.write(0x0200, prog, sizeof(prog));
+    cpu.mem.write(0x0210, sub, sizeof(sub));
+
+    cpudbg dbg;
+    dbg.attach_cpu(&cpu);
+    dbg.prof.start(cpu_model::mos6502);
+    for (int i = 0; i < 6; i++) {
+        step(dbg, cpu);
+    }
+    // JSR: 6, PHA: 3, PLA: 4, RTS: 6, JMP: 3 cycles
+    CHECK(dbg.prof.total_cycles == 25);
+    CHECK(dbg.prof.depth() == 0);
+    CHECK(dbg.prof.inclusive_cycles(0x0210) == 13);
+    CHECK(dbg.prof.num_calls(0x0210) == 1);
+    CHECK(dbg.prof.addr_cycles(0x0203) == 6);
+}
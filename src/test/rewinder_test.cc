@@ -0,0 +1,164 @@
+//------------------------------------------------------------------------------
+//  rewinder_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/yakc.h"
+
+using namespace YAKC;
+
+static yakc emu;
+static uint8_t rom[0x4000];
+static uint8_t expected[8][0x4000];
+
+static void assert_msg(const char* cond, const char* msg, const char* file, int line, const char* func) {
+    fprintf(stderr, "assert failed: %s in %s:%d\n", cond, file, line);
+}
+
+static void init_emu() {
+    static bool initialized = false;
+    if (!initialized) {
+        initialized = true;
+        ext_funcs funcs;
+        funcs.assertmsg_func = assert_msg;
+        funcs.malloc_func = malloc;
+        funcs.free_func = free;
+        emu.init(funcs);
+        memset(rom, 0, sizeof(rom));
+        emu.add_rom(rom_images::zx128k_0, rom, 0x4000);
+        emu.add_rom(rom_images::zx128k_1, rom, 0x4000);
+    }
+    if (emu.switchedon()) {
+        emu.poweroff();
+    }
+    emu.poweron(system::zxspectrum128k);
+    memset(emu.board.ram, 0, emu.board.ram_size());
+}
+
+// write a frame-dependent pattern into RAM and the CPU state
+static void modify_state(int frame) {
+    memory& mem = emu.board.z80.mem;
+    emu.board.z80.PC = uword(0x1000 + frame);
+    emu.board.z80.HL = uword(frame * 3);
+    mem.w8(0x8000 + (frame & 0x3FFF), ubyte(frame));
+    // write to a bank which is switched out again before the frame ends
+    emu.zx.cpu_out(0x7FFD, ubyte(frame & 7));
+    mem.w8(0xC000 + ((frame * 7) & 0x3FFF), ubyte(frame ^ 0x55));
+    if (0 == (frame % 10)) {
+        mem.fill(0xC000, ubyte(frame), 0x4000);
+    }
+    emu.zx.cpu_out(0x7FFD, 0x00);
+}
+
+static bool ram_matches() {
+    return 0 == memcmp(&emu.board.ram[0][0], &expected[0][0], sizeof(expected));
+}
+
+TEST(rewinder_step_back) {
+    init_emu();
+    rewinder rw;
+    rw.init(rewinder::default_budget, 8);
+    CHECK(rw.is_valid());
+    CHECK(rw.num_frames() == 0);
+    CHECK(!rw.step_back(0, emu));
+
+    const int num = 30;
+    for (int i = 0; i < num; i++) {
+        modify_state(i);
+        rw.record(emu);
+        if (i == (num - 6)) {
+            memcpy(expected, emu.board.ram, sizeof(expected));
+        }
+    }
+    CHECK(rw.num_frames() == num);
+    CHECK(rw.num_recorded == num);
+    CHECK(rw.num_dropped == 0);
+    // only changed bytes are stored, the filled banks dominate the
+    // keyframes, still much less than 30 copies of the RAM
+    CHECK(rw.bytes_used() < 8 * 0x4000);
+
+    // step back 5 frames
+    CHECK(rw.step_back(5, emu));
+    CHECK(rw.num_frames() == num - 5);
+    CHECK(emu.model == system::zxspectrum128k);
+    CHECK(emu.board.z80.PC == 0x1000 + (num - 6));
+    CHECK(emu.board.z80.HL == (num - 6) * 3);
+    CHECK(emu.zx.last_7ffd_out == 0x00);
+    CHECK(ram_matches());
+
+    // continue recording from the restored frame
+    for (int i = num - 5; i < num + 5; i++) {
+        modify_state(i);
+        rw.record(emu);
+    }
+    memcpy(expected, emu.board.ram, sizeof(expected));
+    CHECK(rw.num_frames() == num + 5);
+    modify_state(100);
+    CHECK(rw.step_back(0, emu));
+    CHECK(emu.board.z80.PC == 0x1000 + num + 4);
+    CHECK(ram_matches());
+    CHECK(!rw.step_back(num + 5, emu));
+    emu.poweroff();
+}
+
+TEST(rewinder_budget) {
+    init_emu();
+    rewinder rw;
+    rw.init(1024 * 1024, 4);
+    memory& mem = emu.board.z80.mem;
+    for (int i = 0; i < 200; i++) {
+        // overwrite every bank, so each frame is big
+        for (int bank = 0; bank < 8; bank++) {
+            emu.zx.cpu_out(0x7FFD, ubyte(bank));
+            mem.fill(0xC000, ubyte(i + bank + 1), 0x4000);
+        }
+        rw.record(emu);
+        CHECK(rw.bytes_used() <= 1024 * 1024);
+    }
+    CHECK(rw.num_dropped > 0);
+    CHECK(rw.num_frames() + rw.num_dropped == 200);
+    memcpy(expected, emu.board.ram, sizeof(expected));
+    CHECK(rw.step_back(0, emu));
+    CHECK(ram_matches());
+    // the oldest frame is still reachable
+    CHECK(rw.step_back(rw.num_frames() - 1, emu));
+    CHECK(rw.num_frames() == 1);
+    rw.discard();
+    CHECK(!rw.is_valid());
+    emu.poweroff();
+}
+
+TEST(rewinder_emu_step) {
+    init_emu();
+    // INC (HL); INC HL; JR -4
+    const ubyte prog[] = { 0x34, 0x23, 0x18, 0xFC };
+    emu.board.z80.mem.write(0x4000, prog, sizeof(prog));
+    emu.board.z80.PC = 0x4000;
+    emu.board.z80.HL = 0x8000;
+
+    emu.start_rewind();
+    uword pc = 0;
+    for (int i = 0; i < 10; i++) {
+        emu.step(20000, 0);
+        if (i == 6) {
+            memcpy(expected, emu.board.ram, sizeof(expected));
+            pc = emu.board.z80.PC;
+        }
+    }
+    CHECK(emu.rewinder.num_frames() == 10);
+    // the RAM has changed after the recorded frame
+    CHECK(!ram_matches());
+    const uint64_t cycle_count = emu.abs_cycle_count;
+    CHECK(emu.rewind(3));
+    CHECK(ram_matches());
+    CHECK(emu.board.z80.PC == pc);
+    CHECK(emu.abs_cycle_count == cycle_count);
+    CHECK(emu.rewinder.num_frames() == 7);
+    // recording continues from the restored frame
+    emu.step(20000, 0);
+    CHECK(emu.rewinder.num_frames() == 8);
+    CHECK(!emu.rewind(8));
+    emu.stop_rewind();
+    CHECK(!emu.rewinder.is_valid());
+    CHECK(!emu.board.z80.mem.dirty_clients[memory::dirty_rewinder].enabled);
+    emu.poweroff();
+}
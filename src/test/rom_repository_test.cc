@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+//  rom_repository_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/yakc.h"
+#include "yakc/roms/rom_dumps.h"
+#include <stdio.h>
+
+using namespace YAKC;
+
+static bool write_file(const char* path, const void* ptr, int size) {
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        return false;
+    }
+    const bool ok = 1 == fwrite(ptr, size, 1, fp);
+    fclose(fp);
+    return ok;
+}
+
+TEST(rom_repository) {
+    func.malloc_func = malloc;
+    func.free_func = free;
+
+    // same as zlib crc32()
+    CHECK(rom_repository::crc32("123456789", 9) == 0xCBF43926);
+    CHECK(rom_repository::validate(rom_images::caos31, dump_caos31, sizeof(dump_caos31)));
+    CHECK(!rom_repository::validate(rom_images::caos34, dump_caos31, sizeof(dump_caos31)));
+    CHECK(!rom_repository::validate(rom_images::caos31, dump_caos31, sizeof(dump_caos31) - 1));
+
+    // load from directory, a corrupted image is rejected
+    static uint8_t bad_rom[sizeof(dump_basic_c0)];
+    memcpy(bad_rom, dump_basic_c0, sizeof(bad_rom));
+    bad_rom[0x100] ^= 0xFF;
+    CHECK(write_file("./caos31.853", dump_caos31, sizeof(dump_caos31)));
+    CHECK(write_file("./basic_c0.853", bad_rom, sizeof(bad_rom)));
+    CHECK(write_file("./z9001_basic.bin", dump_basic_c0, sizeof(dump_basic_c0)));
+    rom_repository repo;
+    CHECK(repo.load_dir(".") == 2);
+    CHECK(repo.num_rejected == 1);
+    CHECK(repo.has(rom_images::caos31));
+    CHECK(repo.has(rom_images::z9001_basic));
+    CHECK(!repo.has(rom_images::kc85_basic_rom));
+    CHECK(repo.size(rom_images::caos31) == int(sizeof(dump_caos31)));
+    CHECK(0 == memcmp(repo.ptr(rom_images::caos31), dump_caos31, sizeof(dump_caos31)));
+    remove("./caos31.853");
+    remove("./basic_c0.853");
+    remove("./z9001_basic.bin");
+
+    // ROM pack round trip, identical images are matched by content
+    CHECK(repo.write_pack("./yakc_test.rompack"));
+    rom_repository pack;
+    CHECK(pack.load_pack("./yakc_test.rompack") == 3);
+    CHECK(pack.has(rom_images::caos31));
+    CHECK(pack.has(rom_images::z9001_basic));
+    CHECK(pack.has(rom_images::kc85_basic_rom));
+    CHECK(pack.ptr(rom_images::z9001_basic) == pack.ptr(rom_images::kc85_basic_rom));
+    CHECK(0 == memcmp(pack.ptr(rom_images::kc85_basic_rom), dump_basic_c0, sizeof(dump_basic_c0)));
+    CHECK(pack.load_pack("./caos31.853") == 0);
+    remove("./yakc_test.rompack");
+
+    // the images are shared, not copied
+    rom_images roms;
+    roms.add(rom_images::caos31, dump_caos31, sizeof(dump_caos31));
+    pack.share(roms);
+    CHECK(roms.ptr(rom_images::caos31) != pack.ptr(rom_images::caos31));
+    CHECK(roms.ptr(rom_images::z9001_basic) == pack.ptr(rom_images::z9001_basic));
+    CHECK(roms.size(rom_images::kc85_basic_rom) == int(sizeof(dump_basic_c0)));
+    roms.clear();
+    CHECK(!roms.has(rom_images::caos31));
+}
@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+//  savestate_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/systems/savestate.h"
+
+using namespace YAKC;
+
+static yakc emu;
+static uint8_t rom[0x4000];
+static uint8_t buf[256 * 1024];
+static uint8_t buf2[256 * 1024];
+
+static void assert_msg(const char* cond, const char* msg, const char* file, int line, const char* func) {
+    fprintf(stderr, "assert failed: %s in %s:%d\n", cond, file, line);
+}
+
+static void init_emu() {
+    static bool initialized = false;
+    if (initialized) {
+        return;
+    }
+    initialized = true;
+    ext_funcs funcs;
+    funcs.assertmsg_func = assert_msg;
+    funcs.malloc_func = malloc;
+    funcs.free_func = free;
+    emu.init(funcs);
+    memset(rom, 0, sizeof(rom));
+    emu.add_rom(rom_images::zx48k, rom, 0x4000);
+    emu.add_rom(rom_images::zx128k_0, rom, 0x4000);
+    emu.add_rom(rom_images::zx128k_1, rom, 0x4000);
+    emu.add_rom(rom_images::z1013_mon202, rom, 0x800);
+    emu.add_rom(rom_images::z1013_font, rom, 0x800);
+}
+
+TEST(savestate_zx128) {
+    init_emu();
+    emu.poweron(system::zxspectrum128k);
+    // map RAM bank 3 to 0xC000
+    emu.zx.cpu_out(0x7FFD, 0x03);
+    emu.board.z80.mem.w8(0xC000, 0x42);
+    emu.board.z80.mem.w8(0x4000, 0x23);
+    emu.board.z80.PC = 0x1234;
+    emu.board.z80.HL = 0xBEEF;
+    emu.board.z80.IFF1 = true;
+    emu.board.ay8910.regs[ay8910::ENABLE] = 0x38;
+    emu.abs_cycle_count = 12345;
+
+    const int size = savestate::write(emu, nullptr, 0);
+    CHECK(size > 128 * 1024);
+    CHECK(size < 130 * 1024);
+    CHECK(savestate::write(emu, buf, sizeof(buf)) == size);
+    CHECK(savestate::is_savestate(buf, size));
+
+    // switch to a different system, and restore
+    emu.poweroff();
+    emu.poweron(system::zxspectrum48k);
+    CHECK(savestate::apply(buf, size, emu));
+    CHECK(emu.model == system::zxspectrum128k);
+    CHECK(emu.zx.on);
+    CHECK(emu.zx.last_7ffd_out == 0x03);
+    CHECK(emu.board.z80.mem.r8(0xC000) == 0x42);
+    CHECK(emu.board.z80.mem.r8(0x4000) == 0x23);
+    CHECK(emu.board.ram[3][0] == 0x42);
+    CHECK(emu.board.z80.PC == 0x1234);
+    CHECK(emu.board.z80.HL == 0xBEEF);
+    CHECK(emu.board.z80.IFF1);
+    CHECK(emu.board.ay8910.regs[ay8910::ENABLE] == 0x38);
+    CHECK(emu.abs_cycle_count == 12345);
+
+    // a truncated savestate is rejected
+    CHECK(!savestate::apply(buf, size - 100, emu));
+    emu.poweroff();
+    CHECK(emu.board.ram == nullptr);
+    CHECK(emu.board.rgba8_buffer == nullptr);
+}
+
+TEST(savestate_z1013) {
+    init_emu();
+    emu.poweron(system::z1013_01, os_rom::z1013_mon202);
+    // only the RAM banks up to the video RAM bank are allocated
+    CHECK(emu.board.ram_size() == (z1013::vidmem_page + 1) * breadboard::ram_bank_size);
+    emu.board.z80.mem.w8(0x0100, 0x11);
+    emu.board.z80.mem.w8(0xEC00, 0x22);
+    emu.board.z80.SP = 0x3FF0;
+    emu.z1013.kbd_column_bits = 0x12345678;
+
+    // only 16 KByte RAM and 1 KByte video RAM are written
+    const int size = savestate::write(emu, buf, sizeof(buf));
+    CHECK(size > 17 * 1024);
+    CHECK(size < 18 * 1024);
+
+    // insert an unknown chunk after the header, it must be skipped
+    const int hdr_size = 16;
+    memcpy(buf2, buf, hdr_size);
+    const uint32_t chunk[4] = { savestate::tag('X','T','R','A'), 1, 4, 0xDEADBEEF };
+    memcpy(buf2 + hdr_size, chunk, sizeof(chunk));
+    memcpy(buf2 + hdr_size + sizeof(chunk), buf + hdr_size, size - hdr_size);
+    const int size2 = size + sizeof(chunk);
+
+    emu.board.z80.mem.w8(0x0100, 0x00);
+    emu.board.z80.SP = 0;
+    emu.z1013.kbd_column_bits = 0;
+    CHECK(savestate::apply(buf2, size2, emu));
+    CHECK(emu.model == system::z1013_01);
+    CHECK(emu.board.z80.mem.r8(0x0100) == 0x11);
+    CHECK(emu.board.z80.mem.r8(0xEC00) == 0x22);
+    CHECK(emu.board.z80.SP == 0x3FF0);
+    CHECK(emu.z1013.kbd_column_bits == 0x12345678);
+    emu.poweroff();
+}
+
+TEST(savestate_tape) {
+    init_emu();
+    static const uint8_t tape[] = {
+        'Z', 'X', 'T', 'a', 'p', 'e', '!', 0x1A, 1, 20,
+        // standard speed data block, 100ms pause, 4 bytes
+        0x10, 0x64, 0x00, 4, 0,
+        0xFF, 0x11, 0x22, 0xFF^0x11^0x22,
+    };
+    emu.poweron(system::zxspectrum48k);
+    auto& deck = emu.tapedeck;
+    CHECK(deck.insert_external_tape("test.tzx", filetype::zx_tzx, tape, sizeof(tape)));
+    deck.play();
+    deck.inc_counter(3);
+    // play into the data bytes
+    const int pilot_cycles = 3223 * 2168 + 667 + 735;
+    deck.step(pilot_cycles + 2 * 8 * 1710);
+    const int size = savestate::write(emu, buf, sizeof(buf), false);
+
+    // record the rest of the tape
+    bool levels[256];
+    int num_high = 0;
+    for (auto& l : levels) {
+        l = deck.step(500);
+        num_high += l ? 1 : 0;
+    }
+    CHECK((num_high > 0) && (num_high < 256));
+    deck.stop_rewind();
+    CHECK(savestate::apply(buf, size, emu));
+    CHECK(deck.is_playing());
+    CHECK(deck.counter() == 3);
+    for (auto l : levels) {
+        CHECK(l == deck.step(500));
+    }
+
+    // the tape position isn't applied to a different tape
+    deck.insert_external_tape("other.tzx", filetype::zx_tzx, tape, sizeof(tape));
+    CHECK(savestate::apply(buf, size, emu));
+    CHECK(!deck.is_playing());
+    CHECK(deck.counter() == 0);
+    deck.remove_tape();
+    emu.poweroff();
+}
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+//  stats_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/core/stats.h"
+#include "yakc/chips/z80.h"
+#include "yakc/core/system_bus.h"
+#include <string.h>
+
+using namespace YAKC;
+
+//------------------------------------------------------------------------------
+TEST(stats_frame_times) {
+    stats s;
+    CHECK(0 == s.num_frame_times());
+    CHECK(0.0f == s.frame_time_percentile(50.0f));
+    for (int i = 1; i <= 100; i++) {
+        s.add_frame_time(float(i));
+    }
+    CHECK(100 == s.num_frame_times());
+    CHECK(50.0f == s.frame_time_percentile(50.0f));
+    CHECK(99.0f == s.frame_time_percentile(99.0f));
+    CHECK(100.0f == s.frame_time_percentile(100.0f));
+    CHECK(1.0f == s.frame_time_percentile(0.0f));
+    // only the most recent frames are kept
+    for (int i = 0; i < stats::max_frame_times; i++) {
+        s.add_frame_time(2.0f);
+    }
+    CHECK(stats::max_frame_times == s.num_frame_times());
+    CHECK(2.0f == s.frame_time_percentile(100.0f));
+
+    s.num_frames = 3;
+    s.ports = stats::port_low_byte;
+    s.port_writes[0xFE] = 7;
+    FILE* fp = tmpfile();
+    s.write(fp);
+    rewind(fp);
+    char buf[1024] = { };
+    fread(buf, 1, sizeof(buf)-1, fp);
+    fclose(fp);
+    CHECK(nullptr != strstr(buf, "yakc_frames 3\n"));
+    CHECK(nullptr != strstr(buf, "yakc_port_writes{port=\"xxFE\"} 7\n"));
+    CHECK(nullptr == strstr(buf, "yakc_port_reads"));
+    char name[8];
+    s.ports = stats::port_high_byte;
+    s.port_name(0x7F, name, sizeof(name));
+    CHECK(0 == strcmp(name, "7Fxx"));
+
+    s.reset();
+    CHECK(0 == s.num_frames);
+    CHECK(0 == s.port_writes[0xFE]);
+    CHECK(0 == s.num_frame_times());
+}
+
+//------------------------------------------------------------------------------
+TEST(stats_z80_counters) {
+    static ubyte ram[0x4000];
+    system_bus bus;
+    z80 cpu;
+    const uint64_t remaps = cpu.mem.num_remaps;
+    cpu.mem.map(0, 0x0000, sizeof(ram), ram, true);
+    CHECK((cpu.mem.num_remaps - remaps) == 16);
+    cpu.mem.map(0, 0x0000, sizeof(ram), ram, true);
+    CHECK((cpu.mem.num_remaps - remaps) == 16);
+    cpu.init();
+    ubyte prog[] = {
+        0x3E, 0x12,         // LD A,0x12
+        0xD3, 0x34,         // OUT (0x34),A
+        0x01, 0xFE, 0x12,   // LD BC,0x12FE
+        0xED, 0x78,         // IN A,(C)
+        0xED, 0x79,         // OUT (C),A
+        0xFB,               // EI
+        0x00,               // NOP
+    };
+    cpu.mem.write(0x0000, prog, sizeof(prog));
+    cpu.SP = 0x1000;
+    cpu.IM = 1;
+    for (int i = 0; i < 7; i++) {
+        cpu.step(&bus);
+        cpu.handle_irq(&bus);
+    }
+    CHECK(cpu.num_ops == 7);
+    CHECK(cpu.num_irqs == 0);
+    CHECK(cpu.port_writes[0x34] == 1);
+    CHECK(cpu.port_reads[0xFE] == 1);
+    CHECK(cpu.port_writes[0xFE] == 1);
+    cpu.irq(true);
+    cpu.handle_irq(&bus);
+    CHECK(cpu.num_irqs == 1);
+    CHECK(cpu.PC == 0x0038);
+
+    // count by the high port byte (Amstrad CPC)
+    cpu.port_stats_shift = 8;
+    cpu.PC = 0x0009;
+    cpu.step(&bus);
+    CHECK(cpu.port_writes[0x12] == 1);
+    CHECK(cpu.port_writes[0xFE] == 1);
+}
@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+//  tracer_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/chips/cpudbg.h"
+#include "yakc/core/system_bus.h"
+#include "yakc/chips/z80dasm.h"
+#include "yakc/chips/mos6502dasm.h"
+
+using namespace YAKC;
+
+static ubyte ram[0x4000];
+static system_bus bus;
+
+static void init_funcs() {
+    func.malloc_func = malloc;
+    func.free_func = free;
+}
+
+struct trace_check {
+    uint64_t num = 0;
+    uint64_t first_index = 0;
+    tracer::item items[8];
+    uint64_t sum_cycles = 0;
+};
+
+static void check_item(uint64_t index, const tracer::item& it, void* userdata) {
+    trace_check* tc = (trace_check*) userdata;
+    if (0 == tc->num) {
+        tc->first_index = index;
+    }
+    if (tc->num < 8) {
+        tc->items[tc->num] = it;
+    }
+    tc->sum_cycles += it.cycles;
+    tc->num++;
+}
+
+TEST(tracer_record) {
+    init_funcs();
+    z80 cpu;
+    ubyte prog[] = {
+        0x21, 0x00, 0x10,   // LD HL,0x1000
+        0x3E, 0x33,         // loop: LD A,0x33
+        0x77,               // LD (HL),A
+        0x23,               // INC HL
+        0x18, 0xFA,         // JR loop
+    };
+    memset(ram, 0, sizeof(ram));
+    cpu.mem.map(0, 0x0000, sizeof(ram), ram, true);
+    cpu.init();
+    cpu.mem.write(0x0000, prog, sizeof(prog));
+
+    cpudbg dbg;
+    dbg.attach_cpu(&cpu);
+    CHECK(!dbg.trace.enabled);
+    dbg.trace.start(cpu_model::z80);
+    CHECK(dbg.trace.enabled);
+    for (int i = 0; i < 9; i++) {
+        uint32_t ticks = cpu.step(&bus);
+        dbg.step(cpu.PC, ticks);
+    }
+    dbg.trace.stop();
+    uint32_t ticks = cpu.step(&bus);
+    dbg.step(cpu.PC, ticks);
+    CHECK(dbg.trace.num_items() == 9);
+
+    trace_check tc;
+    dbg.trace.decode(check_item, &tc);
+    CHECK(tc.num == 9);
+    CHECK(tc.first_index == 0);
+    // LD HL,0x1000
+    CHECK(tc.items[0].pc == 0x0000);
+    CHECK(tc.items[0].cycles == 10);
+    CHECK(tc.items[0].num_op_bytes == 3);
+    CHECK(tc.items[0].op_bytes[0] == 0x21);
+    CHECK(tc.items[0].op_bytes[2] == 0x10);
+    CHECK(tc.items[0].regs[3] == 0x1000);
+    // LD A,0x33
+    CHECK(tc.items[1].pc == 0x0003);
+    CHECK(tc.items[1].cycles == 7);
+    CHECK((tc.items[1].regs[0] & 0xFF00) == 0x3300);
+    CHECK(tc.items[1].regs[3] == 0x1000);
+    // LD (HL),A
+    CHECK(tc.items[2].pc == 0x0005);
+    CHECK(tc.items[2].num_op_bytes == 1);
+    // INC HL
+    CHECK(tc.items[3].pc == 0x0006);
+    CHECK(tc.items[3].cycles == 6);
+    CHECK(tc.items[3].regs[3] == 0x1001);
+    // JR loop
+    CHECK(tc.items[4].pc == 0x0007);
+    CHECK(tc.items[4].cycles == 12);
+    CHECK(tc.items[4].num_op_bytes == 2);
+    CHECK(tc.items[4].op_bytes[1] == 0xFA);
+    // LD A,0x33
+    CHECK(tc.items[5].pc == 0x0003);
+    CHECK(tc.items[7].regs[3] == 0x1002);
+}
+
+TEST(tracer_budget) {
+    init_funcs();
+    tracer trace;
+    trace.start(cpu_model::mos6502, tracer::chunk_size * 2);
+    tracer::item it;
+    it.num_op_bytes = 1;
+    const int num = 100000;
+    for (int i = 0; i < num; i++) {
+        it.pc = uint16_t(i * 3);
+        it.regs[0] = uint16_t(i);
+        it.cycles = 2 + (i & 3);
+        trace.record(it);
+    }
+    CHECK(trace.num_recorded == num);
+    CHECK(trace.num_dropped > 0);
+    CHECK(trace.num_items() == (num - trace.num_dropped));
+
+    trace_check tc;
+    trace.decode(check_item, &tc);
+    CHECK(tc.num == trace.num_items());
+    CHECK(tc.first_index == trace.num_dropped);
+    CHECK(tc.items[0].pc == uint16_t(tc.first_index * 3));
+    CHECK(tc.items[0].regs[0] == uint16_t(tc.first_index));
+    CHECK(tc.items[1].cycles == 2 + ((tc.first_index+1) & 3));
+    trace.reset();
+    CHECK(trace.num_items() == 0);
+}
+
+TEST(tracer_save_load) {
+    init_funcs();
+    const char* path = "yakc_tracer_test.trc";
+    tracer trace;
+    trace.start(cpu_model::z80, tracer::chunk_size);
+    tracer::item it;
+    it.num_op_bytes = 2;
+    for (int i = 0; i < 100; i++) {
+        it.pc = uint16_t(i * 2);
+        it.op_bytes[0] = uint8_t(i);
+        // a block instruction executed in bulk may take more than 0xFFFF cycles
+        it.cycles = (50 == i) ? 0x12345 : 4;
+        trace.record(it);
+    }
+    trace.stop();
+    CHECK(trace.save(path));
+
+    tracer loaded;
+    CHECK(loaded.load(path));
+    CHECK(loaded.num_items() == 100);
+    trace_check tc;
+    loaded.decode(check_item, &tc);
+    CHECK(tc.num == 100);
+    CHECK(tc.items[7].pc == 14);
+    CHECK(tc.items[7].op_bytes[0] == 7);
+    CHECK(tc.items[7].cycles == 4);
+    CHECK(tc.sum_cycles == (99 * 4 + 0x12345));
+
+    // a chunk with more items than fit into its size is rejected
+    static uint8_t buf[tracer::chunk_size + 64];
+    FILE* fp = fopen(path, "rb");
+    const int size = (int) fread(buf, 1, sizeof(buf), fp);
+    fclose(fp);
+    const int num_items_offset = 16 + 8;
+    buf[num_items_offset + 2] = 0x01;
+    fp = fopen(path, "wb");
+    fwrite(buf, 1, size, fp);
+    fclose(fp);
+    CHECK(!loaded.load(path));
+    CHECK(loaded.num_items() == 0);
+    remove(path);
+}
+
+static ubyte op_bytes[4];
+static unsigned char fetch_op_byte(unsigned short base, int offset, void* userdata) {
+    return op_bytes[offset & 3];
+}
+
+TEST(tracer_op_length) {
+    // the opcode length tables must agree with the disassemblers
+    char buf[64];
+    for (int b0 = 0; b0 < 256; b0++) {
+        for (int b1 = 0; b1 < 256; b1++) {
+            op_bytes[0] = b0; op_bytes[1] = b1; op_bytes[2] = 0x12; op_bytes[3] = 0x34;
+            const int len = z80dasm::z80disasm(fetch_op_byte, 0, buf, nullptr) & 0xFFFF;
+            CHECK_EQUAL(len, z80dasm::z80oplength(op_bytes));
+        }
+        op_bytes[0] = b0;
+        CHECK_EQUAL(mos6502dasm::mos6502disasm(fetch_op_byte, 0, buf, nullptr), mos6502dasm::mos6502oplength(b0));
+    }
+}
@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+//  tzx_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/peripherals/tapedeck.h"
+
+using namespace YAKC;
+
+static const uint8_t tape[] = {
+    'Z', 'X', 'T', 'a', 'p', 'e', '!', 0x1A, 1, 20,
+    // text description
+    0x30, 3, 'a', 'b', 'c',
+    // standard speed data block, 1000ms pause, 4 bytes
+    0x10, 0xE8, 0x03, 4, 0,
+    0xFF, 0x11, 0x22, 0xFF^0x11^0x22,
+    // stop the tape
+    0x20, 0, 0,
+    // turbo speed data block
+    0x11,
+    0xD0, 0x07,     // pilot pulse
+    0x58, 0x02,     // sync1
+    0x58, 0x02,     // sync2
+    0x20, 0x03,     // bit 0
+    0x40, 0x06,     // bit 1
+    4, 0,           // pilot pulses
+    8,              // used bits in last byte
+    0, 0,           // pause
+    2, 0, 0,        // data size
+    0x80, 0x00,
+};
+
+TEST(tzx_blocks) {
+    func.malloc_func = malloc;
+    func.free_func = free;
+
+    tapedeck deck;
+    static const uint8_t no_tzx[16] = { };
+    CHECK(!deck.insert_external_tape("bla.tzx", filetype::zx_tzx, no_tzx, sizeof(no_tzx)));
+    CHECK(!deck.tzx.is_valid());
+    CHECK(deck.insert_external_tape("test.tzx", filetype::zx_tzx, tape, sizeof(tape)));
+    CHECK(deck.tzx.is_valid());
+
+    // the text block is skipped
+    auto& tzx = deck.tzx;
+    CHECK(tzx.data_block_ready());
+    CHECK(tzx.blk.id == tzx::standard);
+    CHECK(tzx.blk.pause_ms == 1000);
+    CHECK(tzx.blk.pilot_pulses == 3223);
+    CHECK(tzx.data_left() == 4);
+    CHECK(tzx.read_u8() == 0xFF);
+    CHECK(tzx.read_u8() == 0x11);
+    CHECK(tzx.data_left() == 2);
+    CHECK(!tzx.data_block_ready());
+    tzx.finish_block();
+
+    // the stop block is skipped when loading block-wise
+    CHECK(tzx.data_block_ready());
+    CHECK(tzx.blk.id == tzx::turbo);
+    CHECK(tzx.blk.pilot_len == 2000);
+    CHECK(tzx.blk.sync1_len == 600);
+    CHECK(tzx.blk.bit1_len == 1600);
+    CHECK(tzx.blk.pilot_pulses == 4);
+    CHECK(tzx.data_left() == 2);
+    CHECK(tzx.read_u8() == 0x80);
+    CHECK(tzx.read_u8() == 0x00);
+    CHECK(tzx.read_u8() == 0x00);
+    tzx.finish_block();
+    CHECK(!tzx.data_block_ready());
+    CHECK(tzx.num_data_blocks == 2);
+
+    deck.remove_tape();
+    CHECK(!deck.tzx.is_valid());
+}
+
+TEST(tzx_pulses) {
+    func.malloc_func = malloc;
+    func.free_func = free;
+
+    tapedeck deck;
+    CHECK(deck.insert_external_tape("test.tzx", filetype::zx_tzx, tape, sizeof(tape)));
+    auto& tzx = deck.tzx;
+
+    // not playing, the tape doesn't move
+    CHECK(!deck.step(100000));
+    CHECK(tzx.num_data_blocks == 0);
+
+    // first pilot pulse is 2168 cycles
+    deck.play();
+    CHECK(deck.step(1));
+    CHECK(deck.step(2166));
+    CHECK(!deck.step(1));
+    CHECK(!deck.step(2167));
+    CHECK(deck.step(1));
+
+    // play until the stop block is reached
+    for (int i = 0; (i < 20) && deck.is_playing(); i++) {
+        deck.step(1000000);
+    }
+    CHECK(!deck.is_playing());
+    CHECK(!tzx.level);
+    CHECK(tzx.num_data_blocks == 1);
+
+    // continue with the turbo block at 4 MHz
+    tzx.freq_khz = 4000;
+    deck.play();
+    CHECK(deck.step(1));
+    CHECK(tzx.blk.id == tzx::turbo);
+    CHECK(deck.step(2283));
+    CHECK(!deck.step(1));
+
+    // rewind goes back to the first block
+    deck.stop_rewind();
+    CHECK(!deck.is_playing());
+    CHECK(tzx.data_block_ready());
+    CHECK(tzx.blk.id == tzx::standard);
+}
+
+TEST(tzx_skip_blocks) {
+    func.malloc_func = malloc;
+    func.free_func = free;
+    static const uint8_t skip_tape[] = {
+        'Z', 'X', 'T', 'a', 'p', 'e', '!', 0x1A, 1, 20,
+        // emulation info, 8 bytes
+        0x34, 1, 2, 3, 4, 5, 6, 7, 8,
+        // snapshot, type byte and 24-bit length
+        0x40, 0, 3, 0, 0, 0x10, 0x10, 0x10,
+        // hardware type, 1 entry
+        0x33, 1, 0, 0, 0,
+        // CSW recording, 32-bit length
+        0x18, 2, 0, 0, 0, 0x10, 0x10,
+        // pure data block, 1 byte
+        0x14, 0x57, 0x03, 0xAE, 0x06, 8, 0, 0, 1, 0, 0, 0x42,
+    };
+    tapedeck deck;
+    CHECK(deck.insert_external_tape("skip.tzx", filetype::zx_tzx, skip_tape, sizeof(skip_tape)));
+    auto& tzx = deck.tzx;
+    CHECK(tzx.data_block_ready());
+    CHECK(tzx.blk.id == tzx::pure_data);
+    CHECK(tzx.data_left() == 1);
+    CHECK(tzx.read_u8() == 0x42);
+}
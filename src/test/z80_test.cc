@@ -2127,6 +2127,77 @@ TEST(CPDR) {
     CHECK(cpu.test_flags(z80::NF|z80::CF));
 }
 
+// runs block instructions in bulk, must give identical results
+class bulkTestBus : public cpuTestBus {
+public:
+    int budget = 0;
+    virtual int cpu_block_budget() override {
+        return this->budget;
+    }
+};
+
+static void run_until_halt(z80& cpu, system_bus* bus, uint64_t& cycles, int& steps) {
+    cycles = 0;
+    steps = 0;
+    while (!cpu.HALT && (steps < 100000)) {
+        cycles += cpu.step(bus);
+        steps++;
+    }
+}
+
+TEST(BLOCK_bulk) {
+    static ubyte ram_a[0x4000];
+    static ubyte ram_b[0x4000];
+    memset(ram_a, 0, sizeof(ram_a));
+    for (int i = 0x1000; i < 0x3800; i++) {
+        ram_a[i] = ubyte((i * 37) ^ (i >> 7));
+    }
+    const ubyte prog[] = {
+        0x21, 0x00, 0x10, 0x11, 0x00, 0x20, 0x01, 0x00, 0x09, 0xED, 0xB0,  // LDIR, crosses pages
+        0x3E, 0xAA, 0x32, 0x00, 0x28,                                       // LD (0x2800),0xAA
+        0x21, 0x00, 0x28, 0x11, 0x01, 0x28, 0x01, 0xFF, 0x07, 0xED, 0xB0,  // LDIR, overlapping fill
+        0x21, 0xFF, 0x10, 0x11, 0xFF, 0x30, 0x01, 0x00, 0x05, 0xED, 0xB8,  // LDDR
+        0x21, 0x01, 0x38, 0x11, 0x00, 0x38, 0x01, 0x00, 0x04, 0xED, 0xB8,  // LDDR, overlapping
+        0x3E, 0x5A, 0x32, 0x34, 0x32,                                       // LD (0x3234),0x5A
+        0x21, 0x00, 0x30, 0x01, 0x00, 0x08, 0xED, 0xB1,                    // CPIR, found
+        0x3E, 0x00, 0x21, 0xFF, 0x2F, 0x01, 0x00, 0x03, 0xED, 0xB9,        // CPDR, not found
+        0x21, 0x00, 0x3F, 0x11, 0x4D, 0x00, 0x01, 0x20, 0x00, 0xED, 0xB0,  // LDIR, overwrites itself
+    };
+    memcpy(ram_a, prog, sizeof(prog));
+    ram_a[0x0080] = 0x76;   // HALT
+    memcpy(ram_b, ram_a, sizeof(ram_a));
+
+    for (int budget : { 30, 100, 1000, 1<<20 }) {
+        memcpy(ram_a, ram_b, sizeof(ram_a));
+        memcpy(ram0, ram_b, sizeof(ram0));
+        z80 cpu0, cpu1;
+        cpu0.mem.map(0, 0x0000, sizeof(ram0), ram0, true);
+        cpu1.mem.map(0, 0x0000, sizeof(ram_a), ram_a, true);
+        cpu0.init();
+        cpu1.init();
+        bulkTestBus bulk_bus;
+        bulk_bus.budget = budget;
+        uint64_t cycles0, cycles1;
+        int steps0, steps1;
+        run_until_halt(cpu0, &bus, cycles0, steps0);
+        run_until_halt(cpu1, &bulk_bus, cycles1, steps1);
+        CHECK(cpu0.HALT && cpu1.HALT);
+        CHECK(cycles0 == cycles1);
+        if (budget > 100) {
+            CHECK(steps1 < (steps0 / 16));
+        }
+        CHECK(cpu0.AF == cpu1.AF);
+        CHECK(cpu0.BC == cpu1.BC);
+        CHECK(cpu0.DE == cpu1.DE);
+        CHECK(cpu0.HL == cpu1.HL);
+        CHECK(cpu0.WZ == cpu1.WZ);
+        CHECK(cpu0.PC == cpu1.PC);
+        CHECK(cpu0.R == cpu1.R);
+        CHECK(cpu0.num_ops == cpu1.num_ops);
+        CHECK(0 == memcmp(ram0, ram_a, sizeof(ram0)));
+    }
+}
+
 TEST(DAA) {
     z80 cpu = init_z80();
 
@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+//  z80ctc_test.cc
+//------------------------------------------------------------------------------
+#include "UnitTest++/src/UnitTest++.h"
+#include "yakc/chips/z80ctc.h"
+#include "yakc/core/system_bus.h"
+
+using namespace YAKC;
+
+class ctc_bus : public system_bus {
+public:
+    int zcto[z80ctc::num_channels] = { };
+    virtual void ctc_zcto(int ctc_id, int chn_id) override {
+        zcto[chn_id]++;
+    }
+};
+
+//------------------------------------------------------------------------------
+TEST(z80ctc_timer) {
+
+    ctc_bus bus;
+    z80ctc ctc;
+    ctc.init(0);
+    CHECK(ctc.ticks_until_event(1000) == 1000);
+
+    // timer with prescaler 16 and constant 10, zero-crossing every 160 ticks
+    ctc.write(&bus, z80ctc::CTC0, z80ctc::MODE_TIMER|z80ctc::PRESCALER_16|z80ctc::TRIGGER_AUTOMATIC|z80ctc::CONSTANT_FOLLOWS|z80ctc::CONTROL_WORD);
+    ctc.write(&bus, z80ctc::CTC0, 10);
+    CHECK(ctc.ticks_until_event(1000) == 160);
+    CHECK(ctc.ticks_until_event(100) == 100);
+
+    // the counter value is derived without updating the channel
+    ctc.step(&bus, 100);
+    CHECK(ctc.read(z80ctc::CTC0) == 3);
+    CHECK(ctc.channels[z80ctc::CTC0].down_counter == 160);
+    CHECK(ctc.ticks_until_event(1000) == 60);
+
+    // the callback fires when the counter goes below zero
+    ctc.step(&bus, 60);
+    CHECK(bus.zcto[0] == 0);
+    CHECK(ctc.ticks_until_event(1000) == 0);
+    ctc.step(&bus, 1);
+    CHECK(bus.zcto[0] == 1);
+    CHECK(ctc.ticks_until_event(1000) == 159);
+
+    // a big step may cross zero several times
+    ctc.step(&bus, 3*160);
+    CHECK(bus.zcto[0] == 4);
+    CHECK(ctc.ticks_until_event(1000) == 159);
+
+    // a second timer with prescaler 256 and constant 1 comes first,
+    // the first timer is restarted with prescaler 256 and constant 2
+    ctc.write(&bus, z80ctc::CTC1, z80ctc::MODE_TIMER|z80ctc::PRESCALER_256|z80ctc::TRIGGER_AUTOMATIC|z80ctc::CONSTANT_FOLLOWS|z80ctc::CONTROL_WORD);
+    ctc.write(&bus, z80ctc::CTC1, 1);
+    ctc.write(&bus, z80ctc::CTC0, z80ctc::MODE_TIMER|z80ctc::PRESCALER_256|z80ctc::TRIGGER_AUTOMATIC|z80ctc::CONSTANT_FOLLOWS|z80ctc::CONTROL_WORD);
+    ctc.write(&bus, z80ctc::CTC0, 2);
+    CHECK(ctc.ticks_until_event(1000) == 256);
+    ctc.step(&bus, 257);
+    CHECK(bus.zcto[0] == 4);
+    CHECK(bus.zcto[1] == 1);
+    CHECK(ctc.ticks_until_event(1000) == 255);
+    ctc.step(&bus, 256);
+    CHECK(bus.zcto[0] == 5);
+    CHECK(bus.zcto[1] == 2);
+    CHECK(ctc.ticks_until_event(1000) == 255);
+
+    // a software reset stops the timers
+    ctc.write(&bus, z80ctc::CTC0, z80ctc::RESET|z80ctc::CONTROL_WORD);
+    ctc.write(&bus, z80ctc::CTC1, z80ctc::RESET|z80ctc::CONTROL_WORD);
+    CHECK(ctc.ticks_until_event(1000) == 1000);
+    ctc.step(&bus, 10000);
+    CHECK(bus.zcto[0] == 5);
+    CHECK(bus.zcto[1] == 2);
+
+    // a timer waiting for a trigger pulse doesn't run until triggered
+    ctc.write(&bus, z80ctc::CTC2, z80ctc::MODE_TIMER|z80ctc::PRESCALER_16|z80ctc::TRIGGER_PULSE|z80ctc::CONSTANT_FOLLOWS|z80ctc::CONTROL_WORD);
+    ctc.write(&bus, z80ctc::CTC2, 1);
+    CHECK(ctc.ticks_until_event(1000) == 1000);
+    ctc.step(&bus, 100);
+    CHECK(bus.zcto[2] == 0);
+    ctc.ctrg(&bus, z80ctc::CTC2);
+    CHECK(ctc.ticks_until_event(1000) == 16);
+    ctc.step(&bus, 17);
+    CHECK(bus.zcto[2] == 1);
+}
+
+//------------------------------------------------------------------------------
+TEST(z80ctc_counter) {
+
+    ctc_bus bus;
+    z80ctc ctc;
+    ctc.init(0);
+
+    // counters are only advanced by ctrg, and never produce a timer event
+    ctc.write(&bus, z80ctc::CTC3, z80ctc::MODE_COUNTER|z80ctc::CONSTANT_FOLLOWS|z80ctc::CONTROL_WORD);
+    ctc.write(&bus, z80ctc::CTC3, 2);
+    CHECK(ctc.ticks_until_event(1000) == 1000);
+    ctc.step(&bus, 1000);
+    CHECK(ctc.read(z80ctc::CTC3) == 2);
+    ctc.ctrg(&bus, z80ctc::CTC3);
+    CHECK(ctc.read(z80ctc::CTC3) == 1);
+    CHECK(bus.zcto[3] == 0);
+    ctc.ctrg(&bus, z80ctc::CTC3);
+    CHECK(bus.zcto[3] == 1);
+    CHECK(ctc.read(z80ctc::CTC3) == 2);
+}
@@ -117,11 +117,20 @@ TEST(zexdoc) {
     run_test(cpu, bus, "ZEXDOC");
 }
 
+//------------------------------------------------------------------------------
+// zexall runs with bulk block instructions enabled
+class zexBus : public system_bus {
+public:
+    virtual int cpu_block_budget() override {
+        return 1<<20;
+    }
+};
+
 //------------------------------------------------------------------------------
 TEST(zexall) {
 
     memset(output, 0, sizeof(output));
-    system_bus bus;
+    zexBus bus;
     z80 cpu;
     memset(ram, 0, sizeof(ram));
     cpu.mem.map(0, 0x0000, sizeof(ram), ram, true);
@@ -2,12 +2,48 @@
 //  cpudbg.cc
 //------------------------------------------------------------------------------
 #include "cpudbg.h"
+#include "yakc/chips/z80dasm.h"
+#include "yakc/chips/mos6502dasm.h"
 
 namespace YAKC {
 
 //------------------------------------------------------------------------------
 cpudbg::cpudbg() {
     memset(&this->history, 0, sizeof(this->history));
+    clear(this->bp_bits, sizeof(this->bp_bits));
+    clear(this->break_bits, sizeof(this->break_bits));
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::attach_cpu(z80* cpu) {
+    YAKC_ASSERT(cpu);
+    this->z80cpu = cpu;
+    this->m6502cpu = nullptr;
+    this->update();
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::attach_cpu(mos6502* cpu) {
+    YAKC_ASSERT(cpu);
+    this->z80cpu = nullptr;
+    this->m6502cpu = cpu;
+    this->update();
+}
+
+//------------------------------------------------------------------------------
+memory*
+cpudbg::mem() const {
+    if (this->z80cpu) {
+        return &this->z80cpu->mem;
+    }
+    else if (this->m6502cpu) {
+        return &this->m6502cpu->mem;
+    }
+    else {
+        return nullptr;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -20,21 +56,29 @@ cpudbg::get_pc_history(int index) const {
 //------------------------------------------------------------------------------
 void
 cpudbg::enable_breakpoint(uint16_t addr) {
-    this->bp.enabled = true;
-    this->bp.address = addr;
+    this->bp_bits[addr>>5] |= (1<<(addr&0x1F));
+    this->break_bits[addr>>5] |= (1<<(addr&0x1F));
 }
 
 //------------------------------------------------------------------------------
 void
-cpudbg::disable_breakpoint() {
-    this->bp.enabled = false;
+cpudbg::disable_breakpoint(uint16_t addr) {
+    this->bp_bits[addr>>5] &= ~(1<<(addr&0x1F));
+    this->update();
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::clear_breakpoints() {
+    clear(this->bp_bits, sizeof(this->bp_bits));
+    this->update();
 }
 
 //------------------------------------------------------------------------------
 void
 cpudbg::toggle_breakpoint(uint16_t addr) {
-    if (this->bp.address == addr) {
-        this->bp.enabled = !this->bp.enabled;
+    if (this->is_breakpoint(addr)) {
+        this->disable_breakpoint(addr);
     }
     else {
         this->enable_breakpoint(addr);
@@ -44,24 +88,385 @@ cpudbg::toggle_breakpoint(uint16_t addr) {
 //------------------------------------------------------------------------------
 bool
 cpudbg::is_breakpoint(uint16_t addr) const {
-    if ((this->bp.enabled) && (this->bp.address == addr)) {
-        return true;
+    return 0 != (this->bp_bits[addr>>5] & (1<<(addr&0x1F)));
+}
+
+//------------------------------------------------------------------------------
+int
+cpudbg::num_breakpoints() const {
+    int num = 0;
+    for (int i = 0; i < num_bitmap_words; i++) {
+        for (uint32_t bits = this->bp_bits[i]; bits; bits &= bits-1) {
+            num++;
+        }
     }
-    else {
-        return false;
+    return num;
+}
+
+//------------------------------------------------------------------------------
+bool
+cpudbg::add_condition(uint16_t addr, reg r, cmp op, uint16_t value) {
+    for (auto& c : this->conditions) {
+        if (!c.enabled) {
+            c.enabled = true;
+            c.addr = addr;
+            c.r = r;
+            c.op = op;
+            c.value = value;
+            this->update();
+            return true;
+        }
     }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::remove_conditions(uint16_t addr) {
+    for (auto& c : this->conditions) {
+        if (c.addr == addr) {
+            c.enabled = false;
+        }
+    }
+    this->update();
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::clear_conditions() {
+    for (auto& c : this->conditions) {
+        c.enabled = false;
+    }
+    this->update();
 }
 
 //------------------------------------------------------------------------------
 bool
-cpudbg::breakpoint_enabled() const {
-    return this->bp.enabled;
+cpudbg::add_watchpoint(uint16_t addr, uint16_t len, int mode) {
+    YAKC_ASSERT(len > 0);
+    YAKC_ASSERT(0 != (mode & (watch_read|watch_write|watch_exec)));
+    for (auto& wp : this->watchpoints) {
+        if (!wp.enabled) {
+            wp.enabled = true;
+            wp.addr = addr;
+            wp.len = len;
+            wp.mode = mode;
+            this->update();
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::remove_watchpoints(uint16_t addr) {
+    for (auto& wp : this->watchpoints) {
+        if (wp.addr == addr) {
+            wp.enabled = false;
+        }
+    }
+    this->update();
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::clear_watchpoints() {
+    for (auto& wp : this->watchpoints) {
+        wp.enabled = false;
+    }
+    this->update();
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::update() {
+    // rebuild the bitmap of addresses which need a closer look
+    memcpy(this->break_bits, this->bp_bits, sizeof(this->break_bits));
+    for (const auto& c : this->conditions) {
+        if (c.enabled) {
+            this->break_bits[c.addr>>5] |= (1<<(c.addr&0x1F));
+        }
+    }
+    uint64_t trap_pages = 0;
+    for (const auto& wp : this->watchpoints) {
+        if (wp.enabled) {
+            if (wp.mode & watch_exec) {
+                for (uint32_t i = 0; i < wp.len; i++) {
+                    const uint16_t addr = wp.addr + i;
+                    this->break_bits[addr>>5] |= (1<<(addr&0x1F));
+                }
+            }
+            if (wp.mode & (watch_read|watch_write)) {
+                const uint32_t first_page = wp.addr>>memory::page::shift;
+                const uint32_t last_page = (wp.addr+wp.len-1)>>memory::page::shift;
+                for (uint32_t i = first_page; i <= last_page; i++) {
+                    trap_pages |= uint64_t(1)<<(i & (memory::num_pages-1));
+                }
+            }
+        }
+    }
+
+    // install memory traps for read/write watchpoints, a running
+    // heatmap counts memory accesses in the trap callback on all pages
+    this->watch_pages = trap_pages;
+    if (this->heat.enabled) {
+        trap_pages = ~uint64_t(0);
+    }
+    memory* m = this->mem();
+    if (this->trap_mem && (this->trap_mem != m)) {
+        this->trap_mem->set_traps(0, nullptr, nullptr);
+        this->trap_mem->set_heatmap(nullptr);
+    }
+    this->trap_mem = m;
+    if (m) {
+        m->set_traps(trap_pages, trap_pages ? trap : nullptr, this);
+        m->set_heatmap(this->heat.enabled ? &this->heat : nullptr);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::start_heatmap(bool per_address) {
+    this->heat.start(per_address);
+    this->update();
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::stop_heatmap() {
+    this->heat.stop();
+    this->update();
+}
+
+//------------------------------------------------------------------------------
+int
+cpudbg::op_length(uint16_t pc) const {
+    const memory* m = this->mem();
+    if (!m) {
+        return 1;
+    }
+    if (this->z80cpu) {
+        const uint8_t bytes[2] = { m->r8_untrapped(pc), m->r8_untrapped(uint16_t(pc + 1)) };
+        return z80dasm::z80oplength(bytes);
+    }
+    else {
+        return mos6502dasm::mos6502oplength(m->r8_untrapped(pc));
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::fetch_op(uint16_t pc) {
+    this->op_pc = pc;
+    this->op_len = 1;
+    if (this->z80cpu) {
+        this->op_num_irqs = this->z80cpu->num_irqs;
+    }
+    memory* m = this->mem();
+    if (!m) {
+        memset(this->op_bytes, 0, sizeof(this->op_bytes));
+        return;
+    }
+    if (this->trace.enabled) {
+        // the instruction length is looked up from the opcode bytes, the
+        // next PC can't be used for jumps, calls, returns and interrupts
+        for (int i = 0; i < tracer::max_op_bytes; i++) {
+            this->op_bytes[i] = m->r8_untrapped(uint16_t(pc + i));
+        }
+        if (this->z80cpu) {
+            this->op_len = uint8_t(z80dasm::z80oplength(this->op_bytes));
+        }
+        else if (this->m6502cpu) {
+            this->op_len = uint8_t(mos6502dasm::mos6502oplength(this->op_bytes[0]));
+        }
+        this->op_full = true;
+    }
+    else {
+        // the profiler only needs the opcode (behind an index prefix)
+        this->op_bytes[0] = m->r8_untrapped(pc);
+        if (this->z80cpu && ((this->op_bytes[0] == 0xDD) || (this->op_bytes[0] == 0xFD))) {
+            this->op_bytes[1] = m->r8_untrapped(uint16_t(pc + 1));
+            this->op_len = 2;
+        }
+        this->op_full = false;
+    }
+    this->op_prefix = 0;
+    if (this->z80cpu && ((this->op_bytes[0] == 0xDD) || (this->op_bytes[0] == 0xFD))) {
+        this->op_prefix = 1;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::trace_step(uint32_t op_cycles) {
+    tracer::item it;
+    it.pc = this->history[this->hist_pos].pc;
+    it.cycles = op_cycles;
+    // the opcode bytes have been captured before the instruction was executed
+    it.num_op_bytes = this->op_len;
+    memcpy(it.op_bytes, this->op_bytes, sizeof(it.op_bytes));
+    if (this->z80cpu) {
+        const z80& cpu = *this->z80cpu;
+        it.regs[0] = cpu.AF; it.regs[1] = cpu.BC; it.regs[2] = cpu.DE; it.regs[3] = cpu.HL;
+        it.regs[4] = cpu.IX; it.regs[5] = cpu.IY; it.regs[6] = cpu.SP;
+    }
+    else if (this->m6502cpu) {
+        const mos6502& cpu = *this->m6502cpu;
+        it.regs[0] = cpu.A; it.regs[1] = cpu.X; it.regs[2] = cpu.Y; it.regs[3] = cpu.S; it.regs[4] = cpu.P;
+    }
+    this->trace.record(it);
+}
+
+//------------------------------------------------------------------------------
+void
+cpudbg::profile_step(uint16_t next_pc, uint32_t op_cycles) {
+    const uint16_t pc = this->history[this->hist_pos].pc;
+    if (this->z80cpu) {
+        const z80& cpu = *this->z80cpu;
+        this->prof.record(pc, op_cycles, cpu.SP);
+        // handle_irq() counts accepted interrupts (the counter may have
+        // been reset in between, so only check for an increase), otherwise
+        // check the opcode captured before execution for CALL nn, a taken
+        // CALL cc,nn, or RST (a DD/FD prefix doesn't change these)
+        const uint8_t op = this->op_bytes[this->op_prefix];
+        const bool irq = cpu.num_irqs > this->op_num_irqs;
+        if (irq ||
+            (op == 0xCD) ||
+            (((op & 0xC7) == 0xC4) && (next_pc != uint16_t(pc + this->op_prefix + 3))) ||
+            ((op & 0xC7) == 0xC7))
+        {
+            this->prof.call(next_pc, cpu.SP);
+        }
+    }
+    else if (this->m6502cpu) {
+        const mos6502& cpu = *this->m6502cpu;
+        const uint16_t sp = 0x0100 | cpu.S;
+        this->prof.record(pc, op_cycles, sp);
+        // IR is the executed opcode, interrupts are executed as BRK
+        if ((cpu.IR == 0x20) || (cpu.IR == 0x00)) {
+            this->prof.call(next_pc, sp);
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
 uint16_t
-cpudbg::breakpoint_addr() const {
-    return this->bp.address;
+cpudbg::reg_value(reg r) const {
+    if (this->z80cpu) {
+        const z80& cpu = *this->z80cpu;
+        switch (r) {
+            case reg::A:  return cpu.A;
+            case reg::F:  return cpu.F;
+            case reg::B:  return cpu.B;
+            case reg::C:  return cpu.C;
+            case reg::D:  return cpu.D;
+            case reg::E:  return cpu.E;
+            case reg::H:  return cpu.H;
+            case reg::L:  return cpu.L;
+            case reg::AF: return cpu.AF;
+            case reg::BC: return cpu.BC;
+            case reg::DE: return cpu.DE;
+            case reg::HL: return cpu.HL;
+            case reg::IX: return cpu.IX;
+            case reg::IY: return cpu.IY;
+            case reg::SP: return cpu.SP;
+            default: return 0;
+        }
+    }
+    else if (this->m6502cpu) {
+        const mos6502& cpu = *this->m6502cpu;
+        switch (r) {
+            case reg::A:  return cpu.A;
+            case reg::X:  return cpu.X;
+            case reg::Y:  return cpu.Y;
+            case reg::S:
+            case reg::SP: return cpu.S;
+            case reg::F:
+            case reg::P:  return cpu.P;
+            default: return 0;
+        }
+    }
+    return 0;
+}
+
+//------------------------------------------------------------------------------
+bool
+cpudbg::check_break(uint16_t pc) {
+    if (this->is_breakpoint(pc)) {
+        return true;
+    }
+    for (const auto& c : this->conditions) {
+        if (c.enabled && (c.addr == pc)) {
+            const uint16_t val = this->reg_value(c.r);
+            bool hit = false;
+            switch (c.op) {
+                case cmp::eq: hit = val == c.value; break;
+                case cmp::ne: hit = val != c.value; break;
+                case cmp::lt: hit = val <  c.value; break;
+                case cmp::le: hit = val <= c.value; break;
+                case cmp::gt: hit = val >  c.value; break;
+                case cmp::ge: hit = val >= c.value; break;
+            }
+            if (hit) {
+                return true;
+            }
+        }
+    }
+    for (const auto& wp : this->watchpoints) {
+        if (wp.enabled && (wp.mode & watch_exec) && (uint16_t(pc - wp.addr) < wp.len)) {
+            this->last_watch_hit.pc = pc;
+            this->last_watch_hit.addr = pc;
+            this->last_watch_hit.value = this->trap_mem ? this->trap_mem->r8_untrapped(pc) : 0;
+            this->last_watch_hit.mode = watch_exec;
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+uint8_t
+cpudbg::trap(void* userdata, bool write, uint16_t addr, uint8_t inval) {
+    cpudbg* dbg = (cpudbg*) userdata;
+    YAKC_ASSERT(dbg && dbg->trap_mem);
+    // the start address of the currently executed instruction
+    const uint16_t pc = dbg->history[dbg->hist_pos].pc;
+    uint8_t val;
+    int mode;
+    if (write) {
+        if (dbg->heat.enabled) {
+            dbg->heat.count_write(addr);
+        }
+        dbg->trap_mem->w8io_untrapped(addr, inval);
+        val = inval;
+        mode = watch_write;
+    }
+    else {
+        if (dbg->heat.enabled) {
+            dbg->heat.count_read(addr);
+        }
+        val = dbg->trap_mem->r8io_untrapped(addr);
+        if ((uint16_t(addr - pc) < tracer::max_op_bytes) && (uint16_t(addr - pc) < dbg->op_length(pc))) {
+            // an opcode or operand fetch of the current instruction
+            return val;
+        }
+        mode = watch_read;
+    }
+    if (0 == (dbg->watch_pages & (uint64_t(1)<<(addr>>memory::page::shift)))) {
+        return val;
+    }
+    for (const auto& wp : dbg->watchpoints) {
+        if (wp.enabled && (wp.mode & mode) && (uint16_t(addr - wp.addr) < wp.len)) {
+            dbg->last_watch_hit.pc = pc;
+            dbg->last_watch_hit.addr = addr;
+            dbg->last_watch_hit.value = val;
+            dbg->last_watch_hit.mode = mode;
+            dbg->watch_triggered = true;
+            break;
+        }
+    }
+    return val;
 }
 
 } // namespace YAKC
@@ -3,10 +3,29 @@
 /**
     @class YAKC::cpudbg
     @brief debug helper functions
+
+    Breakpoints are stored in a 64k-bit bitmap, so that checking for
+    breakpoints costs a single bit test per instruction, no matter how
+    many breakpoints are set. Conditional breakpoints and execute
+    watchpoints set a bit in the same bitmap, the slow path which
+    evaluates the conditions is only taken when the bit is set.
+
+    Read and write watchpoints redirect the watched 1 KByte memory pages
+    to a trap callback (see memory::set_traps()), all other pages
+    are accessed without overhead.
+
+    To record a deep execution trace, call trace.start() (see tracer.h),
+    to profile the executed cycles per address and subroutine, call
+    prof.start() (see profiler.h). To count memory accesses per page
+    or address, call start_heatmap(), this redirects all memory pages
+    to the trap callback which counts the accesses, and counts the
+    executed instructions (see heatmap.h).
 */
 #include "yakc/core/core.h"
 #include "yakc/chips/z80.h"
 #include "yakc/chips/mos6502.h"
+#include "yakc/chips/tracer.h"
+#include "yakc/chips/profiler.h"
 
 namespace YAKC {
 
@@ -20,56 +39,198 @@ public:
     /// an item in the history
     struct history_item {
         uint16_t pc = 0;
-        uint16_t cycles = 0;
+        uint32_t cycles = 0;
     };
     /// debugger is currently active
     bool active = false;
 
+    /// register identifiers for conditional breakpoints
+    enum class reg {
+        A, F, B, C, D, E, H, L,     // Z80 8-bit registers (A and F also 6502)
+        AF, BC, DE, HL, IX, IY, SP, // Z80 16-bit registers
+        X, Y, S, P,                 // 6502 registers
+    };
+    /// comparison ops for conditional breakpoints
+    enum class cmp {
+        eq, ne, lt, le, gt, ge,
+    };
+    /// watchpoint access mode bits
+    enum {
+        watch_read = (1<<0),
+        watch_write = (1<<1),
+        watch_exec = (1<<2),
+    };
+    /// max number of conditional breakpoints
+    static const int max_conditions = 16;
+    /// max number of watchpoints
+    static const int max_watchpoints = 16;
+
+    /// a conditional breakpoint
+    struct condition {
+        bool enabled = false;
+        uint16_t addr = 0;
+        reg r = reg::A;
+        cmp op = cmp::eq;
+        uint16_t value = 0;
+    };
+    /// a watchpoint
+    struct watchpoint {
+        bool enabled = false;
+        uint16_t addr = 0;
+        uint16_t len = 0;
+        int mode = 0;
+    };
+    /// info about the last watchpoint hit
+    struct watch_hit {
+        uint16_t pc = 0;
+        uint16_t addr = 0;
+        uint8_t value = 0;
+        int mode = 0;
+    };
+
     /// constructor
     cpudbg();
+    /// attach to a Z80 CPU (for register conditions and watchpoints)
+    void attach_cpu(z80* cpu);
+    /// attach to a 6502 CPU (for register conditions and watchpoints)
+    void attach_cpu(mos6502* cpu);
     /// check if breakpoint hit, and store pc in history, return if breakkpoint hit
-    bool step(uint16_t pc, uint16_t op_cycles);
+    bool step(uint16_t pc, uint32_t op_cycles);
     /// get pc from history ringbuffer (0 is oldest entry)
     history_item get_pc_history(int index) const;
-    /// enable breakpoint
+
+    /// enable breakpoint at address
     void enable_breakpoint(uint16_t addr);
-    /// disable breakpoint
-    void disable_breakpoint();
-    /// if breakpoint at addr exists, toggle state, else enable breakpoint
+    /// disable breakpoint at address
+    void disable_breakpoint(uint16_t addr);
+    /// disable all breakpoints
+    void clear_breakpoints();
+    /// if breakpoint at addr exists, disable it, else enable breakpoint
     void toggle_breakpoint(uint16_t addr);
     /// test if an address is breakpoint
     bool is_breakpoint(uint16_t addr) const;
-    /// return true if breakpoint is enabled
-    bool breakpoint_enabled() const;
-    /// get breakpoint address
-    uint16_t breakpoint_addr() const;
+    /// return number of enabled breakpoints
+    int num_breakpoints() const;
+
+    /// add a conditional breakpoint, return false if no free slot
+    bool add_condition(uint16_t addr, reg r, cmp op, uint16_t value);
+    /// remove all conditional breakpoints at address
+    void remove_conditions(uint16_t addr);
+    /// remove all conditional breakpoints
+    void clear_conditions();
+
+    /// add a watchpoint (mode is combination of watch_read, watch_write, watch_exec), return false if no free slot
+    bool add_watchpoint(uint16_t addr, uint16_t len, int mode);
+    /// remove all watchpoints starting at address
+    void remove_watchpoints(uint16_t addr);
+    /// remove all watchpoints
+    void clear_watchpoints();
+
+    /// get current value of a register of the attached CPU
+    uint16_t reg_value(reg r) const;
+
+    /// start counting memory accesses, clears the heatmap
+    void start_heatmap(bool per_address);
+    /// stop counting memory accesses, the heatmap counters are kept
+    void stop_heatmap();
+
+    condition conditions[max_conditions];
+    watchpoint watchpoints[max_watchpoints];
+    /// set by the memory trap callback when a read/write watchpoint triggers
+    bool watch_triggered = false;
+    /// the last watchpoint hit
+    watch_hit last_watch_hit;
+    /// the execution trace recorder
+    tracer trace;
+    /// the cycle profiler
+    profiler prof;
+    /// the memory access counters
+    heatmap heat;
 
 private:
+    /// memory trap callback for read/write watchpoints, userdata is the cpudbg
+    static uint8_t trap(void* userdata, bool write, uint16_t addr, uint8_t inval);
+    /// slow-path breakpoint check when the breakpoint bit is set
+    bool check_break(uint16_t pc);
+    /// rebuild the breakpoint bitmap, memory traps and heatmap attachment
+    void update();
+    /// decode the length of the instruction at pc
+    int op_length(uint16_t pc) const;
+    /// capture the opcode bytes at pc before the instruction is executed
+    void fetch_op(uint16_t pc);
+    /// record the last executed instruction into the trace
+    void trace_step(uint32_t op_cycles);
+    /// record the last executed instruction into the profiler
+    void profile_step(uint16_t next_pc, uint32_t op_cycles);
+    /// the memory object of the attached CPU
+    memory* mem() const;
+
+    static const int num_bitmap_words = (1<<16)/32;
+    z80* z80cpu = nullptr;
+    mos6502* m6502cpu = nullptr;
+    memory* trap_mem = nullptr;
+    /// pages with read or write watchpoints
+    uint64_t watch_pages = 0;
     int hist_pos = 0;
     history_item history[ringbuffer_size];
-    struct breakpoint {
-        breakpoint() : enabled(false), address(0) {};
-        bool enabled;
-        uint16_t address;
-    } bp;
+    /// opcode bytes of the next instruction, captured before it executes
+    /// (all bytes for the tracer, only prefix and opcode for the profiler)
+    uint16_t op_pc = 0;
+    uint8_t op_len = 0;             // 0 if not captured
+    uint8_t op_bytes[tracer::max_op_bytes] = { };
+    /// true if all bytes of the instruction have been captured
+    bool op_full = false;
+    /// number of Z80 DD/FD prefix bytes before the opcode
+    uint8_t op_prefix = 0;
+    /// Z80 accepted interrupts before the next instruction (see z80::handle_irq())
+    uint64_t op_num_irqs = 0;
+    /// unconditional breakpoints
+    uint32_t bp_bits[num_bitmap_words];
+    /// all addresses which need a check_break()
+    uint32_t break_bits[num_bitmap_words];
 };
 
 //------------------------------------------------------------------------------
 inline bool
-cpudbg::step(uint16_t pc, uint16_t op_cycles) {
+cpudbg::step(uint16_t pc, uint32_t op_cycles) {
+    if (this->trace.enabled || this->prof.enabled) {
+        const uint16_t cur_pc = this->history[this->hist_pos].pc;
+        if ((0 == this->op_len) || (cur_pc != this->op_pc) || (this->trace.enabled && !this->op_full)) {
+            // recording has just started, or PC was changed from outside
+            this->fetch_op(cur_pc);
+        }
+        if (this->trace.enabled) {
+            this->trace_step(op_cycles);
+        }
+        if (this->prof.enabled) {
+            this->profile_step(pc, op_cycles);
+        }
+    }
+    if (this->heat.enabled) {
+        this->heat.count_exec(this->history[this->hist_pos].pc);
+    }
+
     // store pc in history
     history[hist_pos].cycles = op_cycles;
     hist_pos = (this->hist_pos+1) & (ringbuffer_size-1);
     history[hist_pos].pc = pc;
     history[hist_pos].cycles = 0;
+    if (this->trace.enabled || this->prof.enabled) {
+        this->fetch_op(pc);
+    }
 
-    // check breakpoint
-    if (this->bp.enabled) {
-        if (pc == this->bp.address) {
+    // check breakpoints and watchpoints
+    if (this->break_bits[pc>>5] & (1<<(pc&0x1F))) {
+        if (this->check_break(pc)) {
             this->active = true;
             return true;
         }
     }
+    if (this->watch_triggered) {
+        this->watch_triggered = false;
+        this->active = true;
+        return true;
+    }
     return false;
 }
 
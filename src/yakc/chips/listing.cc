@@ -0,0 +1,459 @@
+//------------------------------------------------------------------------------
+//  listing.cc
+//------------------------------------------------------------------------------
+#include "listing.h"
+#include "yakc/chips/z80dasm.h"
+#include "yakc/chips/mos6502dasm.h"
+#include <string.h>
+#include <ctype.h>
+
+namespace YAKC {
+
+namespace {
+
+/// a ROM image for the fetch callback
+struct image {
+    const uint8_t* ptr;
+    int size;
+    uint16_t base_addr;
+};
+
+/// state passed through the z80dasm/mos6502dasm fetch callback
+struct dasm_ctx {
+    uint8_t (*fetch)(uint16_t addr, const void* userdata);
+    const void* userdata;
+    uint8_t bytes[listing::max_bytes];
+};
+
+//------------------------------------------------------------------------------
+uint8_t
+fetch_mem(uint16_t addr, const void* userdata) {
+    const memory& mem = *(const memory*) userdata;
+    if (mem.untrapped_table[addr>>memory::page::shift].write_ptr) {
+        return mem.r8_untrapped(addr);
+    }
+    else {
+        // don't trigger side effects of memory-mapped-io
+        return 0xFF;
+    }
+}
+
+//------------------------------------------------------------------------------
+uint8_t
+fetch_image(uint16_t addr, const void* userdata) {
+    const image& img = *(const image*) userdata;
+    const int offset = uint16_t(addr - img.base_addr);
+    return (offset < img.size) ? img.ptr[offset] : 0xFF;
+}
+
+//------------------------------------------------------------------------------
+unsigned char
+fetch_dasm(unsigned short base, int offset, void* userdata) {
+    dasm_ctx* ctx = (dasm_ctx*) userdata;
+    const uint8_t val = ctx->fetch(uint16_t(base + offset), ctx->userdata);
+    if (offset < listing::max_bytes) {
+        ctx->bytes[offset] = val;
+    }
+    return val;
+}
+
+//------------------------------------------------------------------------------
+bool
+parse_hex(const char* str, uint16_t& out_val) {
+    int len = int(strlen(str));
+    if ((len > 0) && ((str[0] == '$') || (str[0] == '&'))) {
+        str++; len--;
+    }
+    else if ((len > 1) && (str[0] == '0') && ((str[1] == 'x') || (str[1] == 'X'))) {
+        str += 2; len -= 2;
+    }
+    else if ((len > 1) && ((str[len-1] == 'h') || (str[len-1] == 'H'))) {
+        len--;
+    }
+    if ((len < 1) || (len > 5)) {
+        return false;
+    }
+    uint32_t val = 0;
+    for (int i = 0; i < len; i++) {
+        const char c = str[i];
+        if (!isxdigit(c)) {
+            return false;
+        }
+        val = (val << 4) | (isdigit(c) ? (c - '0') : ((tolower(c) - 'a') + 10));
+    }
+    if (val > 0xFFFF) {
+        return false;
+    }
+    out_val = uint16_t(val);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+equals_nocase(const char* a, const char* b) {
+    while (*a && *b && (tolower(*a) == tolower(*b))) {
+        a++; b++;
+    }
+    return (*a == 0) && (*b == 0);
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+listing::~listing() {
+    this->clear();
+    this->clear_symbols();
+}
+
+//------------------------------------------------------------------------------
+void
+listing::disassemble(cpu_model cpu, const memory& mem, uint16_t start_addr, int num_bytes) {
+    this->disassemble(cpu, fetch_mem, &mem, start_addr, num_bytes);
+}
+
+//------------------------------------------------------------------------------
+void
+listing::disassemble(cpu_model cpu, const uint8_t* ptr, int size, uint16_t base_addr) {
+    YAKC_ASSERT(ptr && (size > 0) && (size <= memory::addr_range));
+    image img;
+    img.ptr = ptr;
+    img.size = size;
+    img.base_addr = base_addr;
+    this->disassemble(cpu, fetch_image, &img, base_addr, size);
+}
+
+//------------------------------------------------------------------------------
+void
+listing::disassemble(cpu_model cpu, fetch_cb fetch, const void* userdata, uint16_t start_addr, int num_bytes) {
+    YAKC_ASSERT((num_bytes > 0) && (num_bytes <= memory::addr_range));
+    this->clear();
+    // each instruction is at least one byte long
+    this->lines = (line*) YAKC_MALLOC(num_bytes * sizeof(line));
+    dasm_ctx ctx;
+    ctx.fetch = fetch;
+    ctx.userdata = userdata;
+    char buf[64];
+    int pos = 0;
+    while (pos < num_bytes) {
+        const uint16_t addr = uint16_t(start_addr + pos);
+        int len = 0;
+        if (cpu_model::mos6502 == cpu) {
+            len = mos6502dasm::mos6502disasm(fetch_dasm, addr, buf, &ctx);
+        }
+        else {
+            len = z80dasm::z80disasm(fetch_dasm, addr, buf, &ctx) & 0xFFFF;
+        }
+        YAKC_ASSERT((len > 0) && (len <= max_bytes));
+        line& l = this->lines[this->lines_size++];
+        l = line();
+        l.addr = addr;
+        l.num_bytes = uint8_t(len);
+        memcpy(l.bytes, ctx.bytes, len);
+
+        // split into mnemonic and operands
+        const char* src = buf;
+        int i = 0;
+        while (*src && (*src != ' ') && (i < int(sizeof(l.mnemonic)) - 1)) {
+            l.mnemonic[i++] = *src++;
+        }
+        while (*src == ' ') {
+            src++;
+        }
+        i = 0;
+        while (*src && (i < int(sizeof(l.operands)) - 1)) {
+            l.operands[i++] = *src++;
+        }
+        decode_target(cpu, l);
+        pos += len;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+listing::decode_target(cpu_model cpu, line& l) {
+    const uint8_t op = l.bytes[0];
+    const uint16_t abs_addr = l.bytes[1] | (l.bytes[2]<<8);
+    const uint16_t rel_addr = uint16_t(l.addr + 2 + int8_t(l.bytes[1]));
+    if (cpu_model::mos6502 == cpu) {
+        if (0x20 == op) {
+            // JSR abs
+            l.target = abs_addr;
+            l.call = true;
+        }
+        else if (0x4C == op) {
+            // JMP abs
+            l.target = abs_addr;
+        }
+        else if (0x10 == (op & 0x1F)) {
+            // BPL, BMI, BVC, BVS, BCC, BCS, BNE, BEQ
+            l.target = rel_addr;
+        }
+    }
+    else {
+        if ((0x10 == op) || (0x18 == op) || (0x20 == (op & 0xE7))) {
+            // DJNZ, JR, JR cc
+            l.target = rel_addr;
+        }
+        else if ((0xC3 == op) || (0xC2 == (op & 0xC7))) {
+            // JP nn, JP cc,nn
+            l.target = abs_addr;
+        }
+        else if ((0xCD == op) || (0xC4 == (op & 0xC7))) {
+            // CALL nn, CALL cc,nn
+            l.target = abs_addr;
+            l.call = true;
+        }
+        else if (0xC7 == (op & 0xC7)) {
+            // RST p
+            l.target = op & 0x38;
+            l.call = true;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+listing::clear() {
+    if (this->lines) {
+        YAKC_FREE(this->lines);
+        this->lines = nullptr;
+    }
+    this->lines_size = 0;
+}
+
+//------------------------------------------------------------------------------
+int
+listing::num_lines() const {
+    return this->lines_size;
+}
+
+//------------------------------------------------------------------------------
+const listing::line&
+listing::get_line(int index) const {
+    YAKC_ASSERT((index >= 0) && (index < this->lines_size));
+    return this->lines[index];
+}
+
+//------------------------------------------------------------------------------
+int
+listing::lower_bound(uint16_t addr) const {
+    int lo = 0;
+    int hi = this->symbols_size;
+    while (lo < hi) {
+        const int mid = (lo + hi) / 2;
+        if (this->symbols[mid].addr < addr) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+//------------------------------------------------------------------------------
+bool
+listing::add_symbol(uint16_t addr, const char* name) {
+    YAKC_ASSERT(name);
+    const int len = int(strlen(name));
+    if ((len == 0) || (len >= max_name)) {
+        return false;
+    }
+    int index = this->lower_bound(addr);
+    if ((index < this->symbols_size) && (this->symbols[index].addr == addr)) {
+        // replace existing symbol
+        strcpy(this->symbols[index].name, name);
+        return true;
+    }
+    if (this->symbols_size == this->symbols_capacity) {
+        const int new_capacity = this->symbols_capacity ? 2 * this->symbols_capacity : 256;
+        symbol* new_symbols = (symbol*) YAKC_MALLOC(new_capacity * sizeof(symbol));
+        if (this->symbols) {
+            memcpy(new_symbols, this->symbols, this->symbols_size * sizeof(symbol));
+            YAKC_FREE(this->symbols);
+        }
+        this->symbols = new_symbols;
+        this->symbols_capacity = new_capacity;
+    }
+    // symbol files are usually sorted by address, so this is mostly an append
+    memmove(&this->symbols[index + 1], &this->symbols[index], (this->symbols_size - index) * sizeof(symbol));
+    this->symbols_size++;
+    symbol& sym = this->symbols[index];
+    sym = symbol();
+    sym.addr = addr;
+    strcpy(sym.name, name);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+int
+listing::parse_symbols(const char* text) {
+    YAKC_ASSERT(text);
+    int num_added = 0;
+    while (*text) {
+        // split the line into up to 3 tokens, stop at a comment
+        char tokens[3][max_name + 8];
+        int num_tokens = 0;
+        bool too_many = false;
+        while (*text && (*text != '\n')) {
+            if ((*text == ';') || (*text == '#')) {
+                while (*text && (*text != '\n')) {
+                    text++;
+                }
+            }
+            else if (isspace(*text)) {
+                text++;
+            }
+            else {
+                char* dst = (num_tokens < 3) ? tokens[num_tokens] : nullptr;
+                int len = 0;
+                while (*text && !isspace(*text) && (*text != ';') && (*text != '#')) {
+                    if (dst && (len < int(sizeof(tokens[0])) - 1)) {
+                        dst[len++] = *text;
+                    }
+                    text++;
+                }
+                if (dst) {
+                    dst[len] = 0;
+                    num_tokens++;
+                }
+                else {
+                    too_many = true;
+                }
+            }
+        }
+        if (*text == '\n') {
+            text++;
+        }
+        if (too_many) {
+            continue;
+        }
+        uint16_t addr = 0;
+        if ((3 == num_tokens) && ((0 == strcmp(tokens[1], "=")) || equals_nocase(tokens[1], "equ"))) {
+            // 'NAME = ADDR' or 'NAME: EQU ADDR'
+            char* name = tokens[0];
+            const int len = int(strlen(name));
+            if ((len > 0) && (name[len-1] == ':')) {
+                name[len-1] = 0;
+            }
+            if (parse_hex(tokens[2], addr) && this->add_symbol(addr, name)) {
+                num_added++;
+            }
+        }
+        else if ((2 == num_tokens) && parse_hex(tokens[0], addr)) {
+            // 'ADDR NAME'
+            if (this->add_symbol(addr, tokens[1])) {
+                num_added++;
+            }
+        }
+    }
+    return num_added;
+}
+
+//------------------------------------------------------------------------------
+int
+listing::load_symbols(const char* path) {
+    YAKC_ASSERT(path);
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return -1;
+    }
+    fseek(fp, 0, SEEK_END);
+    const int size = int(ftell(fp));
+    fseek(fp, 0, SEEK_SET);
+    char* text = (char*) YAKC_MALLOC(size + 1);
+    const bool ok = (size == 0) || (1 == fread(text, size, 1, fp));
+    fclose(fp);
+    int num_added = -1;
+    if (ok) {
+        text[size] = 0;
+        num_added = this->parse_symbols(text);
+    }
+    YAKC_FREE(text);
+    return num_added;
+}
+
+//------------------------------------------------------------------------------
+void
+listing::clear_symbols() {
+    if (this->symbols) {
+        YAKC_FREE(this->symbols);
+        this->symbols = nullptr;
+    }
+    this->symbols_size = 0;
+    this->symbols_capacity = 0;
+}
+
+//------------------------------------------------------------------------------
+int
+listing::num_symbols() const {
+    return this->symbols_size;
+}
+
+//------------------------------------------------------------------------------
+const char*
+listing::find_symbol(uint16_t addr) const {
+    const int index = this->lower_bound(addr);
+    if ((index < this->symbols_size) && (this->symbols[index].addr == addr)) {
+        return this->symbols[index].name;
+    }
+    else {
+        return nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+listing::symbolize(const char* src, char* dst, int dst_size) const {
+    // both disassemblers print 16-bit addresses as '$' and 4 hex digits
+    int pos = 0;
+    while (*src && (pos < dst_size - 1)) {
+        const char* name = nullptr;
+        if ((src[0] == '$') && isxdigit(src[1]) && isxdigit(src[2]) && isxdigit(src[3]) && isxdigit(src[4]) && !isxdigit(src[5])) {
+            char hex[6];
+            memcpy(hex, src, 5);
+            hex[5] = 0;
+            uint16_t addr = 0;
+            if (parse_hex(hex, addr)) {
+                name = this->find_symbol(addr);
+            }
+        }
+        if (name) {
+            while (*name && (pos < dst_size - 1)) {
+                dst[pos++] = *name++;
+            }
+            src += 5;
+        }
+        else {
+            dst[pos++] = *src++;
+        }
+    }
+    dst[pos] = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+listing::write(FILE* fp) const {
+    YAKC_ASSERT(fp);
+    char operands[max_name + 32];
+    for (int i = 0; i < this->lines_size; i++) {
+        const line& l = this->lines[i];
+        const char* label = this->find_symbol(l.addr);
+        if (label) {
+            fprintf(fp, "%s:\n", label);
+        }
+        char bytes[max_bytes * 3 + 1] = { };
+        for (int b = 0; b < l.num_bytes; b++) {
+            snprintf(&bytes[b * 3], 4, "%02X ", l.bytes[b]);
+        }
+        this->symbolize(l.operands, operands, sizeof(operands));
+        if (operands[0]) {
+            fprintf(fp, "%04X  %-12s  %-5s %s\n", l.addr, bytes, l.mnemonic, operands);
+        }
+        else {
+            fprintf(fp, "%04X  %-12s  %s\n", l.addr, bytes, l.mnemonic);
+        }
+    }
+}
+
+} // namespace YAKC
@@ -0,0 +1,105 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::listing
+    @brief batch disassembler for Z80 and 6502 code with symbols
+
+    Disassembles a range of emulator memory or a ROM image into a
+    list of structured lines (address, instruction bytes, mnemonic,
+    operands and the static jump, branch or call target). The range
+    is disassembled linearly from its start address, data bytes in
+    between code are decoded as instructions.
+
+    Symbols are loaded from text files, one symbol per line in one
+    of the forms:
+
+        F003 PV1
+        PV1 = $F003
+        PV1: EQU 0F003H
+
+    Hex addresses may be prefixed with '$', '&' or '0x', or suffixed
+    with 'h', everything after ';' or '#' is a comment.
+
+    write() produces a text listing with a label line in front of
+    each address with a symbol, and the 16-bit addresses in the
+    operands replaced by their symbol names.
+*/
+#include "yakc/core/core.h"
+#include "yakc/core/memory.h"
+#include <stdio.h>
+
+namespace YAKC {
+
+class listing {
+public:
+    /// max length of an instruction in bytes
+    static const int max_bytes = 4;
+    /// max length of a symbol name (including terminating zero)
+    static const int max_name = 32;
+
+    /// a disassembled instruction
+    struct line {
+        uint16_t addr = 0;
+        uint8_t num_bytes = 0;
+        uint8_t bytes[max_bytes] = { };
+        char mnemonic[8] = { };
+        char operands[24] = { };
+        int target = -1;            // static jump/branch/call target, -1 if none
+        bool call = false;          // true if target is a subroutine call
+    };
+    /// a symbol
+    struct symbol {
+        uint16_t addr = 0;
+        char name[max_name] = { };
+    };
+
+    /// destructor
+    ~listing();
+
+    /// disassemble a range of emulator memory (without triggering memory-mapped-io)
+    void disassemble(cpu_model cpu, const memory& mem, uint16_t start_addr, int num_bytes);
+    /// disassemble a ROM image which is mapped at base_addr
+    void disassemble(cpu_model cpu, const uint8_t* ptr, int size, uint16_t base_addr);
+    /// discard the disassembled lines (symbols are kept)
+    void clear();
+    /// number of disassembled lines
+    int num_lines() const;
+    /// get a disassembled line
+    const line& get_line(int index) const;
+
+    /// add or replace a symbol, return false if the name is invalid
+    bool add_symbol(uint16_t addr, const char* name);
+    /// parse symbols from a zero-terminated text, return number of added symbols
+    int parse_symbols(const char* text);
+    /// load symbols from a text file, return number of added symbols, or -1 on error
+    int load_symbols(const char* path);
+    /// remove all symbols
+    void clear_symbols();
+    /// number of symbols
+    int num_symbols() const;
+    /// get symbol name of an address, or nullptr
+    const char* find_symbol(uint16_t addr) const;
+
+    /// write a text listing of all lines
+    void write(FILE* fp) const;
+
+private:
+    /// byte fetch callback for the disassemblers
+    typedef uint8_t (*fetch_cb)(uint16_t addr, const void* userdata);
+    /// disassemble from a fetch callback
+    void disassemble(cpu_model cpu, fetch_cb fetch, const void* userdata, uint16_t start_addr, int num_bytes);
+    /// decode the static target of a jump, branch or call
+    static void decode_target(cpu_model cpu, line& l);
+    /// copy operands, replacing 16-bit addresses with symbol names
+    void symbolize(const char* src, char* dst, int dst_size) const;
+    /// find index of first symbol with address >= addr
+    int lower_bound(uint16_t addr) const;
+
+    line* lines = nullptr;
+    int lines_size = 0;
+    symbol* symbols = nullptr;
+    int symbols_size = 0;
+    int symbols_capacity = 0;
+};
+
+} // namespace YAKC
@@ -162,28 +162,88 @@ mc6847::step() {
     }
     if (h_count >= h_limit) {
         h_count -= h_limit;
-        l_count++;
-        if (l_count >= l_limit) {
-            // rewind line counter, FSYNC off
-            l_count = 0;
-            bits &= ~FSYNC;
+        next_line();
+    }
+    on_bits = bits & ~prev_bits;
+    off_bits = prev_bits & ~bits;
+}
+
+//------------------------------------------------------------------------------
+int
+mc6847::step(int num_ticks) {
+    // advance to the end of the current scanline at once, only
+    // checking whether the HSYNC pulse was started or ended
+    // on the way (the pulse is always longer than one tick)
+    prev_bits = bits;
+    uint16_t on_mask = 0;
+    uint16_t off_mask = 0;
+    int num_hsync = 0;
+    while (num_ticks > 0) {
+        int n = (h_limit - h_count + prec - 1) / prec;
+        if (n > num_ticks) {
+            n = num_ticks;
         }
-        if (l_count < l_vblank) {
-            // skip
+        const int h_start = h_count;
+        h_count += n * prec;
+        num_ticks -= n;
+        const bool was_on = 0 != (bits & HSYNC);
+        const bool started = (h_start < h_sync_start) && (h_count >= h_sync_start);
+        const bool is_on = (h_count >= h_sync_start) && (h_count < h_sync_end);
+        if (started) {
+            num_hsync++;
+            on_mask |= HSYNC;
         }
-        else if (l_count < l_disp_start) {
-            // top border (y=0..243)
-            decode_border(l_count - l_vblank);
+        if ((was_on || started) && !is_on) {
+            off_mask |= HSYNC;
         }
-        else if (l_count < l_disp_end) {
-            // visible area (y=0..192)
-            decode_line(l_count - l_disp_start);
+        if (is_on) {
+            bits |= HSYNC;
+        }
+        else {
+            bits &= ~HSYNC;
+        }
+        if ((started || is_on) && (l_count == l_disp_end) && !(bits & FSYNC)) {
+            // switch FSYNC on
+            bits |= FSYNC;
+            on_mask |= FSYNC;
         }
-        else if (l_count < l_btmborder_end) {
-            // bottom border (y=0..243)
-            decode_border(l_count - l_vblank);
+        if (h_count >= h_limit) {
+            h_count -= h_limit;
+            if ((l_count + 1) >= l_limit) {
+                off_mask |= bits & FSYNC;
+            }
+            next_line();
         }
     }
+    on_bits = on_mask;
+    off_bits = off_mask;
+    return num_hsync;
+}
+
+//------------------------------------------------------------------------------
+void
+mc6847::next_line() {
+    l_count++;
+    if (l_count >= l_limit) {
+        // rewind line counter, FSYNC off
+        l_count = 0;
+        bits &= ~FSYNC;
+    }
+    if (l_count < l_vblank) {
+        // skip
+    }
+    else if (l_count < l_disp_start) {
+        // top border (y=0..243)
+        decode_border(l_count - l_vblank);
+    }
+    else if (l_count < l_disp_end) {
+        // visible area (y=0..192)
+        decode_line(l_count - l_disp_start);
+    }
+    else if (l_count < l_btmborder_end) {
+        // bottom border (y=0..243)
+        decode_border(l_count - l_vblank);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -42,6 +42,8 @@ public:
     void reset();
     /// step the chip one clock cycle
     void step();
+    /// step the chip by num_ticks clock cycles, return number of started HSYNC pulses
+    int step(int num_ticks);
 
     /// pin status bits
     enum {
@@ -59,9 +61,9 @@ public:
 
     /// test if any status bit is set
     bool test(uint16_t mask) const;
-    /// check if any status bits have changed state to 'on' this step
+    /// check if any status bits have changed state to 'on' during the last step
     bool on(uint16_t mask) const;
-    /// check if any status bits have changed state to 'off' this step
+    /// check if any status bits have changed state to 'off' during the last step
     bool off(uint16_t mask) const;
     /// set or clear the A_G bit
     void ag(bool b);
@@ -86,6 +88,8 @@ public:
     void decode_border(int y);
     /// determine current border color
     uint32_t border_color();
+    /// advance to the next scanline and decode the finished line
+    void next_line();
 
     /// fixed-point precision multiplicator for counters
     static const int prec = 8;
@@ -93,6 +97,9 @@ public:
     read_func read_addr_func = nullptr;
     uint16_t prev_bits = 0;
     uint16_t bits = 0;
+    /// status bits switched on or off during the last step
+    uint16_t on_bits = 0;
+    uint16_t off_bits = 0;
 
 
     static const int l_all = 262;
@@ -136,13 +143,13 @@ mc6847::test(uint16_t mask) const {
 //------------------------------------------------------------------------------
 inline bool
 mc6847::on(uint16_t mask) const {
-    return 0 != ((this->bits & (this->bits ^ this->prev_bits)) & mask);
+    return 0 != (this->on_bits & mask);
 }
 
 //------------------------------------------------------------------------------
 inline bool
 mc6847::off(uint16_t mask) const {
-    return 0 != ((~this->bits & (this->bits ^ this->prev_bits)) & mask);
+    return 0 != (this->off_bits & mask);
 }
 
 //------------------------------------------------------------------------------
@@ -70,11 +70,17 @@ public:
     bool NMI = false;
     bool irq_taken = false;
 
+    /// if false, the bus isn't ticked per memory access, instead the
+    /// system catches up its peripherals when they are accessed
+    bool tick_bus = true;
+
     int Cycle;              // current instruction cycle
-    uint8_t AddrMode;       // currently active addressing mode
-    uint8_t MemAccess;      // M_R, M_W, M_RW
 
-    // addressing mode table
+    // statistics counters (see stats.h), not reset by reset()
+    uint64_t num_ops = 0;   // executed instructions
+    uint64_t num_irqs = 0;  // accepted interrupt requests (IRQ and NMI)
+
+    // addressing mode table (generated in mos6502_opcodes.cc)
     struct op_desc {
         uint8_t addr;       // addressing mode
         uint8_t mem;        // memory access mode
@@ -100,19 +106,15 @@ public:
     void nmi();
     /// trigger interrupt request line on/off
     void irq(bool b);
-    /// execute next instruction, return cycles
+    /// execute next instruction, return cycles (generated in mos6502_opcodes.cc)
     uint32_t step();
 
-    /// read byte from mem, incr cycle, tick bus
+    /// read byte from mem, incr cycle, tick bus (if tick_bus)
     void read();
-    /// write byte to mem, incr cycle, tick bus
+    /// write byte to mem, incr cycle, tick bus (if tick_bus)
     void write();
     /// fetch next instruction
     void fetch();
-    /// determine address and put on address bus
-    void addr();
-    /// execute instruction
-    void exec();
 
     /// helper funcs
     void do_sbc(uint8_t val);
@@ -246,22 +248,14 @@ mos6502::brk() {
     P = (P | IF);   // decimal flag only deleted on later chips & ~DF;
 }
 
-//------------------------------------------------------------------------------
-inline uint32_t
-mos6502::step() {
-    Cycle = 0;
-    fetch();
-    addr();
-    exec();
-    return Cycle;
-}
-
 //------------------------------------------------------------------------------
 inline void
 mos6502::read() {
     DATA = mem.r8io(ADDR);
     Cycle++;
-    bus->cpu_tick();
+    if (tick_bus) {
+        bus->cpu_tick();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -269,7 +263,9 @@ inline void
 mos6502::write() {
     mem.w8io(ADDR, DATA);
     Cycle++;
-    bus->cpu_tick();
+    if (tick_bus) {
+        bus->cpu_tick();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -281,9 +277,11 @@ mos6502::fetch() {
     if (NMI || (IRQ && !(P & IF))) {
         irq_taken = true;
         IR = 0x00; // BRK
+        num_irqs++;
     }
     else {
         PC++;
+        num_ops++;
     }
 }
 
@@ -0,0 +1,1488 @@
+// #version:1#
+// machine generated, do not edit!
+#include "mos6502.h"
+namespace YAKC {
+using namespace mos6502_enums;
+mos6502::op_desc mos6502::ops[4][8][8] = {
+  { // cc = 00
+    {{A____,M___},{A_JSR,M_R_},{A____,M_R_},{A____,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_}},
+    {{A_ZER,M_R_},{A_ZER,M_R_},{A_ZER,M_R_},{A_ZER,M_R_},{A_ZER,M__W},{A_ZER,M_R_},{A_ZER,M_R_},{A_ZER,M_R_}},
+    {{A____,M___},{A____,M___},{A____,M__W},{A____,M___},{A____,M___},{A____,M___},{A____,M___},{A____,M___}},
+    {{A_ABS,M_R_},{A_ABS,M_R_},{A_JMP,M_R_},{A_JMP,M_R_},{A_ABS,M__W},{A_ABS,M_R_},{A_ABS,M_R_},{A_ABS,M_R_}},
+    {{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_}},
+    {{A_ZPX,M_R_},{A_ZPX,M_R_},{A_ZPX,M_R_},{A_ZPX,M_R_},{A_ZPX,M__W},{A_ZPX,M_R_},{A_ZPX,M_R_},{A_ZPX,M_R_}},
+    {{A____,M___},{A____,M___},{A____,M___},{A____,M___},{A____,M___},{A____,M___},{A____,M___},{A____,M___}},
+    {{A_ABX,M_R_},{A_ABX,M_R_},{A_ABS,M_R_},{A_ABS,M_R_},{A_INV,M___},{A_ABX,M_R_},{A_ABX,M_R_},{A_ABX,M_R_}},
+  },
+  { // cc = 01
+    {{A_IDX,M_R_},{A_IDX,M_R_},{A_IDX,M_R_},{A_IDX,M_R_},{A_IDX,M__W},{A_IDX,M_R_},{A_IDX,M_R_},{A_IDX,M_R_}},
+    {{A_ZER,M_R_},{A_ZER,M_R_},{A_ZER,M_R_},{A_ZER,M_R_},{A_ZER,M__W},{A_ZER,M_R_},{A_ZER,M_R_},{A_ZER,M_R_}},
+    {{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_}},
+    {{A_ABS,M_R_},{A_ABS,M_R_},{A_ABS,M_R_},{A_ABS,M_R_},{A_ABS,M__W},{A_ABS,M_R_},{A_ABS,M_R_},{A_ABS,M_R_}},
+    {{A_IDY,M_R_},{A_IDY,M_R_},{A_IDY,M_R_},{A_IDY,M_R_},{A_IDY,M__W},{A_IDY,M_R_},{A_IDY,M_R_},{A_IDY,M_R_}},
+    {{A_ZPX,M_R_},{A_ZPX,M_R_},{A_ZPX,M_R_},{A_ZPX,M_R_},{A_ZPX,M__W},{A_ZPX,M_R_},{A_ZPX,M_R_},{A_ZPX,M_R_}},
+    {{A_ABY,M_R_},{A_ABY,M_R_},{A_ABY,M_R_},{A_ABY,M_R_},{A_ABY,M__W},{A_ABY,M_R_},{A_ABY,M_R_},{A_ABY,M_R_}},
+    {{A_ABX,M_R_},{A_ABX,M_R_},{A_ABX,M_R_},{A_ABX,M_R_},{A_ABX,M__W},{A_ABX,M_R_},{A_ABX,M_R_},{A_ABX,M_R_}},
+  },
+  { // cc = 10
+    {{A_INV,M_RW},{A_INV,M_RW},{A_INV,M_RW},{A_INV,M_RW},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_},{A_IMM,M_R_}},
+    {{A_ZER,M_RW},{A_ZER,M_RW},{A_ZER,M_RW},{A_ZER,M_RW},{A_ZER,M__W},{A_ZER,M_R_},{A_ZER,M_RW},{A_ZER,M_RW}},
+    {{A____,M___},{A____,M___},{A____,M___},{A____,M___},{A____,M___},{A____,M___},{A____,M___},{A____,M___}},
+    {{A_ABS,M_RW},{A_ABS,M_RW},{A_ABS,M_RW},{A_ABS,M_RW},{A_ABS,M__W},{A_ABS,M_R_},{A_ABS,M_RW},{A_ABS,M_RW}},
+    {{A_INV,M_RW},{A_INV,M_RW},{A_INV,M_RW},{A_INV,M_RW},{A_INV,M__W},{A_INV,M_R_},{A_INV,M_RW},{A_INV,M_RW}},
+    {{A_ZPX,M_RW},{A_ZPX,M_RW},{A_ZPX,M_RW},{A_ZPX,M_RW},{A_ZPY,M__W},{A_ZPY,M_R_},{A_ZPX,M_RW},{A_ZPX,M_RW}},
+    {{A____,M_R_},{A____,M_R_},{A____,M_R_},{A____,M_R_},{A____,M___},{A____,M___},{A____,M_R_},{A____,M_R_}},
+    {{A_ABX,M_RW},{A_ABX,M_RW},{A_ABX,M_RW},{A_ABX,M_RW},{A_INV,M__W},{A_ABY,M_R_},{A_ABX,M_RW},{A_ABX,M_RW}},
+  },
+  { // cc = 11
+    {{A_IDX,M_RW},{A_IDX,M_RW},{A_IDX,M_RW},{A_IDX,M_RW},{A_IDX,M__W},{A_IDX,M_R_},{A_IDX,M_RW},{A_IDX,M_RW}},
+    {{A_ZER,M_RW},{A_ZER,M_RW},{A_ZER,M_RW},{A_ZER,M_RW},{A_ZER,M__W},{A_ZER,M_R_},{A_ZER,M_RW},{A_ZER,M_RW}},
+    {{A_INV,M___},{A_INV,M___},{A_INV,M___},{A_INV,M___},{A_INV,M___},{A_INV,M___},{A_INV,M___},{A_IMM,M_R_}},
+    {{A_ABS,M_RW},{A_ABS,M_RW},{A_ABS,M_RW},{A_ABS,M_RW},{A_ABS,M__W},{A_ABS,M_R_},{A_ABS,M_RW},{A_ABS,M_RW}},
+    {{A_IDY,M_RW},{A_IDY,M_RW},{A_IDY,M_RW},{A_IDY,M_RW},{A_INV,M___},{A_IDY,M_R_},{A_IDY,M_RW},{A_IDY,M_RW}},
+    {{A_ZPX,M_RW},{A_ZPX,M_RW},{A_ZPX,M_RW},{A_ZPX,M_RW},{A_ZPY,M__W},{A_ZPY,M_R_},{A_ZPX,M_RW},{A_ZPX,M_RW}},
+    {{A_ABY,M_RW},{A_ABY,M_RW},{A_ABY,M_RW},{A_ABY,M_RW},{A_INV,M___},{A_INV,M___},{A_ABY,M_RW},{A_ABY,M_RW}},
+    {{A_ABX,M_RW},{A_ABX,M_RW},{A_ABX,M_RW},{A_ABX,M_RW},{A_INV,M___},{A_ABY,M_R_},{A_ABX,M_RW},{A_ABX,M_RW}},
+  },
+};
+uint32_t mos6502::step() {
+  Cycle = 0;
+  fetch();
+  switch (IR) {
+    case 0x0: // BRK
+      ADDR=PC;
+      brk();
+      break;
+    case 0x1: // ORA (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      ora();
+      break;
+    case 0x2: // ASL (invalid)
+      YAKC_ASSERT(false);
+      asl();
+      break;
+    case 0x3: // *SLO (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_slo();
+      break;
+    case 0x4: // *NOP zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_nop();
+      break;
+    case 0x5: // ORA zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      ora();
+      break;
+    case 0x6: // ASL zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      asl();
+      break;
+    case 0x7: // *SLO zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_slo();
+      break;
+    case 0x8: // PHP
+      ADDR=PC;
+      php();
+      break;
+    case 0x9: // ORA #
+      ADDR=PC++;
+      ora();
+      break;
+    case 0xa: // ASL A
+      ADDR=PC;
+      asla();
+      break;
+    case 0xb: // *SLO (invalid)
+      YAKC_ASSERT(false);
+      u_slo();
+      break;
+    case 0xc: // *NOP abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_nop();
+      break;
+    case 0xd: // ORA abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      ora();
+      break;
+    case 0xe: // ASL abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      asl();
+      break;
+    case 0xf: // *SLO abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_slo();
+      break;
+    case 0x10: // BPL rel
+      ADDR=PC++;
+      br(NF,0);
+      break;
+    case 0x11: // ORA (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      ora();
+      break;
+    case 0x12: // ASL (invalid)
+      YAKC_ASSERT(false);
+      asl();
+      break;
+    case 0x13: // *SLO (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_slo();
+      break;
+    case 0x14: // *NOP zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_nop();
+      break;
+    case 0x15: // ORA zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      ora();
+      break;
+    case 0x16: // ASL zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      asl();
+      break;
+    case 0x17: // *SLO zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_slo();
+      break;
+    case 0x18: // CLC
+      ADDR=PC;
+      cl(CF);
+      break;
+    case 0x19: // ORA abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      ora();
+      break;
+    case 0x1a: // *NOP
+      ADDR=PC;
+      u_nop();
+      break;
+    case 0x1b: // *SLO abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_slo();
+      break;
+    case 0x1c: // *NOP abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      u_nop();
+      break;
+    case 0x1d: // ORA abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      ora();
+      break;
+    case 0x1e: // ASL abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      asl();
+      break;
+    case 0x1f: // *SLO abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_slo();
+      break;
+    case 0x20: // JSR abs
+      ADDR=PC++;
+      jsr();
+      break;
+    case 0x21: // AND (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      anda();
+      break;
+    case 0x22: // ROL (invalid)
+      YAKC_ASSERT(false);
+      rol();
+      break;
+    case 0x23: // *RLA (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_rla();
+      break;
+    case 0x24: // BIT zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      bit();
+      break;
+    case 0x25: // AND zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      anda();
+      break;
+    case 0x26: // ROL zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      rol();
+      break;
+    case 0x27: // *RLA zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_rla();
+      break;
+    case 0x28: // PLP
+      ADDR=PC;
+      plp();
+      break;
+    case 0x29: // AND #
+      ADDR=PC++;
+      anda();
+      break;
+    case 0x2a: // ROL A
+      ADDR=PC;
+      rola();
+      break;
+    case 0x2b: // *RLA (invalid)
+      YAKC_ASSERT(false);
+      u_rla();
+      break;
+    case 0x2c: // BIT abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      bit();
+      break;
+    case 0x2d: // AND abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      anda();
+      break;
+    case 0x2e: // ROL abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      rol();
+      break;
+    case 0x2f: // *RLA abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_rla();
+      break;
+    case 0x30: // BMI rel
+      ADDR=PC++;
+      br(NF,NF);
+      break;
+    case 0x31: // AND (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      anda();
+      break;
+    case 0x32: // ROL (invalid)
+      YAKC_ASSERT(false);
+      rol();
+      break;
+    case 0x33: // *RLA (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_rla();
+      break;
+    case 0x34: // *NOP zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_nop();
+      break;
+    case 0x35: // AND zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      anda();
+      break;
+    case 0x36: // ROL zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      rol();
+      break;
+    case 0x37: // *RLA zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_rla();
+      break;
+    case 0x38: // SEC
+      ADDR=PC;
+      se(CF);
+      break;
+    case 0x39: // AND abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      anda();
+      break;
+    case 0x3a: // *NOP
+      ADDR=PC;
+      u_nop();
+      break;
+    case 0x3b: // *RLA abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_rla();
+      break;
+    case 0x3c: // *NOP abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      u_nop();
+      break;
+    case 0x3d: // AND abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      anda();
+      break;
+    case 0x3e: // ROL abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      rol();
+      break;
+    case 0x3f: // *RLA abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_rla();
+      break;
+    case 0x40: // RTI
+      ADDR=PC;
+      rti();
+      break;
+    case 0x41: // EOR (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      eor();
+      break;
+    case 0x42: // LSR (invalid)
+      YAKC_ASSERT(false);
+      lsr();
+      break;
+    case 0x43: // *SRE (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_sre();
+      break;
+    case 0x44: // *NOP zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_nop();
+      break;
+    case 0x45: // EOR zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      eor();
+      break;
+    case 0x46: // LSR zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      lsr();
+      break;
+    case 0x47: // *SRE zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_sre();
+      break;
+    case 0x48: // PHA
+      ADDR=PC;
+      pha();
+      break;
+    case 0x49: // EOR #
+      ADDR=PC++;
+      eor();
+      break;
+    case 0x4a: // LSR A
+      ADDR=PC;
+      lsra();
+      break;
+    case 0x4b: // *SRE (invalid)
+      YAKC_ASSERT(false);
+      u_sre();
+      break;
+    case 0x4c: // JMP abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++;
+      jmp();
+      break;
+    case 0x4d: // EOR abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      eor();
+      break;
+    case 0x4e: // LSR abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      lsr();
+      break;
+    case 0x4f: // *SRE abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_sre();
+      break;
+    case 0x50: // BVC rel
+      ADDR=PC++;
+      br(VF,0);
+      break;
+    case 0x51: // EOR (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      eor();
+      break;
+    case 0x52: // LSR (invalid)
+      YAKC_ASSERT(false);
+      lsr();
+      break;
+    case 0x53: // *SRE (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_sre();
+      break;
+    case 0x54: // *NOP zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_nop();
+      break;
+    case 0x55: // EOR zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      eor();
+      break;
+    case 0x56: // LSR zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      lsr();
+      break;
+    case 0x57: // *SRE zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_sre();
+      break;
+    case 0x58: // CLI
+      ADDR=PC;
+      cl(IF);
+      break;
+    case 0x59: // EOR abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      eor();
+      break;
+    case 0x5a: // *NOP
+      ADDR=PC;
+      u_nop();
+      break;
+    case 0x5b: // *SRE abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_sre();
+      break;
+    case 0x5c: // *NOP abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_nop();
+      break;
+    case 0x5d: // EOR abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      eor();
+      break;
+    case 0x5e: // LSR abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      lsr();
+      break;
+    case 0x5f: // *SRE abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_sre();
+      break;
+    case 0x60: // RTS
+      ADDR=PC;
+      rts();
+      break;
+    case 0x61: // ADC (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      adc();
+      break;
+    case 0x62: // ROR (invalid)
+      YAKC_ASSERT(false);
+      ror();
+      break;
+    case 0x63: // *RRA (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_rra();
+      break;
+    case 0x64: // *NOP zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_nop();
+      break;
+    case 0x65: // ADC zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      adc();
+      break;
+    case 0x66: // ROR zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      ror();
+      break;
+    case 0x67: // *RRA zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_rra();
+      break;
+    case 0x68: // PLA
+      ADDR=PC;
+      pla();
+      break;
+    case 0x69: // ADC #
+      ADDR=PC++;
+      adc();
+      break;
+    case 0x6a: // ROR A
+      ADDR=PC;
+      rora();
+      break;
+    case 0x6b: // *RRA (invalid)
+      YAKC_ASSERT(false);
+      u_rra();
+      break;
+    case 0x6c: // JMP (abs)
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++;
+      jmpi();
+      break;
+    case 0x6d: // ADC abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      adc();
+      break;
+    case 0x6e: // ROR abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      ror();
+      break;
+    case 0x6f: // *RRA abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_rra();
+      break;
+    case 0x70: // BVS rel
+      ADDR=PC++;
+      br(VF,VF);
+      break;
+    case 0x71: // ADC (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      adc();
+      break;
+    case 0x72: // ROR (invalid)
+      YAKC_ASSERT(false);
+      ror();
+      break;
+    case 0x73: // *RRA (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_rra();
+      break;
+    case 0x74: // *NOP zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_nop();
+      break;
+    case 0x75: // ADC zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      adc();
+      break;
+    case 0x76: // ROR zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      ror();
+      break;
+    case 0x77: // *RRA zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_rra();
+      break;
+    case 0x78: // SEI
+      ADDR=PC;
+      se(IF);
+      break;
+    case 0x79: // ADC abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      adc();
+      break;
+    case 0x7a: // *NOP
+      ADDR=PC;
+      u_nop();
+      break;
+    case 0x7b: // *RRA abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_rra();
+      break;
+    case 0x7c: // *NOP abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_nop();
+      break;
+    case 0x7d: // ADC abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      adc();
+      break;
+    case 0x7e: // ROR abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      ror();
+      break;
+    case 0x7f: // *RRA abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_rra();
+      break;
+    case 0x80: // *NOP #
+      ADDR=PC++;
+      u_nop();
+      break;
+    case 0x81: // STA (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      sta();
+      break;
+    case 0x82: // *NOP #
+      ADDR=PC++;
+      u_nop();
+      break;
+    case 0x83: // *SAX (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_sax();
+      break;
+    case 0x84: // STY zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      sty();
+      break;
+    case 0x85: // STA zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      sta();
+      break;
+    case 0x86: // STX zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      stx();
+      break;
+    case 0x87: // *SAX zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_sax();
+      break;
+    case 0x88: // DEY
+      ADDR=PC;
+      dey();
+      break;
+    case 0x89: // *NOP #
+      ADDR=PC++;
+      u_nop();
+      break;
+    case 0x8a: // TXA
+      ADDR=PC;
+      txa();
+      break;
+    case 0x8b: // *SAX (invalid)
+      YAKC_ASSERT(false);
+      u_sax();
+      break;
+    case 0x8c: // STY abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      sty();
+      break;
+    case 0x8d: // STA abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      sta();
+      break;
+    case 0x8e: // STX abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      stx();
+      break;
+    case 0x8f: // *SAX abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_sax();
+      break;
+    case 0x90: // BCC rel
+      ADDR=PC++;
+      br(CF,0);
+      break;
+    case 0x91: // STA (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      sta();
+      break;
+    case 0x92: // STX (invalid)
+      YAKC_ASSERT(false);
+      stx();
+      break;
+    case 0x93: // *SAX (invalid)
+      YAKC_ASSERT(false);
+      u_sax();
+      break;
+    case 0x94: // STY zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      sty();
+      break;
+    case 0x95: // STA zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      sta();
+      break;
+    case 0x96: // STX zp,Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+Y)&0x00FF;
+      stx();
+      break;
+    case 0x97: // *SAX zp,Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+Y)&0x00FF;
+      u_sax();
+      break;
+    case 0x98: // TYA
+      ADDR=PC;
+      tya();
+      break;
+    case 0x99: // STA abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      sta();
+      break;
+    case 0x9a: // TXS
+      ADDR=PC;
+      txs();
+      break;
+    case 0x9b: // *SAX (invalid)
+      YAKC_ASSERT(false);
+      u_sax();
+      break;
+    case 0x9c: // STY (invalid)
+      YAKC_ASSERT(false);
+      sty();
+      break;
+    case 0x9d: // STA abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      sta();
+      break;
+    case 0x9e: // STX (invalid)
+      YAKC_ASSERT(false);
+      stx();
+      break;
+    case 0x9f: // *SAX (invalid)
+      YAKC_ASSERT(false);
+      u_sax();
+      break;
+    case 0xa0: // LDY #
+      ADDR=PC++;
+      ldy();
+      break;
+    case 0xa1: // LDA (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      lda();
+      break;
+    case 0xa2: // LDX #
+      ADDR=PC++;
+      ldx();
+      break;
+    case 0xa3: // *LAX (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_lax();
+      break;
+    case 0xa4: // LDY zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      ldy();
+      break;
+    case 0xa5: // LDA zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      lda();
+      break;
+    case 0xa6: // LDX zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      ldx();
+      break;
+    case 0xa7: // *LAX zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_lax();
+      break;
+    case 0xa8: // TAY
+      ADDR=PC;
+      tay();
+      break;
+    case 0xa9: // LDA #
+      ADDR=PC++;
+      lda();
+      break;
+    case 0xaa: // TAX
+      ADDR=PC;
+      tax();
+      break;
+    case 0xab: // *LAX (invalid)
+      YAKC_ASSERT(false);
+      u_lax();
+      break;
+    case 0xac: // LDY abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      ldy();
+      break;
+    case 0xad: // LDA abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      lda();
+      break;
+    case 0xae: // LDX abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      ldx();
+      break;
+    case 0xaf: // *LAX abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_lax();
+      break;
+    case 0xb0: // BCS rel
+      ADDR=PC++;
+      br(CF,CF);
+      break;
+    case 0xb1: // LDA (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      lda();
+      break;
+    case 0xb2: // LDX (invalid)
+      YAKC_ASSERT(false);
+      ldx();
+      break;
+    case 0xb3: // *LAX (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      u_lax();
+      break;
+    case 0xb4: // LDY zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      ldy();
+      break;
+    case 0xb5: // LDA zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      lda();
+      break;
+    case 0xb6: // LDX zp,Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+Y)&0x00FF;
+      ldx();
+      break;
+    case 0xb7: // *LAX zp,Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+Y)&0x00FF;
+      u_lax();
+      break;
+    case 0xb8: // CLV
+      ADDR=PC;
+      cl(VF);
+      break;
+    case 0xb9: // LDA abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      lda();
+      break;
+    case 0xba: // TSX
+      ADDR=PC;
+      tsx();
+      break;
+    case 0xbb: // *LAX (invalid)
+      YAKC_ASSERT(false);
+      u_lax();
+      break;
+    case 0xbc: // LDY abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      ldy();
+      break;
+    case 0xbd: // LDA abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      lda();
+      break;
+    case 0xbe: // LDX abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      ldx();
+      break;
+    case 0xbf: // *LAX abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      u_lax();
+      break;
+    case 0xc0: // CPY #
+      ADDR=PC++;
+      cpy();
+      break;
+    case 0xc1: // CMP (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      cmp();
+      break;
+    case 0xc2: // *NOP #
+      ADDR=PC++;
+      u_nop();
+      break;
+    case 0xc3: // *DCP (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_dcp();
+      break;
+    case 0xc4: // CPY zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      cpy();
+      break;
+    case 0xc5: // CMP zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      cmp();
+      break;
+    case 0xc6: // DEC zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      dec();
+      break;
+    case 0xc7: // *DCP zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_dcp();
+      break;
+    case 0xc8: // INY
+      ADDR=PC;
+      iny();
+      break;
+    case 0xc9: // CMP #
+      ADDR=PC++;
+      cmp();
+      break;
+    case 0xca: // DEX
+      ADDR=PC;
+      dex();
+      break;
+    case 0xcb: // *DCP (invalid)
+      YAKC_ASSERT(false);
+      u_dcp();
+      break;
+    case 0xcc: // CPY abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      cpy();
+      break;
+    case 0xcd: // CMP abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      cmp();
+      break;
+    case 0xce: // DEC abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      dec();
+      break;
+    case 0xcf: // *DCP abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_dcp();
+      break;
+    case 0xd0: // BNE rel
+      ADDR=PC++;
+      br(ZF,0);
+      break;
+    case 0xd1: // CMP (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      cmp();
+      break;
+    case 0xd2: // DEC (invalid)
+      YAKC_ASSERT(false);
+      dec();
+      break;
+    case 0xd3: // *DCP (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_dcp();
+      break;
+    case 0xd4: // *NOP zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_nop();
+      break;
+    case 0xd5: // CMP zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      cmp();
+      break;
+    case 0xd6: // DEC zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      dec();
+      break;
+    case 0xd7: // *DCP zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_dcp();
+      break;
+    case 0xd8: // CLD
+      ADDR=PC;
+      cl(DF);
+      break;
+    case 0xd9: // CMP abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      cmp();
+      break;
+    case 0xda: // *NOP
+      ADDR=PC;
+      u_nop();
+      break;
+    case 0xdb: // *DCP abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_dcp();
+      break;
+    case 0xdc: // *NOP abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      u_nop();
+      break;
+    case 0xdd: // CMP abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      cmp();
+      break;
+    case 0xde: // DEC abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      dec();
+      break;
+    case 0xdf: // *DCP abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_dcp();
+      break;
+    case 0xe0: // CPX #
+      ADDR=PC++;
+      cpx();
+      break;
+    case 0xe1: // SBC (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      sbc();
+      break;
+    case 0xe2: // *NOP #
+      ADDR=PC++;
+      u_nop();
+      break;
+    case 0xe3: // *ISB (zp,X)
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF; read();
+      tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_isb();
+      break;
+    case 0xe4: // CPX zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      cpx();
+      break;
+    case 0xe5: // SBC zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      sbc();
+      break;
+    case 0xe6: // INC zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      inc();
+      break;
+    case 0xe7: // *ISB zp
+      ADDR=PC++; read();
+      ADDR=DATA;
+      u_isb();
+      break;
+    case 0xe8: // INX
+      ADDR=PC;
+      inx();
+      break;
+    case 0xe9: // SBC #
+      ADDR=PC++;
+      sbc();
+      break;
+    case 0xea: // NOP
+      ADDR=PC;
+      nop();
+      break;
+    case 0xeb: // *SBC #
+      ADDR=PC++;
+      u_sbc();
+      break;
+    case 0xec: // CPX abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      cpx();
+      break;
+    case 0xed: // SBC abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      sbc();
+      break;
+    case 0xee: // INC abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      inc();
+      break;
+    case 0xef: // *ISB abs
+      ADDR=PC++; read();
+      tmp16=DATA; ADDR=PC++; read();
+      ADDR=(DATA<<8)|tmp16;
+      u_isb();
+      break;
+    case 0xf0: // BEQ rel
+      ADDR=PC++;
+      br(ZF,ZF);
+      break;
+    case 0xf1: // SBC (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      sbc();
+      break;
+    case 0xf2: // INC (invalid)
+      YAKC_ASSERT(false);
+      inc();
+      break;
+    case 0xf3: // *ISB (zp),Y
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_isb();
+      break;
+    case 0xf4: // *NOP zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_nop();
+      break;
+    case 0xf5: // SBC zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      sbc();
+      break;
+    case 0xf6: // INC zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      inc();
+      break;
+    case 0xf7: // *ISB zp,X
+      ADDR=PC++; read();
+      ADDR=DATA; read();
+      ADDR=(ADDR+X)&0x00FF;
+      u_isb();
+      break;
+    case 0xf8: // SED
+      ADDR=PC;
+      se(DF);
+      break;
+    case 0xf9: // SBC abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      sbc();
+      break;
+    case 0xfa: // *NOP
+      ADDR=PC;
+      u_nop();
+      break;
+    case 0xfb: // *ISB abs,Y
+      ADDR=PC++; read();
+      tmp16=DATA+Y; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_isb();
+      break;
+    case 0xfc: // *NOP abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      u_nop();
+      break;
+    case 0xfd: // SBC abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }
+      sbc();
+      break;
+    case 0xfe: // INC abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      inc();
+      break;
+    case 0xff: // *ISB abs,X
+      ADDR=PC++; read();
+      tmp16=DATA+X; ADDR=PC++; read();
+      ADDR=(DATA<<8)|(tmp16&0xFF);
+      read(); ADDR=(ADDR&0xFF00)+tmp16;
+      u_isb();
+      break;
+  }
+  return Cycle;
+}
+} // namespace YAKC
@@ -0,0 +1,402 @@
+#-------------------------------------------------------------------------------
+#   mos6502_opcodes.py
+#   Generate huge switch/case 6502 instruction decoder.
+#   See:
+#       http://www.llx.com/~nparker/a2/opcodes.html
+#       http://www.oxyron.de/html/opcodes02.html
+#       http://nesdev.com/6502_cpu.txt
+#-------------------------------------------------------------------------------
+
+# fips code generator version stamp
+Version = 1
+
+# tab-width for generated code
+TabWidth = 2
+
+# the target file handle
+Out = None
+
+# addressing modes (names of the mos6502_enums constants)
+A____ = 'A____'     # no addressing mode
+A_IMM = 'A_IMM'     # #
+A_ZER = 'A_ZER'     # zp
+A_ZPX = 'A_ZPX'     # zp,X
+A_ZPY = 'A_ZPY'     # zp,Y
+A_ABS = 'A_ABS'     # abs
+A_ABX = 'A_ABX'     # abs,X
+A_ABY = 'A_ABY'     # abs,Y
+A_IDX = 'A_IDX'     # (zp,X)
+A_IDY = 'A_IDY'     # (zp),Y
+A_JMP = 'A_JMP'     # special JMP abs
+A_JSR = 'A_JSR'     # special JSR abs
+A_INV = 'A_INV'     # an invalid instruction
+
+# memory access modes
+M___ = 'M___'       # no memory access
+M_R_ = 'M_R_'       # read
+M__W = 'M__W'       # write
+M_RW = 'M_RW'       # read-modify-write
+
+# addressing mode and memory access table, indexed by [cc][bbb][aaa],
+# this is also written to the generated source as mos6502::ops
+ops = [
+# cc = 00
+[
+#--- BIT JMP JMP() STY LDY CPY CPX
+[[A____,M___],[A_JSR,M_R_],[A____,M_R_],[A____,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_]],
+[[A_ZER,M_R_],[A_ZER,M_R_],[A_ZER,M_R_],[A_ZER,M_R_],[A_ZER,M__W],[A_ZER,M_R_],[A_ZER,M_R_],[A_ZER,M_R_]],
+[[A____,M___],[A____,M___],[A____,M__W],[A____,M___],[A____,M___],[A____,M___],[A____,M___],[A____,M___]],
+[[A_ABS,M_R_],[A_ABS,M_R_],[A_JMP,M_R_],[A_JMP,M_R_],[A_ABS,M__W],[A_ABS,M_R_],[A_ABS,M_R_],[A_ABS,M_R_]],
+[[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_]],
+[[A_ZPX,M_R_],[A_ZPX,M_R_],[A_ZPX,M_R_],[A_ZPX,M_R_],[A_ZPX,M__W],[A_ZPX,M_R_],[A_ZPX,M_R_],[A_ZPX,M_R_]],
+[[A____,M___],[A____,M___],[A____,M___],[A____,M___],[A____,M___],[A____,M___],[A____,M___],[A____,M___]],
+[[A_ABX,M_R_],[A_ABX,M_R_],[A_ABS,M_R_],[A_ABS,M_R_],[A_INV,M___],[A_ABX,M_R_],[A_ABX,M_R_],[A_ABX,M_R_]]
+],
+# cc = 01
+[
+# ORA AND EOR ADC STA LDA CMP SBC
+[[A_IDX,M_R_],[A_IDX,M_R_],[A_IDX,M_R_],[A_IDX,M_R_],[A_IDX,M__W],[A_IDX,M_R_],[A_IDX,M_R_],[A_IDX,M_R_]],
+[[A_ZER,M_R_],[A_ZER,M_R_],[A_ZER,M_R_],[A_ZER,M_R_],[A_ZER,M__W],[A_ZER,M_R_],[A_ZER,M_R_],[A_ZER,M_R_]],
+[[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_]],
+[[A_ABS,M_R_],[A_ABS,M_R_],[A_ABS,M_R_],[A_ABS,M_R_],[A_ABS,M__W],[A_ABS,M_R_],[A_ABS,M_R_],[A_ABS,M_R_]],
+[[A_IDY,M_R_],[A_IDY,M_R_],[A_IDY,M_R_],[A_IDY,M_R_],[A_IDY,M__W],[A_IDY,M_R_],[A_IDY,M_R_],[A_IDY,M_R_]],
+[[A_ZPX,M_R_],[A_ZPX,M_R_],[A_ZPX,M_R_],[A_ZPX,M_R_],[A_ZPX,M__W],[A_ZPX,M_R_],[A_ZPX,M_R_],[A_ZPX,M_R_]],
+[[A_ABY,M_R_],[A_ABY,M_R_],[A_ABY,M_R_],[A_ABY,M_R_],[A_ABY,M__W],[A_ABY,M_R_],[A_ABY,M_R_],[A_ABY,M_R_]],
+[[A_ABX,M_R_],[A_ABX,M_R_],[A_ABX,M_R_],[A_ABX,M_R_],[A_ABX,M__W],[A_ABX,M_R_],[A_ABX,M_R_],[A_ABX,M_R_]],
+],
+# cc = 02
+[
+# ASL ROL LSR ROR STX LDX DEC INC
+[[A_INV,M_RW],[A_INV,M_RW],[A_INV,M_RW],[A_INV,M_RW],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_],[A_IMM,M_R_]],
+[[A_ZER,M_RW],[A_ZER,M_RW],[A_ZER,M_RW],[A_ZER,M_RW],[A_ZER,M__W],[A_ZER,M_R_],[A_ZER,M_RW],[A_ZER,M_RW]],
+[[A____,M___],[A____,M___],[A____,M___],[A____,M___],[A____,M___],[A____,M___],[A____,M___],[A____,M___]],
+[[A_ABS,M_RW],[A_ABS,M_RW],[A_ABS,M_RW],[A_ABS,M_RW],[A_ABS,M__W],[A_ABS,M_R_],[A_ABS,M_RW],[A_ABS,M_RW]],
+[[A_INV,M_RW],[A_INV,M_RW],[A_INV,M_RW],[A_INV,M_RW],[A_INV,M__W],[A_INV,M_R_],[A_INV,M_RW],[A_INV,M_RW]],
+[[A_ZPX,M_RW],[A_ZPX,M_RW],[A_ZPX,M_RW],[A_ZPX,M_RW],[A_ZPY,M__W],[A_ZPY,M_R_],[A_ZPX,M_RW],[A_ZPX,M_RW]],
+[[A____,M_R_],[A____,M_R_],[A____,M_R_],[A____,M_R_],[A____,M___],[A____,M___],[A____,M_R_],[A____,M_R_]],
+[[A_ABX,M_RW],[A_ABX,M_RW],[A_ABX,M_RW],[A_ABX,M_RW],[A_INV,M__W],[A_ABY,M_R_],[A_ABX,M_RW],[A_ABX,M_RW]],
+],
+# cc = 03
+[
+[[A_IDX,M_RW],[A_IDX,M_RW],[A_IDX,M_RW],[A_IDX,M_RW],[A_IDX,M__W],[A_IDX,M_R_],[A_IDX,M_RW],[A_IDX,M_RW]],
+[[A_ZER,M_RW],[A_ZER,M_RW],[A_ZER,M_RW],[A_ZER,M_RW],[A_ZER,M__W],[A_ZER,M_R_],[A_ZER,M_RW],[A_ZER,M_RW]],
+[[A_INV,M___],[A_INV,M___],[A_INV,M___],[A_INV,M___],[A_INV,M___],[A_INV,M___],[A_INV,M___],[A_IMM,M_R_]],
+[[A_ABS,M_RW],[A_ABS,M_RW],[A_ABS,M_RW],[A_ABS,M_RW],[A_ABS,M__W],[A_ABS,M_R_],[A_ABS,M_RW],[A_ABS,M_RW]],
+[[A_IDY,M_RW],[A_IDY,M_RW],[A_IDY,M_RW],[A_IDY,M_RW],[A_INV,M___],[A_IDY,M_R_],[A_IDY,M_RW],[A_IDY,M_RW]],
+[[A_ZPX,M_RW],[A_ZPX,M_RW],[A_ZPX,M_RW],[A_ZPX,M_RW],[A_ZPY,M__W],[A_ZPY,M_R_],[A_ZPX,M_RW],[A_ZPX,M_RW]],
+[[A_ABY,M_RW],[A_ABY,M_RW],[A_ABY,M_RW],[A_ABY,M_RW],[A_INV,M___],[A_INV,M___],[A_ABY,M_RW],[A_ABY,M_RW]],
+[[A_ABX,M_RW],[A_ABX,M_RW],[A_ABX,M_RW],[A_ABX,M_RW],[A_INV,M___],[A_ABY,M_R_],[A_ABX,M_RW],[A_ABX,M_RW]]
+]
+]
+
+# addressing modes in human readable form for comments
+addr_cmt = {
+    A____: '',
+    A_IMM: '#',
+    A_ZER: 'zp',
+    A_ZPX: 'zp,X',
+    A_ZPY: 'zp,Y',
+    A_ABS: 'abs',
+    A_ABX: 'abs,X',
+    A_ABY: 'abs,Y',
+    A_IDX: '(zp,X)',
+    A_IDY: '(zp),Y',
+    A_JMP: 'abs',
+    A_JSR: 'abs',
+    A_INV: '(invalid)'
+}
+
+# the branch instructions, indexed by aaa: (flag mask, value, mnemonic)
+branches = [
+    ('NF', '0',  'BPL'), ('NF', 'NF', 'BMI'),
+    ('VF', '0',  'BVC'), ('VF', 'VF', 'BVS'),
+    ('CF', '0',  'BCC'), ('CF', 'CF', 'BCS'),
+    ('ZF', '0',  'BNE'), ('ZF', 'ZF', 'BEQ')
+]
+
+# the regular cc=01 instructions (C++ method names and mnemonics)
+alu = [ 'ora', 'anda', 'eor', 'adc', 'sta', 'lda', 'cmp', 'sbc' ]
+alu_cmt = [ 'ORA', 'AND', 'EOR', 'ADC', 'STA', 'LDA', 'CMP', 'SBC' ]
+
+# the regular cc=10 instructions
+rmw = [ 'asl', 'rol', 'lsr', 'ror', 'stx', 'ldx', 'dec', 'inc' ]
+
+# the undocumented cc=11 instructions
+undoc = [ 'u_slo', 'u_rla', 'u_sre', 'u_rra', 'u_sax', 'u_lax', 'u_dcp', 'u_isb' ]
+
+import sys
+import io
+import genutil  # fips code generator helpers
+
+# an 'opcode' wraps the instruction byte, human-readable asm mnemonics,
+# the addressing and memory access mode, and the instruction method call
+class opcode :
+    def __init__(self, op) :
+        self.byte = op
+        self.cc  = op & 3
+        self.bbb = (op >> 2) & 7
+        self.aaa = (op >> 5) & 7
+        self.addr = ops[self.cc][self.bbb][self.aaa][0]
+        self.mem = ops[self.cc][self.bbb][self.aaa][1]
+        self.cmt = None
+        self.call = None
+
+    # set the instruction method call and the mnemonic (for undocumented
+    # instructions the mnemonic is prefixed with a '*', the addressing
+    # mode is appended to the mnemonic unless an operand string is given)
+    def set(self, call, mnemonic, operand=None) :
+        self.call = call
+        if operand is None :
+            operand = addr_cmt[self.addr]
+        self.cmt = (mnemonic + ' ' + operand).strip()
+
+#-------------------------------------------------------------------------------
+# Map an instruction byte to the instruction method to call, this
+# must match the instruction decoding in mos6502dasm.cc
+#
+def enc_op(op) :
+    o = opcode(op)
+    cc = o.cc
+    bbb = o.bbb
+    aaa = o.aaa
+    if cc == 0 :
+        if bbb == 4 :
+            br = branches[aaa]
+            o.set('br({},{});'.format(br[0], br[1]), br[2], 'rel')
+        elif bbb == 6 :
+            flags = [ ('cl','CF','CLC'), ('se','CF','SEC'), ('cl','IF','CLI'), ('se','IF','SEI'),
+                      (None,None,None), ('cl','VF','CLV'), ('cl','DF','CLD'), ('se','DF','SED') ]
+            f = flags[aaa]
+            if f[0] :
+                o.set('{}({});'.format(f[0], f[1]), f[2])
+            else :
+                o.set('tya();', 'TYA')
+        elif bbb == 2 :
+            impl = [ ('php','PHP'), ('plp','PLP'), ('pha','PHA'), ('pla','PLA'),
+                     ('dey','DEY'), ('tay','TAY'), ('iny','INY'), ('inx','INX') ]
+            o.set('{}();'.format(impl[aaa][0]), impl[aaa][1])
+        elif aaa == 0 :
+            if bbb == 0 :
+                o.set('brk();', 'BRK')
+            else :
+                o.set('u_nop();', '*NOP')
+        elif aaa == 1 :
+            if bbb == 0 :
+                o.set('jsr();', 'JSR')
+            elif bbb in (5, 7) :
+                o.set('u_nop();', '*NOP')
+            else :
+                o.set('bit();', 'BIT')
+        elif aaa == 2 :
+            if bbb == 0 :
+                o.set('rti();', 'RTI')
+            elif bbb == 3 :
+                o.set('jmp();', 'JMP')
+            else :
+                o.set('u_nop();', '*NOP')
+        elif aaa == 3 :
+            if bbb == 0 :
+                o.set('rts();', 'RTS')
+            elif bbb == 3 :
+                o.set('jmpi();', 'JMP', '(abs)')
+            else :
+                o.set('u_nop();', '*NOP')
+        elif aaa == 4 :
+            if bbb == 0 :
+                o.set('u_nop();', '*NOP')
+            else :
+                o.set('sty();', 'STY')
+        elif aaa == 5 :
+            o.set('ldy();', 'LDY')
+        elif aaa == 6 :
+            if bbb in (5, 7) :
+                o.set('u_nop();', '*NOP')
+            else :
+                o.set('cpy();', 'CPY')
+        else :
+            if bbb in (5, 7) :
+                o.set('u_nop();', '*NOP')
+            else :
+                o.set('cpx();', 'CPX')
+    elif cc == 1 :
+        if aaa == 4 and bbb == 2 :
+            o.set('u_nop();', '*NOP')
+        else :
+            o.set('{}();'.format(alu[aaa]), alu_cmt[aaa])
+    elif cc == 2 :
+        if aaa < 4 :
+            if bbb == 2 :
+                o.set('{}a();'.format(rmw[aaa]), rmw[aaa].upper(), 'A')
+            elif bbb == 6 :
+                o.set('u_nop();', '*NOP')
+            else :
+                o.set('{}();'.format(rmw[aaa]), rmw[aaa].upper())
+        elif aaa == 4 :
+            if bbb == 0 :
+                o.set('u_nop();', '*NOP')
+            elif bbb == 2 :
+                o.set('txa();', 'TXA')
+            elif bbb == 6 :
+                o.set('txs();', 'TXS')
+            else :
+                o.set('stx();', 'STX')
+        elif aaa == 5 :
+            if bbb == 2 :
+                o.set('tax();', 'TAX')
+            elif bbb == 6 :
+                o.set('tsx();', 'TSX')
+            else :
+                o.set('ldx();', 'LDX')
+        else :
+            if bbb == 0 or bbb == 6 :
+                o.set('u_nop();', '*NOP')
+            elif bbb == 2 :
+                o.set('dex();' if aaa == 6 else 'nop();', 'DEX' if aaa == 6 else 'NOP')
+            else :
+                o.set('{}();'.format(rmw[aaa]), rmw[aaa].upper())
+    else :
+        if aaa == 7 and bbb == 2 :
+            o.set('u_sbc();', '*SBC')
+        else :
+            o.set('{}();'.format(undoc[aaa]), '*' + undoc[aaa][2:].upper())
+    return o
+
+#-------------------------------------------------------------------------------
+# Return the source lines for the address computation of an indexed
+# addressing mode after the low byte plus index is in tmp16 and the
+# uncorrected address is on the address bus. Reads only take the extra
+# cycle when a page boundary is crossed, writes always do.
+#
+def page_cross(mem) :
+    if mem == M_R_ :
+        return [ 'if (tmp16&0xFF00) { read(); ADDR=(ADDR&0xFF00)+tmp16; }' ]
+    else :
+        return [ 'read(); ADDR=(ADDR&0xFF00)+tmp16;' ]
+
+#-------------------------------------------------------------------------------
+# Return the source lines which put the effective address on the
+# address bus, this is one line per memory access cycle
+#
+def enc_addr(addr, mem) :
+    if addr == A____ :
+        # this still puts the PC on the address bus, so that
+        # the next instruction byte is read
+        return [ 'ADDR=PC;' ]
+    elif addr == A_IMM or addr == A_JSR :
+        return [ 'ADDR=PC++;' ]
+    elif addr == A_ZER :
+        return [ 'ADDR=PC++; read();',
+                 'ADDR=DATA;' ]
+    elif addr == A_ZPX or addr == A_ZPY :
+        return [ 'ADDR=PC++; read();',
+                 'ADDR=DATA; read();',
+                 'ADDR=(ADDR+{})&0x00FF;'.format('X' if addr==A_ZPX else 'Y') ]
+    elif addr == A_ABS :
+        return [ 'ADDR=PC++; read();',
+                 'tmp16=DATA; ADDR=PC++; read();',
+                 'ADDR=(DATA<<8)|tmp16;' ]
+    elif addr == A_ABX or addr == A_ABY :
+        return [ 'ADDR=PC++; read();',
+                 'tmp16=DATA+{}; ADDR=PC++; read();'.format('X' if addr==A_ABX else 'Y'),
+                 'ADDR=(DATA<<8)|(tmp16&0xFF);' ] + page_cross(mem)
+    elif addr == A_IDX :
+        return [ 'ADDR=PC++; read();',
+                 'ADDR=DATA; read();',
+                 'ADDR=(ADDR+X)&0x00FF; read();',
+                 'tmp16=DATA; ADDR=(ADDR+1)&0x00FF; read();',
+                 'ADDR=(DATA<<8)|tmp16;' ]
+    elif addr == A_IDY :
+        return [ 'ADDR=PC++; read();',
+                 'ADDR=DATA; read();',
+                 'tmp16=DATA+Y; ADDR=(ADDR+1)&0x00FF; read();',
+                 'ADDR=(DATA<<8)|(tmp16&0xFF);' ] + page_cross(mem)
+    elif addr == A_JMP :
+        # just load the next two bytes, the instruction forms the address
+        return [ 'ADDR=PC++; read();',
+                 'tmp16=DATA; ADDR=PC++;' ]
+    else :
+        # invalid instruction, the address bus is left unchanged
+        return [ 'YAKC_ASSERT(false);' ]
+
+#-------------------------------------------------------------------------------
+# return a tab-string for given indent level
+#
+def tab(indent) :
+    return ' '*TabWidth*indent
+
+#-------------------------------------------------------------------------------
+# output a src line
+def l(s) :
+    Out.write(s+'\n')
+
+#-------------------------------------------------------------------------------
+# write source header
+#
+def write_header() :
+    l('// #version:{}#'.format(Version))
+    l('// machine generated, do not edit!')
+    l('#include "mos6502.h"')
+    l('namespace YAKC {')
+    l('using namespace mos6502_enums;')
+
+#-------------------------------------------------------------------------------
+# write the addressing mode table which is used by the disassembler
+#
+def write_ops_table() :
+    l('mos6502::op_desc mos6502::ops[4][8][8] = {')
+    for cc in range(0, 4) :
+        l('{}{{ // cc = {:02b}'.format(tab(1), cc))
+        for bbb in range(0, 8) :
+            row = ','.join('{{{},{}}}'.format(o[0], o[1]) for o in ops[cc][bbb])
+            l('{}{{{}}},'.format(tab(2), row))
+        l('{}}},'.format(tab(1)))
+    l('};')
+
+#-------------------------------------------------------------------------------
+# write a single instruction (a case inside the decoder switch)
+#
+def write_op(indent, op) :
+    l('{}case {}: // {}'.format(tab(indent), hex(op.byte), op.cmt))
+    for src in enc_addr(op.addr, op.mem) :
+        l('{}{}'.format(tab(indent+1), src))
+    l('{}{}'.format(tab(indent+1), op.call))
+    l('{}break;'.format(tab(indent+1)))
+
+#-------------------------------------------------------------------------------
+# write the decoder function
+#
+def write_step() :
+    l('uint32_t mos6502::step() {')
+    l('{}Cycle = 0;'.format(tab(1)))
+    l('{}fetch();'.format(tab(1)))
+    l('{}switch (IR) {{'.format(tab(1)))
+    for i in range(0, 256) :
+        write_op(2, enc_op(i))
+    l('{}}}'.format(tab(1)))
+    l('{}return Cycle;'.format(tab(1)))
+    l('}')
+
+#-------------------------------------------------------------------------------
+# write source footer
+#
+def write_footer() :
+    l('} // namespace YAKC')
+
+#-------------------------------------------------------------------------------
+# main encoder function, generates the C++ source code into the file f
+#
+def do_it(f) :
+    global Out
+    Out = f
+    write_header()
+    write_ops_table()
+    write_step()
+    write_footer()
+
+#-------------------------------------------------------------------------------
+# fips code generator entry
+#
+def generate(input, out_src, out_hdr) :
+    if genutil.isDirty(Version, [input], [out_src]) :
+        with open(out_src, 'w') as f:
+            do_it(f)
@@ -205,7 +205,13 @@ int mos6502disasm(fetch_func fetch, unsigned short pc, char* buffer, void* userd
     switch (mos6502::ops[cc][bbb][aaa].addr) {
         case A_IMM:
             l = fetch(pc, pos++, userdata);
-            dst += sprintf(dst, " #$%02X", l);
+            if ((cc == 0) && (bbb == 4)) {
+                // relative branch, show the target address
+                dst += sprintf(dst, " $%04X", (pc + 2 + int8_t(l)) & 0xFFFF);
+            }
+            else {
+                dst += sprintf(dst, " #$%02X", l);
+            }
             break;
         case A_ZER:
             l = fetch(pc, pos++, userdata);
@@ -254,6 +260,26 @@ int mos6502disasm(fetch_func fetch, unsigned short pc, char* buffer, void* userd
     return pos;
 }
 
+int mos6502oplength(unsigned char op) {
+    switch (mos6502::ops[op & 0x03][(op >> 2) & 0x07][(op >> 5) & 0x07].addr) {
+        case A_IMM:
+        case A_ZER:
+        case A_ZPX:
+        case A_ZPY:
+        case A_IDX:
+        case A_IDY:
+            return 2;
+        case A_ABS:
+        case A_JSR:
+        case A_JMP:
+        case A_ABX:
+        case A_ABY:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
 } // namespace mos6502dasm
 
 
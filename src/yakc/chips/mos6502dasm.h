@@ -7,4 +7,6 @@
 namespace mos6502dasm {
 typedef unsigned char (*fetch_func)(unsigned short base, int offset, void* userdata);
 extern int mos6502disasm(fetch_func fetch, unsigned short pc, char* buffer, void* userdata);
+/// length of the instruction with an opcode byte, same as mos6502disasm() without disassembling
+extern int mos6502oplength(unsigned char op);
 }
@@ -27,34 +27,109 @@ mos6522::reset() {
     t2ll = t2lh = 0;
     t1 = 0;
     t2 = 0;
+    ifr = 0;
+    ier = 0;
+    synced_tick = cur_tick;
+    update_next_event();
 }
 
 //------------------------------------------------------------------------------
 void
-mos6522::step(system_bus* bus) {
-    t1--;
-    if (t1 == 0) {
-        // FIXME: implement 3 cycle delay
-        if (acr_t1_cont_int()) {
-            // continuous interval, reset counter
-            t1_pb7 = !t1_pb7;
-            t1 = (t1lh<<8) | t1ll;
+mos6522::update(system_bus* bus) {
+    const int ticks = int(cur_tick - synced_tick);
+    synced_tick = cur_tick;
+
+    // both timers are always counting down, a counter which is at
+    // zero wraps around and reaches zero again after 0x10000 ticks
+    int t1_ticks = ticks;
+    while (t1_ticks > 0) {
+        const int t1_zero = t1 ? t1 : 0x10000;
+        if (t1_ticks < t1_zero) {
+            t1 -= t1_ticks;
+            break;
         }
-        else {
-            // one-shot, don't reset counter
-            t1_pb7 = 1;
-            t1_active = false;
+        t1_ticks -= t1_zero;
+        t1 = 0;
+        t1_timeout(bus);
+    }
+    int t2_ticks = ticks;
+    while (t2_ticks > 0) {
+        const int t2_zero = t2 ? t2 : 0x10000;
+        if (t2_ticks < t2_zero) {
+            t2 -= t2_ticks;
+            break;
         }
-        if (acr_t1_pb7()) {
-            bus_out_b(bus);
+        t2_ticks -= t2_zero;
+        t2 = 0;
+        t2_timeout(bus);
+    }
+    update_next_event();
+}
+
+//------------------------------------------------------------------------------
+void
+mos6522::update_next_event() {
+    const int t1_zero = t1 ? t1 : 0x10000;
+    const int t2_zero = t2 ? t2 : 0x10000;
+    next_event_tick = synced_tick + ((t1_zero < t2_zero) ? t1_zero : t2_zero);
+}
+
+//------------------------------------------------------------------------------
+void
+mos6522::t1_timeout(system_bus* bus) {
+    // FIXME: implement 3 cycle delay
+    if (acr_t1_cont_int()) {
+        // continuous interval, reset counter
+        t1_pb7 = !t1_pb7;
+        t1 = (t1lh<<8) | t1ll;
+        set_irq(bus, IRQ_T1);
+    }
+    else {
+        // one-shot, don't reset counter, only the first
+        // timeout after loading the counter is an interrupt
+        if (t1_active) {
+            set_irq(bus, IRQ_T1);
         }
-        // FIXME: interrupt
+        t1_pb7 = 1;
+        t1_active = false;
+    }
+    if (acr_t1_pb7()) {
+        bus_out_b(bus);
     }
-    t2--;
-    if (t2 == 0) {
-        // FIXME: implement 3 cycle delay
-        t2_active = false;
-        // FIXME: interrupt
+}
+
+//------------------------------------------------------------------------------
+void
+mos6522::t2_timeout(system_bus* bus) {
+    // FIXME: implement 3 cycle delay
+    if (t2_active) {
+        set_irq(bus, IRQ_T2);
+    }
+    t2_active = false;
+}
+
+//------------------------------------------------------------------------------
+void
+mos6522::set_irq(system_bus* bus, uint8_t mask) {
+    const bool was_active = irq_active();
+    ifr |= mask;
+    update_irq(bus, was_active);
+}
+
+//------------------------------------------------------------------------------
+void
+mos6522::clear_irq(system_bus* bus, uint8_t mask) {
+    const bool was_active = irq_active();
+    ifr &= ~mask;
+    update_irq(bus, was_active);
+}
+
+//------------------------------------------------------------------------------
+void
+mos6522::update_irq(system_bus* bus, bool was_active) {
+    const bool active = irq_active();
+    if ((active != was_active) && bus) {
+        bus->irq(active);
     }
 }
 
@@ -101,6 +176,7 @@ mos6522::bus_in_a(system_bus* bus) {
 //------------------------------------------------------------------------------
 void
 mos6522::write(system_bus* bus, int addr, uint8_t val) {
+    update(bus);
     switch (addr & 0x0F) {
         case PB:
             out_b = val;
@@ -108,7 +184,7 @@ mos6522::write(system_bus* bus, int addr, uint8_t val) {
             if (ddr_b != 0) {
                 bus_out_b(bus);
             }
-            // FIXME: clear interrupt
+            clear_irq(bus, IRQ_CB1 | (pcr_cb2_independent() ? 0 : IRQ_CB2));
             // FIXME: CB2 data ready handshake
             break;
 
@@ -117,7 +193,7 @@ mos6522::write(system_bus* bus, int addr, uint8_t val) {
             if (ddr_a != 0) {
                 bus_out_a(bus);
             }
-            // FIXME: clear interrupt
+            clear_irq(bus, IRQ_CA1 | (pcr_ca2_independent() ? 0 : IRQ_CA2));
             // FIXME: CA2 ready handshake, pulse
             break;
 
@@ -149,12 +225,12 @@ mos6522::write(system_bus* bus, int addr, uint8_t val) {
             break;
 
         case T1LH:
-            // FIXME: clear interrupt
             t1lh = val;
+            clear_irq(bus, IRQ_T1);
             break;
 
         case T1CH:
-            // FIXME: clear interrupt
+            clear_irq(bus, IRQ_T1);
             t1lh = val;
             t1 = ((t1lh<<8) | t1ll);
             t1_pb7 = 0;
@@ -169,7 +245,7 @@ mos6522::write(system_bus* bus, int addr, uint8_t val) {
             break;
 
         case T2CH:
-            // FIXME: clear interrupt
+            clear_irq(bus, IRQ_T2);
             t2lh = val;
             t2 = (t2lh<<8) | t2ll;
             if (acr_t2_count_pb6()) {
@@ -203,18 +279,31 @@ mos6522::write(system_bus* bus, int addr, uint8_t val) {
             break;
 
         case IER:
-            // FIXME
+            // bit 7 set: set the enable bits, otherwise clear them
+            {
+                const bool was_active = irq_active();
+                if (val & IRQ_ANY) {
+                    ier |= val & ~IRQ_ANY;
+                }
+                else {
+                    ier &= ~val;
+                }
+                update_irq(bus, was_active);
+            }
             break;
 
         case IFR:
-            // FIXME
+            // writing a 1 bit clears the interrupt flag
+            clear_irq(bus, val & ~IRQ_ANY);
             break;
     }
+    update_next_event();
 }
 
 //------------------------------------------------------------------------------
 uint8_t
 mos6522::read(system_bus* bus, int addr) {
+    update(bus);
     uint8_t val = 0;
     switch (addr & 0x0F) {
         case PB:
@@ -224,7 +313,7 @@ mos6522::read(system_bus* bus, int addr) {
             else {
                 val = bus_in_b(bus);
             }
-            // FIXME: clear interrupt
+            clear_irq(bus, IRQ_CB1 | (pcr_cb2_independent() ? 0 : IRQ_CB2));
             break;
 
         case PA:
@@ -234,7 +323,7 @@ mos6522::read(system_bus* bus, int addr) {
             else {
                 val = bus_in_a(bus);
             }
-            // FIXME: clear interrupt
+            clear_irq(bus, IRQ_CA1 | (pcr_ca2_independent() ? 0 : IRQ_CA2));
             // FIXME: handshake, pulse
             break;
 
@@ -257,7 +346,7 @@ mos6522::read(system_bus* bus, int addr) {
             break;
 
         case T1CL:
-            // FIXME: clear interrupt
+            clear_irq(bus, IRQ_T1);
             val = t1 & 0x00FF;
             break;
 
@@ -274,7 +363,7 @@ mos6522::read(system_bus* bus, int addr) {
             break;
 
         case T2CL:
-            // FIXME: clear interrupt
+            clear_irq(bus, IRQ_T2);
             val = t2 & 0x00FF;
             break;
 
@@ -295,11 +384,15 @@ mos6522::read(system_bus* bus, int addr) {
             break;
 
         case IER:
-            // FIXME
+            val = ier | IRQ_ANY;
             break;
 
         case IFR:
-            // FIXME
+            // bit 7 is set if any enabled interrupt flag is set
+            val = ifr;
+            if (ifr & ier) {
+                val |= IRQ_ANY;
+            }
             break;
     }
     return val;
@@ -3,6 +3,12 @@
 /**
     @class YAKC::mos6522.h
     @brief MOS Technologies 6522 VIA emulation
+
+    The timers are not decremented on every tick. step() only advances
+    the current tick, and the timer counters, the PB7 output and the
+    timer interrupt flags are brought up to date when the tick is
+    reached where the next timer reaches zero, or when a register
+    is accessed.
 */
 #include "yakc/core/core.h"
 
@@ -39,12 +45,30 @@ public:
         NUM_PORTS,
     };
 
+    /// interrupt flag and enable bits
+    enum {
+        IRQ_CA2 = (1<<0),
+        IRQ_CA1 = (1<<1),
+        IRQ_SR  = (1<<2),
+        IRQ_CB2 = (1<<3),
+        IRQ_CB1 = (1<<4),
+        IRQ_T2  = (1<<5),
+        IRQ_T1  = (1<<6),
+        IRQ_ANY = (1<<7),
+    };
+
     /// initialize 6522 instance
     void init(int id);
     /// reset the 6522
     void reset();
-    /// step the 6522 one tick
-    void step(system_bus* bus);
+    /// advance the 6522 by a number of ticks
+    void step(system_bus* bus, int num_ticks);
+    /// bring the timers up to date, and recompute the next event tick
+    void update(system_bus* bus);
+    /// number of ticks until the next timer reaches zero
+    int ticks_until_event() const;
+    /// test if the IRQ output is active
+    bool irq_active() const;
 
     /// write to VIA
     void write(system_bus* bus, int addr, uint8_t val);
@@ -79,6 +103,15 @@ public:
     uint16_t t2 = 0;        // timer2 counter
     bool t1_active = false; // timer1 is active
     bool t2_active = false; // timer2 is active
+    uint8_t ifr = 0;        // interrupt flag register (without bit 7)
+    uint8_t ier = 0;        // interrupt enable register (without bit 7)
+
+    /// the current tick, advanced by step()
+    uint64_t cur_tick = 0;
+    /// the tick the timer counters have been updated to
+    uint64_t synced_tick = 0;
+    /// the tick where the next timer reaches zero
+    uint64_t next_event_tick = 0;
 
     /// auxilary control register bits
     bool acr_latch_a() const { return 0 != (acr & 0x01); }
@@ -96,6 +129,45 @@ public:
     bool acr_t1_timed_int() const   { return (acr & (1<<6)) == 0; }
     bool acr_t1_cont_int() const    { return (acr & (1<<6)) != 0; }
     bool acr_t1_pb7() const         { return (acr & (1<<7)) != 0; }
+
+    /// peripheral control register bits
+    bool pcr_ca2_independent() const { return (pcr & 0x0A) == 0x02; }
+    bool pcr_cb2_independent() const { return (pcr & 0xA0) == 0x20; }
+
+private:
+    /// compute next_event_tick from the timer counters
+    void update_next_event();
+    /// timer 1 has reached zero
+    void t1_timeout(system_bus* bus);
+    /// timer 2 has reached zero
+    void t2_timeout(system_bus* bus);
+    /// set interrupt flags, and update the IRQ line
+    void set_irq(system_bus* bus, uint8_t mask);
+    /// clear interrupt flags, and update the IRQ line
+    void clear_irq(system_bus* bus, uint8_t mask);
+    /// notify the bus if the IRQ output has changed
+    void update_irq(system_bus* bus, bool was_active);
 };
 
+//------------------------------------------------------------------------------
+inline void
+mos6522::step(system_bus* bus, int num_ticks) {
+    this->cur_tick += num_ticks;
+    if (this->cur_tick >= this->next_event_tick) {
+        this->update(bus);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline int
+mos6522::ticks_until_event() const {
+    return int(this->next_event_tick - this->cur_tick);
+}
+
+//------------------------------------------------------------------------------
+inline bool
+mos6522::irq_active() const {
+    return 0 != (this->ifr & this->ier);
+}
+
 } // namespace YAKC
@@ -0,0 +1,250 @@
+//------------------------------------------------------------------------------
+//  profiler.cc
+//------------------------------------------------------------------------------
+#include "profiler.h"
+
+namespace YAKC {
+
+//------------------------------------------------------------------------------
+profiler::~profiler() {
+    this->reset();
+}
+
+//------------------------------------------------------------------------------
+void
+profiler::start(cpu_model cpu_) {
+    this->reset();
+    this->cpu = cpu_;
+    this->addr_counters = (uint64_t*) YAKC_MALLOC(num_addrs * sizeof(uint64_t));
+    clear(this->addr_counters, num_addrs * sizeof(uint64_t));
+    this->nodes = (node*) YAKC_MALLOC(max_nodes * sizeof(node));
+    this->nodes[root] = node();
+    this->nodes_used = 1;
+    this->enabled = true;
+}
+
+//------------------------------------------------------------------------------
+void
+profiler::stop() {
+    this->enabled = false;
+}
+
+//------------------------------------------------------------------------------
+void
+profiler::reset() {
+    this->enabled = false;
+    if (this->addr_counters) {
+        YAKC_FREE(this->addr_counters);
+        this->addr_counters = nullptr;
+    }
+    if (this->nodes) {
+        YAKC_FREE(this->nodes);
+        this->nodes = nullptr;
+    }
+    this->nodes_used = 0;
+    this->cur_node = root;
+    this->stack_depth = 0;
+    this->total_cycles = 0;
+    this->num_dropped_calls = 0;
+}
+
+//------------------------------------------------------------------------------
+void
+profiler::record(uint16_t pc, uint32_t cycles, uint16_t sp) {
+    YAKC_ASSERT(this->addr_counters && this->nodes);
+    this->addr_counters[pc] += cycles;
+    this->nodes[this->cur_node].cycles += cycles;
+    this->total_cycles += cycles;
+
+    // leave all call frames where the stack pointer has
+    // moved above the return address
+    while ((this->stack_depth > 0) && (sp > this->stack[this->stack_depth-1].sp)) {
+        this->stack_depth--;
+        this->cur_node = this->nodes[this->stack[this->stack_depth].node].parent;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+profiler::call(uint16_t entry, uint16_t sp) {
+    YAKC_ASSERT(this->nodes);
+    if (this->stack_depth < max_depth) {
+        const int n = this->child(this->cur_node, entry);
+        if (n >= 0) {
+            this->nodes[n].calls++;
+            this->stack[this->stack_depth].node = n;
+            this->stack[this->stack_depth].sp = sp;
+            this->stack_depth++;
+            this->cur_node = n;
+            return;
+        }
+    }
+    // call tree or stack full, the callee is accounted to the caller
+    this->num_dropped_calls++;
+}
+
+//------------------------------------------------------------------------------
+int
+profiler::child(int parent, uint16_t entry) {
+    int last = -1;
+    for (int i = this->nodes[parent].first_child; i >= 0; i = this->nodes[i].next_sibling) {
+        if (this->nodes[i].func == entry) {
+            return i;
+        }
+        last = i;
+    }
+    if (this->nodes_used >= max_nodes) {
+        return -1;
+    }
+    const int n = this->nodes_used++;
+    this->nodes[n] = node();
+    this->nodes[n].func = entry;
+    this->nodes[n].parent = parent;
+    if (last >= 0) {
+        this->nodes[last].next_sibling = n;
+    }
+    else {
+        this->nodes[parent].first_child = n;
+    }
+    return n;
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+profiler::addr_cycles(uint16_t addr) const {
+    return this->addr_counters ? this->addr_counters[addr] : 0;
+}
+
+//------------------------------------------------------------------------------
+bool
+profiler::is_recursive(int index) const {
+    const uint16_t entry = this->nodes[index].func;
+    for (int i = this->nodes[index].parent; i > root; i = this->nodes[i].parent) {
+        if (this->nodes[i].func == entry) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+profiler::inclusive_cycles(uint16_t entry) const {
+    if (!this->nodes) {
+        return 0;
+    }
+    // child nodes are always created after their parents, so the
+    // subtree totals can be accumulated in reverse node order
+    uint64_t* totals = (uint64_t*) YAKC_MALLOC(this->nodes_used * sizeof(uint64_t));
+    for (int i = 0; i < this->nodes_used; i++) {
+        totals[i] = this->nodes[i].cycles;
+    }
+    for (int i = this->nodes_used - 1; i > root; i--) {
+        totals[this->nodes[i].parent] += totals[i];
+    }
+    // don't count recursive calls twice
+    uint64_t sum = 0;
+    for (int i = root + 1; i < this->nodes_used; i++) {
+        if ((this->nodes[i].func == entry) && !this->is_recursive(i)) {
+            sum += totals[i];
+        }
+    }
+    YAKC_FREE(totals);
+    return sum;
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+profiler::num_calls(uint16_t entry) const {
+    uint64_t sum = 0;
+    for (int i = root + 1; i < this->nodes_used; i++) {
+        if (this->nodes[i].func == entry) {
+            sum += this->nodes[i].calls;
+        }
+    }
+    return sum;
+}
+
+//------------------------------------------------------------------------------
+int
+profiler::hotspots(hotspot* out_items, int max_items) const {
+    YAKC_ASSERT(out_items && (max_items > 0));
+    if (!this->addr_counters) {
+        return 0;
+    }
+    // insertion into a sorted list of max_items
+    int num = 0;
+    for (int addr = 0; addr < num_addrs; addr++) {
+        const uint64_t cycles = this->addr_counters[addr];
+        if ((0 == cycles) || ((num == max_items) && (cycles <= out_items[num-1].cycles))) {
+            continue;
+        }
+        int i = (num < max_items) ? num++ : num-1;
+        while ((i > 0) && (out_items[i-1].cycles < cycles)) {
+            out_items[i] = out_items[i-1];
+            i--;
+        }
+        out_items[i].addr = uint16_t(addr);
+        out_items[i].cycles = cycles;
+    }
+    return num;
+}
+
+//------------------------------------------------------------------------------
+int
+profiler::depth() const {
+    return this->stack_depth;
+}
+
+//------------------------------------------------------------------------------
+int
+profiler::num_nodes() const {
+    return this->nodes_used;
+}
+
+//------------------------------------------------------------------------------
+const profiler::node&
+profiler::get_node(int index) const {
+    YAKC_ASSERT((index >= 0) && (index < this->nodes_used));
+    return this->nodes[index];
+}
+
+//------------------------------------------------------------------------------
+void
+profiler::write_stack(FILE* fp, int index) const {
+    if (root == index) {
+        fputs("root", fp);
+    }
+    else {
+        this->write_stack(fp, this->nodes[index].parent);
+        fprintf(fp, ";%04X", this->nodes[index].func);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+profiler::write_collapsed(FILE* fp) const {
+    YAKC_ASSERT(fp);
+    for (int i = 0; i < this->nodes_used; i++) {
+        if (this->nodes[i].cycles > 0) {
+            this->write_stack(fp, i);
+            fprintf(fp, " %llu\n", (unsigned long long)this->nodes[i].cycles);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+profiler::write_hotspots(FILE* fp, int max_items) const {
+    YAKC_ASSERT(fp && (max_items > 0));
+    hotspot* items = (hotspot*) YAKC_MALLOC(max_items * sizeof(hotspot));
+    const int num = this->hotspots(items, max_items);
+    fprintf(fp, "addr      cycles        %%\n");
+    for (int i = 0; i < num; i++) {
+        const double percent = this->total_cycles ? (100.0 * items[i].cycles) / this->total_cycles : 0.0;
+        fprintf(fp, "%04X %12llu %7.2f%%\n", items[i].addr, (unsigned long long)items[i].cycles, percent);
+    }
+    YAKC_FREE(items);
+}
+
+} // namespace YAKC
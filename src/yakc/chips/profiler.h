@@ -0,0 +1,116 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::profiler
+    @brief per-address cycle profiler with call tracking
+
+    Accumulates the executed CPU cycles per instruction address into
+    64K counters, and builds a call tree from subroutine calls and
+    returns, so that inclusive per-subroutine cycle totals can be
+    computed, and the call tree can be exported as collapsed-stack
+    text (one line per call stack: 'root;C000;C123 1234') which can
+    be fed to flame graph tools.
+
+    Calls (Z80: CALL, RST and interrupts, 6502: JSR, BRK and interrupts)
+    are reported by cpudbg with the stack pointer after the call.
+    Returns are detected from the stack pointer instead of the opcode,
+    a call frame is left when the stack pointer moves above the return
+    address, this handles RET, RETI, RTS, RTI and stack manipulations
+    like 'POP HL; JP (HL)' the same way.
+
+    The profiler is fed by cpudbg::step(), which costs a single bool
+    check per instruction while profiling is disabled.
+*/
+#include "yakc/core/core.h"
+#include <stdio.h>
+
+namespace YAKC {
+
+class profiler {
+public:
+    /// number of per-address counters
+    static const int num_addrs = 1<<16;
+    /// max number of call tree nodes
+    static const int max_nodes = 16 * 1024;
+    /// max call stack depth
+    static const int max_depth = 256;
+    /// the root node index
+    static const int root = 0;
+
+    /// a call tree node
+    struct node {
+        uint16_t func = 0;          // subroutine entry address
+        int parent = -1;            // parent node index
+        int first_child = -1;       // first child node index
+        int next_sibling = -1;      // next sibling node index
+        uint64_t cycles = 0;        // exclusive cycles spent in this node
+        uint64_t calls = 0;         // number of calls into this node
+    };
+    /// an address with the number of cycles spent there
+    struct hotspot {
+        uint16_t addr = 0;
+        uint64_t cycles = 0;
+    };
+
+    /// destructor
+    ~profiler();
+    /// start profiling, existing profile data is discarded
+    void start(cpu_model cpu);
+    /// stop profiling, profile data is kept
+    void stop();
+    /// discard profile data and free memory
+    void reset();
+
+    /// record an executed instruction (called by cpudbg)
+    void record(uint16_t pc, uint32_t cycles, uint16_t sp);
+    /// record a subroutine call, sp points to the return address (called by cpudbg)
+    void call(uint16_t entry, uint16_t sp);
+
+    /// get cycles spent at an instruction address
+    uint64_t addr_cycles(uint16_t addr) const;
+    /// get the inclusive cycles of a subroutine (including its callees)
+    uint64_t inclusive_cycles(uint16_t entry) const;
+    /// get the number of calls to a subroutine
+    uint64_t num_calls(uint16_t entry) const;
+    /// get the addresses with the most cycles, return number of written items
+    int hotspots(hotspot* out_items, int max_items) const;
+
+    /// current call stack depth
+    int depth() const;
+    /// number of call tree nodes
+    int num_nodes() const;
+    /// access a call tree node
+    const node& get_node(int index) const;
+
+    /// write the call tree as collapsed stacks
+    void write_collapsed(FILE* fp) const;
+    /// write the hotspot list as text
+    void write_hotspots(FILE* fp, int max_items) const;
+
+    bool enabled = false;
+    cpu_model cpu = cpu_model::z80;
+    uint64_t total_cycles = 0;          // total number of recorded cycles
+    uint64_t num_dropped_calls = 0;     // calls not tracked because the call tree or stack was full
+
+private:
+    /// a call stack frame
+    struct frame {
+        int node;
+        uint16_t sp;
+    };
+    /// find or create a child node
+    int child(int parent, uint16_t entry);
+    /// test if a node has an ancestor with the same subroutine address
+    bool is_recursive(int index) const;
+    /// write the collapsed stack of a node
+    void write_stack(FILE* fp, int index) const;
+
+    uint64_t* addr_counters = nullptr;
+    node* nodes = nullptr;
+    int nodes_used = 0;
+    int cur_node = root;
+    int stack_depth = 0;
+    frame stack[max_depth];
+};
+
+} // namespace YAKC
@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+//  tracer.cc
+//------------------------------------------------------------------------------
+#include "tracer.h"
+
+namespace YAKC {
+
+static const uint32_t trace_magic = 0x43525459;    // 'YTRC'
+static const uint32_t trace_version = 2;     // 2: 4-byte cycle counts
+
+//------------------------------------------------------------------------------
+tracer::~tracer() {
+    this->reset();
+}
+
+//------------------------------------------------------------------------------
+void
+tracer::alloc_chunks(int num) {
+    YAKC_ASSERT(num > 0);
+    this->max_chunks = num;
+    this->chunks = (uint8_t**) YAKC_MALLOC(num * sizeof(uint8_t*));
+    for (int i = 0; i < num; i++) {
+        this->chunks[i] = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+tracer::start(cpu_model cpu_, int budget_bytes) {
+    YAKC_ASSERT(budget_bytes >= chunk_size);
+    this->reset();
+    this->cpu = cpu_;
+    this->alloc_chunks(budget_bytes / chunk_size);
+    this->enabled = true;
+}
+
+//------------------------------------------------------------------------------
+void
+tracer::stop() {
+    this->enabled = false;
+}
+
+//------------------------------------------------------------------------------
+void
+tracer::reset() {
+    this->enabled = false;
+    if (this->chunks) {
+        for (int i = 0; i < this->max_chunks; i++) {
+            if (this->chunks[i]) {
+                YAKC_FREE(this->chunks[i]);
+            }
+        }
+        YAKC_FREE(this->chunks);
+        this->chunks = nullptr;
+    }
+    this->max_chunks = 0;
+    this->first_chunk = 0;
+    this->num_chunks = 0;
+    this->cur_chunk = nullptr;
+    this->keyframe = true;
+    this->num_recorded = 0;
+    this->num_dropped = 0;
+}
+
+//------------------------------------------------------------------------------
+uint8_t*
+tracer::chunk(int index) const {
+    YAKC_ASSERT((index >= 0) && (index < this->num_chunks));
+    return this->chunks[(this->first_chunk + index) % this->max_chunks];
+}
+
+//------------------------------------------------------------------------------
+void
+tracer::new_chunk() {
+    int slot;
+    if (this->num_chunks < this->max_chunks) {
+        slot = (this->first_chunk + this->num_chunks) % this->max_chunks;
+        this->num_chunks++;
+        if (!this->chunks[slot]) {
+            this->chunks[slot] = (uint8_t*) YAKC_MALLOC(chunk_size);
+        }
+    }
+    else {
+        // budget used up, recycle the oldest chunk
+        slot = this->first_chunk;
+        this->first_chunk = (this->first_chunk + 1) % this->max_chunks;
+        this->num_dropped += ((chunk_header*)this->chunks[slot])->num_items;
+    }
+    this->cur_chunk = this->chunks[slot];
+    chunk_header* hdr = (chunk_header*) this->cur_chunk;
+    hdr->first_index = this->num_recorded;
+    hdr->num_items = 0;
+    hdr->num_bytes = sizeof(chunk_header);
+    this->keyframe = true;
+}
+
+//------------------------------------------------------------------------------
+void
+tracer::record(const item& it) {
+    YAKC_ASSERT(it.num_op_bytes <= max_op_bytes);
+    if (!this->cur_chunk || ((((chunk_header*)this->cur_chunk)->num_bytes + max_item_size) > chunk_size)) {
+        this->new_chunk();
+    }
+    chunk_header* hdr = (chunk_header*) this->cur_chunk;
+    uint8_t* start = this->cur_chunk + hdr->num_bytes;
+    uint8_t* ptr = start + 2;
+    uint16_t flags = it.num_op_bytes << 9;
+    if (this->keyframe || (it.pc != uint16_t(this->prev.pc + this->prev.num_op_bytes))) {
+        flags |= (1<<7);
+        *ptr++ = it.pc & 0xFF;
+        *ptr++ = it.pc >> 8;
+    }
+    if (this->keyframe || (it.cycles != this->prev.cycles)) {
+        flags |= (1<<8);
+        *ptr++ = it.cycles & 0xFF;
+        *ptr++ = (it.cycles >> 8) & 0xFF;
+        if (it.cycles > 0xFFFF) {
+            flags |= (1<<12);
+            *ptr++ = (it.cycles >> 16) & 0xFF;
+            *ptr++ = it.cycles >> 24;
+        }
+    }
+    for (int i = 0; i < it.num_op_bytes; i++) {
+        *ptr++ = it.op_bytes[i];
+    }
+    for (int i = 0; i < num_regs; i++) {
+        if (this->keyframe || (it.regs[i] != this->prev.regs[i])) {
+            flags |= (1<<i);
+            *ptr++ = it.regs[i] & 0xFF;
+            *ptr++ = it.regs[i] >> 8;
+        }
+    }
+    start[0] = flags & 0xFF;
+    start[1] = flags >> 8;
+    hdr->num_bytes += uint32_t(ptr - start);
+    hdr->num_items++;
+    this->num_recorded++;
+    this->prev = it;
+    this->keyframe = false;
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+tracer::num_items() const {
+    return this->num_recorded - this->num_dropped;
+}
+
+//------------------------------------------------------------------------------
+void
+tracer::decode_chunk(const uint8_t* chunk, decode_cb cb, void* userdata) {
+    const chunk_header* hdr = (const chunk_header*) chunk;
+    const uint8_t* ptr = chunk + sizeof(chunk_header);
+    item it;
+    for (uint32_t i = 0; i < hdr->num_items; i++) {
+        const uint16_t flags = ptr[0] | (ptr[1]<<8);
+        ptr += 2;
+        if (flags & (1<<7)) {
+            it.pc = ptr[0] | (ptr[1]<<8);
+            ptr += 2;
+        }
+        else {
+            it.pc += it.num_op_bytes;
+        }
+        if (flags & (1<<8)) {
+            it.cycles = ptr[0] | (ptr[1]<<8);
+            ptr += 2;
+            if (flags & (1<<12)) {
+                it.cycles |= (uint32_t(ptr[0])<<16) | (uint32_t(ptr[1])<<24);
+                ptr += 2;
+            }
+        }
+        it.num_op_bytes = (flags>>9) & 7;
+        for (int j = 0; j < it.num_op_bytes; j++) {
+            it.op_bytes[j] = *ptr++;
+        }
+        for (int j = 0; j < num_regs; j++) {
+            if (flags & (1<<j)) {
+                it.regs[j] = ptr[0] | (ptr[1]<<8);
+                ptr += 2;
+            }
+        }
+        cb(hdr->first_index + i, it, userdata);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+tracer::validate_chunk(const uint8_t* chunk) {
+    const chunk_header* hdr = (const chunk_header*) chunk;
+    const uint8_t* ptr = chunk + sizeof(chunk_header);
+    const uint8_t* end = chunk + hdr->num_bytes;
+    // each item is at least 2 bytes (the flags)
+    if (hdr->num_items > ((hdr->num_bytes - sizeof(chunk_header)) / 2)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < hdr->num_items; i++) {
+        if ((end - ptr) < 2) {
+            return false;
+        }
+        const uint16_t flags = ptr[0] | (ptr[1]<<8);
+        ptr += 2;
+        const int num_op_bytes = (flags>>9) & 7;
+        if (num_op_bytes > max_op_bytes) {
+            return false;
+        }
+        int size = num_op_bytes;
+        size += (flags & (1<<7)) ? 2 : 0;
+        size += (flags & (1<<8)) ? ((flags & (1<<12)) ? 4 : 2) : 0;
+        for (int j = 0; j < num_regs; j++) {
+            size += (flags & (1<<j)) ? 2 : 0;
+        }
+        if ((end - ptr) < size) {
+            return false;
+        }
+        ptr += size;
+    }
+    return ptr == end;
+}
+
+//------------------------------------------------------------------------------
+void
+tracer::decode(decode_cb cb, void* userdata) const {
+    YAKC_ASSERT(cb);
+    for (int i = 0; i < this->num_chunks; i++) {
+        decode_chunk(this->chunk(i), cb, userdata);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+tracer::save(const char* path) const {
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        return false;
+    }
+    const uint32_t hdr[4] = { trace_magic, trace_version, uint32_t(this->cpu), uint32_t(this->num_chunks) };
+    bool ok = 1 == fwrite(hdr, sizeof(hdr), 1, fp);
+    for (int i = 0; ok && (i < this->num_chunks); i++) {
+        const uint8_t* c = this->chunk(i);
+        ok = 1 == fwrite(c, ((const chunk_header*)c)->num_bytes, 1, fp);
+    }
+    fclose(fp);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+bool
+tracer::load(const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return false;
+    }
+    this->reset();
+    uint32_t hdr[4] = { };
+    bool ok = (1 == fread(hdr, sizeof(hdr), 1, fp)) &&
+              (trace_magic == hdr[0]) && (hdr[1] >= 1) && (hdr[1] <= trace_version) &&
+              (hdr[3] > 0);
+    if (ok) {
+        this->cpu = (cpu_model) hdr[2];
+        this->alloc_chunks(hdr[3]);
+        for (uint32_t i = 0; ok && (i < hdr[3]); i++) {
+            uint8_t* c = (uint8_t*) YAKC_MALLOC(chunk_size);
+            this->chunks[i] = c;
+            chunk_header* ch = (chunk_header*) c;
+            ok = (1 == fread(ch, sizeof(chunk_header), 1, fp)) &&
+                 (ch->num_bytes >= sizeof(chunk_header)) && (ch->num_bytes <= uint32_t(chunk_size));
+            if (ok) {
+                const uint32_t data_size = ch->num_bytes - sizeof(chunk_header);
+                ok = (0 == data_size) || (1 == fread(c + sizeof(chunk_header), data_size, 1, fp));
+            }
+            if (ok) {
+                // chunks must contain a contiguous range of items
+                ok = validate_chunk(c) && ((0 == i) || (ch->first_index == this->num_recorded));
+            }
+            if (ok) {
+                if (0 == i) {
+                    this->num_dropped = ch->first_index;
+                }
+                this->num_recorded = ch->first_index + ch->num_items;
+                this->num_chunks++;
+            }
+        }
+    }
+    fclose(fp);
+    if (!ok) {
+        this->reset();
+    }
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+static void
+dump_item(uint64_t index, const tracer::item& it, void* userdata) {
+    FILE* fp = (FILE*) userdata;
+    fprintf(fp, "%10llu %04X: ", (unsigned long long)index, it.pc);
+    for (int i = 0; i < tracer::max_op_bytes; i++) {
+        if (i < it.num_op_bytes) {
+            fprintf(fp, "%02X ", it.op_bytes[i]);
+        }
+        else {
+            fputs("   ", fp);
+        }
+    }
+    fprintf(fp, "cyc=%-3u ", it.cycles);
+    fprintf(fp, "AF=%04X BC=%04X DE=%04X HL=%04X IX=%04X IY=%04X SP=%04X\n",
+        it.regs[0], it.regs[1], it.regs[2], it.regs[3], it.regs[4], it.regs[5], it.regs[6]);
+}
+
+//------------------------------------------------------------------------------
+static void
+dump_item_6502(uint64_t index, const tracer::item& it, void* userdata) {
+    FILE* fp = (FILE*) userdata;
+    fprintf(fp, "%10llu %04X: ", (unsigned long long)index, it.pc);
+    for (int i = 0; i < tracer::max_op_bytes; i++) {
+        if (i < it.num_op_bytes) {
+            fprintf(fp, "%02X ", it.op_bytes[i]);
+        }
+        else {
+            fputs("   ", fp);
+        }
+    }
+    fprintf(fp, "cyc=%-3u ", it.cycles);
+    fprintf(fp, "A=%02X X=%02X Y=%02X S=%02X P=%02X\n",
+        it.regs[0], it.regs[1], it.regs[2], it.regs[3], it.regs[4]);
+}
+
+//------------------------------------------------------------------------------
+void
+tracer::dump(FILE* fp) const {
+    YAKC_ASSERT(fp);
+    this->decode(cpu_model::z80 == this->cpu ? dump_item : dump_item_6502, fp);
+}
+
+} // namespace YAKC
@@ -0,0 +1,114 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::tracer
+    @brief deep execution trace recorder
+
+    Records PC, opcode bytes, registers and cycle count of every executed
+    instruction into a chain of fixed-size chunks. Each item is
+    delta-encoded against the previous item (only changed registers are
+    written, the PC is only written if it doesn't follow the previous
+    instruction), the first item of each chunk is a full keyframe so that
+    chunks can be decoded independently. When the memory budget is used
+    up, the oldest chunk is recycled.
+
+    Encoded item layout:
+
+    - 2 bytes flags:
+        - bits 0..6:    register N has changed
+        - bit 7:        explicit PC follows
+        - bit 8:        cycle count follows
+        - bits 9..11:   number of opcode bytes (0..4)
+        - bit 12:       cycle count is 4 bytes (block instructions
+                        executed in bulk may take more than 0xFFFF cycles)
+    - 2 bytes PC (if flag bit 7)
+    - 2 or 4 bytes cycle count (if flag bit 8)
+    - 0..4 opcode bytes
+    - 2 bytes per changed register
+
+    The tracer is fed by cpudbg::step(), which costs a single bool check
+    per instruction while tracing is disabled.
+*/
+#include "yakc/core/core.h"
+#include <stdio.h>
+
+namespace YAKC {
+
+class tracer {
+public:
+    /// number of recorded registers (Z80: AF,BC,DE,HL,IX,IY,SP, 6502: A,X,Y,S,P)
+    static const int num_regs = 7;
+    /// max number of opcode bytes per item
+    static const int max_op_bytes = 4;
+    /// size of a chunk in bytes
+    static const int chunk_size = 64 * 1024;
+    /// default memory budget
+    static const int default_budget = 16 * 1024 * 1024;
+
+    /// a decoded trace item
+    struct item {
+        uint16_t pc = 0;
+        uint32_t cycles = 0;
+        uint8_t num_op_bytes = 0;
+        uint8_t op_bytes[max_op_bytes] = { };
+        uint16_t regs[num_regs] = { };
+    };
+    /// callback for decode()
+    typedef void (*decode_cb)(uint64_t index, const item& item, void* userdata);
+
+    /// destructor
+    ~tracer();
+    /// start recording, existing trace data is discarded
+    void start(cpu_model cpu, int budget_bytes=default_budget);
+    /// stop recording, trace data is kept
+    void stop();
+    /// discard trace data and free memory
+    void reset();
+    /// record an item (called by cpudbg)
+    void record(const item& it);
+
+    /// number of items currently in the trace buffer
+    uint64_t num_items() const;
+    /// decode all items from oldest to newest
+    void decode(decode_cb cb, void* userdata) const;
+    /// save trace to binary file
+    bool save(const char* path) const;
+    /// load trace from binary file
+    bool load(const char* path);
+    /// write decoded trace as text
+    void dump(FILE* fp) const;
+
+    bool enabled = false;
+    cpu_model cpu = cpu_model::z80;
+    uint64_t num_recorded = 0;          // total number of recorded items
+    uint64_t num_dropped = 0;           // number of items dropped in recycled chunks
+
+private:
+    struct chunk_header {
+        uint64_t first_index;
+        uint32_t num_items;
+        uint32_t num_bytes;             // including header
+    };
+    /// max size of an encoded item in bytes
+    static const int max_item_size = 2 + 2 + 4 + max_op_bytes + num_regs*2;
+    /// begin a new chunk, recycle oldest if necessary
+    void new_chunk();
+    /// allocate chunk pointer array
+    void alloc_chunks(int num);
+    /// get chunk by age (0 is oldest)
+    uint8_t* chunk(int index) const;
+    /// decode a single chunk
+    static void decode_chunk(const uint8_t* chunk, decode_cb cb, void* userdata);
+    /// check that the items of a loaded chunk fit into its num_bytes
+    static bool validate_chunk(const uint8_t* chunk);
+
+    uint8_t** chunks = nullptr;
+    int max_chunks = 0;
+    int first_chunk = 0;
+    int num_chunks = 0;
+    uint8_t* cur_chunk = nullptr;
+    bool keyframe = true;
+    item prev;
+};
+
+} // namespace YAKC
@@ -95,7 +95,7 @@ z80::halt() {
 void
 z80::rst(ubyte vec) {
     SP -= 2;
-    mem.w16(SP, PC);
+    mem.w16io(SP, PC);
     WZ = PC = (uword) vec;
 }
 
@@ -123,13 +123,14 @@ z80::handle_irq(system_bus* bus) {
         if (this->IFF1) {
             this->IFF1 = this->IFF2 = false;
             this->int_active = false;
+            this->num_irqs++;
             if (0 == this->IM) {
                 // NOT IMPLEMENTED
             }
             else if (1 == this->IM) {
                 // this is an RST 38
                 SP -= 2;
-                mem.w16(SP, PC);
+                mem.w16io(SP, PC);
                 this->PC = 0x38;
                 tstates += 11;
                 if (bus) {
@@ -155,8 +156,8 @@ z80::handle_irq(system_bus* bus) {
                 }
                 uword addr = (this->I<<8)|(vec&0xFE);
                 this->SP -= 2;
-                this->mem.w16(this->SP, this->PC);
-                this->PC = this->mem.r16(addr);
+                this->mem.w16io(this->SP, this->PC);
+                this->PC = this->mem.r16io(addr);
                 tstates += 17;
             }
         }
@@ -169,7 +170,7 @@ z80::handle_irq(system_bus* bus) {
 void
 z80::reti() {
     // this is the same as RET
-    WZ = PC = mem.r16(SP);
+    WZ = PC = mem.r16io(SP);
     SP += 2;
     // ...notify daisy chain, if configured
     if (this->irq_device) {
@@ -196,6 +197,7 @@ z80::di() {
 //------------------------------------------------------------------------------
 ubyte
 z80::in(system_bus* bus, uword port) {
+    this->port_reads[uint8_t(port >> this->port_stats_shift)]++;
     if (bus) {
         return bus->cpu_in(port);
     }
@@ -207,6 +209,7 @@ z80::in(system_bus* bus, uword port) {
 //------------------------------------------------------------------------------
 void
 z80::out(system_bus* bus, uword port, ubyte val) {
+    this->port_writes[uint8_t(port >> this->port_stats_shift)]++;
     if (bus) {
         bus->cpu_out(port, val);
     }
@@ -224,8 +227,8 @@ z80::sziff2(ubyte val, bool iff2) {
 //------------------------------------------------------------------------------
 void
 z80::ldi() {
-    ubyte val = mem.r8(HL);
-    mem.w8(DE, val);
+    ubyte val = mem.r8io(HL);
+    mem.w8io(DE, val);
     val += A;
     ubyte f = F & (SF|ZF|CF);
     if (val & 0x02) f |= YF;
@@ -241,12 +244,12 @@ z80::ldi() {
 
 //------------------------------------------------------------------------------
 int
-z80::ldir() {
+z80::ldir(system_bus* bus) {
     ldi();
     if (BC != 0) {
         PC -= 2;
         WZ = PC + 1;
-        return 21;
+        return repeat_ld(bus, +1);
     }
     else {
         return 16;
@@ -256,8 +259,8 @@ z80::ldir() {
 //------------------------------------------------------------------------------
 void
 z80::ldd() {
-    ubyte val = mem.r8(HL);
-    mem.w8(DE, val);
+    ubyte val = mem.r8io(HL);
+    mem.w8io(DE, val);
     val += A;
     ubyte f = F & (SF|ZF|CF);
     if (val & 0x02) f |= YF;
@@ -273,12 +276,12 @@ z80::ldd() {
 
 //------------------------------------------------------------------------------
 int
-z80::lddr() {
+z80::lddr(system_bus* bus) {
     ldd();
     if (BC != 0) {
         PC -= 2;
         WZ = PC + 1;
-        return 21;
+        return repeat_ld(bus, -1);
     }
     else {
         return 16;
@@ -288,7 +291,7 @@ z80::lddr() {
 //------------------------------------------------------------------------------
 void
 z80::cpi() {
-    int r = int(A) - int(mem.r8(HL));
+    int r = int(A) - int(mem.r8io(HL));
     ubyte f = NF | (F & CF) | YAKC_SZ(r);
     if ((r & 0xF) > (A & 0xF)) {
         f |= HF;
@@ -307,12 +310,12 @@ z80::cpi() {
 
 //------------------------------------------------------------------------------
 int
-z80::cpir() {
+z80::cpir(system_bus* bus) {
     cpi();
     if ((BC != 0) && !(F & ZF)) {
         PC -= 2;
         WZ = PC + 1;
-        return 21;
+        return repeat_cp(bus, +1);
     }
     else {
         return 16;
@@ -322,7 +325,7 @@ z80::cpir() {
 //------------------------------------------------------------------------------
 void
 z80::cpd() {
-    int r = int(A) - int(mem.r8(HL));
+    int r = int(A) - int(mem.r8io(HL));
     ubyte f = NF | (F & CF) | YAKC_SZ(r);
     if ((r & 0xF) > (A & 0xF)) {
         f |= HF;
@@ -341,18 +344,235 @@ z80::cpd() {
 
 //------------------------------------------------------------------------------
 int
-z80::cpdr() {
+z80::cpdr(system_bus* bus) {
     cpd();
     if ((BC != 0) && !(F & ZF)) {
         PC -= 2;
         WZ = PC + 1;
-        return 21;
+        return repeat_cp(bus, -1);
     }
     else {
         return 16;
     }
 }
 
+//------------------------------------------------------------------------------
+static int
+page_run(uword addr, int dir, int num) {
+    // number of bytes from addr to the page boundary in direction dir, clamped to num
+    const int n = (dir > 0) ? (memory::page::size - (addr & memory::page::mask)) : ((addr & memory::page::mask) + 1);
+    return n < num ? n : num;
+}
+
+//------------------------------------------------------------------------------
+int
+z80::num_repeats(system_bus* bus) const {
+    // A repeating block instruction (PC points to its ED prefix) may
+    // run further iterations without returning from step() as long as the
+    // system doesn't need to be ticked in between, the bus returns the
+    // number of T-states until its next scheduled event. A pending
+    // interrupt request is handled after each iteration, and the
+    // instruction bytes must be in regular memory so that an overwritten
+    // instruction can be detected (this also excludes trapped pages,
+    // which includes all pages while a heatmap is running).
+    if (!bus || int_active) {
+        return 0;
+    }
+    const int budget = bus->cpu_block_budget();
+    if (budget < 42) {
+        return 0;
+    }
+    if (!mem.page_table[PC>>memory::page::shift].write_ptr ||
+        !mem.page_table[uword(PC+1)>>memory::page::shift].write_ptr)
+    {
+        return 0;
+    }
+    // the first iteration has already been executed (21 T-states)
+    const int num = (budget - 21) / 21;
+    return num < BC ? num : BC;
+}
+
+//------------------------------------------------------------------------------
+int
+z80::repeat_ld(system_bus* bus, int dir) {
+    // Continue an LDIR/LDDR after its first iteration, the result is identical
+    // with executing one iteration per step() (registers, flags, R and
+    // T-states), but memory is copied page-wise.
+    int cycles = 21;
+    const int num = this->num_repeats(bus);
+    if (0 == num) {
+        return cycles;
+    }
+    const uword op_addr = PC;
+    const ubyte op = (dir > 0) ? 0xB0 : 0xB8;
+    if ((mem.r8(op_addr) != 0xED) || (mem.r8(op_addr + 1) != op)) {
+        // the first iteration has overwritten the instruction
+        return cycles;
+    }
+    // host addresses of the instruction bytes
+    const ubyte* op_ptr[2] = {
+        mem.read_ptr(op_addr) + (op_addr & memory::page::mask),
+        mem.read_ptr(op_addr + 1) + (uword(op_addr + 1) & memory::page::mask)
+    };
+    ubyte val = 0;
+    int done = 0;
+    while (done < num) {
+        int n = page_run(HL, dir, num - done);
+        n = page_run(DE, dir, n);
+        const auto& src_page = mem.page_table[HL>>memory::page::shift];
+        const auto& dst_page = mem.page_table[DE>>memory::page::shift];
+        if (src_page.write_ptr && dst_page.write_ptr) {
+            const ubyte* src = src_page.read_ptr + HL;
+            ubyte* dst = dst_page.write_ptr + DE;
+            // stop right after the instruction itself has been overwritten
+            for (int i = 0; i < 2; i++) {
+                const intptr_t offset = (dir > 0) ? (op_ptr[i] - dst) : (dst - op_ptr[i]);
+                if ((offset >= 0) && (offset < n)) {
+                    n = int(offset) + 1;
+                }
+            }
+            if (dir > 0) {
+                if ((dst <= src) || (dst >= src + n)) {
+                    memmove(dst, src, n);
+                }
+                else {
+                    // overlapping ranges repeat a pattern, copy byte by byte
+                    for (int i = 0; i < n; i++) {
+                        dst[i] = src[i];
+                    }
+                }
+            }
+            else {
+                if ((dst >= src) || (dst <= src - n)) {
+                    memmove(dst - n + 1, src - n + 1, n);
+                }
+                else {
+                    for (int i = 0; i < n; i++) {
+                        dst[-i] = src[-i];
+                    }
+                }
+            }
+            val = dst[(n - 1) * dir];
+            mem.mark_dirty((dir > 0) ? DE : uword(DE - n + 1), n);
+        }
+        else {
+            // memory-mapped-io or trapped page, one iteration
+            n = 1;
+            val = mem.r8io(HL);
+            mem.w8io(DE, val);
+        }
+        HL += n * dir;
+        DE += n * dir;
+        BC -= n;
+        R = (R&0x80) | ((R + 2*n)&0x7F);
+        done += n;
+        if (0 == BC) {
+            cycles += 21*(n-1) + 16;
+            break;
+        }
+        cycles += 21*n;
+        if (int_active ||
+            !mem.page_table[op_addr>>memory::page::shift].write_ptr ||
+            !mem.page_table[uword(op_addr+1)>>memory::page::shift].write_ptr ||
+            (mem.r8(op_addr) != 0xED) || (mem.r8(op_addr+1) != op))
+        {
+            break;
+        }
+    }
+    // each iteration counts as an executed instruction
+    num_ops += done;
+    // flags only depend on the last iteration
+    ubyte f = F & (SF|ZF|CF);
+    val += A;
+    if (val & 0x02) f |= YF;
+    if (val & 0x08) f |= XF;
+    if (BC) {
+        f |= VF;
+    }
+    else {
+        PC = op_addr + 2;
+    }
+    F = f;
+    return cycles;
+}
+
+//------------------------------------------------------------------------------
+int
+z80::repeat_cp(system_bus* bus, int dir) {
+    // Continue a CPIR/CPDR after its first iteration, see repeat_ld()
+    int cycles = 21;
+    const int num = this->num_repeats(bus);
+    if (0 == num) {
+        return cycles;
+    }
+    const uword op_addr = PC;
+    ubyte val = 0;
+    bool found = false;
+    int done = 0;
+    while (done < num) {
+        int n = page_run(HL, dir, num - done);
+        const auto& page = mem.page_table[HL>>memory::page::shift];
+        if (page.write_ptr) {
+            const ubyte* src = page.read_ptr + HL;
+            if (dir > 0) {
+                const ubyte* p = (const ubyte*) memchr(src, A, n);
+                if (p) {
+                    n = int(p - src) + 1;
+                    found = true;
+                }
+            }
+            else {
+                for (int i = 0; i < n; i++) {
+                    if (src[-i] == A) {
+                        n = i + 1;
+                        found = true;
+                        break;
+                    }
+                }
+            }
+            val = src[(n - 1) * dir];
+        }
+        else {
+            // memory-mapped-io or trapped page, one iteration
+            n = 1;
+            val = mem.r8io(HL);
+            found = (val == A);
+        }
+        HL += n * dir;
+        BC -= n;
+        R = (R&0x80) | ((R + 2*n)&0x7F);
+        done += n;
+        if (found || (0 == BC)) {
+            cycles += 21*(n-1) + 16;
+            break;
+        }
+        cycles += 21*n;
+        if (int_active) {
+            break;
+        }
+    }
+    num_ops += done;
+    // flags only depend on the last iteration
+    int r = int(A) - int(val);
+    ubyte f = NF | (F & CF) | YAKC_SZ(r);
+    if ((r & 0xF) > (A & 0xF)) {
+        f |= HF;
+        r--;
+    }
+    if (r & 0x02) f |= YF;
+    if (r & 0x08) f |= XF;
+    if (BC) {
+        f |= VF;
+    }
+    F = f;
+    if (found || (0 == BC)) {
+        // the last iteration didn't repeat
+        PC = op_addr + 2;
+        WZ = op_addr + 1 + dir;
+    }
+    return cycles;
+}
+
 //------------------------------------------------------------------------------
 ubyte
 z80::ini_ind_flags(ubyte io_val, int c_add) {
@@ -373,7 +593,7 @@ z80::ini(system_bus* bus) {
     ubyte io_val = in(bus, BC);
     WZ = BC + 1;
     B--;
-    mem.w8(HL++, io_val);
+    mem.w8io(HL++, io_val);
     F = ini_ind_flags(io_val, +1);
 }
 
@@ -396,7 +616,7 @@ z80::ind(system_bus* bus) {
     ubyte io_val = in(bus, BC);
     WZ = BC - 1;
     B--;
-    mem.w8(HL--, io_val);
+    mem.w8io(HL--, io_val);
     F = ini_ind_flags(io_val, -1);
 }
 
@@ -430,7 +650,7 @@ z80::outi_outd_flags(ubyte io_val) {
 //------------------------------------------------------------------------------
 void
 z80::outi(system_bus* bus) {
-    ubyte io_val = mem.r8(HL++);
+    ubyte io_val = mem.r8io(HL++);
     B--;
     WZ = BC + 1;
     out(bus, BC, io_val);
@@ -453,7 +673,7 @@ z80::otir(system_bus* bus) {
 //------------------------------------------------------------------------------
 void
 z80::outd(system_bus* bus) {
-    ubyte io_val = mem.r8(HL--);
+    ubyte io_val = mem.r8io(HL--);
     B--;
     WZ = BC - 1;
     out(bus, BC, io_val);
@@ -505,11 +725,11 @@ z80::daa() {
 void
 z80::rld() {
     WZ = HL;
-    ubyte x = mem.r8(WZ++);
+    ubyte x = mem.r8io(WZ++);
     ubyte tmp = A & 0xF;              // store A low nibble
     A = (A & 0xF0) | (x>>4);    // move (HL) high nibble into A low nibble
     x = (x<<4) | tmp;   // move (HL) low to high nibble, move A low nibble to (HL) low nibble
-    mem.w8(HL, x);
+    mem.w8io(HL, x);
     F = szp[A] | (F & CF);
 }
 
@@ -517,11 +737,11 @@ z80::rld() {
 void
 z80::rrd() {
     WZ = HL;
-    ubyte x = mem.r8(WZ++);
+    ubyte x = mem.r8io(WZ++);
     ubyte tmp = A & 0xF;                  // store A low nibble
     A = (A & 0xF0) | (x & 0x0F);    // move (HL) low nibble to A low nibble
     x = (x >> 4) | (tmp << 4);  // move A low nibble to (HL) high nibble, and (HL) high nibble to (HL) low nibble
-    mem.w8(HL, x);
+    mem.w8io(HL, x);
     F = szp[A] | (F & CF);
 }
 
@@ -83,6 +83,13 @@ public:
     /// break on invalid opcode?
     bool break_on_invalid_opcode;
 
+    /// statistics counters (see stats.h), not reset by reset()
+    uint64_t num_ops = 0;                   // executed instructions
+    uint64_t num_irqs = 0;                  // accepted interrupt requests
+    uint64_t port_reads[256] = { };         // IN accesses by port byte
+    uint64_t port_writes[256] = { };        // OUT accesses by port byte
+    int port_stats_shift = 0;               // 0: count by low port byte, 8: by high byte
+
     /// constructor
     z80();
 
@@ -155,19 +162,25 @@ public:
     /// implement the LDI instruction
     void ldi();
     /// implement the LDIR instruction, return number of T-states
-    int ldir();
+    int ldir(system_bus* bus);
     /// implement the LDD instruction
     void ldd();
     /// implement the LDDR instruction, return number of T-states
-    int lddr();
+    int lddr(system_bus* bus);
     /// implement the CPI instruction
     void cpi();
     /// implement the CPIR instruction, return number of T-states
-    int cpir();
+    int cpir(system_bus* bus);
     /// implement the CPD instruction
     void cpd();
     /// implement the CPDR instruction, return number of T-states
-    int cpdr();
+    int cpdr(system_bus* bus);
+    /// number of further block instruction iterations which fit into the bus' block budget
+    int num_repeats(system_bus* bus) const;
+    /// run further LDIR/LDDR iterations in bulk, return number of T-states
+    int repeat_ld(system_bus* bus, int dir);
+    /// run further CPIR/CPDR iterations in bulk, return number of T-states
+    int repeat_cp(system_bus* bus, int dir);
     /// return flags for ini/ind instruction
     ubyte ini_ind_flags(ubyte io_val, int c_add);
     /// implement the INI instruction
@@ -225,10 +238,14 @@ public:
 
     /// fetch an opcode byte and increment R register
     ubyte fetch_op();
+    /// same as fetch_op(), with memory-mapped-io support
+    ubyte fetch_op_io();
     /// execute a single instruction, return number of cycles
     uint32_t step(system_bus* bus);
     /// top-level opcode decoder (generated)
     uint32_t do_op(system_bus* bus);
+    /// same as do_op(), but with memory-mapped-io support, used when memory traps are installed
+    uint32_t do_op_trap(system_bus* bus);
 };
 
 #define YAKC_SZ(val) ((val&0xFF)?(val&SF):ZF)
@@ -499,15 +516,28 @@ z80::fetch_op() {
     return mem.r8(PC++);
 }
 
+//------------------------------------------------------------------------------
+inline ubyte
+z80::fetch_op_io() {
+    R = (R&0x80) | ((R+1)&0x7F);
+    return mem.r8io(PC++);
+}
+
 //------------------------------------------------------------------------------
 inline uint32_t
 z80::step(system_bus* bus) {
     INV = false;
+    num_ops++;
     if (int_enable) {
         IFF1 = IFF2 = true;
         int_enable = false;
     }
-    return do_op(bus);
+    if (mem.trapped_pages) {
+        return do_op_trap(bus);
+    }
+    else {
+        return do_op(bus);
+    }
 }
 
 } // namespace YAKC
@@ -9,7 +9,7 @@
 #-------------------------------------------------------------------------------
 
 # fips code generator version stamp
-Version = 3 
+Version = 5 
 
 # tab-width for generated code
 TabWidth = 2
@@ -54,6 +54,7 @@ rot = [ 'rlc8', 'rrc8', 'rl8', 'rr8', 'sla8', 'sra8', 'sll8', 'srl8' ]
 rot_cmt = [ 'RLC', 'RRC', 'RL', 'RR', 'SLA', 'SRA', 'SLL', 'SRL' ]
 
 import sys
+import io
 import genutil  # fips code generator helpers
 
 # an 'opcode' wraps the instruction byte, human-readable asm mnemonics,
@@ -330,14 +331,14 @@ def enc_ed_op(op) :
                 [ 
                     [ 'LDI',    'ldi(); return 16;' ],
                     [ 'LDD',    'ldd(); return 16;' ],
-                    [ 'LDIR',   'return ldir();' ],
-                    [ 'LDDR',   'return lddr();' ]
+                    [ 'LDIR',   'return ldir(bus);' ],
+                    [ 'LDDR',   'return lddr(bus);' ]
                 ],
                 [
                     [ 'CPI',    'cpi(); return 16;' ],
                     [ 'CPD',    'cpd(); return 16;' ],
-                    [ 'CPIR',   'return cpir();' ],
-                    [ 'CPDR',   'return cpdr();' ]
+                    [ 'CPIR',   'return cpir(bus);' ],
+                    [ 'CPDR',   'return cpdr(bus);' ]
                 ],
                 [
                     [ 'INI',    'ini(bus); return 16;' ],
@@ -530,7 +531,6 @@ def write_header() :
     l('// machine generated, do not edit!')
     l('#include "z80.h"')
     l('namespace YAKC {')
-    l('uint32_t z80::do_op(system_bus* bus) {')
 
 #-------------------------------------------------------------------------------
 # begin a new instruction group (begins a switch statement)
@@ -571,11 +571,27 @@ def write_end_group(indent, inv_op_bytes, ext_byte=None, read_offset=False) :
     indent -= 1
     return indent
 
+#-------------------------------------------------------------------------------
+# write a decoder function with the given name and body
+#
+def write_func(name, body) :
+    l('uint32_t z80::{}(system_bus* bus) {{'.format(name))
+    Out.write(body)
+    l('}')
+
+#-------------------------------------------------------------------------------
+# patch a decoder body to use the memory-mapped-io aware memory
+# accessors, this is used while debugger traps are installed
+#
+def trap_body(body) :
+    for acc in [ 'r8', 'rs8', 'w8', 'r16', 'w16' ] :
+        body = body.replace('mem.{}('.format(acc), 'mem.{}io('.format(acc))
+    return body.replace('fetch_op()', 'fetch_op_io()')
+
 #-------------------------------------------------------------------------------
 # write source footer
 #
 def write_footer() :
-    l('}')
     l('} // namespace YAKC');
 
 #-------------------------------------------------------------------------------
@@ -585,10 +601,8 @@ def write_footer() :
 def do_it(f) :
 
     global Out
-    Out = f
+    Out = io.StringIO()
 
-    write_header()
-    
     # loop over all instruction bytes
     indent = write_begin_group(0)
     for i in range(0, 256) :
@@ -623,6 +637,13 @@ def do_it(f) :
         else:
             write_op(indent, enc_op(i, 0, False))
     write_end_group(indent, 1)
+    body = Out.getvalue()
+
+    # write the regular and the trapping decoder function
+    Out = f
+    write_header()
+    write_func('do_op', body)
+    write_func('do_op_trap', trap_body(body))
     write_footer()
 
 #-------------------------------------------------------------------------------
@@ -13,6 +13,8 @@ z80ctc::init(int id_) {
     for (auto& chn : channels) {
         chn = channel_state();
     }
+    this->synced_tick = this->cur_tick;
+    this->update_next_event();
 }
 
 //------------------------------------------------------------------------------
@@ -34,6 +36,8 @@ z80ctc::reset() {
         chn.down_counter = 0;
         chn.waiting_for_trigger = false;
     }
+    this->synced_tick = this->cur_tick;
+    this->update_next_event();
 }
 
 //------------------------------------------------------------------------------
@@ -41,6 +45,7 @@ void
 z80ctc::write(system_bus* bus, channel c, uint8_t v) {
     YAKC_ASSERT((c >= 0) && (c<num_channels));
 
+    this->update(bus);
     channel_state& chn = channels[c];
     if (chn.mode & CONSTANT_FOLLOWS) {
         // time constant value following a control word
@@ -73,6 +78,7 @@ z80ctc::write(system_bus* bus, channel c, uint8_t v) {
             }
         }
     }
+    this->update_next_event();
 }
 
 //------------------------------------------------------------------------------
@@ -81,6 +87,11 @@ z80ctc::read(channel c) {
     YAKC_ASSERT((c >= 0) && (c<num_channels));
     const channel_state& chn = channels[c];
     int val = chn.down_counter;
+    if (timer_running(chn)) {
+        // the next event hasn't been reached yet, so the counter
+        // can't have crossed zero since the last update
+        val -= int(this->cur_tick - this->synced_tick);
+    }
     if ((chn.mode & MODE) == MODE_TIMER) {
         val /= ((chn.mode & PRESCALER) == PRESCALER_256) ? 256 : 16;
     }
@@ -97,13 +108,40 @@ z80ctc::down_counter_init(const channel_state& chn) const {
     return c;
 }
 
+//------------------------------------------------------------------------------
+bool
+z80ctc::timer_running(const channel_state& chn) {
+    return (0 == (chn.mode & (RESET|CONSTANT_FOLLOWS))) &&
+           ((chn.mode & MODE) == MODE_TIMER) &&
+           !chn.waiting_for_trigger;
+}
+
+//------------------------------------------------------------------------------
+void
+z80ctc::update_next_event() {
+    // a timer reaches zero when its down-counter drops below 0
+    this->next_event_tick = ~uint64_t(0);
+    for (const auto& chn : this->channels) {
+        if (timer_running(chn)) {
+            const uint64_t tick = this->synced_tick + chn.down_counter + 1;
+            if (tick < this->next_event_tick) {
+                this->next_event_tick = tick;
+            }
+        }
+    }
+}
+
 //------------------------------------------------------------------------------
 void
-z80ctc::step(system_bus* bus, int ticks) {
-    for (int c = 0; c < num_channels; c++) {
-        channel_state& chn = channels[c];
-        if (0 == (chn.mode & (RESET|CONSTANT_FOLLOWS))) {
-            if (((chn.mode & MODE) == MODE_TIMER) && !chn.waiting_for_trigger) {
+z80ctc::update(system_bus* bus) {
+    // NOTE: the zero-count callback may trigger another channel, which
+    // calls update() recursively, this finds nothing left to do
+    const int ticks = int(this->cur_tick - this->synced_tick);
+    this->synced_tick = this->cur_tick;
+    if (ticks > 0) {
+        for (int c = 0; c < num_channels; c++) {
+            channel_state& chn = channels[c];
+            if (timer_running(chn)) {
                 chn.down_counter -= ticks;
                 while (chn.down_counter < 0) {
                     down_counter_callback(bus, c);
@@ -112,6 +150,17 @@ z80ctc::step(system_bus* bus, int ticks) {
             }
         }
     }
+    this->update_next_event();
+}
+
+//------------------------------------------------------------------------------
+int
+z80ctc::ticks_until_event(int max_ticks) const {
+    if (this->next_event_tick <= this->cur_tick) {
+        return 0;
+    }
+    const uint64_t ticks = this->next_event_tick - this->cur_tick - 1;
+    return ticks < uint64_t(max_ticks) ? int(ticks) : max_ticks;
 }
 
 //------------------------------------------------------------------------------
@@ -145,7 +194,9 @@ z80ctc::down_counter_callback(system_bus* bus, int chn_index) {
 void
 z80ctc::ctrg(system_bus* bus, channel c) {
     YAKC_ASSERT(bus);
+    this->update(bus);
     this->update_counter(bus, c);
+    this->update_next_event();
 }
 
 } // namespace YAKC
@@ -7,6 +7,15 @@
     CTC channels 0 and 1 seem to be triggered per video scanline,
     and channels 2 and 3 once per vertical refresh @50Hz 
     (see here: https://github.com/mamedev/mame/blob/dfa148ff8022e9f1a544c8603dd0e8c4aa469c1e/src/mame/machine/kc.cpp#L710)
+
+    The timer channels are not counted down on every step(), instead
+    the CTC computes the tick where the next running timer reaches zero,
+    and only updates the down-counters when this tick is reached, or
+    when a channel is written or triggered. Reading a channel derives
+    the current counter value on demand. The system should call update()
+    at the end of its step() function, so that the down_counter values
+    are current for the debugger UI and snapshots, and after a snapshot
+    has been applied.
 */
 #include "yakc/core/core.h"
 #include "yakc/chips/z80.h"
@@ -76,8 +85,12 @@ public:
 
     /// reset the ctc
     void reset();
-    /// update the CTC for a number of ticks, a tick is equal to a Z80 T-cycle
+    /// advance the CTC by a number of ticks, a tick is equal to a Z80 T-cycle
     void step(system_bus* bus, int ticks);
+    /// bring the down-counters up to date, and recompute the next event tick
+    void update(system_bus* bus);
+    /// number of ticks which can be stepped until a timer reaches zero (max_ticks if no timer is running)
+    int ticks_until_event(int max_ticks) const;
 
     /// trigger one of the CTC channel lines
     void ctrg(system_bus* bus, channel c);
@@ -87,7 +100,18 @@ public:
     /// read value from channel
     uint8_t read(channel c);
 
+    /// the current tick, advanced by step()
+    uint64_t cur_tick = 0;
+    /// the tick the channel down-counters have been updated to
+    uint64_t synced_tick = 0;
+    /// the tick where the next running timer reaches zero
+    uint64_t next_event_tick = ~uint64_t(0);
+
 private:
+    /// test if a channel is a running timer
+    static bool timer_running(const channel_state& chn);
+    /// compute next_event_tick from the running timers
+    void update_next_event();
     /// get the counter/timer cycle count (prescaler * constant)
     int down_counter_init(const channel_state& chn) const;
     /// execute actions when down_counter reaches zero
@@ -98,5 +122,14 @@ private:
     int id = 0;
 };
 
+//------------------------------------------------------------------------------
+inline void
+z80ctc::step(system_bus* bus, int ticks) {
+    this->cur_tick += ticks;
+    if (this->cur_tick >= this->next_event_tick) {
+        this->update(bus);
+    }
+}
+
 } // namespace YAKC
     
@@ -550,4 +550,56 @@ int z80disasm(fetch_func fetch, unsigned short pc, char* buffer, void* userdata)
     return pos | s_flags[d->mnemonic] | DASMFLAG_SUPPORTED;
 }
 
+/****************************************************************************
+ * YAKC: instruction length without disassembling, the number of argument
+ * bytes per opcode is computed once from the mnemonic tables
+ ****************************************************************************/
+static UINT8 num_arg_bytes(const z80dasm& d)
+{
+    UINT8 num = 0;
+    for (const char* src = d.arguments; src && *src; src++)
+    {
+        switch (*src)
+        {
+            case 'A': case 'N': case 'W': num += 2; break;
+            case 'B': case 'O': case 'P': case 'X': num += 1; break;
+            default: break;
+        }
+    }
+    return num;
+}
+
+struct arg_bytes_tables
+{
+    UINT8 main[256];
+    UINT8 ed[256];
+    UINT8 xx[256];
+    arg_bytes_tables()
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            main[i] = num_arg_bytes(mnemonic_main[i]);
+            ed[i] = num_arg_bytes(mnemonic_ed[i]);
+            xx[i] = num_arg_bytes(mnemonic_xx[i]);
+        }
+    }
+};
+
+int z80oplength(const unsigned char* bytes)
+{
+    static const arg_bytes_tables args;
+    switch (bytes[0])
+    {
+        case 0xcb:
+            return 2;
+        case 0xed:
+            return 2 + args.ed[bytes[1]];
+        case 0xdd:
+        case 0xfd:
+            return (bytes[1] == 0xcb) ? 4 : 2 + args.xx[bytes[1]];
+        default:
+            return 1 + args.main[bytes[0]];
+    }
+}
+
 } // namespace z80dasm
@@ -8,4 +8,6 @@
 namespace z80dasm {
 typedef unsigned char (*fetch_func)(unsigned short base, int offset, void* userdata);
 extern int z80disasm(fetch_func fetch, unsigned short pc, char* buffer, void* userdata);
+/// length of the instruction starting at bytes (reads up to 2 bytes), same as z80disasm() without disassembling
+extern int z80oplength(const unsigned char* bytes);
 }
@@ -6,10 +6,77 @@
 
 namespace YAKC {
 
+//------------------------------------------------------------------------------
+static int
+first_set_bit(uint32_t val) {
+    #if _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, val);
+    return int(index);
+    #else
+    return __builtin_ctz(val);
+    #endif
+}
+
 //------------------------------------------------------------------------------
 void
 z80int::connect_irq_device(z80int* device) {
+    z80int* old_device = this->downstream_device;
     this->downstream_device = device;
+    if (device) {
+        device->upstream_device = this;
+    }
+    if (old_device && (old_device != device)) {
+        // the old downstream devices are now their own chain
+        if (old_device->upstream_device == this) {
+            old_device->upstream_device = nullptr;
+        }
+        old_device->flatten();
+    }
+    this->flatten();
+}
+
+//------------------------------------------------------------------------------
+void
+z80int::flatten() {
+    z80int* h = this;
+    while (h->upstream_device && (h->upstream_device->downstream_device == h)) {
+        h = h->upstream_device;
+    }
+    h->chain_size = 0;
+    h->requested_mask = 0;
+    h->pending_mask = 0;
+    for (z80int* dev = h; dev; dev = dev->downstream_device) {
+        YAKC_ASSERT(h->chain_size < max_chain_devices);
+        dev->chain_head = h;
+        dev->chain_index = h->chain_size;
+        h->chain[h->chain_size++] = dev;
+        if (dev->int_requested) {
+            h->requested_mask |= 1<<dev->chain_index;
+        }
+        if (dev->int_pending) {
+            h->pending_mask |= 1<<dev->chain_index;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+z80int::update_chain_state() {
+    z80int* h = this->head();
+    const uint32_t bit = 1<<this->chain_index;
+    if (this->int_requested) {
+        h->requested_mask |= bit;
+    }
+    else {
+        h->requested_mask &= ~bit;
+    }
+    if (this->int_pending) {
+        h->pending_mask |= bit;
+    }
+    else {
+        h->pending_mask &= ~bit;
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -19,6 +86,7 @@ z80int::reset() {
     this->int_requested = false;
     this->int_request_data = 0;
     this->int_pending = false;
+    this->update_chain_state();
 }
 
 //------------------------------------------------------------------------------
@@ -37,8 +105,10 @@ z80int::request_interrupt(system_bus* bus, uint8_t data) {
         }
         this->int_requested = true;
         this->int_request_data = data;
-        if (this->downstream_device) {
-            this->downstream_device->disable_interrupt();
+        z80int* h = this->head();
+        h->requested_mask |= 1<<this->chain_index;
+        for (int i = this->chain_index + 1; i < h->chain_size; i++) {
+            h->chain[i]->int_enabled = false;
         }
         return true;
     }
@@ -50,23 +120,23 @@ z80int::request_interrupt(system_bus* bus, uint8_t data) {
 //------------------------------------------------------------------------------
 uint8_t
 z80int::interrupt_acknowledged() {
-    if (this->int_requested) {
-        // it's our turn, return the interrupt-request data byte,
-        // downstream interrupts remain disabled until RETI
-        this->int_requested = false;
-        this->int_pending = true;
-        return this->int_request_data;
+    // the first requesting device at or downstream of us gets the
+    // acknowledge, downstream interrupts remain disabled until RETI
+    z80int* h = this->head();
+    const uint32_t mask = h->requested_mask & ~((1<<this->chain_index)-1);
+    if (mask) {
+        const int i = first_set_bit(mask);
+        z80int* dev = h->chain[i];
+        dev->int_requested = false;
+        dev->int_pending = true;
+        h->requested_mask &= ~(1<<i);
+        h->pending_mask |= 1<<i;
+        return dev->int_request_data;
     }
     else {
-        // we didn't request the interrupt, pass the ack downstream
-        if (this->downstream_device) {
-            return this->downstream_device->interrupt_acknowledged();
-        }
-        else {
-            // hmm this shouldn't happen...
-            YAKC_ASSERT(false);
-            return 0;
-        }
+        // hmm this shouldn't happen...
+        YAKC_ASSERT(false);
+        return 0;
     }
 }
 
@@ -96,19 +166,20 @@ z80int::interrupt_cancelled() {
 //------------------------------------------------------------------------------
 void
 z80int::reti() {
-    this->int_enabled = true;
-    if (this->int_pending) {
-        // this was our interrupt service routine that has finished,
-        // enable interrupt on downstream device
-        this->int_pending = false;
-        if (this->downstream_device) {
-            this->downstream_device->enable_interrupt();
-        }
+    // the RETI passes downstream until it reaches the device which is
+    // under service, which then enables interrupts on its downstream
+    // devices, all devices passed on the way are enabled
+    z80int* h = this->head();
+    const uint32_t mask = h->pending_mask & ~((1<<this->chain_index)-1);
+    const int last = mask ? first_set_bit(mask) : h->chain_size - 1;
+    for (int i = this->chain_index; i <= last; i++) {
+        h->chain[i]->int_enabled = true;
     }
-    else {
-        // we're not services, pass the reti on downstream
-        if (this->downstream_device) {
-            this->downstream_device->reti();
+    if (mask) {
+        h->chain[last]->int_pending = false;
+        h->pending_mask &= ~(1<<last);
+        if ((last + 1) < h->chain_size) {
+            h->chain[last + 1]->enable_interrupt();
         }
     }
 }
@@ -116,21 +187,23 @@ z80int::reti() {
 //------------------------------------------------------------------------------
 void
 z80int::enable_interrupt() {
-    this->int_enabled = true;
-    // interrupt-enable only propagates downstream if we're
-    // currently not under service by the CPU
-    if (!this->int_pending && this->downstream_device) {
-        this->downstream_device->enable_interrupt();
+    // interrupt-enable only propagates downstream up to the first
+    // device which is currently under service by the CPU
+    z80int* h = this->head();
+    const uint32_t mask = h->pending_mask & ~((1<<this->chain_index)-1);
+    const int last = mask ? first_set_bit(mask) : h->chain_size - 1;
+    for (int i = this->chain_index; i <= last; i++) {
+        h->chain[i]->int_enabled = true;
     }
 }
 
 //------------------------------------------------------------------------------
 void
 z80int::disable_interrupt() {
-    this->int_enabled = false;
     // disable-interrupt always propagates to downstream-devices
-    if (this->downstream_device) {
-        this->downstream_device->disable_interrupt();
+    z80int* h = this->head();
+    for (int i = this->chain_index; i < h->chain_size; i++) {
+        h->chain[i]->int_enabled = false;
     }
 }
 
@@ -12,6 +12,15 @@
     Each chip that can generate interrupt requests has an z80int object 
     embedded which implements the daisy-chain protocol to prioritize
     interrupt requests.
+
+    When devices are connected, the chain is flattened into a priority
+    array owned by the highest-priority device (the chain head), together
+    with bit masks of the devices which are requesting an interrupt or
+    are under service by the CPU. This way acknowledging an interrupt
+    and handling a RETI don't need to walk the chain recursively.
+    If the int_requested or int_pending flags are changed from the
+    outside (for instance when loading a snapshot), update_chain_state()
+    must be called afterwards.
 */
 #include "yakc/core/core.h"
 
@@ -20,8 +29,13 @@ namespace YAKC {
 class system_bus;
 class z80int {
 public:
+    /// max number of devices in a daisy chain
+    static const int max_chain_devices = 16;
+
     /// connect to downstream (lower-pri) device in daisy chain
     void connect_irq_device(z80int* downstream_device);
+    /// update the chain's request/service bit masks from int_requested and int_pending
+    void update_chain_state();
 
     /// reset our state
     void reset();
@@ -51,7 +65,34 @@ public:
     bool int_pending = false;
 
 private:
+    /// flatten the daisy chain this device belongs to
+    void flatten();
+    /// get the chain head, flatten the chain first if needed
+    z80int* head();
+
     z80int* downstream_device = nullptr;
+    z80int* upstream_device = nullptr;
+    /// the head of the flattened chain (nullptr if not flattened yet)
+    z80int* chain_head = nullptr;
+    /// priority of this device in the chain (0 is highest)
+    int chain_index = 0;
+
+    /// the following are only valid in the chain head
+    int chain_size = 0;
+    z80int* chain[max_chain_devices] = { };
+    /// bit mask of devices which are requesting an interrupt
+    uint32_t requested_mask = 0;
+    /// bit mask of devices which are under service by the CPU
+    uint32_t pending_mask = 0;
 };
 
+//------------------------------------------------------------------------------
+inline z80int*
+z80int::head() {
+    if (!this->chain_head) {
+        this->flatten();
+    }
+    return this->chain_head;
+}
+
 } // namespace YAKC
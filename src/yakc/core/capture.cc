@@ -0,0 +1,353 @@
+//------------------------------------------------------------------------------
+//  capture.cc
+//------------------------------------------------------------------------------
+#include "capture.h"
+#if YAKC_CAPTURE_THREAD
+#include <chrono>
+#endif
+
+namespace YAKC {
+
+//------------------------------------------------------------------------------
+capture::~capture() {
+    this->stop();
+}
+
+//------------------------------------------------------------------------------
+bool
+capture::start(const char* video_path, const char* audio_path, video_format fmt, int fps_) {
+    YAKC_ASSERT(!this->active);
+    YAKC_ASSERT(fps_ > 0);
+    YAKC_ASSERT(video_path || audio_path);
+    if (video_path) {
+        this->video_file = fopen(video_path, "wb");
+        if (!this->video_file) {
+            return false;
+        }
+    }
+    if (audio_path) {
+        this->audio_file = fopen(audio_path, "wb");
+        if (!this->audio_file) {
+            if (this->video_file) {
+                fclose(this->video_file);
+                this->video_file = nullptr;
+            }
+            return false;
+        }
+        // placeholder header, patched in stop()
+        this->write_wav_header(0);
+    }
+    this->format = fmt;
+    this->fps = fps_;
+    this->frame_width = 0;
+    this->frame_height = 0;
+    this->frames_written = 0;
+    this->frames_dropped = 0;
+    this->frames_resized = 0;
+    this->samples_written = 0;
+    this->samples_dropped = 0;
+    this->frame_head = 0;
+    this->frame_tail = 0;
+    this->audio_head = 0;
+    this->audio_tail = 0;
+    this->audio_fill = 0;
+    const int max_frame_size = global_max_fb_width * global_max_fb_height;
+    if (this->video_file) {
+        for (auto& slot : this->frames) {
+            slot.width = slot.height = 0;
+            slot.pixels = (uint32_t*) YAKC_MALLOC(max_frame_size * sizeof(uint32_t));
+        }
+        if (video_format::y4m == fmt) {
+            this->line_buffer = (uint8_t*) YAKC_MALLOC(max_frame_size * 3);
+        }
+    }
+    if (this->audio_file) {
+        this->audio = (audio_slot*) YAKC_MALLOC(num_audio_slots * sizeof(audio_slot));
+    }
+    this->active = true;
+    #if YAKC_CAPTURE_THREAD
+    this->quit = false;
+    this->writer = std::thread(&capture::writer_loop, this);
+    #endif
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+capture::stop() {
+    if (!this->active) {
+        return;
+    }
+    this->active = false;
+
+    // publish partially filled audio block
+    if (this->audio_file && (this->audio_fill > 0)) {
+        if ((this->audio_head - this->audio_tail) < num_audio_slots) {
+            this->audio[this->audio_head % num_audio_slots].num_samples = this->audio_fill;
+            this->audio_head++;
+        }
+        else {
+            this->samples_dropped += this->audio_fill;
+        }
+        this->audio_fill = 0;
+    }
+
+    #if YAKC_CAPTURE_THREAD
+    // let the writer thread drain the queues and exit
+    this->quit = true;
+    this->wakeup.notify_one();
+    this->writer.join();
+    #else
+    this->drain();
+    #endif
+
+    if (this->video_file) {
+        fclose(this->video_file);
+        this->video_file = nullptr;
+        for (auto& slot : this->frames) {
+            YAKC_FREE(slot.pixels);
+            slot.pixels = nullptr;
+        }
+        if (this->line_buffer) {
+            YAKC_FREE(this->line_buffer);
+            this->line_buffer = nullptr;
+        }
+    }
+    if (this->audio_file) {
+        this->write_wav_header(this->samples_written);
+        fclose(this->audio_file);
+        this->audio_file = nullptr;
+        YAKC_FREE(this->audio);
+        this->audio = nullptr;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+capture::is_active() const {
+    return this->active;
+}
+
+//------------------------------------------------------------------------------
+void
+capture::push_frame(const void* pixels, int width, int height) {
+    if (!this->active || !this->video_file || !pixels) {
+        return;
+    }
+    YAKC_ASSERT((width <= global_max_fb_width) && (height <= global_max_fb_height));
+    if (0 == this->frame_width) {
+        // first frame defines the video size
+        this->frame_width = width;
+        this->frame_height = height;
+    }
+    const uint32_t head = this->frame_head;
+    while (this->blocking && ((head - this->frame_tail) >= num_frame_slots)) {
+        this->wait_writer();
+    }
+    if ((head - this->frame_tail) >= num_frame_slots) {
+        // writer thread too slow
+        this->frames_dropped++;
+        return;
+    }
+    this->copy_frame(this->frames[head % num_frame_slots], pixels, width, height);
+    this->frame_head = head + 1;
+    #if YAKC_CAPTURE_THREAD
+    this->wakeup.notify_one();
+    #else
+    this->drain();
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+capture::copy_frame(frame_slot& slot, const void* pixels, int width, int height) {
+    slot.width = this->frame_width;
+    slot.height = this->frame_height;
+    if ((width == this->frame_width) && (height == this->frame_height)) {
+        memcpy(slot.pixels, pixels, width * height * sizeof(uint32_t));
+    }
+    else {
+        // video size has changed, crop or pad with black
+        const int w = width < slot.width ? width : slot.width;
+        const int h = height < slot.height ? height : slot.height;
+        const uint32_t* src = (const uint32_t*) pixels;
+        uint32_t* dst = slot.pixels;
+        for (int y = 0; y < slot.height; y++, dst += slot.width) {
+            int x = 0;
+            if (y < h) {
+                memcpy(dst, src + y * width, w * sizeof(uint32_t));
+                x = w;
+            }
+            for (; x < slot.width; x++) {
+                dst[x] = 0xFF000000;
+            }
+        }
+        this->frames_resized++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+capture::push_audio(const float* samples, int num_samples) {
+    if (!this->active || !this->audio_file) {
+        return;
+    }
+    while (num_samples > 0) {
+        const uint32_t head = this->audio_head;
+        while (this->blocking && ((head - this->audio_tail) >= num_audio_slots)) {
+            this->wait_writer();
+        }
+        if ((head - this->audio_tail) >= num_audio_slots) {
+            this->samples_dropped += num_samples;
+            return;
+        }
+        audio_slot& slot = this->audio[head % num_audio_slots];
+        int num = audio_slot_size - this->audio_fill;
+        if (num > num_samples) {
+            num = num_samples;
+        }
+        memcpy(&slot.samples[this->audio_fill], samples, num * sizeof(float));
+        this->audio_fill += num;
+        samples += num;
+        num_samples -= num;
+        if (audio_slot_size == this->audio_fill) {
+            slot.num_samples = audio_slot_size;
+            this->audio_fill = 0;
+            this->audio_head = head + 1;
+            #if YAKC_CAPTURE_THREAD
+            this->wakeup.notify_one();
+            #else
+            this->drain();
+            #endif
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+capture::wait_writer() {
+    #if YAKC_CAPTURE_THREAD
+    this->wakeup.notify_one();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    #else
+    this->drain();
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+capture::drain() {
+    while (this->frame_tail != this->frame_head) {
+        this->write_frame(this->frame_tail % num_frame_slots);
+        this->frame_tail++;
+    }
+    while (this->audio_tail != this->audio_head) {
+        this->write_audio(this->audio_tail % num_audio_slots);
+        this->audio_tail++;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+capture::writer_loop() {
+    #if YAKC_CAPTURE_THREAD
+    for (;;) {
+        bool quit_requested = this->quit;
+        this->drain();
+        if (quit_requested) {
+            // queues have been drained after quit was requested
+            break;
+        }
+        // producers don't take the mutex, so only wait for a short time
+        // to not miss a wakeup notification
+        std::unique_lock<std::mutex> lock(this->wakeup_mutex);
+        this->wakeup.wait_for(lock, std::chrono::milliseconds(5));
+    }
+    #endif
+}
+
+//------------------------------------------------------------------------------
+void
+capture::write_frame(int slot_index) {
+    const frame_slot& slot = this->frames[slot_index];
+    const int num_pixels = slot.width * slot.height;
+    if (video_format::rgba8 == this->format) {
+        fwrite(slot.pixels, sizeof(uint32_t), num_pixels, this->video_file);
+    }
+    else {
+        if (0 == this->frames_written) {
+            fprintf(this->video_file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n",
+                slot.width, slot.height, this->fps);
+        }
+        // convert RGBA8 to planar BT.601 YCbCr (studio range)
+        uint8_t* y_plane = this->line_buffer;
+        uint8_t* cb_plane = y_plane + num_pixels;
+        uint8_t* cr_plane = cb_plane + num_pixels;
+        const uint8_t* src = (const uint8_t*) slot.pixels;
+        for (int i = 0; i < num_pixels; i++, src += 4) {
+            const int r = src[0];
+            const int g = src[1];
+            const int b = src[2];
+            y_plane[i]  = uint8_t(((66*r + 129*g + 25*b + 128) >> 8) + 16);
+            cb_plane[i] = uint8_t(((-38*r - 74*g + 112*b + 128) >> 8) + 128);
+            cr_plane[i] = uint8_t(((112*r - 94*g - 18*b + 128) >> 8) + 128);
+        }
+        fputs("FRAME\n", this->video_file);
+        fwrite(this->line_buffer, 1, num_pixels * 3, this->video_file);
+    }
+    this->frames_written++;
+}
+
+//------------------------------------------------------------------------------
+void
+capture::write_audio(int slot_index) {
+    const audio_slot& slot = this->audio[slot_index];
+    int16_t pcm[audio_slot_size];
+    for (int i = 0; i < slot.num_samples; i++) {
+        float s = slot.samples[i];
+        if (s > 1.0f) {
+            s = 1.0f;
+        }
+        else if (s < -1.0f) {
+            s = -1.0f;
+        }
+        pcm[i] = int16_t(s * 32767.0f);
+    }
+    fwrite(pcm, sizeof(int16_t), slot.num_samples, this->audio_file);
+    this->samples_written += slot.num_samples;
+}
+
+//------------------------------------------------------------------------------
+static void
+put_u32(uint8_t* dst, uint32_t val) {
+    dst[0] = val & 0xFF;
+    dst[1] = (val>>8) & 0xFF;
+    dst[2] = (val>>16) & 0xFF;
+    dst[3] = (val>>24) & 0xFF;
+}
+
+//------------------------------------------------------------------------------
+void
+capture::write_wav_header(uint32_t num_samples) {
+    const uint32_t data_size = num_samples * sizeof(int16_t);
+    uint8_t hdr[44] = {
+        'R','I','F','F', 0,0,0,0, 'W','A','V','E',
+        'f','m','t',' ', 16,0,0,0,
+        1,0,                    // PCM
+        1,0,                    // mono
+        0,0,0,0,                // sample rate
+        0,0,0,0,                // byte rate
+        2,0,                    // block align
+        16,0,                   // bits per sample
+        'd','a','t','a', 0,0,0,0
+    };
+    put_u32(&hdr[4], 36 + data_size);
+    put_u32(&hdr[24], SOUND_SAMPLE_RATE);
+    put_u32(&hdr[28], SOUND_SAMPLE_RATE * sizeof(int16_t));
+    put_u32(&hdr[40], data_size);
+    fseek(this->audio_file, 0, SEEK_SET);
+    fwrite(hdr, 1, sizeof(hdr), this->audio_file);
+    fseek(this->audio_file, 0, SEEK_END);
+}
+
+} // namespace YAKC
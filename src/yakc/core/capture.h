@@ -0,0 +1,128 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::capture
+    @brief stream emulator video frames and audio samples to disk
+
+    Video frames are written either as a YUV4MPEG2 stream (converted
+    to 4:4:4 YCbCr), or as headerless raw RGBA8 frames, audio is
+    written as 16-bit mono PCM WAV file at SOUND_SAMPLE_RATE.
+
+    The emulation thread only copies data into a small number of
+    preallocated queue slots, the actual conversion and file I/O happens
+    on a background writer thread. If the writer falls behind, new
+    frames or audio blocks are dropped (and counted) instead of
+    blocking the emulation. For offline rendering without a realtime
+    deadline, set 'blocking' to wait for the writer thread instead.
+    On platforms without threads (emscripten), the data is written
+    directly in push_frame() and push_audio().
+
+    The first captured frame defines the video size, later frames
+    with a different size (e.g. after switching the system) are
+    cropped or padded with black to that size, and counted in
+    frames_resized.
+
+    push_frame() and push_audio() may be called from different threads,
+    but each of them only from a single thread.
+*/
+#include "yakc/core/core.h"
+#include <stdio.h>
+#include <atomic>
+#if !defined(__EMSCRIPTEN__)
+#define YAKC_CAPTURE_THREAD (1)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace YAKC {
+
+class capture {
+public:
+    /// video output formats
+    enum class video_format {
+        y4m,        // YUV4MPEG2 stream, C444
+        rgba8,      // raw RGBA8 frames, no header
+    };
+
+    /// destructor, stops capturing
+    ~capture();
+
+    /// start capturing, video_path or audio_path may be nullptr
+    bool start(const char* video_path, const char* audio_path, video_format fmt=video_format::y4m, int fps=50);
+    /// stop capturing, flush pending data and close files
+    void stop();
+    /// return true if capturing is active
+    bool is_active() const;
+
+    /// queue a video frame (width*height RGBA8 pixels), drops frame if queue is full
+    void push_frame(const void* pixels, int width, int height);
+    /// queue audio samples, drops samples if queue is full
+    void push_audio(const float* samples, int num_samples);
+
+    /// number of queue slots for video frames
+    static const int num_frame_slots = 4;
+    /// number of queue slots for audio blocks
+    static const int num_audio_slots = 32;
+    /// number of samples in one audio block
+    static const int audio_slot_size = 1024;
+
+    /// if true, wait for a free queue slot instead of dropping data
+    bool blocking = false;
+    video_format format = video_format::y4m;
+    int fps = 50;
+    int frame_width = 0;                    // set by first captured frame
+    int frame_height = 0;
+    std::atomic<uint32_t> frames_written = { 0 };
+    std::atomic<uint32_t> frames_dropped = { 0 };
+    std::atomic<uint32_t> frames_resized = { 0 };     // frames cropped/padded to the video size
+    std::atomic<uint32_t> samples_written = { 0 };
+    std::atomic<uint32_t> samples_dropped = { 0 };
+
+private:
+    struct frame_slot {
+        int width = 0;
+        int height = 0;
+        uint32_t* pixels = nullptr;
+    };
+    struct audio_slot {
+        int num_samples = 0;
+        float samples[audio_slot_size];
+    };
+
+    /// wait until the writer thread has consumed a queue slot
+    void wait_writer();
+    /// writer thread entry
+    void writer_loop();
+    /// write all queued frames and audio blocks
+    void drain();
+    /// copy a frame into a queue slot, cropped or padded to the video size
+    void copy_frame(frame_slot& slot, const void* pixels, int width, int height);
+    /// write one queued frame to the video file
+    void write_frame(int slot_index);
+    /// write one queued audio block to the wav file
+    void write_audio(int slot_index);
+    /// write or patch the wav file header
+    void write_wav_header(uint32_t num_samples);
+
+    bool active = false;
+    FILE* video_file = nullptr;
+    FILE* audio_file = nullptr;
+    frame_slot frames[num_frame_slots];
+    audio_slot* audio = nullptr;
+    uint8_t* line_buffer = nullptr;         // conversion buffer for writer thread
+    // single-producer/single-consumer queue positions (monotonic counters)
+    std::atomic<uint32_t> frame_head = { 0 };
+    std::atomic<uint32_t> frame_tail = { 0 };
+    std::atomic<uint32_t> audio_head = { 0 };
+    std::atomic<uint32_t> audio_tail = { 0 };
+    int audio_fill = 0;                     // fill position in current audio slot
+    #if YAKC_CAPTURE_THREAD
+    std::atomic<bool> quit = { false };
+    std::mutex wakeup_mutex;
+    std::condition_variable wakeup;
+    std::thread writer;
+    #endif
+};
+
+} // namespace YAKC
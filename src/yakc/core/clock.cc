@@ -54,4 +54,18 @@ clock::step(system_bus* bus, int num_cycles) {
     }
 }
 
+//------------------------------------------------------------------------------
+int
+clock::cycles_until_timer(int max_cycles) const {
+    // a timer triggers when its value drops below 0
+    int cycles = max_cycles;
+    for (int i = 0; i < num_timers; i++) {
+        const auto& t = this->timers[i];
+        if ((t.period > 0) && (t.value < cycles)) {
+            cycles = t.value;
+        }
+    }
+    return cycles;
+}
+
 } // namespace YAKC
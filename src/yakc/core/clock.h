@@ -28,6 +28,8 @@ public:
     void config_timer_cycles(int index, int cycles);
     /// advance the timers by a number of cycles
     void step(system_bus* bus, int num_cycles);
+    /// number of cycles which can be stepped without triggering a timer (max_cycles if no timer is active)
+    int cycles_until_timer(int max_cycles) const;
 
     int base_freq_khz = 0;
     static const int num_timers = 4;
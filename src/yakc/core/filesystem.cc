@@ -5,30 +5,107 @@
 #define _CRT_SECURE_NO_WARNINGS
 #endif
 #include "filesystem.h"
+#include <stdio.h>
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#define YAKC_HAS_MMAP (1)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace YAKC {
 
+//------------------------------------------------------------------------------
+filesystem::~filesystem() {
+    this->discard();
+}
+
+//------------------------------------------------------------------------------
+void
+filesystem::init(int max_files, int max_blocks) {
+    YAKC_ASSERT((max_files > 1) && (max_blocks > 0));
+    this->discard();
+    this->max_num_files = max_files;
+    this->files = (file_item*) YAKC_MALLOC(max_files * sizeof(file_item));
+    for (int i = 0; i < max_files; i++) {
+        this->files[i] = file_item();
+    }
+    this->num_buckets = 1;
+    while (this->num_buckets < max_files) {
+        this->num_buckets <<= 1;
+    }
+    this->buckets = (file*) YAKC_MALLOC(this->num_buckets * sizeof(file));
+    clear(this->buckets, this->num_buckets * sizeof(file));
+
+    this->max_num_blocks = max_blocks;
+    this->store = (uint8_t**) YAKC_MALLOC(max_blocks * sizeof(uint8_t*));
+    clear(this->store, max_blocks * sizeof(uint8_t*));
+    const int num_words = (max_blocks + 63) / 64;
+    this->free_bits = (uint64_t*) YAKC_MALLOC(num_words * sizeof(uint64_t));
+    for (int i = 0; i < num_words; i++) {
+        const int num = max_blocks - i*64;
+        this->free_bits[i] = (num >= 64) ? ~uint64_t(0) : ((uint64_t(1)<<num) - 1);
+    }
+    this->free_blocks = max_blocks;
+}
+
+//------------------------------------------------------------------------------
+void
+filesystem::discard() {
+    if (this->files) {
+        this->reset();
+        YAKC_FREE(this->files);
+        this->files = nullptr;
+        YAKC_FREE(this->buckets);
+        this->buckets = nullptr;
+        YAKC_FREE(this->store);
+        this->store = nullptr;
+        YAKC_FREE(this->free_bits);
+        this->free_bits = nullptr;
+    }
+    this->max_num_files = 0;
+    this->num_buckets = 0;
+    this->max_num_blocks = 0;
+    this->free_blocks = 0;
+}
+
 //------------------------------------------------------------------------------
 void
 filesystem::reset() {
-    for (auto& b : blocks) {
-        b = block();
+    if (!this->files) {
+        return;
     }
-    for (auto& f : files) {
-        f = file_item();
+    for (int i = 0; i < max_num_files; i++) {
+        if (files[i].valid) {
+            this->free_file(files[i]);
+        }
+    }
+    YAKC_ASSERT(free_blocks == max_num_blocks);
+}
+
+//------------------------------------------------------------------------------
+uint32_t
+filesystem::hash(const char* name) {
+    // FNV-1a over the (possibly truncated) file name
+    uint32_t h = 2166136261U;
+    for (int i = 0; (i < (file_item::max_name_size-1)) && name[i]; i++) {
+        h = (h ^ uint8_t(name[i])) * 16777619U;
     }
-    clear(store, sizeof(store));
+    return h;
 }
 
 //------------------------------------------------------------------------------
 filesystem::file
 filesystem::find(const char* name) {
     YAKC_ASSERT(name);
-    for (int i = 0; i < max_num_files; i++) {
-        if (files[i].valid) {
-            if (strncmp(name, files[i].name, sizeof(files[i].name)) == 0) {
-                return i;
-            }
+    if (!this->files) {
+        return invalid_file;
+    }
+    const uint32_t h = hash(name);
+    for (file i = buckets[h & (num_buckets-1)]; i != invalid_file; i = files[i].next) {
+        if ((files[i].hash == h) && (strncmp(name, files[i].name, sizeof(files[i].name)-1) == 0)) {
+            return i;
         }
     }
     return invalid_file;
@@ -44,25 +121,48 @@ filesystem::exists(const char* name) {
 //------------------------------------------------------------------------------
 int
 filesystem::block_index(int pos) {
-    int index = pos >> block::shift;
-    YAKC_ASSERT(index < max_num_blocks);
-    return index;
+    return pos >> block::shift;
 }
 
 //------------------------------------------------------------------------------
 int
 filesystem::num_blocks(int size) {
-    int num = (size + (block::size-1)) / block::size;
-    YAKC_ASSERT(num <= max_num_blocks);
-    return num;
+    return (size + (block::size-1)) / block::size;
+}
+
+//------------------------------------------------------------------------------
+int
+filesystem::num_free_blocks() const {
+    return free_blocks;
+}
+
+//------------------------------------------------------------------------------
+static int
+first_set_bit(uint64_t val) {
+    #if _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, val);
+    return int(index);
+    #else
+    return __builtin_ctzll(val);
+    #endif
 }
 
 //------------------------------------------------------------------------------
 int
 filesystem::alloc_block() {
-    for (int i = 0; i < max_num_blocks; i++) {
-        if (blocks[i].free) {
-            blocks[i].free = false;
+    if (0 == free_blocks) {
+        return -1;
+    }
+    const int num_words = (max_num_blocks + 63) / 64;
+    for (int w = 0; w < num_words; w++) {
+        if (free_bits[w]) {
+            const int i = w*64 + first_set_bit(free_bits[w]);
+            free_bits[w] &= ~(uint64_t(1)<<(i & 63));
+            free_blocks--;
+            if (!store[i]) {
+                store[i] = (uint8_t*) YAKC_MALLOC(block::size);
+            }
             return i;
         }
     }
@@ -73,8 +173,35 @@ filesystem::alloc_block() {
 void
 filesystem::free_block(int i) {
     YAKC_ASSERT((i >= 0) && (i < max_num_blocks));
-    YAKC_ASSERT(!blocks[i].free);
-    blocks[i].free = true;
+    YAKC_ASSERT(0 == (free_bits[i>>6] & (uint64_t(1)<<(i & 63))));
+    free_bits[i>>6] |= uint64_t(1)<<(i & 63);
+    free_blocks++;
+    YAKC_FREE(store[i]);
+    store[i] = nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+filesystem::add_file_block(file_item& f) {
+    const int index = block_index(f.pos);
+    if (index >= f.num_blocks) {
+        // grow the block index array
+        const int num = f.num_blocks ? 2*f.num_blocks : 8;
+        int* blocks = (int*) YAKC_MALLOC(num * sizeof(int));
+        if (f.blocks) {
+            memcpy(blocks, f.blocks, f.num_blocks * sizeof(int));
+            YAKC_FREE(f.blocks);
+        }
+        f.blocks = blocks;
+        f.num_blocks = num;
+    }
+    int i = alloc_block();
+    if (i < 0) {
+        return false;
+    }
+    f.b_index = index;
+    f.blocks[index] = i;
+    return true;
 }
 
 //------------------------------------------------------------------------------
@@ -83,12 +210,152 @@ filesystem::rm(const char* name) {
     YAKC_ASSERT(name);
     file h = find(name);
     if (h) {
-        file_item& f = files[h];
+        this->free_file(files[h]);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+filesystem::free_file(file_item& f) {
+    if (kind::blocks == f.type) {
         for (int i = 0; i < num_blocks(f.size); i++) {
             free_block(f.blocks[i]);
         }
-        f = file_item();
+        if (f.blocks) {
+            YAKC_FREE(f.blocks);
+        }
+    }
+    else if ((kind::mapped == f.type) && f.ext_ptr) {
+        #if YAKC_HAS_MMAP
+        munmap((void*)f.ext_ptr, f.size);
+        #else
+        YAKC_FREE((void*)f.ext_ptr);
+        #endif
+    }
+    // unlink from hash bucket
+    const file h = file(&f - files);
+    file* link = &buckets[f.hash & (num_buckets-1)];
+    while (*link != h) {
+        YAKC_ASSERT(*link != invalid_file);
+        link = &files[*link].next;
+    }
+    *link = f.next;
+    f = file_item();
+}
+
+//------------------------------------------------------------------------------
+filesystem::file
+filesystem::alloc_file(const char* name, mode m, kind k) {
+    if (!this->files) {
+        this->init();
+    }
+    // file already exists?
+    if (find(name)) {
+        return invalid_file;
+    }
+    // find first free file handle
+    file h = invalid_file;
+    for (h = 1; h < max_num_files; h++) {
+        if (!files[h].valid) {
+            break;
+        }
+    }
+    // no free file handle found?
+    if (h == max_num_files) {
+        return invalid_file;
     }
+    auto& f = files[h];
+
+    // setup the new file item
+    strncpy(f.name, name, sizeof(f.name));
+    f.name[sizeof(f.name)-1] = 0;
+    f.hash = hash(f.name);
+    f.open_mode = m;
+    f.type = k;
+    f.valid = true;
+    f.pos = 0;
+    f.size = 0;
+    f.b_index = -1;
+    f.ext_ptr = nullptr;
+
+    // link into hash bucket
+    file& bucket = buckets[f.hash & (num_buckets-1)];
+    f.next = bucket;
+    bucket = h;
+    return h;
+}
+
+//------------------------------------------------------------------------------
+bool
+filesystem::add_external(const char* name, const void* ptr, int num_bytes) {
+    YAKC_ASSERT(name && ptr && (num_bytes >= 0));
+    file h = alloc_file(name, mode::none, kind::external);
+    if (!h) {
+        return false;
+    }
+    files[h].ext_ptr = (const uint8_t*) ptr;
+    files[h].size = num_bytes;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+filesystem::add_mapped(const char* name, const char* path) {
+    YAKC_ASSERT(name && path);
+    if (find(name)) {
+        return false;
+    }
+    const uint8_t* ptr = nullptr;
+    int size = 0;
+    #if YAKC_HAS_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) == 0) && (st.st_size > 0) && (st.st_size < 0x7FFFFFFF)) {
+        size = int(st.st_size);
+        void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            ptr = (const uint8_t*) p;
+        }
+    }
+    ::close(fd);
+    #else
+    // no mmap on this platform, load the file into an owned buffer instead
+    FILE* fh = fopen(path, "rb");
+    if (!fh) {
+        return false;
+    }
+    fseek(fh, 0, SEEK_END);
+    size = int(ftell(fh));
+    fseek(fh, 0, SEEK_SET);
+    if (size > 0) {
+        uint8_t* p = (uint8_t*) YAKC_MALLOC(size);
+        if (fread(p, 1, size, fh) == size_t(size)) {
+            ptr = p;
+        }
+        else {
+            YAKC_FREE(p);
+        }
+    }
+    fclose(fh);
+    #endif
+    if (!ptr) {
+        return false;
+    }
+    file h = alloc_file(name, mode::none, kind::mapped);
+    if (!h) {
+        #if YAKC_HAS_MMAP
+        munmap((void*)ptr, size);
+        #else
+        YAKC_FREE((void*)ptr);
+        #endif
+        return false;
+    }
+    files[h].ext_ptr = ptr;
+    files[h].size = size;
+    return true;
 }
 
 //------------------------------------------------------------------------------
@@ -112,33 +379,7 @@ filesystem::open(const char* name, mode m) {
     }
     else {
         // write to new file
-
-        // file already exists?
-        if (find(name)) {
-            return invalid_file;
-        }
-        // find first free file handle
-        file h = invalid_file;
-        for (h = 1; h < max_num_files; h++) {
-            if (!files[h].valid) {
-                break;
-            }
-        }
-        // no free file handle found?
-        if (!h) {
-            return invalid_file;
-        }
-        auto& f = files[h];
-
-        // setup the new file item
-        strncpy(f.name, name, sizeof(f.name));
-        f.name[sizeof(f.name)-1] = 0;
-        f.open_mode = mode::write;
-        f.valid = true;
-        f.pos = 0;
-        f.size = 0;
-        f.b_index = -1;
-        return h;
+        return alloc_file(name, mode::write, kind::blocks);
     }
 }
 
@@ -157,11 +398,7 @@ filesystem::close_rm(file h) {
     YAKC_ASSERT((h != invalid_file) && (h < max_num_files));
     auto& f = files[h];
     YAKC_ASSERT(f.valid && f.open_mode != mode::none);
-    f.open_mode = mode::none;
-    for (int i = 0; i < num_blocks(f.size); i++) {
-        free_block(f.blocks[i]);
-    }
-    f = file_item();
+    this->free_file(f);
 }
 
 //------------------------------------------------------------------------------
@@ -213,23 +450,30 @@ filesystem::write(file h, const void* ptr, int num_bytes) {
     YAKC_ASSERT((h != invalid_file) && (h < max_num_files));
     YAKC_ASSERT(ptr && (num_bytes > 0));
     auto& f = files[h];
-    YAKC_ASSERT(f.valid && f.open_mode == mode::write);
+    YAKC_ASSERT(f.valid && f.open_mode == mode::write && (kind::blocks == f.type));
     YAKC_ASSERT(f.size == f.pos);
     const int end_pos = f.pos + num_bytes;
     int bytes_written = 0;
     const uint8_t* u8_ptr = (const uint8_t*) ptr;
-    for (; f.pos < end_pos; f.pos++, f.size++, bytes_written++) {
+    while (f.pos < end_pos) {
         if (f.b_index != block_index(f.pos)) {
             // need to start a new block
-            int i = alloc_block();
-            if (i < 0) {
+            if (!this->add_file_block(f)) {
                 // no more free blocks left
                 return bytes_written;
             }
-            f.b_index = block_index(f.pos);
-            f.blocks[f.b_index] = i;
         }
-        store[f.blocks[f.b_index]][f.pos&block::mask] = *u8_ptr++;
+        // copy up to the end of the current block
+        const int offset = f.pos & block::mask;
+        int num = end_pos - f.pos;
+        if (num > (block::size - offset)) {
+            num = block::size - offset;
+        }
+        memcpy(store[f.blocks[f.b_index]] + offset, u8_ptr, num);
+        u8_ptr += num;
+        f.pos += num;
+        f.size += num;
+        bytes_written += num;
     }
     return bytes_written;
 }
@@ -247,8 +491,24 @@ filesystem::read(file h, void* ptr, int num_bytes) {
     }
     int bytes_read = 0;
     uint8_t* u8_ptr = (uint8_t*) ptr;
-    for (; f.pos < end_pos; f.pos++, bytes_read++) {
-        *u8_ptr++ = store[f.blocks[block_index(f.pos)]][f.pos & block::mask];
+    while (f.pos < end_pos) {
+        // copy contiguous chunks, either up to the end of a block or directly from external data
+        const uint8_t* src;
+        int num = end_pos - f.pos;
+        if (kind::blocks == f.type) {
+            const int offset = f.pos & block::mask;
+            src = store[f.blocks[block_index(f.pos)]] + offset;
+            if (num > (block::size - offset)) {
+                num = block::size - offset;
+            }
+        }
+        else {
+            src = f.ext_ptr + f.pos;
+        }
+        memcpy(u8_ptr, src, num);
+        u8_ptr += num;
+        f.pos += num;
+        bytes_read += num;
     }
     return bytes_read;
 }
@@ -260,7 +520,12 @@ filesystem::peek_u8(file h, int rel_pos) {
     const auto& f = files[h];
     YAKC_ASSERT(f.valid && f.open_mode == mode::read && f.size > 0);
     int pos = (f.pos + rel_pos) % f.size;
-    return store[f.blocks[block_index(pos)]][pos & block::mask];
+    if (kind::blocks == f.type) {
+        return store[f.blocks[block_index(pos)]][pos & block::mask];
+    }
+    else {
+        return f.ext_ptr[pos];
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -2,9 +2,23 @@
 //------------------------------------------------------------------------------
 /**
     @class YAKC::filesystem
-    
-    A simple memory filesystem for transferring files between 
+
+    A simple memory filesystem for transferring files between
     emulated systems and the outside world.
+
+    The storage blocks are allocated when a file grows into them,
+    and freed when the file is deleted, so an empty filesystem
+    only occupies the space for the file and block tables.
+
+    Besides files which are written through the filesystem, there
+    are read-only external files which directly reference caller-owned
+    memory or a memory-mapped host file. External files are never
+    copied and have no size limit.
+
+    The max number of files and storage blocks can be configured
+    with init(), otherwise the tables are created with default
+    limits on first use. Files are found through a hashed name index,
+    and free storage blocks are tracked in a bitmap.
 */
 #include "yakc/core/core.h"
 
@@ -18,15 +32,36 @@ public:
         read,
         write,
     };
+    /// file kinds
+    enum class kind {
+        blocks,     // stored in filesystem blocks
+        external,   // references caller-owned memory
+        mapped,     // references a memory-mapped host file
+    };
     /// file handle typedef
     typedef int file;
     /// the invalid file handle (must evaluate to false!)
     static const int invalid_file = 0;
 
+    /// default max number of files
+    static const int default_max_num_files = 256;
+    /// default max number of storage blocks (16 MByte)
+    static const int default_max_num_blocks = 4096;
+
+    /// destructor, frees all memory
+    ~filesystem();
+    /// setup file and block tables, deletes all files
+    void init(int max_num_files=default_max_num_files, int max_num_blocks=default_max_num_blocks);
+    /// free all memory
+    void discard();
     /// clear everything in the filesystem
     void reset();
     /// open a file
     file open(const char* name, mode m);
+    /// add a read-only file referencing external memory (must remain valid until the file is deleted)
+    bool add_external(const char* name, const void* ptr, int num_bytes);
+    /// add a read-only file by memory-mapping a host file
+    bool add_mapped(const char* name, const char* path);
     /// read data from file
     int read(file fp, void* ptr, int num_bytes);
     /// write data to file
@@ -53,45 +88,59 @@ public:
     bool exists(const char* name);
     /// find a file entry by name
     file find(const char* name);
+    /// get number of free storage blocks
+    int num_free_blocks() const;
 
-    static const int max_num_blocks = 256;
     struct block {
         static const int shift = 12;            // 1<<12 = 4 kbyte
         static const int size = (1<<shift);
         static const int mask = size - 1;
-        bool free = true;
     };
-    block blocks[max_num_blocks];
+    int max_num_blocks = 0;
+    int free_blocks = 0;
+    /// one bit per block, set if the block is free
+    uint64_t* free_bits = nullptr;
+    /// block storage, allocated on demand
+    uint8_t** store = nullptr;
 
-    static const int max_num_files = 16;
     struct file_item {
         static const int max_name_size = 128;
         char name[max_name_size] = { };
+        uint32_t hash = 0;
+        file next = invalid_file;   // next file in same hash bucket
         mode open_mode = mode::none;
+        kind type = kind::blocks;
         bool valid = false;
         int pos = 0;
         int size = 0;
-        int b_index = -1;   // last write block index
-        static const int max_blocks = 32;
-        static const int max_size = max_blocks * block::size;
-        uint8_t blocks[max_blocks] = { };
+        int b_index = -1;           // last write block index
+        int num_blocks = 0;         // capacity of blocks array
+        int* blocks = nullptr;      // storage block indices
+        const uint8_t* ext_ptr = nullptr;   // data of external and mapped files
     };
     /// note the first entry is never used (it's the 'invalid file')
-    file_item files[max_num_files];
-
-    uint8_t store[max_num_blocks][block::size];
+    int max_num_files = 0;
+    file_item* files = nullptr;
+    /// hash buckets with the first file in the bucket
+    int num_buckets = 0;
+    file* buckets = nullptr;
 
     /// convert a position to a block index
     static int block_index(int pos);
     /// convert a byte size to a block index (size + block_size-1) / block_size
     static int num_blocks(int size);
+    /// compute the hash of a file name
+    static uint32_t hash(const char* name);
     /// allocate a new block, return -1 if no free blocks
     int alloc_block();
-    /// free a block
+    /// free a block (and its storage)
     void free_block(int i);
+    /// find a free file handle and setup a new file item, return invalid_file if no free handle
+    file alloc_file(const char* name, mode m, kind k);
+    /// release the data of a file item and clear it
+    void free_file(file_item& f);
+    /// append a storage block to a file, return false if no free blocks
+    bool add_file_block(file_item& f);
 };
 
 } // namespace YAKC
-
-
-
@@ -17,6 +17,8 @@ enum class filetype {
     cpc_sna,
     cpc_tap,
     atom_tap,
+    zx_tzx,
+    cpc_cdt,
     text,
 
     num,
@@ -34,6 +36,8 @@ inline filetype filetype_from_string(const char* str) {
     if (strcmp(str, "cpc_sna")==0) return filetype::cpc_sna;
     if (strcmp(str, "cpc_tap")==0) return filetype::cpc_tap;
     if (strcmp(str, "atom_tap")==0) return filetype::atom_tap;
+    if (strcmp(str, "zx_tzx")==0) return filetype::zx_tzx;
+    if (strcmp(str, "cpc_cdt")==0) return filetype::cpc_cdt;
     if (strcmp(str, "text")==0) return filetype::text;
     return filetype::none;
 }
@@ -43,6 +47,8 @@ inline bool filetype_quickloadable(filetype t) {
     switch (t) {
         case filetype::cpc_tap:
         case filetype::atom_tap:
+        case filetype::zx_tzx:
+        case filetype::cpc_cdt:
             return false;
         default:
             return true;
@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+//  heatmap.cc
+//------------------------------------------------------------------------------
+#include "heatmap.h"
+
+namespace YAKC {
+
+//------------------------------------------------------------------------------
+heatmap::~heatmap() {
+    this->reset();
+}
+
+//------------------------------------------------------------------------------
+void
+heatmap::start(bool per_address) {
+    this->reset();
+    if (per_address) {
+        const int size = num_addr_types * num_addrs * sizeof(uint32_t);
+        this->addr_counters = (uint32_t*) YAKC_MALLOC(size);
+        clear(this->addr_counters, size);
+    }
+    this->enabled = true;
+}
+
+//------------------------------------------------------------------------------
+void
+heatmap::stop() {
+    this->enabled = false;
+}
+
+//------------------------------------------------------------------------------
+void
+heatmap::clear_counters() {
+    clear(this->page_counters, sizeof(this->page_counters));
+    if (this->addr_counters) {
+        clear(this->addr_counters, num_addr_types * num_addrs * sizeof(uint32_t));
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+heatmap::reset() {
+    this->enabled = false;
+    if (this->addr_counters) {
+        YAKC_FREE(this->addr_counters);
+        this->addr_counters = nullptr;
+    }
+    clear(this->page_counters, sizeof(this->page_counters));
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+heatmap::page_count(type t, int page_index) const {
+    YAKC_ASSERT((t >= 0) && (t < num_types));
+    YAKC_ASSERT((page_index >= 0) && (page_index < num_pages));
+    return this->page_counters[t][page_index];
+}
+
+//------------------------------------------------------------------------------
+uint32_t
+heatmap::addr_count(type t, uint16_t addr) const {
+    YAKC_ASSERT((t >= 0) && (t < num_types));
+    if (this->addr_counters && (t < num_addr_types)) {
+        return this->addr_counters[t*num_addrs + addr];
+    }
+    else {
+        return 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+heatmap::has_addr_counters() const {
+    return nullptr != this->addr_counters;
+}
+
+} // namespace YAKC
@@ -0,0 +1,116 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::heatmap
+    @brief memory access counters for the debugger UI
+
+    Counts memory reads, writes and executed instructions per 1 KByte
+    page, and optionally per address, and the number of times the
+    CPU-visible mapping of a page has changed (bank switching).
+
+    The heatmap is driven by cpudbg::start_heatmap(), which redirects
+    all memory pages to the debugger's trap callback (see
+    memory::set_traps()), the trap callback counts all reads and writes
+    (including opcode fetches), so the memory accessors have no extra
+    cost while no heatmap is running. The block accessors (read(),
+    write(), fill()) bypass the traps and don't count. Mapping changes
+    are counted by the memory object the heatmap is attached to
+    (memory::set_heatmap()), and executed instructions by cpudbg::step().
+
+    The counters are never cleared while counting, a UI which wants
+    to show recent activity should compute the difference to the
+    previous frame itself.
+*/
+#include "yakc/core/core.h"
+
+namespace YAKC {
+
+class heatmap {
+public:
+    /// 64 KByte addressable memory
+    static const int num_addrs = 1<<16;
+    /// page size (must match memory::page::shift)
+    static const int page_shift = 10;
+    /// number of pages
+    static const int num_pages = num_addrs>>page_shift;
+
+    /// access types
+    enum type {
+        read = 0,
+        write,
+        exec,
+        remap,          // page counters only
+        num_types,
+    };
+    /// number of access types with per-address counters
+    static const int num_addr_types = remap;
+
+    /// destructor
+    ~heatmap();
+    /// start counting, optionally per address, clears all counters
+    void start(bool per_address);
+    /// stop counting, the counters are kept
+    void stop();
+    /// clear all counters
+    void clear_counters();
+    /// stop counting and free memory
+    void reset();
+
+    /// count a memory read
+    void count_read(uint16_t addr);
+    /// count a memory write
+    void count_write(uint16_t addr);
+    /// count an executed instruction
+    void count_exec(uint16_t addr);
+    /// count a change of a page's CPU-visible mapping
+    void count_remap(int page_index);
+
+    /// get a page counter
+    uint64_t page_count(type t, int page_index) const;
+    /// get a per-address counter (0 if not counting per address)
+    uint32_t addr_count(type t, uint16_t addr) const;
+    /// true if per-address counters exist
+    bool has_addr_counters() const;
+
+    bool enabled = false;
+
+private:
+    uint64_t page_counters[num_types][num_pages] = { };
+    uint32_t* addr_counters = nullptr;      // [num_addr_types][num_addrs]
+};
+
+//------------------------------------------------------------------------------
+inline void
+heatmap::count_read(uint16_t addr) {
+    this->page_counters[read][addr>>page_shift]++;
+    if (this->addr_counters) {
+        this->addr_counters[read*num_addrs + addr]++;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+heatmap::count_write(uint16_t addr) {
+    this->page_counters[write][addr>>page_shift]++;
+    if (this->addr_counters) {
+        this->addr_counters[write*num_addrs + addr]++;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+heatmap::count_exec(uint16_t addr) {
+    this->page_counters[exec][addr>>page_shift]++;
+    if (this->addr_counters) {
+        this->addr_counters[exec*num_addrs + addr]++;
+    }
+}
+
+//------------------------------------------------------------------------------
+inline void
+heatmap::count_remap(int page_index) {
+    YAKC_ASSERT((page_index >= 0) && (page_index < num_pages));
+    this->page_counters[remap][page_index]++;
+}
+
+} // namespace YAKC
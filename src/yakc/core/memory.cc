@@ -27,29 +27,39 @@ memory::map_rw(int layer, uint16_t addr, uint32_t size, uint8_t* read_ptr, uint8
 
         const int pre_offset = page_index * page::size;
         YAKC_ASSERT(page_index < num_pages);
-        auto& page = this->layers[layer][page_index];
+        page new_page;
         if (cb) {
             YAKC_ASSERT((!read_ptr) && (!write_ptr));
             // special case memory-mapped-io area, an access to this calls
             // the callback function 'cb', to detect a memory-mapped
             // page, the write_ptr is set to nullptr, and the read_ptr
             // is actually the callback function pointer
-            page.read_ptr  = (uint8_t*) cb;
-            page.write_ptr = nullptr;
+            new_page.read_ptr  = (uint8_t*) cb;
+            new_page.write_ptr = nullptr;
         }
         else {
             // the pointers are 'pre-offsetted' by the upper 6 bits of the 16-bit
             // page-start address, this saves us a masking operation later when
             // when accessing the page
-            page.read_ptr = (read_ptr - pre_offset) + offset;
+            new_page.read_ptr = (read_ptr - pre_offset) + offset;
             if (nullptr != write_ptr) {
-                page.write_ptr = (write_ptr - pre_offset) + offset;
+                new_page.write_ptr = (write_ptr - pre_offset) + offset;
             }
             else {
-                page.write_ptr = this->junk_page - pre_offset;
+                new_page.write_ptr = this->junk_page - pre_offset;
             }
         }
-        this->update_mapping(page_index);
+        auto& page = this->layers[layer][page_index];
+        if ((page.read_ptr != new_page.read_ptr) || (page.write_ptr != new_page.write_ptr)) {
+            page = new_page;
+            if (page.read_ptr) {
+                this->layer_mask[page_index] |= (1<<layer);
+            }
+            else {
+                this->layer_mask[page_index] &= ~(1<<layer);
+            }
+            this->page_changed(page_index);
+        }
     }
 }
 
@@ -74,9 +84,13 @@ memory::map_io(int layer, uint16_t addr, uint32_t size, mem_cb cb) {
 void
 memory::unmap_layer(int layer) {
     YAKC_ASSERT((layer >= 0) && (layer < num_layers));
+    const uint8_t bit = 1<<layer;
     for (int page_index = 0; page_index < num_pages; page_index++) {
-        this->layers[layer][page_index] = page();
-        this->update_mapping(page_index);
+        if (this->layer_mask[page_index] & bit) {
+            this->layers[layer][page_index] = page();
+            this->layer_mask[page_index] &= ~bit;
+            this->page_changed(page_index);
+        }
     }
 }
 
@@ -89,31 +103,279 @@ memory::unmap_all() {
         }
     }
     for (int page_index = 0; page_index < num_pages; page_index++) {
+        this->layer_mask[page_index] = 0;
+        this->page_changed(page_index);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+memory::begin_remap() {
+    this->remap_depth++;
+}
+
+//------------------------------------------------------------------------------
+void
+memory::end_remap() {
+    YAKC_ASSERT(this->remap_depth > 0);
+    if (0 == --this->remap_depth) {
+        uint64_t pages = this->remap_pages;
+        this->remap_pages = 0;
+        for (int page_index = 0; pages; page_index++, pages >>= 1) {
+            if (pages & 1) {
+                this->update_mapping(page_index);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+memory::page_changed(int page_index) {
+    if (this->remap_depth > 0) {
+        this->remap_pages |= uint64_t(1)<<page_index;
+    }
+    else {
         this->update_mapping(page_index);
     }
 }
 
 //------------------------------------------------------------------------------
 void
-memory::update_mapping(int page_index) {
-    // find the highest priority layer which maps this memory range
-    int layer_index;
-    for (layer_index = 0; layer_index < num_layers; layer_index++) {
-        if (this->layers[layer_index][page_index].read_ptr) {
-            // found highest-priority layer with valid mapping
-            break;
+memory::set_traps(uint64_t page_mask, trap_cb cb, void* userdata) {
+    YAKC_ASSERT((0 == page_mask) || cb);
+    const uint64_t changed = this->trapped_pages ^ page_mask;
+    this->trapped_pages = page_mask;
+    this->trap_func = cb;
+    this->trap_userdata = userdata;
+    for (int page_index = 0; page_index < num_pages; page_index++) {
+        if (changed & (uint64_t(1)<<page_index)) {
+            this->update_mapping(page_index);
         }
     }
+}
+
+//------------------------------------------------------------------------------
+void
+memory::update_mapping(int page_index) {
+    // find the highest priority layer which maps this memory range,
+    // this is the lowest set bit in the page's layer mask
+    static const uint8_t first_layer[1<<num_layers] = {
+        num_layers, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0
+    };
+    static_assert(num_layers == 4, "first_layer table must match num_layers");
+    const int layer_index = first_layer[this->layer_mask[page_index]];
     // set the CPU-visible mapping
+    const page old_page = this->untrapped_table[page_index];
+    auto& page = this->untrapped_table[page_index];
     if (layer_index != num_layers) {
         // a valid mapping exists for this page
-        this->page_table[page_index] = this->layers[layer_index][page_index];
+        page = this->layers[layer_index][page_index];
     }
     else {
         // no mapping exists, set to the special 'unmapped page'
         const int pre_offset = page_index * page::size;
-        this->page_table[page_index].read_ptr = this->unmapped_page - pre_offset;
-        this->page_table[page_index].write_ptr = this->junk_page - pre_offset;
+        page.read_ptr = this->unmapped_page - pre_offset;
+        page.write_ptr = this->junk_page - pre_offset;
+    }
+    if ((page.read_ptr != old_page.read_ptr) || (page.write_ptr != old_page.write_ptr)) {
+        if (this->dirty_tracking) {
+            this->remember_dirty(old_page, page_index);
+        }
+        this->num_remaps++;
+        if (this->heat) {
+            this->heat->count_remap(page_index);
+        }
+    }
+    if (this->trapped_pages & (uint64_t(1)<<page_index)) {
+        // a trapped page looks like a memory-mapped-io page,
+        // access_io() calls the trap callback for it
+        this->page_table[page_index].read_ptr = page.read_ptr;
+        this->page_table[page_index].write_ptr = nullptr;
+    }
+    else {
+        this->page_table[page_index] = page;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+memory::set_dirty_tracking(bool enabled, int client) {
+    YAKC_ASSERT((client >= 0) && (client < num_dirty_clients));
+    // hand out the pending dirty bits to the other clients first
+    this->take_dirty_pages(client);
+    dirty_state& state = this->dirty_clients[client];
+    state.enabled = enabled;
+    state.pages = 0;
+    state.num_remapped = 0;
+    this->dirty_tracking = false;
+    for (const auto& c : this->dirty_clients) {
+        this->dirty_tracking |= c.enabled;
+    }
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+memory::take_dirty_pages(int client) {
+    YAKC_ASSERT((client >= 0) && (client < num_dirty_clients));
+    for (auto& c : this->dirty_clients) {
+        if (c.enabled) {
+            c.pages |= this->dirty_pages;
+        }
+    }
+    this->dirty_pages = 0;
+    dirty_state& state = this->dirty_clients[client];
+    const uint64_t pages = state.pages;
+    state.pages = 0;
+    state.num_remapped = 0;
+    return pages;
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+memory::take_dirty_pages(int client, const uint8_t* (&remapped)[max_remapped_dirty], int& num_remapped) {
+    YAKC_ASSERT((client >= 0) && (client < num_dirty_clients));
+    const dirty_state& state = this->dirty_clients[client];
+    if (state.num_remapped > max_remapped_dirty) {
+        num_remapped = -1;
+    }
+    else {
+        num_remapped = state.num_remapped;
+        for (int i = 0; i < num_remapped; i++) {
+            remapped[i] = state.remapped[i];
+        }
+    }
+    return this->take_dirty_pages(client);
+}
+
+//------------------------------------------------------------------------------
+void
+memory::remember_dirty(const page& p, int page_index) {
+    if (!p.write_ptr || this->is_junk(p, page_index)) {
+        return;
+    }
+    const uint64_t mask = uint64_t(1)<<page_index;
+    const uint8_t* host_ptr = p.write_ptr + page_index*page::size;
+    for (auto& c : this->dirty_clients) {
+        if (c.enabled && ((this->dirty_pages | c.pages) & mask)) {
+            if (c.num_remapped < max_remapped_dirty) {
+                c.remapped[c.num_remapped] = host_ptr;
+            }
+            if (c.num_remapped <= max_remapped_dirty) {
+                c.num_remapped++;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+memory::mark_dirty(uint16_t addr, int num) const {
+    if (!this->dirty_tracking) {
+        return;
+    }
+    while (num > 0) {
+        const int n = page_chunk(addr, num);
+        this->dirty_pages |= uint64_t(1)<<(addr>>page::shift);
+        num -= n;
+        addr += n;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+memory::set_heatmap(heatmap* hm) {
+    this->heat = hm;
+}
+
+//------------------------------------------------------------------------------
+int
+memory::page_chunk(uint16_t addr, int num) {
+    const int left = page::size - (addr & page::mask);
+    return num < left ? num : left;
+}
+
+//------------------------------------------------------------------------------
+bool
+memory::is_junk(const page& p, int page_index) const {
+    return (p.write_ptr + page_index*page::size) == this->junk_page;
+}
+
+//------------------------------------------------------------------------------
+void
+memory::write(uint16_t addr, const uint8_t* src, int num) const {
+    YAKC_ASSERT(src && (num >= 0));
+    while (num > 0) {
+        const int page_index = addr>>page::shift;
+        const int n = page_chunk(addr, num);
+        const auto& page = this->page_table[page_index];
+        if (page.write_ptr) {
+            // writes to ROM and unmapped pages are dropped
+            if (!this->is_junk(page, page_index)) {
+                memcpy(page.write_ptr + addr, src, n);
+                if (this->dirty_tracking) {
+                    this->dirty_pages |= uint64_t(1)<<page_index;
+                }
+            }
+        }
+        else {
+            // memory-mapped-io or trapped page
+            for (int i = 0; i < n; i++) {
+                this->access_io(true, addr + i, src[i]);
+            }
+        }
+        src += n;
+        num -= n;
+        addr += n;  // wraps around at 64 KByte
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+memory::read(uint16_t addr, uint8_t* dst, int num) const {
+    YAKC_ASSERT(dst && (num >= 0));
+    while (num > 0) {
+        const int n = page_chunk(addr, num);
+        const auto& page = this->page_table[addr>>page::shift];
+        if (page.write_ptr) {
+            memcpy(dst, page.read_ptr + addr, n);
+        }
+        else {
+            // memory-mapped-io or trapped page
+            for (int i = 0; i < n; i++) {
+                dst[i] = this->access_io(false, addr + i, 0);
+            }
+        }
+        dst += n;
+        num -= n;
+        addr += n;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+memory::fill(uint16_t addr, uint8_t val, int num) const {
+    YAKC_ASSERT(num >= 0);
+    while (num > 0) {
+        const int page_index = addr>>page::shift;
+        const int n = page_chunk(addr, num);
+        const auto& page = this->page_table[page_index];
+        if (page.write_ptr) {
+            if (!this->is_junk(page, page_index)) {
+                memset(page.write_ptr + addr, val, n);
+                if (this->dirty_tracking) {
+                    this->dirty_pages |= uint64_t(1)<<page_index;
+                }
+            }
+        }
+        else {
+            // memory-mapped-io or trapped page
+            for (int i = 0; i < n; i++) {
+                this->access_io(true, addr + i, val);
+            }
+        }
+        num -= n;
+        addr += n;
     }
 }
 
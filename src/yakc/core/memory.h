@@ -31,8 +31,38 @@
     and a 16 KByte part of the 64 KByte expansion module is visible at
     the hole 4000-7FFF. 3/4 of the 64KByte expansion memory remains
     culled and is not visible to the CPU.
+
+    For debugger watchpoints, single pages can be redirected to a
+    'trap callback' (set_traps()), trapped pages look like
+    memory-mapped-io pages to the CPU, so only accessors with
+    memory-mapped-io support may be used while traps are installed.
+    The trap callback gets the userdata pointer given to set_traps(),
+    and forwards the access to the actual mapping through
+    r8io_untrapped() and w8io_untrapped().
+
+    Optionally, written pages can be tracked in a dirty-page bitmap
+    (set_dirty_tracking()), this is maintained by all write accessors,
+    code which writes to mapped memory directly must call mark_dirty().
+    Several clients (the debugger UI and the rewinder) can track dirty
+    pages independently, each gets its own bitmap from take_dirty_pages().
+    When a written page is remapped before a client has taken its dirty
+    bits, the host address of the old mapping is remembered, so that
+    writes to bank-switched memory are not lost.
+
+    For the debugger UI, a heatmap can be attached (set_heatmap()),
+    this counts CPU-visible mapping changes per page, reads and writes
+    are counted by the debugger's trap callback, see heatmap.h for details.
+
+    Each page keeps a bit mask of the layers which map it, so finding
+    the CPU-visible layer is a table lookup instead of a loop over
+    all layers. Mapping changes can be batched between begin_remap()
+    and end_remap(), this only collects the changed pages, and the
+    CPU-visible mapping of those pages is updated once in end_remap().
+    Systems with bank switching should wrap their remapping code like
+    this, batches may be nested.
 */
 #include "yakc/core/core.h"
+#include "yakc/core/heatmap.h"
 
 namespace YAKC {
 
@@ -44,6 +74,8 @@ public:
 
     /// memory-mapped-io callback function typedef
     typedef uint8_t (*mem_cb)(bool write, uint16_t addr, uint8_t inval);
+    /// trap callback function typedef, see set_traps()
+    typedef uint8_t (*trap_cb)(void* userdata, bool write, uint16_t addr, uint8_t inval);
 
     /// a memory page mapping description
     struct page {
@@ -56,13 +88,52 @@ public:
     /// number of pages
     static const int num_pages = addr_range / page::size;
     static_assert(num_pages * page::size == addr_range, "page::size must be 2^N and < 64kByte!");
+    static_assert(heatmap::page_shift == page::shift, "heatmap page size must match memory page size!");
     /// max number of layers
     static const int num_layers = 4;
+    /// dirty-page tracking clients
+    enum dirty_client {
+        dirty_debugger = 0,
+        dirty_rewinder,
+        num_dirty_clients
+    };
+    /// max number of remembered written pages which have been remapped
+    static const int max_remapped_dirty = 32;
+    /// dirty-page state of a client
+    struct dirty_state {
+        bool enabled = false;
+        uint64_t pages = 0;
+        int num_remapped = 0;           // > max_remapped_dirty on overflow
+        const uint8_t* remapped[max_remapped_dirty] = { };
+    };
 
     /// memory mapping layers, layer 0 has highest priority
     page layers[num_layers][num_pages];
+    /// per page, bit N is set if layer N maps the page
+    uint8_t layer_mask[num_pages];
     /// the actually visible pages
     page page_table[num_pages];
+    /// the visible pages without traps applied
+    page untrapped_table[num_pages];
+    /// bit mask of pages redirected to the trap callback
+    uint64_t trapped_pages = 0;
+    /// the trap callback and its userdata
+    trap_cb trap_func = nullptr;
+    void* trap_userdata = nullptr;
+    /// nesting depth of begin_remap()/end_remap()
+    int remap_depth = 0;
+    /// bit mask of pages changed during a begin_remap()/end_remap() batch
+    uint64_t remap_pages = 0;
+    /// true if dirty-page tracking is enabled for any client
+    bool dirty_tracking = false;
+    /// bit mask of pages written since the last take_dirty_pages() of any client
+    mutable uint64_t dirty_pages = 0;
+    /// per-client dirty-page state
+    dirty_state dirty_clients[num_dirty_clients];
+    /// optional mapping change counters, see set_heatmap()
+    heatmap* heat = nullptr;
+    /// number of CPU-visible page mapping changes (statistics, see stats.h)
+    uint64_t num_remaps = 0;
     /// a dummy page for currently unmapped memory
     uint8_t unmapped_page[page::size];
     /// another write-only 'junk' page for writes to ROM areas
@@ -80,8 +151,26 @@ public:
     void unmap_layer(int layer);
     /// unmap all memory pages
     void unmap_all();
+    /// start a batch of mapping changes
+    void begin_remap();
+    /// finish a batch of mapping changes, updates the changed CPU-visible pages
+    void end_remap();
+    /// redirect pages (bit mask of page indices) to a trap callback, 0 removes all traps
+    void set_traps(uint64_t page_mask, trap_cb cb, void* userdata);
     /// map a Z80 address to host memory pointer (read-only)
     const uint8_t* read_ptr(uint16_t addr) const;
+    /// enable or disable dirty-page tracking for a client, clears the client's dirty-page bitmap
+    void set_dirty_tracking(bool enabled, int client=dirty_debugger);
+    /// return the dirty-page bitmap of a client and clear it
+    uint64_t take_dirty_pages(int client=dirty_debugger);
+    /// same, and get the host pointers of written pages which have been remapped, num_remapped is -1 on overflow
+    uint64_t take_dirty_pages(int client, const uint8_t* (&remapped)[max_remapped_dirty], int& num_remapped);
+    /// test if a page is dirty for a client
+    bool is_dirty(int page_index, int client=dirty_debugger) const;
+    /// mark a byte range as dirty (for code which writes to mapped memory directly)
+    void mark_dirty(uint16_t addr, int num) const;
+    /// attach a heatmap which counts mapping changes (nullptr to detach)
+    void set_heatmap(heatmap* hm);
 
     /// read a byte at cpu address, no memory-mapped-io support
     uint8_t r8(uint16_t addr) const;
@@ -105,25 +194,58 @@ public:
     /// write a word to cpu address, with memory-mapped-io support
     void w16io(uint16_t addr, uint16_t w) const;
 
-    /// write a byte range (calls w8() internally)
+    /// read a byte at cpu address, ignoring traps, no memory-mapped-io support
+    uint8_t r8_untrapped(uint16_t addr) const;
+    /// read a byte at cpu address, ignoring traps, with memory-mapped-io support
+    uint8_t r8io_untrapped(uint16_t addr) const;
+    /// write a byte to cpu address, ignoring traps, with memory-mapped-io support
+    void w8io_untrapped(uint16_t addr, uint8_t b) const;
+
+    /// write a byte range page by page, with memory-mapped-io support
     void write(uint16_t addr, const uint8_t* src, int num) const;
+    /// read a byte range page by page, with memory-mapped-io support
+    void read(uint16_t addr, uint8_t* dst, int num) const;
+    /// fill a byte range page by page, with memory-mapped-io support
+    void fill(uint16_t addr, uint8_t val, int num) const;
 
 private:
+    /// access a memory-mapped-io or trapped page
+    uint8_t access_io(bool write, uint16_t addr, uint8_t inval) const;
+    /// update the CPU-visible mapping, or defer until end_remap()
+    void page_changed(int page_index);
     /// update the CPU-visible mapping
     void update_mapping(int page_index);
+    /// number of bytes from addr to the end of its page, clamped to num
+    static int page_chunk(uint16_t addr, int num);
+    /// return true if a page's write pointer goes to the junk page (ROM or unmapped)
+    bool is_junk(const page& p, int page_index) const;
+    /// remember the host page of a written page which is about to be remapped
+    void remember_dirty(const page& p, int page_index);
 };
 
 //------------------------------------------------------------------------------
 inline const uint8_t*
 memory::read_ptr(uint16_t addr) const {
     const int page_index = addr>>page::shift;
-    return this->page_table[page_index].read_ptr + page_index*page::size;
+    return this->untrapped_table[page_index].read_ptr + page_index*page::size;
+}
+
+//------------------------------------------------------------------------------
+inline bool
+memory::is_dirty(int page_index, int client) const {
+    YAKC_ASSERT((page_index >= 0) && (page_index < num_pages));
+    YAKC_ASSERT((client >= 0) && (client < num_dirty_clients));
+    const uint64_t pages = this->dirty_pages | this->dirty_clients[client].pages;
+    return 0 != (pages & (uint64_t(1)<<page_index));
 }
 
 //------------------------------------------------------------------------------
 inline void
 memory::w8(uint16_t addr, uint8_t b) const {
     this->page_table[addr>>page::shift].write_ptr[addr] = b;
+    if (this->dirty_tracking) {
+        this->dirty_pages |= uint64_t(1)<<(addr>>page::shift);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -132,10 +254,13 @@ memory::w8io(uint16_t addr, uint8_t b) const {
     const auto& page = this->page_table[addr>>page::shift];
     if (page.write_ptr) {
         page.write_ptr[addr] = b;
+        if (this->dirty_tracking) {
+            this->dirty_pages |= uint64_t(1)<<(addr>>page::shift);
+        }
     }
     else {
-        // memory-mapped-io page
-        ((mem_cb)page.read_ptr)(true, addr, b);
+        // memory-mapped-io or trapped page
+        this->access_io(true, addr, b);
     }
 }
 
@@ -153,8 +278,8 @@ memory::r8io(uint16_t addr) const {
         return page.read_ptr[addr];
     }
     else {
-        // memory-mapped-io page
-        return ((mem_cb)page.read_ptr)(false, addr, 0);
+        // memory-mapped-io or trapped page
+        return this->access_io(false, addr, 0);
     }
 }
 
@@ -172,8 +297,8 @@ memory::rs8io(uint16_t addr) const {
         return (int8_t)page.read_ptr[addr];
     }
     else {
-        // memory-mapped-io page
-        return (int8_t)((mem_cb)page.read_ptr)(false, addr, 0);
+        // memory-mapped-io or trapped page
+        return (int8_t)this->access_io(false, addr, 0);
     }
 }
 
@@ -209,11 +334,48 @@ memory::r16io(uint16_t addr) const {
     return w;
 }
 
+//------------------------------------------------------------------------------
+inline uint8_t
+memory::access_io(bool write, uint16_t addr, uint8_t inval) const {
+    const int page_index = addr>>page::shift;
+    if (this->trapped_pages & (uint64_t(1)<<page_index)) {
+        return this->trap_func(this->trap_userdata, write, addr, inval);
+    }
+    else {
+        return ((mem_cb)this->page_table[page_index].read_ptr)(write, addr, inval);
+    }
+}
+
+//------------------------------------------------------------------------------
+inline uint8_t
+memory::r8_untrapped(uint16_t addr) const {
+    return this->untrapped_table[addr>>page::shift].read_ptr[addr];
+}
+
+//------------------------------------------------------------------------------
+inline uint8_t
+memory::r8io_untrapped(uint16_t addr) const {
+    const auto& page = this->untrapped_table[addr>>page::shift];
+    if (page.write_ptr) {
+        return page.read_ptr[addr];
+    }
+    else {
+        return ((mem_cb)page.read_ptr)(false, addr, 0);
+    }
+}
+
 //------------------------------------------------------------------------------
 inline void
-memory::write(uint16_t addr, const uint8_t* src, int num) const {
-    for (int i = 0; i < num; i++) {
-        this->w8(addr++, src[i]);
+memory::w8io_untrapped(uint16_t addr, uint8_t b) const {
+    const auto& page = this->untrapped_table[addr>>page::shift];
+    if (page.write_ptr) {
+        page.write_ptr[addr] = b;
+        if (this->dirty_tracking) {
+            this->dirty_pages |= uint64_t(1)<<(addr>>page::shift);
+        }
+    }
+    else {
+        ((mem_cb)page.read_ptr)(true, addr, b);
     }
 }
 
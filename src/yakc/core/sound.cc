@@ -39,6 +39,7 @@ sound::step(int cpu_cycles) {
         this->write_pos = (this->write_pos + 1) & (chunk_size-1);
         if (0 == this->write_pos) {
             this->write_buffer = (this->write_buffer + 1) & (num_chunks-1);
+            this->num_samples += chunk_size;
         }
     }
 }
@@ -30,6 +30,7 @@ public:
     std::atomic<int> read_buffer = { 0 };
     std::atomic<int> write_buffer = { 0 };
     int write_pos = 0;
+    uint64_t num_samples = 0;   // number of generated samples (statistics, counted per chunk)
     float buf[num_chunks][chunk_size];
 };
 
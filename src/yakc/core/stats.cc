@@ -0,0 +1,106 @@
+//------------------------------------------------------------------------------
+//  stats.cc
+//------------------------------------------------------------------------------
+#include "stats.h"
+
+namespace YAKC {
+
+//------------------------------------------------------------------------------
+void
+stats::reset() {
+    *this = stats();
+}
+
+//------------------------------------------------------------------------------
+void
+stats::add_frame_time(float ms) {
+    this->frame_times[this->frame_time_pos] = ms;
+    this->frame_time_pos = (this->frame_time_pos + 1) % max_frame_times;
+    if (this->frame_time_count < max_frame_times) {
+        this->frame_time_count++;
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+stats::num_frame_times() const {
+    return this->frame_time_count;
+}
+
+//------------------------------------------------------------------------------
+float
+stats::frame_time_percentile(float p) const {
+    const int num = this->frame_time_count;
+    if (0 == num) {
+        return 0.0f;
+    }
+    // insertion-sort a copy of the recent frame times, and pick
+    // the nearest rank
+    float sorted[max_frame_times];
+    for (int i = 0; i < num; i++) {
+        const float t = this->frame_times[i];
+        int j = i;
+        while ((j > 0) && (sorted[j-1] > t)) {
+            sorted[j] = sorted[j-1];
+            j--;
+        }
+        sorted[j] = t;
+    }
+    int rank = int((p * num) / 100.0f + 0.5f);
+    if (rank < 1) {
+        rank = 1;
+    }
+    else if (rank > num) {
+        rank = num;
+    }
+    return sorted[rank - 1];
+}
+
+//------------------------------------------------------------------------------
+void
+stats::write(FILE* fp) const {
+    YAKC_ASSERT(fp);
+    fprintf(fp, "yakc_frames %llu\n", (unsigned long long)this->num_frames);
+    fprintf(fp, "yakc_instructions %llu\n", (unsigned long long)this->num_instructions);
+    fprintf(fp, "yakc_interrupts %llu\n", (unsigned long long)this->num_interrupts);
+    fprintf(fp, "yakc_memory_remaps %llu\n", (unsigned long long)this->num_remaps);
+    fprintf(fp, "yakc_video_scanlines %llu\n", (unsigned long long)this->num_scanlines);
+    fprintf(fp, "yakc_audio_samples %llu\n", (unsigned long long)this->num_audio_samples);
+    fprintf(fp, "yakc_cpu_ahead_frames %llu\n", (unsigned long long)this->num_cpu_ahead);
+    fprintf(fp, "yakc_cpu_behind_frames %llu\n", (unsigned long long)this->num_cpu_behind);
+    static const int percentiles[] = { 50, 90, 99, 100 };
+    for (int p : percentiles) {
+        fprintf(fp, "yakc_frame_time_ms{quantile=\"%.2f\"} %.3f\n", p / 100.0f, this->frame_time_percentile(float(p)));
+    }
+    if (no_ports == this->ports) {
+        fprintf(fp, "# no I/O port counters, the CPU uses memory-mapped I/O\n");
+        return;
+    }
+    char name[8];
+    for (int port = 0; port < num_ports; port++) {
+        if (this->port_reads[port]) {
+            this->port_name(port, name, sizeof(name));
+            fprintf(fp, "yakc_port_reads{port=\"%s\"} %llu\n", name, (unsigned long long)this->port_reads[port]);
+        }
+    }
+    for (int port = 0; port < num_ports; port++) {
+        if (this->port_writes[port]) {
+            this->port_name(port, name, sizeof(name));
+            fprintf(fp, "yakc_port_writes{port=\"%s\"} %llu\n", name, (unsigned long long)this->port_writes[port]);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+stats::port_name(int port, char* buf, int buf_size) const {
+    YAKC_ASSERT(buf && (buf_size > 0));
+    if (port_high_byte == this->ports) {
+        snprintf(buf, buf_size, "%02Xxx", port & 0xFF);
+    }
+    else {
+        snprintf(buf, buf_size, "xx%02X", port & 0xFF);
+    }
+}
+
+} // namespace YAKC
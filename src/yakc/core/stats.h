@@ -0,0 +1,76 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::stats
+    @brief emulator runtime counters
+
+    The per-instruction and per-access counters are plain members of the
+    objects where the events happen (e.g. z80::num_ops, memory::num_remaps,
+    sound::num_samples), so counting costs a single increment. They are
+    collected into a stats block once per frame by yakc::update_stats(),
+    all counters are totals since the last yakc::reset_stats().
+
+    The frame time is measured by the host application, which reports it
+    with add_frame_time(), percentiles are computed over the most recent
+    max_frame_times frames.
+
+    write() dumps all counters in a line-oriented 'name value' text format
+    (the Prometheus text exposition format) for scraping.
+
+    I/O ports are counted by the Z80 port address byte which selects the
+    devices of the running system: the low byte on most systems (written
+    as xxFE), the high byte on the Amstrad CPC (written as 7Fxx). Ports
+    which are only told apart by the other byte share a counter (e.g. the
+    ZX Spectrum 128 paging and AY ports 7FFD, BFFD and FFFD). The 6502
+    systems have memory-mapped I/O and no port counters.
+*/
+#include "yakc/core/core.h"
+#include <stdio.h>
+
+namespace YAKC {
+
+class stats {
+public:
+    /// number of recorded frame times for percentiles
+    static const int max_frame_times = 256;
+    /// number of I/O port counters (by one byte of the Z80 port address)
+    static const int num_ports = 256;
+    /// which port address byte the port counters are indexed by
+    enum port_byte {
+        no_ports,                       // CPU without I/O ports
+        port_low_byte,
+        port_high_byte,
+    };
+
+    /// clear all counters
+    void reset();
+    /// record the host time for emulating one frame
+    void add_frame_time(float ms);
+    /// get a frame time percentile (0..100) over the recent frames
+    float frame_time_percentile(float p) const;
+    /// number of recorded frame times
+    int num_frame_times() const;
+    /// write all counters as 'name value' lines
+    void write(FILE* fp) const;
+    /// format a port counter index as port address ("xxFE" or "7Fxx")
+    void port_name(int port, char* buf, int buf_size) const;
+
+    uint64_t num_frames = 0;            // number of yakc::step() calls
+    uint64_t num_instructions = 0;      // executed CPU instructions
+    uint64_t num_interrupts = 0;        // interrupt requests accepted by the CPU
+    uint64_t num_remaps = 0;            // changed CPU-visible memory pages
+    uint64_t num_scanlines = 0;         // video scanlines generated
+    uint64_t num_audio_samples = 0;     // generated audio samples (all sound generators)
+    uint64_t num_cpu_ahead = 0;         // frames where the CPU was throttled to stay behind audio
+    uint64_t num_cpu_behind = 0;        // frames where the CPU had to catch up with audio
+    port_byte ports = no_ports;
+    uint64_t port_reads[num_ports] = { };
+    uint64_t port_writes[num_ports] = { };
+
+private:
+    float frame_times[max_frame_times] = { };
+    int frame_time_pos = 0;
+    int frame_time_count = 0;
+};
+
+} // namespace YAKC
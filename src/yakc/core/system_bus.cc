@@ -71,6 +71,12 @@ system_bus::timer(int timer_id) {
     // empty
 }
 
+//------------------------------------------------------------------------------
+int
+system_bus::cpu_block_budget() {
+    return 0;
+}
+
 //------------------------------------------------------------------------------
 void
 system_bus::vblank() {
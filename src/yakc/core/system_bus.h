@@ -36,6 +36,8 @@ public:
     virtual void iack();
     /// clock timer triggered
     virtual void timer(int timer_id);
+    /// number of T-states the CPU may run ahead until the system must be ticked (0: no bulk block instructions)
+    virtual int cpu_block_budget();
 
     /// optional, called when vblank happens
     virtual void vblank();
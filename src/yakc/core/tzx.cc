@@ -0,0 +1,435 @@
+//------------------------------------------------------------------------------
+//  tzx.cc
+//
+//  TZX format: http://www.worldofspectrum.org/TZXformat.html
+//------------------------------------------------------------------------------
+#include "tzx.h"
+
+namespace YAKC {
+
+//------------------------------------------------------------------------------
+bool
+tzx::is_tzx(filesystem* fs, filesystem::file fp) {
+    YAKC_ASSERT(fs && fp);
+    static const char sig[8] = { 'Z', 'X', 'T', 'a', 'p', 'e', '!', 0x1A };
+    if (fs->size(fp) < header_size) {
+        return false;
+    }
+    // peek_u8() is relative to the current position
+    const int pos = fs->get_pos(fp);
+    for (int i = 0; i < int(sizeof(sig)); i++) {
+        if (fs->peek_u8(fp, i - pos) != uint8_t(sig[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+tzx::open(filesystem* fs_, filesystem::file fp_) {
+    YAKC_ASSERT(fs_ && fp_);
+    this->close();
+    if (!is_tzx(fs_, fp_)) {
+        return false;
+    }
+    this->fs = fs_;
+    this->fp = fp_;
+    this->rewind();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+tzx::close() {
+    this->fs = nullptr;
+    this->fp = filesystem::invalid_file;
+    this->cur_state = state::end;
+    this->level = false;
+    this->stop_requested = false;
+    this->num_data_blocks = 0;
+}
+
+//------------------------------------------------------------------------------
+bool
+tzx::is_valid() const {
+    return nullptr != this->fs;
+}
+
+//------------------------------------------------------------------------------
+void
+tzx::rewind() {
+    if (!this->is_valid()) {
+        return;
+    }
+    this->fs->set_pos(this->fp, header_size);
+    this->blk = block();
+    this->cur_state = state::idle;
+    this->level = false;
+    this->stop_requested = false;
+    this->num_data_blocks = 0;
+    this->pulse_cycles = 0;
+    this->pulses_left = 0;
+    this->data_bytes_left = 0;
+    this->data_started = false;
+    this->data_bits = 0;
+    this->half_pulse = 0;
+    this->loop_count = 0;
+}
+
+//------------------------------------------------------------------------------
+int
+tzx::read_byte() {
+    uint8_t val = 0;
+    this->fs->read(this->fp, &val, 1);
+    return val;
+}
+
+//------------------------------------------------------------------------------
+int
+tzx::read_word() {
+    const int l = this->read_byte();
+    const int h = this->read_byte();
+    return (h<<8) | l;
+}
+
+//------------------------------------------------------------------------------
+int
+tzx::read_u24() {
+    const int l = this->read_word();
+    const int h = this->read_byte();
+    return (h<<16) | l;
+}
+
+//------------------------------------------------------------------------------
+int
+tzx::read_dword() {
+    const int l = this->read_word();
+    const int h = this->read_word();
+    return (h<<16) | l;
+}
+
+//------------------------------------------------------------------------------
+void
+tzx::skip(int num_bytes) {
+    if (num_bytes > 0) {
+        this->fs->skip(this->fp, num_bytes);
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+tzx::cycles(int tstates) const {
+    return int((int64_t(tstates) * this->freq_khz) / 3500);
+}
+
+//------------------------------------------------------------------------------
+bool
+tzx::next_block() {
+    while (!this->fs->eof(this->fp)) {
+        this->blk = block();
+        this->blk.id = this->read_byte();
+        this->data_started = false;
+        this->data_bits = 0;
+        this->half_pulse = 0;
+        switch (this->blk.id) {
+            case standard:
+                this->blk.pause_ms = this->read_word();
+                this->blk.data_size = this->read_word();
+                this->blk.pilot_len = 2168;
+                this->blk.sync1_len = 667;
+                this->blk.sync2_len = 735;
+                this->blk.bit0_len = 855;
+                this->blk.bit1_len = 1710;
+                // header blocks (flag byte < 0x80) have a longer pilot tone
+                if ((this->blk.data_size > 0) && (this->fs->peek_u8(this->fp, 0) < 0x80)) {
+                    this->blk.pilot_pulses = 8063;
+                }
+                else {
+                    this->blk.pilot_pulses = 3223;
+                }
+                this->data_bytes_left = this->blk.data_size;
+                this->pulses_left = this->blk.pilot_pulses;
+                this->cur_state = state::pilot;
+                this->num_data_blocks++;
+                return true;
+            case turbo:
+                this->blk.pilot_len = this->read_word();
+                this->blk.sync1_len = this->read_word();
+                this->blk.sync2_len = this->read_word();
+                this->blk.bit0_len = this->read_word();
+                this->blk.bit1_len = this->read_word();
+                this->blk.pilot_pulses = this->read_word();
+                this->blk.last_bits = this->read_byte();
+                this->blk.pause_ms = this->read_word();
+                this->blk.data_size = this->read_u24();
+                this->data_bytes_left = this->blk.data_size;
+                this->pulses_left = this->blk.pilot_pulses;
+                this->cur_state = state::pilot;
+                this->num_data_blocks++;
+                return true;
+            case pure_tone:
+                this->tone_len = this->read_word();
+                this->pulses_left = this->read_word();
+                this->cur_state = state::tone;
+                return true;
+            case pulse_seq:
+                this->pulses_left = this->read_byte();
+                this->cur_state = state::pulses;
+                return true;
+            case pure_data:
+                this->blk.bit0_len = this->read_word();
+                this->blk.bit1_len = this->read_word();
+                this->blk.last_bits = this->read_byte();
+                this->blk.pause_ms = this->read_word();
+                this->blk.data_size = this->read_u24();
+                this->data_bytes_left = this->blk.data_size;
+                this->cur_state = state::data;
+                this->num_data_blocks++;
+                return true;
+            case direct_rec:
+                this->sample_len = this->read_word();
+                this->blk.pause_ms = this->read_word();
+                this->blk.last_bits = this->read_byte();
+                this->blk.data_size = this->read_u24();
+                this->data_bytes_left = this->blk.data_size;
+                this->cur_state = state::direct;
+                return true;
+            case pause_stop:
+                this->blk.pause_ms = this->read_word();
+                if (0 == this->blk.pause_ms) {
+                    // 'stop the tape'
+                    this->stop_requested = true;
+                    this->cur_state = state::idle;
+                }
+                else {
+                    this->cur_state = state::pause_low;
+                }
+                return true;
+            case loop_start:
+                this->loop_count = this->read_word();
+                this->loop_pos = this->fs->get_pos(this->fp);
+                break;
+            case loop_end:
+                if (this->loop_count > 1) {
+                    this->loop_count--;
+                    this->fs->set_pos(this->fp, this->loop_pos);
+                }
+                break;
+            case set_level:
+                this->skip(4);
+                this->level = 0 != this->read_byte();
+                break;
+            // blocks without effect on the signal
+            case 0x21: this->skip(this->read_byte()); break;     // group start
+            case 0x22: break;                                   // group end
+            case 0x23: this->skip(2); break;                    // jump to block (ignored)
+            case 0x26: this->skip(2 * this->read_word()); break;  // call sequence (ignored)
+            case 0x27: break;                                   // return from sequence
+            case 0x28: this->skip(this->read_word()); break;    // select block
+            case 0x2A: this->skip(4); break;                    // stop the tape if in 48K mode
+            case 0x30: this->skip(this->read_byte()); break;    // text description
+            case 0x31: this->skip(1); this->skip(this->read_byte()); break;  // message
+            case 0x32: this->skip(this->read_word()); break;    // archive info
+            case 0x33: this->skip(3 * this->read_byte()); break;  // hardware type
+            case 0x34: this->skip(8); break;                    // emulation info (deprecated)
+            case 0x35: this->skip(16); this->skip(this->read_dword()); break;  // custom info
+            case 0x40: this->skip(1); this->skip(this->read_u24()); break;  // snapshot (deprecated)
+            case 0x5A: this->skip(9); break;                    // glue block
+            // blocks which start with a 32-bit length
+            case 0x16:                                          // C64 ROM type data (deprecated)
+            case 0x17:                                          // C64 turbo tape data (deprecated)
+            case 0x18:                                          // CSW recording
+            case 0x19:                                          // generalized data
+            case 0x4B:                                          // Kansas City standard
+                this->skip(this->read_dword());
+                break;
+            default:
+                // the TZX spec requires all blocks added after
+                // version 1.10 to start with a 32-bit length
+                this->skip(this->read_dword());
+                break;
+        }
+    }
+    this->cur_state = state::end;
+    return false;
+}
+
+//------------------------------------------------------------------------------
+bool
+tzx::next_pulse() {
+    for (;;) {
+        switch (this->cur_state) {
+            case state::idle:
+                if (this->stop_requested || !this->next_block()) {
+                    return false;
+                }
+                break;
+            case state::pilot:
+                if (this->pulses_left > 0) {
+                    this->pulses_left--;
+                    this->level = !this->level;
+                    this->pulse_cycles += this->cycles(this->blk.pilot_len);
+                    return true;
+                }
+                this->cur_state = state::sync1;
+                break;
+            case state::sync1:
+                this->level = !this->level;
+                this->pulse_cycles += this->cycles(this->blk.sync1_len);
+                this->cur_state = state::sync2;
+                return true;
+            case state::sync2:
+                this->level = !this->level;
+                this->pulse_cycles += this->cycles(this->blk.sync2_len);
+                this->cur_state = state::data;
+                return true;
+            case state::data:
+                if (0 == this->data_bits) {
+                    if (0 == this->data_bytes_left) {
+                        this->cur_state = state::pause;
+                        break;
+                    }
+                    this->data_byte = this->read_u8();
+                    this->data_bits = (0 == this->data_bytes_left) ? this->blk.last_bits : 8;
+                    this->half_pulse = 0;
+                }
+                // each bit is encoded as 2 pulses of the same length
+                this->level = !this->level;
+                this->pulse_cycles += this->cycles((this->data_byte & 0x80) ? this->blk.bit1_len : this->blk.bit0_len);
+                if (++this->half_pulse == 2) {
+                    this->half_pulse = 0;
+                    this->data_byte <<= 1;
+                    this->data_bits--;
+                }
+                return true;
+            case state::tone:
+                if (this->pulses_left > 0) {
+                    this->pulses_left--;
+                    this->level = !this->level;
+                    this->pulse_cycles += this->cycles(this->tone_len);
+                    return true;
+                }
+                this->cur_state = state::idle;
+                break;
+            case state::pulses:
+                if (this->pulses_left > 0) {
+                    this->pulses_left--;
+                    this->level = !this->level;
+                    this->pulse_cycles += this->cycles(this->read_word());
+                    return true;
+                }
+                this->cur_state = state::idle;
+                break;
+            case state::direct:
+                if (0 == this->data_bits) {
+                    if (0 == this->data_bytes_left) {
+                        this->cur_state = state::pause;
+                        break;
+                    }
+                    this->data_byte = this->read_u8();
+                    this->data_bits = (0 == this->data_bytes_left) ? this->blk.last_bits : 8;
+                }
+                // one bit per sample, the bit is the signal level
+                this->level = 0 != (this->data_byte & 0x80);
+                this->data_byte <<= 1;
+                this->data_bits--;
+                this->pulse_cycles += this->cycles(this->sample_len);
+                return true;
+            case state::pause:
+                // keep the level for 1ms after the last pulse, then go low
+                if (this->blk.pause_ms <= 0) {
+                    this->cur_state = state::idle;
+                    break;
+                }
+                this->blk.pause_ms--;
+                this->pulse_cycles += this->cycles(3500);
+                this->cur_state = state::pause_low;
+                return true;
+            case state::pause_low:
+                this->level = false;
+                this->cur_state = state::idle;
+                if (this->blk.pause_ms > 0) {
+                    this->pulse_cycles += this->cycles(this->blk.pause_ms * 3500);
+                    return true;
+                }
+                break;
+            case state::end:
+                return false;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+tzx::step(int num_cycles) {
+    this->pulse_cycles -= num_cycles;
+    while (this->pulse_cycles <= 0) {
+        if (!this->next_pulse()) {
+            this->pulse_cycles = 0;
+            break;
+        }
+    }
+    return this->level;
+}
+
+//------------------------------------------------------------------------------
+bool
+tzx::data_block_ready() {
+    if (!this->is_valid()) {
+        return false;
+    }
+    // finished blocks and pauses don't need to be waited for
+    while ((state::idle == this->cur_state) ||
+           (state::pause == this->cur_state) ||
+           (state::pause_low == this->cur_state))
+    {
+        this->cur_state = state::idle;
+        this->pulse_cycles = 0;
+        if (!this->next_block()) {
+            return false;
+        }
+    }
+    const uint8_t id = this->blk.id;
+    return ((standard == id) || (turbo == id) || (pure_data == id)) && !this->data_started;
+}
+
+//------------------------------------------------------------------------------
+int
+tzx::data_left() const {
+    return this->data_bytes_left;
+}
+
+//------------------------------------------------------------------------------
+uint8_t
+tzx::read_u8() {
+    if (this->data_bytes_left > 0) {
+        this->data_bytes_left--;
+        this->data_started = true;
+        return uint8_t(this->read_byte());
+    }
+    else {
+        return 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+tzx::finish_block() {
+    if (!this->is_valid()) {
+        return;
+    }
+    this->skip(this->data_bytes_left);
+    this->data_bytes_left = 0;
+    if (state::pulses == this->cur_state) {
+        this->skip(2 * this->pulses_left);
+    }
+    this->pulses_left = 0;
+    this->pulse_cycles = 0;
+    this->level = false;
+    if (state::end != this->cur_state) {
+        this->cur_state = state::idle;
+    }
+}
+
+} // namespace YAKC
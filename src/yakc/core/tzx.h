@@ -0,0 +1,142 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::tzx
+    @brief streaming reader for TZX (ZX Spectrum) and CDT (Amstrad CPC) tapes
+
+    The tape image is not decoded up front, instead blocks are parsed
+    one after another directly from an opened filesystem file while the
+    tape is playing, only the header of the current block is kept.
+
+    There are two ways to consume the tape:
+
+    - Instant loading: when the system's ROM loader routine is trapped,
+      data_block_ready() checks whether the current block is a data
+      block which hasn't started playing yet, read_u8() reads its data
+      bytes, and finish_block() skips to the next block.
+    - Pulse playback: step() advances the tape by a number of CPU cycles
+      and returns the current tape input level, this is used for turbo
+      and custom loaders which read the tape input port directly.
+
+    Pulse lengths in TZX files are given in ZX Spectrum T-states
+    (3.5 MHz), and are converted to cycles at freq_khz.
+
+    Supported blocks: 0x10 (standard speed data), 0x11 (turbo speed data),
+    0x12 (pure tone), 0x13 (pulse sequence), 0x14 (pure data), 0x15
+    (direct recording), 0x20 (pause / stop), 0x24/0x25 (loops) and
+    0x2B (signal level). All other blocks are skipped.
+*/
+#include "yakc/core/core.h"
+#include "yakc/core/filesystem.h"
+
+namespace YAKC {
+
+class tzx {
+public:
+    /// TZX block ids
+    enum block_id {
+        standard = 0x10,
+        turbo = 0x11,
+        pure_tone = 0x12,
+        pulse_seq = 0x13,
+        pure_data = 0x14,
+        direct_rec = 0x15,
+        pause_stop = 0x20,
+        loop_start = 0x24,
+        loop_end = 0x25,
+        set_level = 0x2B,
+    };
+    /// size of the file header ("ZXTape!", 0x1A, major, minor)
+    static const int header_size = 10;
+
+    /// check the file header of an opened file (doesn't change the file position)
+    static bool is_tzx(filesystem* fs, filesystem::file fp);
+    /// start reading a tape from an opened file at file position 0
+    bool open(filesystem* fs, filesystem::file fp);
+    /// stop reading
+    void close();
+    /// return true if a tape is open
+    bool is_valid() const;
+    /// go back to the start of the tape
+    void rewind();
+
+    /// advance pulse playback, return current tape input level
+    bool step(int num_cycles);
+    /// true if the current (or next) block is a data block which hasn't started to play its data
+    bool data_block_ready();
+    /// number of bytes left in the current data block
+    int data_left() const;
+    /// read the next data byte of the current data block
+    uint8_t read_u8();
+    /// skip the remaining data of the current block and continue with the next block
+    void finish_block();
+
+    /// the CPU frequency for converting T-states to cycles
+    int freq_khz = 3500;
+    /// current tape input level
+    bool level = false;
+    /// set when a 'stop the tape' block has been reached
+    bool stop_requested = false;
+    /// number of started data blocks (can be used as tape counter)
+    int num_data_blocks = 0;
+
+    /// the header of the current block
+    struct block {
+        uint8_t id = 0;
+        int pilot_len = 0;
+        int sync1_len = 0;
+        int sync2_len = 0;
+        int bit0_len = 0;
+        int bit1_len = 0;
+        int pilot_pulses = 0;
+        int last_bits = 8;
+        int pause_ms = 0;
+        int data_size = 0;
+    } blk;
+
+private:
+    friend class savestate;
+    enum class state {
+        idle,       // need to read the next block
+        pilot,
+        sync1,
+        sync2,
+        data,
+        tone,
+        pulses,
+        direct,
+        pause,
+        pause_low,
+        end,
+    };
+    /// read little-endian values from the file
+    int read_byte();
+    int read_word();
+    int read_u24();
+    int read_dword();
+    /// skip bytes in the file
+    void skip(int num_bytes);
+    /// read the next block header and setup pulse generation, false at end of tape
+    bool next_block();
+    /// generate the next pulse, false at end of tape
+    bool next_pulse();
+    /// convert T-states to CPU cycles
+    int cycles(int tstates) const;
+
+    filesystem* fs = nullptr;
+    filesystem::file fp = filesystem::invalid_file;
+    state cur_state = state::end;
+    int pulse_cycles = 0;       // remaining cycles of current pulse
+    int pulses_left = 0;        // pilot, tone or pulse sequence pulses
+    int data_bytes_left = 0;
+    bool data_started = false;
+    uint8_t data_byte = 0;
+    int data_bits = 0;          // bits left in data_byte
+    int half_pulse = 0;         // 0 or 1, each bit is 2 pulses
+    int tone_len = 0;
+    int sample_len = 0;         // direct recording
+    int loop_pos = 0;
+    int loop_count = 0;
+};
+
+} // namespace YAKC
@@ -9,39 +9,81 @@
 namespace YAKC {
 
 //------------------------------------------------------------------------------
-bool
-tapedeck::insert_tape(const char* name_, filetype type_, const void* data, int num_bytes) {
-    YAKC_ASSERT(name_ && data && num_bytes > 0);
-
+void
+tapedeck::remove_tape() {
     name[0] = 0;
     type = filetype::none;
     playing = false;
     count = 0;
-
-    // remove previous tape?
+    tzx.close();
     if (fp) {
         fs.close_rm(fp);
         fp = filesystem::invalid_file;
     }
+}
 
-    // store the new tape data into the memory filesystem
+//------------------------------------------------------------------------------
+void
+tapedeck::begin_insert(const char* name_, filetype type_) {
+    YAKC_ASSERT(name_);
+    this->remove_tape();
     strncpy(name, name_, sizeof(name));
     name[sizeof(name)-1] = 0;
     type = type_;
-    playing = false;
-    fp = fs.open(name, filesystem::mode::write);
-    if (fp) {
-        fs.write(fp, data, num_bytes);
-        fs.close(fp);
+}
 
+//------------------------------------------------------------------------------
+bool
+tapedeck::end_insert(bool added) {
+    if (added) {
         // open the file for reading
-        fs.open(name, filesystem::mode::read);
-
-        return true;
+        fp = fs.open(name, filesystem::mode::read);
     }
-    else {
+    if (!fp) {
+        name[0] = 0;
+        type = filetype::none;
         return false;
     }
+    if ((filetype::zx_tzx == type) || (filetype::cpc_cdt == type)) {
+        if (!tzx.open(&fs, fp)) {
+            this->remove_tape();
+            return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+tapedeck::insert_tape(const char* name_, filetype type_, const void* data, int num_bytes) {
+    YAKC_ASSERT(name_ && data && num_bytes > 0);
+    this->begin_insert(name_, type_);
+
+    // store a copy of the tape data in the memory filesystem
+    bool added = false;
+    auto wr_fp = fs.open(name, filesystem::mode::write);
+    if (wr_fp) {
+        fs.write(wr_fp, data, num_bytes);
+        fs.close(wr_fp);
+        added = true;
+    }
+    return this->end_insert(added);
+}
+
+//------------------------------------------------------------------------------
+bool
+tapedeck::insert_external_tape(const char* name_, filetype type_, const void* data, int num_bytes) {
+    YAKC_ASSERT(name_ && data && num_bytes > 0);
+    this->begin_insert(name_, type_);
+    return this->end_insert(fs.add_external(name, data, num_bytes));
+}
+
+//------------------------------------------------------------------------------
+bool
+tapedeck::insert_mapped_tape(const char* name_, filetype type_, const char* path) {
+    YAKC_ASSERT(name_ && path);
+    this->begin_insert(name_, type_);
+    return this->end_insert(fs.add_mapped(name, path));
 }
 
 //------------------------------------------------------------------------------
@@ -70,6 +112,7 @@ tapedeck::eof() {
 void
 tapedeck::play() {
     playing = true;
+    tzx.stop_requested = false;
 }
 
 //------------------------------------------------------------------------------
@@ -85,7 +128,21 @@ tapedeck::stop_rewind() {
     count = 0;
     if (fp) {
         fs.set_pos(fp, 0);
+        tzx.rewind();
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+tapedeck::step(int cycles) {
+    if (playing && tzx.is_valid()) {
+        tzx.step(cycles);
+        if (tzx.stop_requested) {
+            tzx.stop_requested = false;
+            playing = false;
+        }
     }
+    return tzx.level;
 }
 
 //------------------------------------------------------------------------------
@@ -3,10 +3,16 @@
 /**
     @class YAKC::tapedeck
     @brief a sort-of-tapedeck abstraction
+
+    TAP-style tapes are read through read() by the system's trapped
+    ROM loader routine. TZX and CDT tapes are read through the
+    tzx block reader, either block-wise by a trapped ROM loader,
+    or as pulses through step() while the tape is playing.
 */
 #include "yakc/core/core.h"
 #include "yakc/core/filesystem.h"
 #include "yakc/core/filetypes.h"
+#include "yakc/core/tzx.h"
 
 namespace YAKC {
 
@@ -14,6 +20,12 @@ class tapedeck {
 public:
     /// insert a new 'tape', remove the previous 'tape'
     bool insert_tape(const char* name, filetype type, const void* data, int num_bytes);
+    /// insert a 'tape' without copying, data must remain valid until the tape is removed
+    bool insert_external_tape(const char* name, filetype type, const void* data, int num_bytes);
+    /// insert a 'tape' by memory-mapping a host file
+    bool insert_mapped_tape(const char* name, filetype type, const char* path);
+    /// remove the current 'tape'
+    void remove_tape();
     /// press the play button
     void play();
     /// press the stop button
@@ -25,6 +37,8 @@ public:
     int read(void* ptr, int num_bytes);
     /// test if there's more data on the tape
     bool eof();
+    /// advance a playing TZX/CDT tape by CPU cycles, return the tape signal level
+    bool step(int cycles);
 
     /// get name of current tape
     const char* tape_name() const;
@@ -38,7 +52,16 @@ public:
     /// current counter value
     int counter() const;
 
+    /// block reader for TZX/CDT tapes (only valid if such a tape is inserted)
+    class tzx tzx;
+
 private:
+    friend class savestate;
+    /// remove previous tape and setup tape name and type
+    void begin_insert(const char* name, filetype type);
+    /// open the tape file for reading
+    bool end_insert(bool added);
+
     filesystem fs;
     filesystem::file fp = filesystem::invalid_file;
     static const int max_name_len = filesystem::file_item::max_name_size;
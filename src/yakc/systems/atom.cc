@@ -129,6 +129,7 @@ atom::check_roms(const rom_images& roms, system model, os_rom os) {
 void
 atom::on_context_switched() {
     // FIXME
+    via->update(this);
 }
 
 //------------------------------------------------------------------------------
@@ -147,9 +148,7 @@ atom::poweron() {
 
     // initialize the memory map
     // fill memory with random junk
-    memcpy(board->ram[0], board->random, breadboard::ram_bank_size);
-    memcpy(board->ram[1], board->random, breadboard::ram_bank_size);
-    memcpy(board->ram[2], board->random, breadboard::ram_bank_size);
+    fill_random(board->ram[0], 3 * breadboard::ram_bank_size);
     clear(board->ram[3], sizeof(board->ram[3]));
     auto& mem = cpu->mem;
     mem.unmap_all();
@@ -169,7 +168,9 @@ atom::poweron() {
     const int freq_khz = 1000;
     board->clck.init(freq_khz);
     cpu->init(this);
+    cpu->tick_bus = false;
     cpu->reset();
+    op_tick = synced_tick = 0;
     ppi->init(0);
     via->init(1);
     vdg->init(read_vidmem, board->rgba8_buffer, freq_khz);
@@ -212,9 +213,18 @@ uint64_t
 atom::step(uint64_t start_tick, uint64_t end_tick) {
     auto& dbg = board->dbg;
     uint64_t cur_tick = start_tick;
+    op_tick = synced_tick;
     while (cur_tick < end_tick) {
         uint32_t ticks = cpu->step();
+        op_tick += ticks;
+        if (int(op_tick - synced_tick) >= via->ticks_until_event()) {
+            // a VIA timer has reached zero, catch up so that
+            // a timer interrupt is seen by the next instruction
+            catch_up(op_tick);
+        }
         if (dbg.step(cpu->PC, ticks)) {
+            catch_up(op_tick);
+            via->update(this);
             return end_tick;
         }
         if (cpu->PC == osload_trap) {
@@ -223,13 +233,19 @@ atom::step(uint64_t start_tick, uint64_t end_tick) {
         }
         cur_tick += ticks;
     }
+    catch_up(op_tick);
+    via->update(this);
     return cur_tick;
 }
 
 //------------------------------------------------------------------------------
 uint32_t
 atom::step_debug() {
+    op_tick = synced_tick;
     uint32_t ticks = cpu->step();
+    op_tick += ticks;
+    catch_up(op_tick);
+    via->update(this);
     board->dbg.step(cpu->PC, ticks);
     return ticks;
 }
@@ -268,31 +284,43 @@ atom::put_input(uint8_t ascii, uint8_t joy0mask) {
 
 //------------------------------------------------------------------------------
 void
-atom::cpu_tick() {
-    vdg->step();
-    via->step(this);
-
-    // update the sound beeper
-    // NOTE: don't make the cassette output audible, since it
-    // seems to get stuck at a 2.4kHz sound at the end of saving BASIC programs
-    board->beeper.write(out_beep);// || ((!state_2_4khz && out_cass1) && out_cass0));
-    board->beeper.step(1);
-
-    // tick the 2.4kHz counter
-    if (counter_2_4khz.tick()) {
-        state_2_4khz = !state_2_4khz;
+atom::catch_up(uint64_t tick) {
+    if (tick <= synced_tick) {
+        return;
     }
+    const int num_ticks = int(tick - synced_tick);
+    synced_tick = tick;
 
+    // the video chip advances by whole scanlines
+    board->num_scanlines += vdg->step(num_ticks);
     // on FSYNC, feed next input key mask, this gives the OS
     // 1 full frame to scan the keyboard matrix
     if (vdg->on(mc6847::FSYNC)) {
         cur_key_mask = next_key_mask;
     }
+
+    // update the sound beeper, the output bit can only
+    // change in an IO access, so it is constant until now
+    // NOTE: don't make the cassette output audible, since it
+    // seems to get stuck at a 2.4kHz sound at the end of saving BASIC programs
+    board->beeper.write(out_beep);// || ((!state_2_4khz && out_cass1) && out_cass0));
+    board->beeper.step(num_ticks);
+
+    // the VIA timers are only updated when a timer reaches zero
+    via->step(this, num_ticks);
+
+    // advance the 2.4kHz counter
+    counter_2_4khz.update(num_ticks);
+    while (counter_2_4khz.step()) {
+        state_2_4khz = !state_2_4khz;
+    }
 }
 
 //------------------------------------------------------------------------------
 uint8_t
 atom::memio(bool write, uint16_t addr, uint8_t inval) {
+    // bring the peripherals up to the current CPU cycle
+    self->catch_up(self->op_tick + self->cpu->Cycle);
     if ((addr >= 0xB000) && (addr < 0xB400)) {
         // i8255: http://www.acornatom.nl/sites/fpga/www.howell1964.freeserve.co.uk/acorn/atom/amb/amb_8255.htm
         if (write) {
@@ -476,6 +504,13 @@ atom::pio_in(int pio_id, int port_id) {
     return val;
 }
 
+//------------------------------------------------------------------------------
+void
+atom::irq(bool b) {
+    // the VIA IRQ output is connected to the CPU IRQ line
+    cpu->irq(b);
+}
+
 //------------------------------------------------------------------------------
 const void*
 atom::framebuffer(int& out_width, int& out_height) {
@@ -557,10 +592,16 @@ atom::osload() {
         if (cpu->mem.r8io(0xCD) & 0x80) {
             addr = cpu->mem.r16io(0xCB);
         }
-        for (int i = 0; i < hdr.length; i++) {
-            uint8_t val;
-            tape->read(&val, sizeof(val));
-            cpu->mem.w8io(addr++, val);
+        int len = hdr.length;
+        while (len > 0) {
+            uint8_t buf[1024];
+            const int num = tape->read(buf, len < int(sizeof(buf)) ? len : int(sizeof(buf)));
+            if (num <= 0) {
+                break;
+            }
+            cpu->mem.write(addr, buf, num);
+            addr += num;
+            len -= num;
         }
         success = true;
     }
@@ -63,12 +63,14 @@ public:
     static uint8_t memio(bool write, uint16_t addr, uint8_t inval);
     /// vidmem reader function (called from mc6847)
     static uint8_t read_vidmem(uint16_t addr);
-    /// called by cycle-stepped CPU per 'subcycle'
-    virtual void cpu_tick() override;
+    /// bring the peripherals up to a CPU tick
+    void catch_up(uint64_t tick);
     /// PIO output callback
     virtual void pio_out(int pio_id, int port_id, uint8_t val) override;
     /// PIO input callback
     virtual uint8_t pio_in(int pio_id, int port_id) override;
+    /// interrupt request from the VIA
+    virtual void irq(bool b) override;
 
     static atom* self;
     bool on = false;
@@ -84,6 +86,13 @@ public:
     bool out_cass1 = false;
     uint16_t osload_trap = 0x0000;
 
+    // the peripherals are not ticked by the CPU, but brought up to
+    // date in bulk when the CPU accesses the IO area, and at the
+    // end of step(), op_tick is the tick at the start of the current
+    // instruction, synced_tick the tick the peripherals are at
+    uint64_t op_tick = 0;
+    uint64_t synced_tick = 0;
+
     // keyboard matrix has 10 columns @ 8 rows,
     // complete row 6 is ctrl
     // complete row 7 is shift
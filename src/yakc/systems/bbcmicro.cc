@@ -56,7 +56,7 @@ bbcmicro::poweron(system m) {
     this->on = true;
     
     // map memory
-    clear(this->board->ram, sizeof(this->board->ram));
+    clear(this->board->ram, this->board->ram_size());
     this->init_memory_map();
 
     // initialize clock to 2 MHz
@@ -64,7 +64,9 @@ bbcmicro::poweron(system m) {
 
     // CPU start state
     this->board->mos6502.init(this);
+    this->board->mos6502.tick_bus = false;
     this->board->mos6502.reset();
+    this->op_tick = this->synced_tick = 0;
 
     // hardware subsystems
     this->video.init(this->board);
@@ -91,13 +93,17 @@ bbcmicro::step(uint64_t start_tick, uint64_t end_tick) {
     auto& cpu = this->board->mos6502;
     auto& dbg = this->board->dbg;
     uint64_t cur_tick = start_tick;
+    this->op_tick = this->synced_tick;
     while (cur_tick < end_tick) {
         uint32_t ticks = cpu.step();
+        this->op_tick += ticks;
         if (dbg.step(cpu.PC, ticks)) {
+            this->catch_up(this->op_tick);
             return end_tick;
         }
         cur_tick += ticks;
     }
+    this->catch_up(this->op_tick);
     return cur_tick;
 }
 
@@ -105,20 +111,28 @@ bbcmicro::step(uint64_t start_tick, uint64_t end_tick) {
 uint32_t
 bbcmicro::step_debug() {
     auto& cpu = board->mos6502;
+    this->op_tick = this->synced_tick;
     uint32_t ticks = cpu.step();
+    this->op_tick += ticks;
+    this->catch_up(this->op_tick);
     board->dbg.step(cpu.PC, ticks);
     return ticks;
 }
 
 //------------------------------------------------------------------------------
 void
-bbcmicro::cpu_tick() {
-    this->video.step();
+bbcmicro::catch_up(uint64_t tick) {
+    if (tick > this->synced_tick) {
+        this->video.step(int(tick - this->synced_tick));
+        this->synced_tick = tick;
+    }
 }
 
 //------------------------------------------------------------------------------
 uint8_t
 bbcmicro::memio(bool write, uint16_t addr, uint8_t inval) {
+    // bring the video hardware up to the current CPU cycle
+    self->catch_up(self->op_tick + self->board->mos6502.Cycle);
     if (write) {
         if (addr >= 0xFF00) {
             // the last 256 bytes of ROM
@@ -47,13 +47,17 @@ public:
 
     /// memory-mapped-io callback
     static uint8_t memio(bool write, uint16_t addr, uint8_t inval);
-    /// called by cycle-stepped CPU per 'subcycle'
-    virtual void cpu_tick();
+    /// bring the video hardware up to a CPU tick
+    void catch_up(uint64_t tick);
 
     static bbcmicro* self;
     system cur_model = system::bbcmicro_b;
     bool on = false;
     bbcmicro_video video;
+    // the video hardware is not ticked by the CPU, but brought up to date
+    // when the CPU accesses the IO area, and at the end of step() (see atom.h)
+    uint64_t op_tick = 0;
+    uint64_t synced_tick = 0;
 };
 
 } // namespace YAKC
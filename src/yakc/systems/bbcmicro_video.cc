@@ -48,18 +48,21 @@ bbcmicro_video::write_palette(uint8_t v) {
 
 //------------------------------------------------------------------------------
 void
-bbcmicro_video::step() {
+bbcmicro_video::step(int num_cycles) {
     // http://beebwiki.mdfs.net/Video_ULA
-    // the CRTC can be driven at 1 or 2 MHz
-    if (--this->tick_count == 0) {
+    // the CRTC can be driven at 1 or 2 MHz, the rate can only
+    // change on an IO write, so it is constant for num_cycles
+    this->tick_count -= num_cycles;
+    while (this->tick_count <= 0) {
 
-        this->tick_count = this->tick_period;
+        this->tick_count += this->tick_period;
 
         auto& crtc = this->board->mc6845;
         auto& crt = this->board->crt;
         crtc.step();
         if (crtc.on(mc6845::HSYNC)) {
             crt.trigger_hsync();
+            this->board->num_scanlines++;
         }
         if (crtc.on(mc6845::VSYNC)) {
             crt.trigger_vsync();
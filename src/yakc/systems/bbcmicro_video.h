@@ -14,8 +14,8 @@ public:
     void init(breadboard* board);
     /// perform a reset
     void reset();
-    /// step the video hardware (at 2 MHz)
-    void step();
+    /// step the video hardware by a number of CPU cycles (at 2 MHz)
+    void step(int num_cycles);
     /// decode the next 16 pixels into the emulator framebuffer
     void decode_pixels(uint32_t* dst);
 
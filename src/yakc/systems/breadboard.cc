@@ -0,0 +1,59 @@
+//------------------------------------------------------------------------------
+//  breadboard.cc
+//------------------------------------------------------------------------------
+#include "breadboard.h"
+
+namespace YAKC {
+
+//------------------------------------------------------------------------------
+breadboard::~breadboard() {
+    this->free_memory();
+}
+
+//------------------------------------------------------------------------------
+void
+breadboard::alloc_memory(int num_banks, int fb_width, int fb_height) {
+    YAKC_ASSERT((num_banks > 0) && (num_banks <= max_ram_banks));
+    YAKC_ASSERT((fb_width <= global_max_fb_width) && (fb_height <= global_max_fb_height));
+    // only re-allocate what has changed, so that pointers to the
+    // framebuffer stay valid when only the number of RAM banks changes
+    if (this->num_ram_banks != num_banks) {
+        if (this->ram) {
+            YAKC_FREE(this->ram);
+        }
+        this->num_ram_banks = num_banks;
+        this->ram = (uint8_t(*)[ram_bank_size]) YAKC_MALLOC(num_banks * ram_bank_size);
+    }
+    const int fb_size = fb_width * fb_height;
+    if (this->rgba8_buffer_size != fb_size) {
+        if (this->rgba8_buffer) {
+            YAKC_FREE(this->rgba8_buffer);
+        }
+        this->rgba8_buffer_size = fb_size;
+        this->rgba8_buffer = (uint32_t*) YAKC_MALLOC(fb_size * sizeof(uint32_t));
+        clear(this->rgba8_buffer, fb_size * sizeof(uint32_t));
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+breadboard::free_memory() {
+    if (this->ram) {
+        YAKC_FREE(this->ram);
+        this->ram = nullptr;
+    }
+    if (this->rgba8_buffer) {
+        YAKC_FREE(this->rgba8_buffer);
+        this->rgba8_buffer = nullptr;
+    }
+    this->num_ram_banks = 0;
+    this->rgba8_buffer_size = 0;
+}
+
+//------------------------------------------------------------------------------
+int
+breadboard::ram_size() const {
+    return this->num_ram_banks * ram_bank_size;
+}
+
+} // namespace YAKC
@@ -3,6 +3,10 @@
 /**
     @class YAKC::breadboard
     @brief houses all the common chips required by emulated systems
+
+    The RAM banks and the RGBA8 framebuffer are not embedded, but
+    allocated at poweron with the size the emulated system actually
+    needs, and freed again at poweroff.
 */
 #include "yakc/core/core.h"
 #include "yakc/core/clock.h"
@@ -39,12 +43,24 @@ public:
     class ay8910 ay8910;
     cpudbg dbg;
     class crt crt;          // this is not a chip, but a cathode-ray-tube emulation
-    static const int num_ram_banks = 8;
+    static const int max_ram_banks = 8;
     static const int ram_bank_size = 0x4000;
-    uint8_t ram[num_ram_banks][ram_bank_size];
-    uint8_t random[ram_bank_size];  // a 16-kbyte bank filled with random numbers
-    uint8_t junk[ram_bank_size];    // a 16-kbyte page for junk writes
-    uint32_t rgba8_buffer[global_max_fb_width*global_max_fb_height]; // RGBA8 linear pixel buffer
+
+    /// destructor, frees allocated memory
+    ~breadboard();
+    /// (re-)allocate RAM banks and framebuffer if their size has changed (RAM content is undefined)
+    void alloc_memory(int num_ram_banks, int fb_width, int fb_height);
+    /// free RAM banks and framebuffer
+    void free_memory();
+    /// size of allocated RAM in bytes
+    int ram_size() const;
+
+    int num_ram_banks = 0;
+    uint8_t (*ram)[ram_bank_size] = nullptr;    // RAM banks, allocated at poweron
+    uint8_t junk[ram_bank_size];                // a 16-kbyte page for junk writes
+    uint32_t* rgba8_buffer = nullptr;           // RGBA8 linear pixel buffer, allocated at poweron
+    int rgba8_buffer_size = 0;                  // number of pixels in rgba8_buffer
+    uint64_t num_scanlines = 0;                 // video scanlines generated by the system (statistics, see stats.h)
 };
 
 } // namespace YAKC
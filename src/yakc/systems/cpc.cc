@@ -116,17 +116,19 @@ cpc::check_roms(const rom_images& roms, system model, os_rom os) {
 void
 cpc::init_memory_map() {
     auto& cpu = this->board->z80;
+    cpu.mem.begin_remap();
     cpu.mem.unmap_all();
     YAKC_ASSERT(check_roms(*this->roms, this->cur_model, os_rom::none));
     this->ga_config = 0x00;     // enable both ROMs
     this->ram_config = 0x00;    // standard RAM bank config (0,1,2,3)
     this->update_memory_mapping();
+    cpu.mem.end_remap();
 }
 
 //------------------------------------------------------------------------------
 void
 cpc::on_context_switched() {
-    // FIXME!
+    this->update_memory_mapping();
 }
 
 //------------------------------------------------------------------------------
@@ -155,11 +157,12 @@ cpc::poweron(system m) {
     this->cur_key_mask = key_mask();
 
     // map memory
-    clear(this->board->ram, sizeof(this->board->ram));
+    clear(this->board->ram, this->board->ram_size());
     this->init_memory_map();
 
     // initialize clock to 4 MHz
     this->board->clck.init(4000);
+    this->tape->tzx.freq_khz = 4000;
 
     // initialize support chips
     this->board->i8255.init(0);
@@ -216,6 +219,9 @@ cpc::step(uint64_t start_tick, uint64_t end_tick) {
 
         this->video.step(this, ticks);
         this->board->ay8910.step(ticks);
+        if (this->tape->is_playing()) {
+            this->tape->step(ticks);
+        }
 
         if (dbg.step(cpu.PC, ticks)) {
             return end_tick;
@@ -247,6 +253,9 @@ cpc::step_debug() {
         ticks = (ticks + 3) & ~3;
         this->video.step(this, ticks);
         this->board->ay8910.step(ticks);
+        if (this->tape->is_playing()) {
+            this->tape->step(ticks);
+        }
         dbg.step(cpu.PC, ticks);
         all_ticks += ticks;
     }
@@ -435,6 +444,9 @@ cpc::pio_in(int /*pio_id*/, int port_id) {
         if (this->video.vsync_bit()) {
             val |= (1<<0);
         }
+        if (this->tape->is_playing() && this->tape->tzx.level) {
+            val |= (1<<7);
+        }
         return val;
     }
     else {
@@ -477,6 +489,7 @@ cpc::update_memory_mapping() {
         rom1_ptr = this->roms->ptr(rom_images::cpc464_basic);
     }
     auto& cpu = this->board->z80;
+    cpu.mem.begin_remap();
     const int i0 = ram_config_table[ram_table_index][0];
     const int i1 = ram_config_table[ram_table_index][1];
     const int i2 = ram_config_table[ram_table_index][2];
@@ -503,6 +516,7 @@ cpc::update_memory_mapping() {
         // read from ROM, write to RAM
         cpu.mem.map_rw(0, 0xC000, 0x4000, rom1_ptr, this->board->ram[i3]);
     }
+    cpu.mem.end_remap();
 }
 
 //------------------------------------------------------------------------------
@@ -588,14 +602,12 @@ cpc::load_sna(filesystem* fs, const char* name, filetype type, bool start) {
     if (fs->read(fp, &hdr, sizeof(hdr)) == sizeof(hdr)) {
         hdr_valid = true;
         const uint16_t dump_size = (hdr.dump_size_h<<8 | hdr.dump_size_l) & 0xFFFF;
-        if (dump_size == 64) {
-            YAKC_ASSERT(sizeof(this->board->ram) >= 0x10000);
-            fs->read(fp, this->board->ram, 0x10000);
-        }
-        else {
-            YAKC_ASSERT(sizeof(this->board->ram) >= 0x20000);
-            fs->read(fp, this->board->ram, 0x20000);
+        // a 128 KByte dump on a 64 KByte machine only loads the first 64 KBytes
+        int num_bytes = (dump_size == 64) ? 0x10000 : 0x20000;
+        if (num_bytes > this->board->ram_size()) {
+            num_bytes = this->board->ram_size();
         }
+        fs->read(fp, this->board->ram, num_bytes);
     }
     // CPU state
     auto& cpu = this->board->z80;
@@ -660,6 +672,10 @@ cpc::quickload(filesystem* fs, const char* name, filetype type, bool start) {
 //------------------------------------------------------------------------------
 void
 cpc::casread() {
+    if (filetype::cpc_cdt == this->tape->tape_filetype()) {
+        this->casread_cdt();
+        return;
+    }
     auto& cpu = this->board->z80;
     bool success = false;
     // read the next block
@@ -673,9 +689,55 @@ cpc::casread() {
         for (uint16_t i = 0; i < (len-1); i++) {
             uint8_t val;
             this->tape->read(&val, sizeof(val));
-            cpu.mem.w8(cpu.HL++, val);
+            cpu.mem.w8io(cpu.HL++, val);
+        }
+    }
+    cpu.F = success ? 0x45 : 0x00;
+    cpu.PC = this->casread_ret;
+}
+
+//------------------------------------------------------------------------------
+void
+cpc::casread_cdt() {
+    // CDT blocks written by the CPC ROM are turbo-speed data blocks
+    // with a sync byte, followed by 256-byte segments with a 2-byte CRC
+    // each, if the current block doesn't look like this, don't trap
+    // and let the ROM loader read the tape signal, a CRC mismatch
+    // returns a read error like the ROM loader would
+    auto& cpu = this->board->z80;
+    auto& tzx = this->tape->tzx;
+    const int num_segs = (cpu.DE + 255) / 256;
+    if (!tzx.data_block_ready() ||
+        (tzx::turbo != tzx.blk.id) ||
+        (tzx.data_left() < (1 + num_segs * 258)))
+    {
+        return;
+    }
+    bool success = false;
+    if (tzx.read_u8() == cpu.A) {
+        success = true;
+        int len = cpu.DE;
+        for (int seg = 0; (seg < num_segs) && success; seg++) {
+            // CRC-16 CCITT over the segment, stored inverted, high byte first
+            uint16_t crc = 0xFFFF;
+            for (int i = 0; i < 256; i++) {
+                const uint8_t val = tzx.read_u8();
+                if (len > 0) {
+                    cpu.mem.w8io(cpu.HL++, val);
+                    len--;
+                }
+                crc ^= val << 8;
+                for (int bit = 0; bit < 8; bit++) {
+                    crc = (crc & 0x8000) ? ((crc << 1) ^ 0x1021) : (crc << 1);
+                }
+            }
+            uint16_t seg_crc = tzx.read_u8() << 8;
+            seg_crc |= tzx.read_u8();
+            success = (seg_crc == uint16_t(~crc));
         }
     }
+    tzx.finish_block();
+    this->tape->inc_counter(1);
     cpu.F = success ? 0x45 : 0x00;
     cpu.PC = this->casread_ret;
 }
@@ -62,6 +62,8 @@ public:
     bool load_sna(filesystem* fs, const char* name, filetype type, bool start);
     /// the trapped casread function for TAP files
     void casread();
+    /// instant block loading for CDT files, called from casread()
+    void casread_cdt();
 
     /// the z80 out callback
     virtual void cpu_out(uint16_t port, uint8_t val) override;
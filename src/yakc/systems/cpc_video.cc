@@ -157,6 +157,7 @@ cpc_video::handle_crtc_sync(system_bus* bus) {
         this->hsync_start_count--;
         if (this->hsync_start_count == 0) {
             crt.trigger_hsync();
+            this->board->num_scanlines++;
             this->hsync_end_count = 4;
         }
     }
@@ -51,6 +51,7 @@ kc85::on_context_switched() {
     this->update_bank_switching();
     this->board->z80.connect_irq_device(&this->board->z80ctc.channels[0].int_ctrl);
     this->board->z80ctc.init_daisychain(&this->board->z80pio.int_ctrl);
+    this->board->z80ctc.update(this);
 }
 
 //------------------------------------------------------------------------------
@@ -86,12 +87,10 @@ kc85::poweron(system m, os_rom os) {
     // fill RAM banks with noise (but not on KC85/4? at least the 4
     // doesn't have the random-color-pattern when switching it on)
     if (system::kc85_4 == m) {
-        clear(this->board->ram, sizeof(this->board->ram));
+        clear(this->board->ram, this->board->ram_size());
     }
     else {
-        for (int i = 0; i < breadboard::num_ram_banks; i++) {
-            memcpy(this->board->ram[i], this->board->random, breadboard::ram_bank_size);
-        }
+        fill_random(this->board->ram, this->board->ram_size());
     }
 
     // set operating system pointers
@@ -199,19 +198,23 @@ kc85::step(uint64_t start_tick, uint64_t end_tick) {
     auto& clk = this->board->clck;
     auto& dbg = this->board->dbg;
     this->handle_keyboard_input();
-    uint64_t cur_tick = start_tick;
-    while (cur_tick < end_tick) {
+    this->cur_tick = start_tick;
+    this->end_tick = end_tick;
+    while (this->cur_tick < end_tick) {
         uint32_t ticks = cpu.step(this);
         ticks += cpu.handle_irq(this);
         clk.step(this, ticks);
         ctc.step(this, ticks);
         this->audio.step(ticks);
         if (dbg.step(cpu.PC, ticks)) {
+            ctc.update(this);
             return end_tick;
         }
-        cur_tick += ticks;
+        this->cur_tick += ticks;
     }
-    return cur_tick;
+    this->end_tick = this->cur_tick;
+    ctc.update(this);
+    return this->cur_tick;
 }
 
 //------------------------------------------------------------------------------
@@ -234,6 +237,7 @@ kc85::step_debug() {
         all_ticks += ticks;
     }
     while ((old_pc == cpu.PC) && !cpu.INV);    
+    ctc.update(this);
     return uint32_t(all_ticks);
 }
 
@@ -271,45 +275,45 @@ kc85::handle_keyboard_input() {
     const uword ix = this->board->z80.IX;
     if (0 == this->key_code) {
         // if keycode is 0, this basically means the CTC3 timeout was hit
-        mem.w8(ix+0x8, mem.r8(ix+0x8)|timeout); // set the CTC3 timeout bit
-        mem.w8(ix+0xD, 0);                      // clear current keycode
+        mem.w8io(ix+0x8, mem.r8io(ix+0x8)|timeout); // set the CTC3 timeout bit
+        mem.w8io(ix+0xD, 0);                      // clear current keycode
     }
     else {
         // a valid keycode has been received, clear the timeout bit
-        mem.w8(ix+0x8, mem.r8(ix+0x8)&~timeout);
+        mem.w8io(ix+0x8, mem.r8io(ix+0x8)&~timeout);
 
         // check for key-repeat
-        if (this->key_code != mem.r8(ix+0xD)) {
+        if (this->key_code != mem.r8io(ix+0xD)) {
             // no key-repeat
-            mem.w8(ix+0xD, this->key_code);             // write new keycode
-            mem.w8(ix+0x8, mem.r8(ix+0x8)&~repeat);     // clear the first-key-repeat bit
-            mem.w8(ix+0x8, mem.r8(ix+0x8)|keyready);    // set the key-ready bit
-            mem.w8(ix+0xA, 0);                          // clear the key-repeat counter
+            mem.w8io(ix+0xD, this->key_code);             // write new keycode
+            mem.w8io(ix+0x8, mem.r8io(ix+0x8)&~repeat);     // clear the first-key-repeat bit
+            mem.w8io(ix+0x8, mem.r8io(ix+0x8)|keyready);    // set the key-ready bit
+            mem.w8io(ix+0xA, 0);                          // clear the key-repeat counter
         }
         else {
             // handle key-repeat
-            mem.w8(ix+0xA, mem.r8(ix+0xA)+1);   // increment repeat-pause-counter
-            if (mem.r8(ix+0x8) & repeat) {
+            mem.w8io(ix+0xA, mem.r8io(ix+0xA)+1);   // increment repeat-pause-counter
+            if (mem.r8io(ix+0x8) & repeat) {
                 // this is a followup, short key-repeat
-                if (mem.r8(ix+0xA) < short_repeat_count) {
+                if (mem.r8io(ix+0xA) < short_repeat_count) {
                     // wait some more...
                     return;
                 }
             }
             else {
                 // this is the first, long key-repeat
-                if (mem.r8(ix+0xA) < long_repeat_count) {
+                if (mem.r8io(ix+0xA) < long_repeat_count) {
                     // wait some more...
                     return;
                 }
                 else {
                     // first key-repeat pause over, set first-key-repeat flag
-                    mem.w8(ix+0x8, mem.r8(ix+0x8)|repeat);
+                    mem.w8io(ix+0x8, mem.r8io(ix+0x8)|repeat);
                 }
             }
             // key-repeat triggered, just set the key-ready flag and reset repeat-count
-            mem.w8(ix+0x8, mem.r8(ix+0x8)|keyready);
-            mem.w8(ix+0xA, 0);
+            mem.w8io(ix+0x8, mem.r8io(ix+0x8)|keyready);
+            mem.w8io(ix+0xA, 0);
         }
     }
 }
@@ -431,6 +435,16 @@ kc85::pio_out(int pio_id, int port_id, ubyte val) {
     }
 }
 
+//------------------------------------------------------------------------------
+int
+kc85::cpu_block_budget() {
+    // block instructions may run until the next clock timer
+    // or CTC timer event, or the end of the current step() call
+    int budget = int(this->end_tick - this->cur_tick);
+    budget = this->board->clck.cycles_until_timer(budget);
+    return this->board->z80ctc.ticks_until_event(budget);
+}
+
 //------------------------------------------------------------------------------
 void
 kc85::irq(bool b) {
@@ -459,6 +473,8 @@ kc85::timer(int timer_id) {
 void
 kc85::update_bank_switching() {
     auto& cpu = this->board->z80;
+    // batch the remapping, visible pages are only updated once in end_remap()
+    cpu.mem.begin_remap();
     cpu.mem.unmap_layer(0);
 
     if ((system::kc85_2 == this->cur_model) || (system::kc85_3 == this->cur_model)) {
@@ -530,6 +546,7 @@ kc85::update_bank_switching() {
 
     // map modules in base-device expansion slots
     this->exp.update_memory_mappings(cpu.mem);
+    cpu.mem.end_remap();
 }
 
 //------------------------------------------------------------------------------
@@ -557,9 +574,9 @@ kc85::quickload(filesystem* fs, const char* name, filetype type, bool start) {
                 static const int block_size = 129;
                 uint8_t block[block_size];
                 fs->read(fp, block, block_size);
-                for (int i = 1; (i < block_size) && (addr < end_addr); i++) {
-                    mem.w8(addr++, block[i]);
-                }
+                const int num = (end_addr - addr) < (block_size - 1) ? (end_addr - addr) : (block_size - 1);
+                mem.write(addr, block + 1, num);
+                addr += num;
             }
         }
     }
@@ -574,9 +591,9 @@ kc85::quickload(filesystem* fs, const char* name, filetype type, bool start) {
                 static const int buf_size = 1024;
                 uint8_t buf[buf_size];
                 fs->read(fp, buf, buf_size);
-                for (int i = 0; (i < buf_size) && (addr < end_addr); i++) {
-                    mem.w8(addr++, buf[i]);
-                }
+                const int num = (end_addr - addr) < buf_size ? (end_addr - addr) : buf_size;
+                mem.write(addr, buf, num);
+                addr += num;
             }
         }
     }
@@ -594,20 +611,20 @@ kc85::quickload(filesystem* fs, const char* name, filetype type, bool start) {
     image_name[sizeof(image_name)-1] = 0;
     if (strcmp(image_name, "JUNGLE     ") == 0) {
         // patch start level 1 into memory
-        mem.w8(0x36b7, 1);
-        mem.w8(0x3697, 1);
+        mem.w8io(0x36b7, 1);
+        mem.w8io(0x3697, 1);
         for (int i = 0; i < 5; i++) {
-            mem.w8(0x1770 + i, mem.r8(0x36b6 + i));
+            mem.w8io(0x1770 + i, mem.r8io(0x36b6 + i));
         }
     }
     // FIXME: patch Digger (see http://lanale.de/kc85_emu/KC85_Emu.html)
     if (strcmp(image_name, "DIGGER  COM\x01") == 0) {
-        mem.w16(0x09AA, 0x0160);    // time for delay-loop 0160 instead of 0260
-        mem.w8(0x3d3a, 0xB5);   // OR L instead of OR (HL)
+        mem.w16io(0x09AA, 0x0160);    // time for delay-loop 0160 instead of 0260
+        mem.w8io(0x3d3a, 0xB5);   // OR L instead of OR (HL)
     }
     if (strcmp(image_name, "DIGGERJ") == 0) {
-        mem.w16(0x09AA, 0x0260);
-        mem.w8(0x3d3a, 0xB5);   // OR L instead of OR (HL)
+        mem.w16io(0x09AA, 0x0260);
+        mem.w8io(0x3d3a, 0xB5);   // OR L instead of OR (HL)
     }
 
     // start loaded image
@@ -621,17 +638,15 @@ kc85::quickload(filesystem* fs, const char* name, filetype type, bool start) {
         cpu.AF_ = 0x0000;
         cpu.SP = 0x01C2;
         // delete ASCII buffer
-        for (uint16_t addr = 0xb200; addr < 0xb700; addr++) {
-            cpu.mem.w8(addr, 0);
-        }
-        cpu.mem.w8(0xb7a0, 0);
+        cpu.mem.fill(0xb200, 0, 0x500);
+        cpu.mem.w8io(0xb7a0, 0);
         if (system::kc85_3 == this->cur_model) {
             cpu.out(this, 0x89, 0x9f);
-            cpu.mem.w16(cpu.SP, 0xf15c);
+            cpu.mem.w16io(cpu.SP, 0xf15c);
         }
         else if (system::kc85_4 == this->cur_model) {
             cpu.out(this, 0x89, 0xFF);
-            cpu.mem.w16(cpu.SP, 0xf17e);
+            cpu.mem.w16io(cpu.SP, 0xf17e);
         }
         cpu.PC = exec_addr;
     }
@@ -105,6 +105,8 @@ public:
     virtual void irq(bool b) override;
     /// clock timer-trigger callback
     virtual void timer(int timer_id) override;
+    /// block instruction budget callback
+    virtual int cpu_block_budget() override;
 
     /// update module/memory mapping
     void update_bank_switching();
@@ -114,6 +116,8 @@ public:
     system cur_model = system::kc85_3;
     os_rom cur_caos = os_rom::caos_3_1;
     bool on = false;
+    uint64_t cur_tick = 0;
+    uint64_t end_tick = 0;
     ubyte key_code = 0;
     ubyte* caos_c_ptr = nullptr;
     int caos_c_size = 0;
@@ -218,6 +218,7 @@ kc85_exp::module_type_in_slot(ubyte slot_addr) const {
 //------------------------------------------------------------------------------
 void
 kc85_exp::update_memory_mappings(memory& mem) {
+    mem.begin_remap();
     for (auto& slot : this->slots) {
         if (0xFF != slot.mod.id) {
             const int memory_layer = this->memory_layer_by_slot_addr(slot.slot_addr);
@@ -238,6 +239,7 @@ kc85_exp::update_memory_mappings(memory& mem) {
             }
         }
     }
+    mem.end_remap();
 }
 
 } // namespace YAKC
@@ -72,6 +72,7 @@ kc85_video::kc85_4_irm_control(ubyte val) {
 void
 kc85_video::scanline() {
     // this needs to be called for each PAL line (one PAL line: 64 microseconds)
+    this->board->num_scanlines++;
     if (this->cur_scanline < display_height) {
         const bool blink_bg = this->ctc_blink_flag && this->pio_blink_flag;
         this->decode_one_line(this->rgba8_buffer, this->cur_scanline, blink_bg);
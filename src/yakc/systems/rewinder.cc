@@ -0,0 +1,478 @@
+//------------------------------------------------------------------------------
+//  rewinder.cc
+//------------------------------------------------------------------------------
+#include "rewinder.h"
+#include "yakc/systems/savestate.h"
+
+namespace YAKC {
+
+//------------------------------------------------------------------------------
+rewinder::~rewinder() {
+    this->discard();
+}
+
+//------------------------------------------------------------------------------
+void
+rewinder::init(int budget_bytes, int keyframe_interval_, int max_frames_) {
+    YAKC_ASSERT(budget_bytes >= 2*max_frame_size);
+    YAKC_ASSERT(keyframe_interval_ > 0);
+    YAKC_ASSERT(max_frames_ > 1);
+    this->discard();
+    this->buffer = (uint8_t*) YAKC_MALLOC(budget_bytes);
+    this->buffer_size = budget_bytes;
+    this->frames = (frame*) YAKC_MALLOC(max_frames_ * sizeof(frame));
+    this->max_frames = max_frames_;
+    this->keyframe_interval = keyframe_interval_;
+    this->prev_ram = (uint8_t*) YAKC_MALLOC(max_pages * page_size);
+    this->prev_chip = (uint8_t*) YAKC_MALLOC(max_chip_size);
+    this->chip_buf = (uint8_t*) YAKC_MALLOC(max_chip_size);
+    this->frame_buf = (uint8_t*) YAKC_MALLOC(max_frame_size);
+    this->clear();
+}
+
+//------------------------------------------------------------------------------
+void
+rewinder::discard() {
+    if (this->buffer) {
+        YAKC_FREE(this->buffer);
+        YAKC_FREE(this->frames);
+        YAKC_FREE(this->prev_ram);
+        YAKC_FREE(this->prev_chip);
+        YAKC_FREE(this->chip_buf);
+        YAKC_FREE(this->frame_buf);
+        this->buffer = nullptr;
+        this->frames = nullptr;
+        this->prev_ram = nullptr;
+        this->prev_chip = nullptr;
+        this->chip_buf = nullptr;
+        this->frame_buf = nullptr;
+    }
+    this->buffer_size = 0;
+    this->max_frames = 0;
+    this->first_frame = 0;
+    this->frame_count = 0;
+    this->model = system::none;
+    this->num_regions = 0;
+    this->num_pages = 0;
+}
+
+//------------------------------------------------------------------------------
+bool
+rewinder::is_valid() const {
+    return nullptr != this->buffer;
+}
+
+//------------------------------------------------------------------------------
+void
+rewinder::clear() {
+    this->first_frame = 0;
+    this->frame_count = 0;
+    this->frames_since_keyframe = 0;
+    this->num_recorded = 0;
+    this->num_dropped = 0;
+    this->prev_chip_size = 0;
+}
+
+//------------------------------------------------------------------------------
+int
+rewinder::num_frames() const {
+    return this->frame_count;
+}
+
+//------------------------------------------------------------------------------
+int
+rewinder::bytes_used() const {
+    int num_bytes = 0;
+    for (int i = 0; i < this->frame_count; i++) {
+        num_bytes += this->get_frame(i).size;
+    }
+    return num_bytes;
+}
+
+//------------------------------------------------------------------------------
+rewinder::frame&
+rewinder::get_frame(int index) const {
+    YAKC_ASSERT((index >= 0) && (index < this->frame_count));
+    return this->frames[(this->first_frame + index) % this->max_frames];
+}
+
+//------------------------------------------------------------------------------
+memory&
+rewinder::cpu_mem(yakc& emu) {
+    if (cpu_model::mos6502 == emu.cpu_type()) {
+        return emu.board.mos6502.mem;
+    }
+    else {
+        return emu.board.z80.mem;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+rewinder::update_regions(yakc& emu) {
+    region r[max_regions];
+    int num = 0;
+    if (emu.board.ram) {
+        r[num].ptr = &emu.board.ram[0][0];
+        r[num].size = emu.board.ram_size();
+        num++;
+    }
+    if (emu.is_system(system::any_kc85)) {
+        for (const auto& slot : emu.kc85.exp.slots) {
+            if (slot.mod.mem_ptr && slot.mod.mem_owned && (num < max_regions)) {
+                r[num].ptr = slot.mod.mem_ptr;
+                r[num].size = int(slot.mod.mem_size);
+                num++;
+            }
+        }
+    }
+    int pages = 0;
+    for (int i = 0; i < num; i++) {
+        pages += (r[i].size + page_size - 1) / page_size;
+    }
+    bool same_layout = (emu.model == this->model) && (num == this->num_regions) && (pages == this->num_pages);
+    for (int i = 0; same_layout && (i < num); i++) {
+        same_layout = r[i].size == this->regions[i].size;
+    }
+    YAKC_ASSERT(pages <= max_pages);
+    this->model = emu.model;
+    this->num_regions = num;
+    this->num_pages = pages;
+    for (int i = 0; i < num; i++) {
+        this->regions[i] = r[i];
+    }
+    return same_layout;
+}
+
+//------------------------------------------------------------------------------
+void
+rewinder::mark_changed(const uint8_t* host_ptr) {
+    int first_page = 0;
+    for (int i = 0; i < this->num_regions; i++) {
+        const region& r = this->regions[i];
+        const intptr_t offset = intptr_t(uintptr_t(host_ptr) - uintptr_t(r.ptr));
+        if ((offset > -page_size) && (offset < r.size)) {
+            // the block may straddle two pages of the region
+            const int first = offset < 0 ? 0 : int(offset / page_size);
+            int last = int((offset + page_size - 1) / page_size);
+            const int region_pages = (r.size + page_size - 1) / page_size;
+            if (last >= region_pages) {
+                last = region_pages - 1;
+            }
+            for (int page = first; page <= last; page++) {
+                const int index = first_page + page;
+                this->changed[index>>6] |= uint64_t(1)<<(index & 63);
+            }
+        }
+        first_page += (r.size + page_size - 1) / page_size;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+rewinder::record(yakc& emu) {
+    YAKC_ASSERT(this->is_valid());
+    memory& mem = cpu_mem(emu);
+    bool full_scan = false;
+    if (!this->update_regions(emu)) {
+        // system or module configuration has changed
+        this->clear();
+        mem.set_dirty_tracking(true, memory::dirty_rewinder);
+        full_scan = true;
+    }
+    else if (!mem.dirty_clients[memory::dirty_rewinder].enabled) {
+        mem.set_dirty_tracking(true, memory::dirty_rewinder);
+        full_scan = true;
+    }
+    this->chip_size = savestate::write(emu, this->chip_buf, max_chip_size, false);
+    if (this->chip_size > max_chip_size) {
+        YAKC_ASSERT(false);
+        return;
+    }
+    bool keyframe = (0 == this->frame_count) ||
+                    (this->frames_since_keyframe >= this->keyframe_interval) ||
+                    (this->chip_size != this->prev_chip_size);
+
+    // collect the RAM pages which have been written since the last frame
+    const uint8_t* remapped[memory::max_remapped_dirty];
+    int num_remapped = 0;
+    uint64_t dirty = mem.take_dirty_pages(memory::dirty_rewinder, remapped, num_remapped);
+    if (keyframe || full_scan || (num_remapped < 0)) {
+        for (auto& bits : this->changed) {
+            bits = ~uint64_t(0);
+        }
+    }
+    else {
+        for (auto& bits : this->changed) {
+            bits = 0;
+        }
+        for (int page_index = 0; dirty; page_index++, dirty >>= 1) {
+            const uint8_t* write_ptr = mem.untrapped_table[page_index].write_ptr;
+            if ((dirty & 1) && write_ptr) {
+                this->mark_changed(write_ptr + page_index*memory::page::size);
+            }
+        }
+        for (int i = 0; i < num_remapped; i++) {
+            this->mark_changed(remapped[i]);
+        }
+    }
+
+    int size = this->encode_frame(keyframe);
+    if (!this->append_frame(size, keyframe)) {
+        // the keyframe this frame depends on was dropped, the
+        // previous RAM content has already been updated by
+        // encode_frame(), so compare against empty pages
+        for (auto& bits : this->changed) {
+            bits = ~uint64_t(0);
+        }
+        keyframe = true;
+        size = this->encode_frame(keyframe);
+        this->append_frame(size, keyframe);
+    }
+    this->frames_since_keyframe = keyframe ? 1 : this->frames_since_keyframe + 1;
+    this->num_recorded++;
+}
+
+//------------------------------------------------------------------------------
+int
+rewinder::encode_xor(const uint8_t* cur, const uint8_t* prv, int size, uint8_t* dst) {
+    // a sequence of (num unchanged bytes, num changed bytes, XOR'ed changed bytes),
+    // if this isn't smaller than the input, the raw XOR'ed bytes are stored instead
+    uint8_t* ptr = dst;
+    const uint8_t* end = dst + size;
+    int i = 0;
+    while (i < size) {
+        int num_same = 0;
+        while ((i < size) && (num_same < 255) && (cur[i] == prv[i])) {
+            num_same++; i++;
+        }
+        const int start = i;
+        int num_diff = 0;
+        while ((i < size) && (num_diff < 255) && (cur[i] != prv[i])) {
+            num_diff++; i++;
+        }
+        if ((i == size) && (0 == num_diff)) {
+            // unchanged tail
+            break;
+        }
+        if ((ptr + 2 + num_diff) >= end) {
+            for (int j = 0; j < size; j++) {
+                dst[j] = cur[j] ^ prv[j];
+            }
+            return size;
+        }
+        *ptr++ = uint8_t(num_same);
+        *ptr++ = uint8_t(num_diff);
+        for (int j = start; j < (start + num_diff); j++) {
+            *ptr++ = cur[j] ^ prv[j];
+        }
+    }
+    return int(ptr - dst);
+}
+
+//------------------------------------------------------------------------------
+void
+rewinder::decode_xor(const uint8_t* src, int enc_size, uint8_t* dst, int size) {
+    if (enc_size == size) {
+        for (int i = 0; i < size; i++) {
+            dst[i] ^= src[i];
+        }
+    }
+    else {
+        const uint8_t* end = src + enc_size;
+        while (src < end) {
+            dst += src[0];
+            const int num_diff = src[1];
+            src += 2;
+            for (int i = 0; i < num_diff; i++) {
+                *dst++ ^= *src++;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+int
+rewinder::encode_frame(bool keyframe) {
+    static const uint8_t zero_page[page_size] = { };
+    uint8_t* ptr = this->frame_buf;
+
+    // chip state, XOR'ed against the previous frame or (for keyframes) zero
+    if (keyframe) {
+        memset(this->prev_chip, 0, this->chip_size);
+    }
+    const int chip_enc_size = encode_xor(this->chip_buf, this->prev_chip, this->chip_size, ptr + 8);
+    const uint32_t chip_hdr[2] = { uint32_t(this->chip_size), uint32_t(chip_enc_size) };
+    memcpy(ptr, chip_hdr, sizeof(chip_hdr));
+    ptr += 8 + chip_enc_size;
+    memcpy(this->prev_chip, this->chip_buf, this->chip_size);
+    this->prev_chip_size = this->chip_size;
+
+    // changed RAM pages
+    uint8_t* num_changed_ptr = ptr;
+    ptr += 4;
+    uint32_t num_changed = 0;
+    int page_index = 0;
+    for (int r = 0; r < this->num_regions; r++) {
+        const region& reg = this->regions[r];
+        for (int offset = 0; offset < reg.size; offset += page_size, page_index++) {
+            if (0 == (this->changed[page_index>>6] & (uint64_t(1)<<(page_index & 63)))) {
+                continue;
+            }
+            const uint8_t* cur = reg.ptr + offset;
+            const int size = (reg.size - offset) < page_size ? (reg.size - offset) : page_size;
+            uint8_t* prv = this->prev_ram + page_index*page_size;
+            const uint8_t* base = keyframe ? zero_page : prv;
+            if (0 != memcmp(cur, base, size)) {
+                const int enc_size = encode_xor(cur, base, size, ptr + page_header_size);
+                ptr[0] = page_index & 0xFF;
+                ptr[1] = page_index >> 8;
+                ptr[2] = enc_size & 0xFF;
+                ptr[3] = enc_size >> 8;
+                ptr += page_header_size + enc_size;
+                num_changed++;
+            }
+            memcpy(prv, cur, size);
+        }
+    }
+    memcpy(num_changed_ptr, &num_changed, 4);
+    const int frame_size = int(ptr - this->frame_buf);
+    YAKC_ASSERT(frame_size <= max_frame_size);
+    return frame_size;
+}
+
+//------------------------------------------------------------------------------
+void
+rewinder::decode_frame(const uint8_t* src) {
+    uint32_t chip_hdr[2];
+    memcpy(chip_hdr, src, sizeof(chip_hdr));
+    src += 8;
+    this->prev_chip_size = int(chip_hdr[0]);
+    decode_xor(src, int(chip_hdr[1]), this->prev_chip, this->prev_chip_size);
+    src += chip_hdr[1];
+
+    uint32_t num_changed;
+    memcpy(&num_changed, src, 4);
+    src += 4;
+    for (uint32_t i = 0; i < num_changed; i++) {
+        const int page_index = src[0] | (src[1]<<8);
+        const int enc_size = src[2] | (src[3]<<8);
+        src += page_header_size;
+        // only the last page of a region may be shorter than page_size
+        int size = page_size;
+        int first_page = 0;
+        for (int r = 0; r < this->num_regions; r++) {
+            const int region_pages = (this->regions[r].size + page_size - 1) / page_size;
+            if (page_index < (first_page + region_pages)) {
+                const int offset = (page_index - first_page) * page_size;
+                if ((this->regions[r].size - offset) < page_size) {
+                    size = this->regions[r].size - offset;
+                }
+                break;
+            }
+            first_page += region_pages;
+        }
+        decode_xor(src, enc_size, this->prev_ram + page_index*page_size, size);
+        src += enc_size;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+rewinder::drop_oldest() {
+    YAKC_ASSERT(this->frame_count > 0);
+    do {
+        this->first_frame = (this->first_frame + 1) % this->max_frames;
+        this->frame_count--;
+        this->num_dropped++;
+    }
+    while ((this->frame_count > 0) && !this->get_frame(0).keyframe);
+}
+
+//------------------------------------------------------------------------------
+bool
+rewinder::append_frame(int size, bool keyframe) {
+    // frames are stored back to back, if the new frame doesn't fit
+    // at the end of the buffer, continue at the start
+    uint32_t offset = 0;
+    if (this->frame_count > 0) {
+        const frame& newest = this->get_frame(this->frame_count - 1);
+        offset = newest.offset + newest.size;
+        if ((offset + size) > uint32_t(this->buffer_size)) {
+            offset = 0;
+        }
+    }
+    if (this->frame_count == this->max_frames) {
+        this->drop_oldest();
+    }
+    // the oldest frame is always the next frame after the write position
+    while (this->frame_count > 0) {
+        const frame& oldest = this->get_frame(0);
+        if ((oldest.offset >= (offset + size)) || ((oldest.offset + oldest.size) <= offset)) {
+            break;
+        }
+        this->drop_oldest();
+    }
+    if (!keyframe && (0 == this->frame_count)) {
+        // the keyframe this frame depends on was dropped
+        return false;
+    }
+    memcpy(this->buffer + offset, this->frame_buf, size);
+    frame& f = this->frames[(this->first_frame + this->frame_count) % this->max_frames];
+    f.offset = offset;
+    f.size = size;
+    f.keyframe = keyframe;
+    this->frame_count++;
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+rewinder::step_back(int num, yakc& emu) {
+    YAKC_ASSERT(this->is_valid());
+    if ((num < 0) || (num >= this->frame_count)) {
+        return false;
+    }
+    const int target = this->frame_count - 1 - num;
+    int key = target;
+    while (!this->get_frame(key).keyframe) {
+        key--;
+        YAKC_ASSERT(key >= 0);
+    }
+    memset(this->prev_ram, 0, this->num_pages * page_size);
+    memset(this->prev_chip, 0, max_chip_size);
+    for (int i = key; i <= target; i++) {
+        this->decode_frame(this->buffer + this->get_frame(i).offset);
+    }
+
+    // drop the newer frames, and continue recording from the restored frame
+    this->frame_count = target + 1;
+    this->frames_since_keyframe = target - key + 1;
+
+    // restore the chip state (this powers on the system), keep the
+    // cycle counter running, it is synchronized with the audio playback
+    const uint64_t abs_cycle_count = emu.abs_cycle_count;
+    if (!savestate::apply(this->prev_chip, this->prev_chip_size, emu)) {
+        this->clear();
+        return false;
+    }
+    emu.abs_cycle_count = abs_cycle_count;
+
+    // the RAM has been reallocated by the poweron, restore its content
+    if (!this->update_regions(emu)) {
+        this->clear();
+        return false;
+    }
+    int page_index = 0;
+    for (int r = 0; r < this->num_regions; r++) {
+        const region& reg = this->regions[r];
+        memcpy(reg.ptr, this->prev_ram + page_index*page_size, reg.size);
+        page_index += (reg.size + page_size - 1) / page_size;
+    }
+    emu.on_context_switched();
+    // the RAM content now matches the restored frame
+    cpu_mem(emu).set_dirty_tracking(true, memory::dirty_rewinder);
+    return true;
+}
+
+} // namespace YAKC
@@ -0,0 +1,150 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::rewinder
+    @brief per-frame rewind ring buffer
+
+    Call record() once per frame to capture the machine state, and
+    step_back() to return to an earlier frame. yakc::step() calls
+    record() when rewinding has been started with yakc::start_rewind().
+
+    Each recorded frame stores the chip and system state as a savestate
+    without RAM (see savestate.h, a few hundred bytes), and only those
+    1 KByte RAM pages which have been written since the previous frame.
+    The written pages are taken from the dirty-page tracking of the
+    CPU's memory (see memory::take_dirty_pages()), this includes pages
+    which have been written and then bank-switched out during the frame.
+    The chip state and changed pages are stored XOR'ed against the
+    previous frame and run-length encoded, so that a page where only a
+    few bytes were written only costs a few bytes.
+
+    Every keyframe_interval frames a keyframe with all non-empty pages
+    is recorded, so that restoring a frame needs to decode at most
+    keyframe_interval frames. Keyframes compare the complete RAM, so
+    that writes which bypass the dirty-page tracking are picked up at
+    the next keyframe.
+
+    The RAM consists of the breadboard RAM banks, and on the KC85 the
+    RAM of the expansion modules. When the system or the module
+    configuration changes, the recorded frames are dropped.
+
+    Encoded frames live in a single ring buffer of the configured memory
+    budget, when the budget is used up, the oldest keyframe and its
+    dependent frames are discarded.
+*/
+#include "yakc/core/core.h"
+
+namespace YAKC {
+
+class yakc;
+class memory;
+
+class rewinder {
+public:
+    /// default memory budget in bytes
+    static const int default_budget = 8 * 1024 * 1024;
+    /// default number of frames between keyframes
+    static const int default_keyframe_interval = 50;
+    /// default max number of frames in the ring buffer
+    static const int default_max_frames = 4096;
+
+    /// destructor
+    ~rewinder();
+    /// allocate the ring buffer, existing frames are discarded
+    void init(int budget_bytes=default_budget, int keyframe_interval=default_keyframe_interval, int max_frames=default_max_frames);
+    /// free all memory
+    void discard();
+    /// return true if init() has been called
+    bool is_valid() const;
+    /// drop all recorded frames
+    void clear();
+
+    /// record the current machine state as a new frame
+    void record(yakc& emu);
+    /// step back N frames (0 is the last recorded frame), newer frames are dropped
+    bool step_back(int num_frames, yakc& emu);
+
+    /// number of frames in the ring buffer
+    int num_frames() const;
+    /// number of bytes used by encoded frames
+    int bytes_used() const;
+
+    /// total number of recorded frames
+    uint64_t num_recorded = 0;
+    /// number of frames dropped because the budget was used up
+    uint64_t num_dropped = 0;
+
+private:
+    /// size of a RAM page
+    static const int page_size = 0x400;
+    /// max number of RAM pages (breadboard RAM and 2 KC85 module slots)
+    static const int max_pages = 256;
+    /// max number of RAM regions
+    static const int max_regions = 3;
+    /// max size of the chip state
+    static const int max_chip_size = 16 * 1024;
+    /// size of a page header in an encoded frame (page index and encoded size)
+    static const int page_header_size = 4;
+    /// max size of an encoded frame
+    static const int max_frame_size = 12 + max_chip_size + max_pages*(page_header_size+page_size);
+
+    struct frame {
+        uint32_t offset = 0;
+        uint32_t size = 0;
+        bool keyframe = false;
+    };
+    /// a block of host memory with emulator RAM
+    struct region {
+        uint8_t* ptr = nullptr;
+        int size = 0;
+    };
+    /// get frame by age (0 is oldest)
+    frame& get_frame(int index) const;
+    /// the memory object of the emulated CPU
+    static memory& cpu_mem(yakc& emu);
+    /// gather the RAM regions of the emulator, return false if the layout has changed
+    bool update_regions(yakc& emu);
+    /// mark the RAM pages overlapping a 1 KByte block of host memory as changed
+    void mark_changed(const uint8_t* host_ptr);
+    /// encode the chip state and changed pages into frame_buf, return encoded size
+    int encode_frame(bool keyframe);
+    /// decode a frame on top of the RAM and chip state in prev_ram and prev_chip
+    void decode_frame(const uint8_t* src);
+    /// XOR-RLE encode a block, return encoded size (size means raw XOR)
+    static int encode_xor(const uint8_t* cur, const uint8_t* prv, int size, uint8_t* dst);
+    /// decode an XOR-RLE encoded block on top of dst
+    static void decode_xor(const uint8_t* src, int enc_size, uint8_t* dst, int size);
+    /// drop the oldest keyframe and its dependent frames
+    void drop_oldest();
+    /// find space for a new frame in the ring buffer and append it
+    bool append_frame(int size, bool keyframe);
+
+    uint8_t* buffer = nullptr;
+    int buffer_size = 0;
+    frame* frames = nullptr;
+    int max_frames = 0;
+    int first_frame = 0;
+    int frame_count = 0;
+    int keyframe_interval = 0;
+    int frames_since_keyframe = 0;
+
+    /// the RAM regions of the recorded system
+    system model = system::none;
+    region regions[max_regions];
+    int num_regions = 0;
+    int num_pages = 0;
+    /// RAM pages which have changed since the last frame
+    uint64_t changed[max_pages/64] = { };
+    /// the RAM of the last recorded frame (num_pages * page_size)
+    uint8_t* prev_ram = nullptr;
+    /// the chip state of the last recorded frame
+    uint8_t* prev_chip = nullptr;
+    int prev_chip_size = 0;
+    /// scratch buffer for the current chip state
+    uint8_t* chip_buf = nullptr;
+    int chip_size = 0;
+    /// scratch buffer for encoding a frame
+    uint8_t* frame_buf = nullptr;
+};
+
+} // namespace YAKC
@@ -5,31 +5,61 @@
 
 namespace YAKC {
 
+//------------------------------------------------------------------------------
+rom_images::~rom_images() {
+    this->clear();
+}
+
 //------------------------------------------------------------------------------
 void
 rom_images::add(rom type, const ubyte* ptr, int size) {
     YAKC_ASSERT((type >= 0) && (type < num_roms));
     YAKC_ASSERT(!this->has(type));
-    YAKC_ASSERT((cur_pos + size) <= buf_size);
+    YAKC_ASSERT(ptr && (size > 0));
 
-    memcpy(&this->buffer[cur_pos], ptr, size);
-    this->roms[type].pos = this->cur_pos;
+    ubyte* copy = (ubyte*) YAKC_MALLOC(size);
+    memcpy(copy, ptr, size);
+    this->roms[type].ptr = copy;
     this->roms[type].size = size;
-    this->cur_pos += size;
+    this->roms[type].owned = true;
+}
+
+//------------------------------------------------------------------------------
+void
+rom_images::add_shared(rom type, const ubyte* ptr, int size) {
+    YAKC_ASSERT((type >= 0) && (type < num_roms));
+    YAKC_ASSERT(!this->has(type));
+    YAKC_ASSERT(ptr && (size > 0));
+
+    this->roms[type].ptr = ptr;
+    this->roms[type].size = size;
+    this->roms[type].owned = false;
+}
+
+//------------------------------------------------------------------------------
+void
+rom_images::clear() {
+    for (auto& rom : this->roms) {
+        if (rom.owned) {
+            YAKC_FREE((void*)rom.ptr);
+        }
+        rom = item();
+    }
 }
 
 //------------------------------------------------------------------------------
 bool
 rom_images::has(rom type) const {
     YAKC_ASSERT((type >= 0) && (type < num_roms));
-    return -1 != this->roms[type].pos;
+    return nullptr != this->roms[type].ptr;
 }
 
 //------------------------------------------------------------------------------
 ubyte*
 rom_images::ptr(rom type) {
     YAKC_ASSERT(this->has(type));
-    return &this->buffer[this->roms[type].pos];
+    // ROM blobs are only mapped as read-only memory
+    return (ubyte*) this->roms[type].ptr;
 }
 
 //------------------------------------------------------------------------------
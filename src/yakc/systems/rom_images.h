@@ -3,6 +3,11 @@
 /**
     class YAKC::rom_images
     @brief storage for dynamically loaded ROM images
+
+    ROM images are either copied (add()), or referenced without
+    copying (add_shared()), for instance to share the images of a
+    rom_repository between all emulator instances of a process.
+    ROM images are never written.
 */
 #include "yakc/core/core.h"
 
@@ -51,25 +56,33 @@ public:
         num_roms
     };
 
-    /// add a ROM blob
+    /// default constructor
+    rom_images() = default;
+    /// destructor, frees copied ROM blobs
+    ~rom_images();
+    /// rom_images can't be copied
+    rom_images(const rom_images&) = delete;
+    rom_images& operator=(const rom_images&) = delete;
+
+    /// add a ROM blob (the data is copied)
     void add(rom type, const ubyte* ptr, int size);
+    /// add a ROM blob by reference (the data must remain valid)
+    void add_shared(rom type, const ubyte* ptr, int size);
+    /// remove all ROM blobs
+    void clear();
     /// test if a ROM blob had been added
     bool has(rom type) const;
-    /// get the pointer to a rom blob
+    /// get the pointer to a rom blob (must not be written)
     ubyte* ptr(rom type);
     /// get the size of a rom blob
     int size(rom type) const;
 
 private:
     struct item {
-        item() : pos(-1), size(0) { };
-        int pos;
-        int size;
+        const ubyte* ptr = nullptr;
+        int size = 0;
+        bool owned = false;
     } roms[num_roms];
-
-    static const int buf_size = 1024 * 1024;
-    int cur_pos = 0;
-    ubyte buffer[buf_size];
 };
 
 } // namespace YAKC
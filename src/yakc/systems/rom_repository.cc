@@ -0,0 +1,340 @@
+//------------------------------------------------------------------------------
+//  rom_repository.cc
+//------------------------------------------------------------------------------
+#if _MSC_VER && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#include "rom_repository.h"
+#include <stdio.h>
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#define YAKC_HAS_MMAP (1)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace YAKC {
+
+// NOTE: must be in the same order as rom_images::rom!
+static const rom_repository::known_rom known_roms[rom_images::num_roms] = {
+    { "hc900.852",                  0x2000, 0xE6F4C0AB },
+    { "caos22.852",                 0x2000, 0x48D5624C },
+    { "caos31.853",                 0x2000, 0x639E4864 },
+    { "caos34.853",                 0x2000, 0xD0245A3E },
+    { "caos42e.854",                0x2000, 0xEE273933 },
+    { "caos42c.854",                0x1000, 0x57D9AB02 },
+    { "basic_c0.853",               0x2000, 0xDFE34B08 },
+    { "m006.rom",                   0x4000, 0xD7C43AF0 },
+    { "forth.853",                  0x2000, 0x501DFA5F },
+    { "develop.853",                0x2000, 0xFE5A79E7 },
+    { "texor.rom",                  0x2000, 0x02263B40 },
+    { "amstrad_zx48k.bin",          0x4000, 0xDDEE531F },
+    { "amstrad_zx128k_0.bin",       0x4000, 0xE76799D2 },
+    { "amstrad_zx128k_1.bin",       0x4000, 0xB96A36BE },
+    { "cpc464_os.bin",              0x4000, 0x815752DF },
+    { "cpc464_basic.bin",           0x4000, 0x7D9A3BAC },
+    { "cpc6128_os.bin",             0x4000, 0x0219BB74 },
+    { "cpc6128_basic.bin",          0x4000, 0xCA6AF63D },
+    { "z9001_basic_507_511.bin",    0x2800, 0x99BF403A },
+    { "z9001_os12_1.bin",           0x0800, 0x6846AFE2 },
+    { "z9001_os12_2.bin",           0x0800, 0x20729E76 },
+    { "z9001_basic.bin",            0x2000, 0xDFE34B08 },
+    { "kc87_os_2.bin",              0x2000, 0xE4ADE421 },
+    { "z9001_font.bin",             0x0800, 0xDD9C0F4E },
+    { "kc87_font_2.bin",            0x0800, 0x8984FFF3 },
+    { "z1013_mon202.bin",           0x0800, 0x5884EDAB },
+    { "z1013_mon_a2.bin",           0x0800, 0x98B19B10 },
+    { "z1013_font.bin",             0x0800, 0x7023088F },
+    { "kcc_os.bin",                 0x4000, 0x7F9AB3F7 },
+    { "kcc_bas.bin",                0x4000, 0xCA6AF63D },
+    { "bbc_b_os12.rom",             0x4000, 0x3C14FC70 },
+    { "bbc_b_basic2.rom",           0x4000, 0x79434781 },
+    { "abasic.ic20",                0x2000, 0x289B7791 },
+    { "afloat.ic21",                0x1000, 0x81D86AF7 },
+    { "dosrom.u15",                 0x1000, 0xC431A9B7 },
+};
+
+//------------------------------------------------------------------------------
+const rom_repository::known_rom&
+rom_repository::info(rom_images::rom type) {
+    YAKC_ASSERT((type >= 0) && (type < rom_images::num_roms));
+    return known_roms[type];
+}
+
+//------------------------------------------------------------------------------
+uint32_t
+rom_repository::crc32(const void* ptr, int num_bytes) {
+    static uint32_t table[256];
+    static bool table_valid = false;
+    if (!table_valid) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+            }
+            table[i] = c;
+        }
+        table_valid = true;
+    }
+    const uint8_t* p = (const uint8_t*) ptr;
+    uint32_t crc = 0xFFFFFFFF;
+    for (int i = 0; i < num_bytes; i++) {
+        crc = table[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFF;
+}
+
+//------------------------------------------------------------------------------
+bool
+rom_repository::validate(rom_images::rom type, const uint8_t* ptr, int size) {
+    const known_rom& known = info(type);
+    return ptr && (size == known.size) && (crc32(ptr, size) == known.crc32);
+}
+
+//------------------------------------------------------------------------------
+rom_repository::~rom_repository() {
+    this->discard();
+}
+
+//------------------------------------------------------------------------------
+void
+rom_repository::discard() {
+    for (int i = 0; i < this->num_files; i++) {
+        unmap_file(this->files[i].ptr, this->files[i].size);
+        this->files[i] = item();
+    }
+    this->num_files = 0;
+    for (auto& rom : this->roms) {
+        rom = item();
+    }
+    this->num_rejected = 0;
+}
+
+//------------------------------------------------------------------------------
+const uint8_t*
+rom_repository::map_file(const char* path, int& out_size) {
+    out_size = 0;
+    const uint8_t* ptr = nullptr;
+    #if YAKC_HAS_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    if ((fstat(fd, &st) == 0) && (st.st_size > 0) && (st.st_size < 0x7FFFFFFF)) {
+        void* p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            ptr = (const uint8_t*) p;
+            out_size = int(st.st_size);
+        }
+    }
+    ::close(fd);
+    #else
+    // no mmap on this platform, load the file into an owned buffer instead
+    FILE* fh = fopen(path, "rb");
+    if (!fh) {
+        return nullptr;
+    }
+    fseek(fh, 0, SEEK_END);
+    const int size = int(ftell(fh));
+    fseek(fh, 0, SEEK_SET);
+    if (size > 0) {
+        uint8_t* p = (uint8_t*) YAKC_MALLOC(size);
+        if (fread(p, 1, size, fh) == size_t(size)) {
+            ptr = p;
+            out_size = size;
+        }
+        else {
+            YAKC_FREE(p);
+        }
+    }
+    fclose(fh);
+    #endif
+    return ptr;
+}
+
+//------------------------------------------------------------------------------
+void
+rom_repository::unmap_file(const uint8_t* ptr, int size) {
+    if (ptr) {
+        #if YAKC_HAS_MMAP
+        munmap((void*)ptr, size);
+        #else
+        YAKC_FREE((void*)ptr);
+        #endif
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+rom_repository::add_file(const uint8_t* ptr, int size) {
+    YAKC_ASSERT(this->num_files < max_files);
+    this->files[this->num_files].ptr = ptr;
+    this->files[this->num_files].size = size;
+    this->num_files++;
+}
+
+//------------------------------------------------------------------------------
+int
+rom_repository::load_dir(const char* path) {
+    YAKC_ASSERT(path);
+    int num_loaded = 0;
+    for (int i = 0; i < rom_images::num_roms; i++) {
+        const rom_images::rom type = (rom_images::rom) i;
+        if (this->has(type) || (this->num_files >= max_files)) {
+            continue;
+        }
+        char file_path[1024];
+        snprintf(file_path, sizeof(file_path), "%s/%s", path, known_roms[i].filename);
+        int size = 0;
+        const uint8_t* ptr = map_file(file_path, size);
+        if (!ptr) {
+            continue;
+        }
+        if (validate(type, ptr, size)) {
+            this->add_file(ptr, size);
+            this->roms[i].ptr = ptr;
+            this->roms[i].size = size;
+            num_loaded++;
+        }
+        else {
+            unmap_file(ptr, size);
+            this->num_rejected++;
+        }
+    }
+    return num_loaded;
+}
+
+//------------------------------------------------------------------------------
+int
+rom_repository::load_pack(const char* path) {
+    YAKC_ASSERT(path);
+    if (this->num_files >= max_files) {
+        return 0;
+    }
+    int size = 0;
+    const uint8_t* ptr = map_file(path, size);
+    if (!ptr) {
+        return 0;
+    }
+    const uint32_t* hdr = (const uint32_t*) ptr;
+    const int hdr_size = 3 * sizeof(uint32_t);
+    if ((size < hdr_size) || (hdr[0] != pack_magic) || (hdr[1] != pack_version) ||
+        (hdr[2] > uint32_t((size - hdr_size) / (3 * sizeof(uint32_t))))) {
+        unmap_file(ptr, size);
+        this->num_rejected++;
+        return 0;
+    }
+    const int num_entries = int(hdr[2]);
+    const uint32_t* entry = hdr + 3;
+    int num_loaded = 0;
+    for (int e = 0; e < num_entries; e++, entry += 3) {
+        const uint32_t offset = entry[0];
+        const uint32_t entry_size = entry[1];
+        const uint32_t entry_crc = entry[2];
+        if ((offset > uint32_t(size)) || (entry_size > (uint32_t(size) - offset))) {
+            this->num_rejected++;
+            continue;
+        }
+        // the entry CRC is only trusted after checking it against the data
+        const uint8_t* data = ptr + offset;
+        if (crc32(data, int(entry_size)) != entry_crc) {
+            this->num_rejected++;
+            continue;
+        }
+        for (int i = 0; i < rom_images::num_roms; i++) {
+            if (!this->roms[i].ptr && (known_roms[i].size == int(entry_size)) && (known_roms[i].crc32 == entry_crc)) {
+                this->roms[i].ptr = data;
+                this->roms[i].size = int(entry_size);
+                num_loaded++;
+            }
+        }
+    }
+    if (num_loaded > 0) {
+        this->add_file(ptr, size);
+    }
+    else {
+        unmap_file(ptr, size);
+    }
+    return num_loaded;
+}
+
+//------------------------------------------------------------------------------
+bool
+rom_repository::write_pack(const char* path) const {
+    YAKC_ASSERT(path);
+    // collect unique images, identical images are only written once
+    int entry_rom[rom_images::num_roms];
+    int num_entries = 0;
+    for (int i = 0; i < rom_images::num_roms; i++) {
+        if (!this->roms[i].ptr) {
+            continue;
+        }
+        bool dup = false;
+        for (int e = 0; e < num_entries; e++) {
+            const known_rom& known = known_roms[entry_rom[e]];
+            if ((known.crc32 == known_roms[i].crc32) && (known.size == known_roms[i].size)) {
+                dup = true;
+                break;
+            }
+        }
+        if (!dup) {
+            entry_rom[num_entries++] = i;
+        }
+    }
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        return false;
+    }
+    bool ok = true;
+    const uint32_t hdr[3] = { pack_magic, pack_version, uint32_t(num_entries) };
+    ok &= 1 == fwrite(hdr, sizeof(hdr), 1, fp);
+    uint32_t offset = sizeof(hdr) + num_entries * 3 * sizeof(uint32_t);
+    for (int e = 0; e < num_entries; e++) {
+        const item& rom = this->roms[entry_rom[e]];
+        const uint32_t entry[3] = { offset, uint32_t(rom.size), known_roms[entry_rom[e]].crc32 };
+        ok &= 1 == fwrite(entry, sizeof(entry), 1, fp);
+        offset += rom.size;
+    }
+    for (int e = 0; e < num_entries; e++) {
+        const item& rom = this->roms[entry_rom[e]];
+        ok &= 1 == fwrite(rom.ptr, rom.size, 1, fp);
+    }
+    fclose(fp);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+bool
+rom_repository::has(rom_images::rom type) const {
+    YAKC_ASSERT((type >= 0) && (type < rom_images::num_roms));
+    return nullptr != this->roms[type].ptr;
+}
+
+//------------------------------------------------------------------------------
+const uint8_t*
+rom_repository::ptr(rom_images::rom type) const {
+    YAKC_ASSERT(this->has(type));
+    return this->roms[type].ptr;
+}
+
+//------------------------------------------------------------------------------
+int
+rom_repository::size(rom_images::rom type) const {
+    YAKC_ASSERT(this->has(type));
+    return this->roms[type].size;
+}
+
+//------------------------------------------------------------------------------
+void
+rom_repository::share(rom_images& roms) const {
+    for (int i = 0; i < rom_images::num_roms; i++) {
+        const rom_images::rom type = (rom_images::rom) i;
+        if (this->roms[i].ptr && !roms.has(type)) {
+            roms.add_shared(type, this->roms[i].ptr, this->roms[i].size);
+        }
+    }
+}
+
+} // namespace YAKC
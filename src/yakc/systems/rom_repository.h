@@ -0,0 +1,95 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::rom_repository
+    @brief process-wide read-only ROM image storage loaded from local files
+
+    A rom_repository loads ROM images either from a directory with the
+    usual ROM file names, or from a single 'ROM pack' file, and validates
+    each image against a table of known sizes and CRC32 checksums. Images
+    which don't match the table are rejected.
+
+    On platforms with mmap() the files are memory-mapped read-only, so
+    the ROM pages are shared with the OS file cache. The repository
+    should be created once per process, and its images are referenced
+    by the rom_images of each emulator instance without copying them
+    (see yakc::add_roms()), the repository must outlive these instances.
+
+    ROM pack file layout (all values little endian uint32):
+
+    - magic 'YKRP', version, number of entries
+    - per entry: offset from start of file, size, CRC32
+    - the image data
+
+    Pack entries are matched by size and CRC32, not by ROM type, so
+    identical images which are used under several ROM types (for
+    instance the KC85/3 and KC87 BASIC) are only stored once.
+*/
+#include "yakc/core/core.h"
+#include "yakc/systems/rom_images.h"
+
+namespace YAKC {
+
+class rom_repository {
+public:
+    /// 'YKRP'
+    static const uint32_t pack_magic = 0x50524B59;
+    /// the pack format version
+    static const uint32_t pack_version = 1;
+
+    /// a known ROM image
+    struct known_rom {
+        const char* filename;
+        int size;
+        uint32_t crc32;
+    };
+    /// get the known file name, size and CRC32 of a ROM image
+    static const known_rom& info(rom_images::rom type);
+    /// compute the CRC32 (same as zlib) of a chunk of memory
+    static uint32_t crc32(const void* ptr, int num_bytes);
+    /// check a ROM image against the known size and CRC32
+    static bool validate(rom_images::rom type, const uint8_t* ptr, int size);
+
+    /// destructor, unmaps or frees all images
+    ~rom_repository();
+    /// load all known ROM images from a directory, return number of new images
+    int load_dir(const char* path);
+    /// memory-map a ROM pack file, return number of new images
+    int load_pack(const char* path);
+    /// write all images into a ROM pack file
+    bool write_pack(const char* path) const;
+    /// unmap or free all images
+    void discard();
+
+    /// test if a ROM image is loaded
+    bool has(rom_images::rom type) const;
+    /// get pointer to a loaded ROM image
+    const uint8_t* ptr(rom_images::rom type) const;
+    /// get size of a loaded ROM image
+    int size(rom_images::rom type) const;
+    /// reference all loaded images from an emulator's rom_images (no copy)
+    void share(rom_images& roms) const;
+
+    /// number of files which failed validation
+    int num_rejected = 0;
+
+private:
+    /// memory-map (or load) a file, return nullptr on failure
+    static const uint8_t* map_file(const char* path, int& out_size);
+    /// unmap (or free) a file mapped with map_file()
+    static void unmap_file(const uint8_t* ptr, int size);
+    /// keep a mapped file until discard()
+    void add_file(const uint8_t* ptr, int size);
+
+    struct item {
+        const uint8_t* ptr = nullptr;
+        int size = 0;
+    };
+    item roms[rom_images::num_roms];
+    /// the mapped files, one per image, plus pack files
+    static const int max_files = rom_images::num_roms + 4;
+    item files[max_files];
+    int num_files = 0;
+};
+
+} // namespace YAKC
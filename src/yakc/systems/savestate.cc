@@ -0,0 +1,725 @@
+//------------------------------------------------------------------------------
+//  savestate.cc
+//------------------------------------------------------------------------------
+#include "savestate.h"
+#include <stdio.h>
+
+namespace YAKC {
+
+static const int ram_page_size = 0x400;
+static const int num_ram_pages = (breadboard::max_ram_banks * breadboard::ram_bank_size) / ram_page_size;
+static_assert(num_ram_pages <= 128, "savestate RAM page mask too small");
+
+//------------------------------------------------------------------------------
+savestate::stream::stream(uint8_t* buf, int buf_size) :
+writing(true),
+wr_buf(buf),
+size(buf ? buf_size : 0) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+savestate::stream::stream(const uint8_t* buf, int buf_size) :
+writing(false),
+rd_buf(buf),
+size(buf_size) {
+    // empty
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::stream::bytes(void* ptr, int num_bytes) {
+    // out-of-bounds accesses are not an error: when writing, the bytes
+    // are only counted, when reading, the field keeps its current value
+    if ((this->pos + num_bytes) <= this->size) {
+        if (this->writing) {
+            memcpy(this->wr_buf + this->pos, ptr, num_bytes);
+        }
+        else {
+            memcpy(ptr, this->rd_buf + this->pos, num_bytes);
+        }
+    }
+    this->pos += num_bytes;
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::stream::operator()(bool& val) {
+    uint8_t b = val ? 1 : 0;
+    this->bytes(&b, 1);
+    val = 0 != b;
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::stream::operator()(counter& c) {
+    (*this)(c.period);
+    (*this)(c.value);
+}
+
+//------------------------------------------------------------------------------
+static int
+begin_chunk(savestate::stream& s, uint32_t tag, uint16_t version) {
+    const int hdr_pos = s.pos;
+    uint16_t reserved = 0;
+    uint32_t size = 0;
+    s(tag);
+    s(version);
+    s(reserved);
+    s(size);
+    return hdr_pos;
+}
+
+//------------------------------------------------------------------------------
+static void
+end_chunk(savestate::stream& s, int hdr_pos) {
+    // patch the payload size into the chunk header
+    const int size_pos = hdr_pos + 8;
+    const uint32_t size = uint32_t(s.pos - (hdr_pos + 12));
+    if ((size_pos + 4) <= s.size) {
+        memcpy(s.wr_buf + size_pos, &size, sizeof(size));
+    }
+}
+
+//------------------------------------------------------------------------------
+static void
+mark_ram(uint64_t (&mask)[2], int bank, int offset, int size) {
+    const int first = (bank * breadboard::ram_bank_size + offset) / ram_page_size;
+    const int num = (size + ram_page_size - 1) / ram_page_size;
+    for (int i = first; i < (first + num); i++) {
+        mask[i>>6] |= uint64_t(1)<<(i & 63);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::ram_pages(system model, uint64_t (&mask)[2]) {
+    const int bank_size = breadboard::ram_bank_size;
+    mask[0] = mask[1] = 0;
+    switch (model) {
+        case system::kc85_2:
+        case system::kc85_3:
+            // 16 KByte RAM + 16 KByte video RAM
+            mark_ram(mask, 0, 0, bank_size);
+            mark_ram(mask, kc85_video::irm0_page, 0, bank_size);
+            break;
+        case system::z1013_01:
+        case system::z1013_16:
+            mark_ram(mask, 0, 0, bank_size);
+            mark_ram(mask, z1013::vidmem_page, 0, 0x400);
+            break;
+        case system::z1013_64:
+            mark_ram(mask, 0, 0, 4 * bank_size);
+            mark_ram(mask, z1013::vidmem_page, 0, 0x400);
+            break;
+        case system::z9001:
+            mark_ram(mask, 0, 0, 2 * bank_size);
+            mark_ram(mask, z9001::video_ram_page, 0, 0x400);
+            break;
+        case system::kc87:
+            mark_ram(mask, 0, 0, 3 * bank_size);
+            mark_ram(mask, z9001::color_ram_page, 0, 0x400);
+            mark_ram(mask, z9001::video_ram_page, 0, 0x400);
+            break;
+        case system::zxspectrum48k:
+            mark_ram(mask, 0, 0, 3 * bank_size);
+            break;
+        case system::cpc464:
+        case system::kccompact:
+            mark_ram(mask, 0, 0, 4 * bank_size);
+            break;
+        case system::acorn_atom:
+            // 32 KByte RAM + 8 KByte video RAM
+            mark_ram(mask, 0, 0, 0xA000);
+            break;
+        case system::bbcmicro_b:
+            mark_ram(mask, 0, 0, 0x8000);
+            break;
+        default:
+            // KC85/4, Spectrum 128K, CPC 6128 use all RAM banks
+            mark_ram(mask, 0, 0, breadboard::max_ram_banks * bank_size);
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+savestate::is_savestate(const uint8_t* buf, int buf_size) {
+    if (!buf || (buf_size < int(sizeof(header)))) {
+        return false;
+    }
+    header hdr;
+    memcpy(&hdr, buf, sizeof(hdr));
+    return (magic == hdr.magic) && (version == hdr.version) &&
+           (hdr.header_size >= sizeof(header)) && (hdr.header_size <= buf_size);
+}
+
+//------------------------------------------------------------------------------
+int
+savestate::write(const yakc& emu_, uint8_t* buf, int buf_size, bool with_ram) {
+    // the state functions are shared between reading and writing,
+    // a writing stream doesn't modify the emulator state
+    yakc& emu = const_cast<yakc&>(emu_);
+    breadboard& board = emu.board;
+    stream s(buf, buf_size);
+
+    header hdr;
+    hdr.magic = magic;
+    hdr.version = version;
+    hdr.header_size = sizeof(header);
+    hdr.model = uint32_t(emu.model);
+    hdr.os = uint32_t(emu.os);
+    s(hdr);
+
+    int c;
+    c = begin_chunk(s, tag('E','M','U',' '), 1); emu_state(s, emu); end_chunk(s, c);
+    c = begin_chunk(s, tag('C','L','C','K'), 1); clock_state(s, board.clck); end_chunk(s, c);
+    if (cpu_model::z80 == emu.cpu_type()) {
+        c = begin_chunk(s, tag('Z','8','0',' '), 1); z80_state(s, board.z80); end_chunk(s, c);
+        c = begin_chunk(s, tag('C','T','C',' '), 1); z80ctc_state(s, board.z80ctc); end_chunk(s, c);
+        c = begin_chunk(s, tag('P','I','O','1'), 1); z80pio_state(s, board.z80pio); end_chunk(s, c);
+        c = begin_chunk(s, tag('P','I','O','2'), 1); z80pio_state(s, board.z80pio2); end_chunk(s, c);
+    }
+    else {
+        c = begin_chunk(s, tag('6','5','0','2'), 1); mos6502_state(s, board.mos6502); end_chunk(s, c);
+        c = begin_chunk(s, tag('6','5','2','2'), 2); mos6522_state(s, board.mos6522); end_chunk(s, c);
+        c = begin_chunk(s, tag('6','8','4','7'), 1); mc6847_state(s, board.mc6847); end_chunk(s, c);
+    }
+    c = begin_chunk(s, tag('8','2','5','5'), 1); i8255_state(s, board.i8255); end_chunk(s, c);
+    c = begin_chunk(s, tag('6','8','4','5'), 1); mc6845_state(s, board.mc6845); end_chunk(s, c);
+    c = begin_chunk(s, tag('A','Y','3','8'), 1); ay8910_state(s, board.ay8910); end_chunk(s, c);
+    c = begin_chunk(s, tag('B','E','E','P'), 1); beeper_state(s, board.beeper); end_chunk(s, c);
+    c = begin_chunk(s, tag('S','P','K','R'), 1); speaker_state(s, board.speaker); end_chunk(s, c);
+    c = begin_chunk(s, tag('C','R','T',' '), 1); crt_state(s, board.crt); end_chunk(s, c);
+
+    if (emu.is_system(system::any_kc85)) {
+        c = begin_chunk(s, tag('K','C','8','5'), 1); kc85_state(s, emu.kc85); end_chunk(s, c);
+    }
+    else if (emu.is_system(system::any_z1013)) {
+        c = begin_chunk(s, tag('Z','1','0','1'), 1); z1013_state(s, emu.z1013); end_chunk(s, c);
+    }
+    else if (emu.is_system(system::any_z9001)) {
+        c = begin_chunk(s, tag('Z','9','0','0'), 1); z9001_state(s, emu.z9001); end_chunk(s, c);
+    }
+    else if (emu.is_system(system::any_zx)) {
+        c = begin_chunk(s, tag('Z','X',' ',' '), 1); zx_state(s, emu.zx); end_chunk(s, c);
+    }
+    else if (emu.is_system(system::any_cpc)) {
+        c = begin_chunk(s, tag('C','P','C',' '), 1); cpc_state(s, emu.cpc); end_chunk(s, c);
+    }
+    else if (emu.is_system(system::acorn_atom)) {
+        c = begin_chunk(s, tag('A','T','O','M'), 1); atom_state(s, emu.atom); end_chunk(s, c);
+    }
+    else if (emu.is_system(system::bbcmicro_b)) {
+        c = begin_chunk(s, tag('B','B','C',' '), 1); bbcmicro_state(s, emu.bbcmicro); end_chunk(s, c);
+    }
+
+    c = begin_chunk(s, tag('T','A','P','E'), 1); tape_state(s, emu.tapedeck); end_chunk(s, c);
+
+    if (!with_ram) {
+        return s.pos;
+    }
+    uint64_t mask[2];
+    ram_pages(emu.model, mask);
+    c = begin_chunk(s, tag('R','A','M',' '), 1); ram_state(s, board, mask); end_chunk(s, c);
+    if (emu.is_system(system::any_kc85)) {
+        // content of KC85 RAM modules
+        for (const auto& slot : emu.kc85.exp.slots) {
+            if (slot.mod.mem_ptr && slot.mod.mem_owned) {
+                c = begin_chunk(s, tag('K','C','M', slot.slot_addr == 0x08 ? '8':'C'), 1);
+                s.bytes(slot.mod.mem_ptr, slot.mod.mem_size);
+                end_chunk(s, c);
+            }
+        }
+    }
+    return s.pos;
+}
+
+//------------------------------------------------------------------------------
+bool
+savestate::apply(const uint8_t* buf, int buf_size, yakc& emu) {
+    if (!is_savestate(buf, buf_size)) {
+        return false;
+    }
+    header hdr;
+    memcpy(&hdr, buf, sizeof(hdr));
+
+    // validate the chunk structure before touching the emulator
+    int pos = hdr.header_size;
+    while ((pos + int(sizeof(chunk_header))) <= buf_size) {
+        chunk_header chdr;
+        memcpy(&chdr, buf + pos, sizeof(chdr));
+        pos += sizeof(chdr);
+        if (chdr.size > uint32_t(buf_size - pos)) {
+            return false;
+        }
+        pos += chdr.size;
+    }
+    const system model = (system) hdr.model;
+    const os_rom os = (os_rom) hdr.os;
+    if (!emu.check_roms(model, os)) {
+        return false;
+    }
+
+    // start with a freshly powered-on system, fields missing from
+    // the savestate keep their power-on state
+    emu.poweroff();
+    emu.poweron(model, os);
+    pos = hdr.header_size;
+    while ((pos + int(sizeof(chunk_header))) <= buf_size) {
+        chunk_header chdr;
+        memcpy(&chdr, buf + pos, sizeof(chdr));
+        pos += sizeof(chdr);
+        apply_chunk(chdr, buf + pos, emu);
+        pos += chdr.size;
+    }
+    emu.on_context_switched();
+    return true;
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::apply_chunk(const chunk_header& hdr, const uint8_t* payload, yakc& emu) {
+    breadboard& board = emu.board;
+    stream s(payload, int(hdr.size));
+    switch (hdr.tag) {
+        case tag('E','M','U',' '): emu_state(s, emu); break;
+        case tag('C','L','C','K'): clock_state(s, board.clck); break;
+        case tag('Z','8','0',' '): z80_state(s, board.z80); break;
+        case tag('C','T','C',' '): z80ctc_state(s, board.z80ctc); break;
+        case tag('P','I','O','1'): z80pio_state(s, board.z80pio); break;
+        case tag('P','I','O','2'): z80pio_state(s, board.z80pio2); break;
+        case tag('6','5','0','2'): mos6502_state(s, board.mos6502); break;
+        case tag('6','5','2','2'): mos6522_state(s, board.mos6522); break;
+        case tag('6','8','4','7'): mc6847_state(s, board.mc6847); break;
+        case tag('8','2','5','5'): i8255_state(s, board.i8255); break;
+        case tag('6','8','4','5'): mc6845_state(s, board.mc6845); break;
+        case tag('A','Y','3','8'): ay8910_state(s, board.ay8910); break;
+        case tag('B','E','E','P'): beeper_state(s, board.beeper); break;
+        case tag('S','P','K','R'): speaker_state(s, board.speaker); break;
+        case tag('C','R','T',' '): crt_state(s, board.crt); break;
+        case tag('K','C','8','5'): kc85_state(s, emu.kc85); break;
+        case tag('Z','1','0','1'): z1013_state(s, emu.z1013); break;
+        case tag('Z','9','0','0'): z9001_state(s, emu.z9001); break;
+        case tag('Z','X',' ',' '): zx_state(s, emu.zx); break;
+        case tag('C','P','C',' '): cpc_state(s, emu.cpc); break;
+        case tag('A','T','O','M'): atom_state(s, emu.atom); break;
+        case tag('B','B','C',' '): bbcmicro_state(s, emu.bbcmicro); break;
+        case tag('T','A','P','E'): tape_state(s, emu.tapedeck); break;
+        case tag('R','A','M',' '):
+            {
+                uint64_t mask[2] = { ~uint64_t(0), ~uint64_t(0) };
+                ram_state(s, board, mask);
+            }
+            break;
+        case tag('K','C','M','8'):
+        case tag('K','C','M','C'):
+            if (emu.is_system(system::any_kc85)) {
+                const ubyte slot_addr = (tag('K','C','M','8') == hdr.tag) ? 0x08 : 0x0C;
+                const auto& slot = emu.kc85.exp.slot_by_addr(slot_addr);
+                if (slot.mod.mem_ptr && slot.mod.mem_owned && (slot.mod.mem_size == hdr.size)) {
+                    s.bytes(slot.mod.mem_ptr, slot.mod.mem_size);
+                }
+            }
+            break;
+        default:
+            // unknown chunk from a newer version, skip
+            break;
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+savestate::save(const yakc& emu, const char* path) {
+    const int size = write(emu, nullptr, 0);
+    uint8_t* buf = (uint8_t*) YAKC_MALLOC(size);
+    write(emu, buf, size);
+    bool ok = false;
+    FILE* fp = fopen(path, "wb");
+    if (fp) {
+        ok = 1 == fwrite(buf, size, 1, fp);
+        fclose(fp);
+    }
+    YAKC_FREE(buf);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+bool
+savestate::load(const char* path, yakc& emu) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return false;
+    }
+    fseek(fp, 0, SEEK_END);
+    const int size = int(ftell(fp));
+    fseek(fp, 0, SEEK_SET);
+    bool ok = false;
+    if (size > 0) {
+        uint8_t* buf = (uint8_t*) YAKC_MALLOC(size);
+        if (1 == fread(buf, size, 1, fp)) {
+            ok = apply(buf, size, emu);
+        }
+        YAKC_FREE(buf);
+    }
+    fclose(fp);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::emu_state(stream& s, yakc& emu) {
+    s(emu.abs_cycle_count);
+    s(emu.overflow_cycles);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::clock_state(stream& s, clock& clk) {
+    s(clk.base_freq_khz);
+    for (auto& t : clk.timers) {
+        s(t);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::z80_state(stream& s, z80& cpu) {
+    s(cpu.AF); s(cpu.BC); s(cpu.DE); s(cpu.HL);
+    s(cpu.IX); s(cpu.IY); s(cpu.WZ);
+    s(cpu.AF_); s(cpu.BC_); s(cpu.DE_); s(cpu.HL_); s(cpu.WZ_);
+    s(cpu.SP); s(cpu.PC);
+    s(cpu.I); s(cpu.R); s(cpu.IM);
+    s(cpu.HALT); s(cpu.IFF1); s(cpu.IFF2); s(cpu.INV);
+    s(cpu.int_active); s(cpu.int_enable);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::mos6502_state(stream& s, mos6502& cpu) {
+    s(cpu.A); s(cpu.X); s(cpu.Y); s(cpu.S); s(cpu.P);
+    s(cpu.IR); s(cpu.PC);
+    s(cpu.RW); s(cpu.ADDR); s(cpu.DATA); s(cpu.tmp16);
+    s(cpu.IRQ); s(cpu.NMI); s(cpu.irq_taken);
+    // the 2 bytes after Cycle used to be the addressing and memory
+    // access mode, they are kept to not break the chunk layout
+    uint8_t unused = 0;
+    s(cpu.Cycle); s(unused); s(unused);
+    s(cpu.bcd_enabled);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::z80int_state(stream& s, z80int& intctrl) {
+    s(intctrl.int_enabled);
+    s(intctrl.int_requested);
+    s(intctrl.int_request_data);
+    s(intctrl.int_pending);
+    if (!s.writing) {
+        intctrl.update_chain_state();
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::z80ctc_state(stream& s, z80ctc& ctc) {
+    for (auto& chn : ctc.channels) {
+        s(chn.mode);
+        s(chn.constant);
+        s(chn.down_counter);
+        s(chn.waiting_for_trigger);
+        s(chn.interrupt_vector);
+        z80int_state(s, chn.int_ctrl);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::z80pio_state(stream& s, z80pio& pio) {
+    for (auto& p : pio.port) {
+        s(p.output); s(p.input); s(p.io_select); s(p.mode);
+        s(p.int_mask); s(p.int_vector); s(p.int_control); s(p.expect);
+        s(p.rdy); s(p.stb); s(p.bctrl_match);
+    }
+    z80int_state(s, pio.int_ctrl);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::i8255_state(stream& s, i8255& ppi) {
+    s(ppi.output);
+    s(ppi.control);
+    s(ppi.last_read);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::mos6522_state(stream& s, mos6522& via) {
+    s(via.out_b); s(via.in_b); s(via.ddr_b);
+    s(via.out_a); s(via.in_a); s(via.ddr_a);
+    s(via.acr); s(via.pcr);
+    s(via.t1_pb7); s(via.t1ll); s(via.t1lh); s(via.t2ll); s(via.t2lh);
+    s(via.t1); s(via.t2);
+    s(via.t1_active); s(via.t2_active);
+    s(via.ifr); s(via.ier);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::mc6845_state(stream& s, mc6845& crtc) {
+    s(crtc.regs);
+    s(crtc.ma); s(crtc.ra);
+    s(crtc.h_count); s(crtc.hsync_count); s(crtc.row_count); s(crtc.vsync_count);
+    s(crtc.scanline_count); s(crtc.adjust_scanline_count);
+    s(crtc.type); s(crtc.reg_sel);
+    s(crtc.hsync_width); s(crtc.vsync_width);
+    s(crtc.prev_bits); s(crtc.bits);
+    s(crtc.ma_row_start);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::mc6847_state(stream& s, mc6847& vdg) {
+    s(vdg.prev_bits); s(vdg.bits);
+    s(vdg.h_count); s(vdg.h_sync_start); s(vdg.h_sync_end); s(vdg.h_limit);
+    s(vdg.l_count);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::sound_state(stream& s, sound& snd) {
+    // the sample buffers are not part of the state
+    s(snd.sample_counter);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::ay8910_state(stream& s, ay8910& ay) {
+    sound_state(s, ay);
+    s(ay.sel);
+    s(ay.regs);
+    s(ay.tone_update);
+    for (auto& chn : ay.channels) {
+        s(chn.count); s(chn.period); s(chn.bit);
+        s(chn.tone_disable); s(chn.noise_disable);
+    }
+    s(ay.noise_count); s(ay.noise_period); s(ay.noise_bit); s(ay.noise_rng);
+    s(ay.env_count); s(ay.env_period); s(ay.env_cycle_count);
+    s(ay.env_volume); s(ay.env_volume_add);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::beeper_state(stream& s, beeper& bp) {
+    sound_state(s, bp);
+    s(bp.state);
+    s(bp.value);
+    s(bp.write_sample_counter);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::speaker_state(stream& s, speaker& spk) {
+    sound_state(s, spk);
+    for (auto& chn : spk.channels) {
+        s(chn.phase_add);
+        s(chn.phase_counter);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::crt_state(stream& s, crt& c) {
+    s(c.visible); s(c.x); s(c.y);
+    s(c.video_standard);
+    s(c.h_pos); s(c.v_pos);
+    s(c.h_black); s(c.v_black);
+    s(c.h_retrace); s(c.v_retrace);
+    s(c.h_disp_start); s(c.h_disp_end);
+    s(c.v_disp_start); s(c.v_disp_end);
+    s(c.vis_area.x0); s(c.vis_area.y0); s(c.vis_area.x1); s(c.vis_area.y1);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::kc85_state(stream& s, kc85& kc) {
+    s(kc.pio_a); s(kc.pio_b);
+    s(kc.io84); s(kc.io86);
+    s(kc.key_code);
+    s(kc.video.irm_control);
+    s(kc.video.pio_blink_flag);
+    s(kc.video.ctc_blink_flag);
+    s(kc.video.cur_scanline);
+    s(kc.audio.cycle_count);
+    for (auto& chn : kc.audio.channels) {
+        s(chn.ctc_mode);
+        s(chn.ctc_constant);
+    }
+    for (auto& slot : kc.exp.slots) {
+        uint8_t type = uint8_t(slot.mod.type);
+        uint8_t ctrl = slot.control_byte;
+        s(type);
+        s(ctrl);
+        if (!s.writing) {
+            if (kc.exp.slot_occupied(slot.slot_addr)) {
+                kc.exp.remove_module(slot.slot_addr, kc.board->z80.mem);
+            }
+            if ((kc85_exp::none != type) && (type < kc85_exp::num_module_types)) {
+                kc.exp.insert_module(slot.slot_addr, (kc85_exp::module_type)type);
+                kc.exp.update_control_byte(slot.slot_addr, ctrl);
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::z1013_state(stream& s, z1013& sys) {
+    s(sys.kbd_column_nr_requested);
+    s(sys.kbd_8x8_requested);
+    s(sys.next_kbd_column_bits);
+    s(sys.kbd_column_bits);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::z9001_state(stream& s, z9001& sys) {
+    s(sys.cur_tick);
+    s(sys.key_mask);
+    s(sys.kbd_column_mask); s(sys.kbd_line_mask);
+    s(sys.blink_flipflop);
+    s(sys.brd_color);
+    s(sys.blink_counter);
+    s(sys.ctc0_mode); s(sys.ctc0_constant);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::zx_state(stream& s, zx& sys) {
+    s(sys.memory_paging_disabled);
+    s(sys.last_7ffd_out);
+    s(sys.last_fe_out);
+    s(sys.blink_counter);
+    s(sys.scanline_counter);
+    s(sys.display_ram_bank);
+    s(sys.border_color);
+    s(sys.joy_mask);
+    s(sys.next_kbd_mask);
+    s(sys.cur_kbd_mask);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::cpc_state(stream& s, cpc& sys) {
+    s(sys.ga_config); s(sys.ram_config);
+    s(sys.scan_kbd_line);
+    s(sys.next_key_mask); s(sys.next_joy_mask); s(sys.cur_key_mask);
+    cpc_video& v = sys.video;
+    s(v.cycle_counter);
+    s(v.hsync_irq_count); s(v.hsync_after_vsync_counter);
+    s(v.hsync_start_count); s(v.hsync_end_count);
+    s(v.int_acknowledge_counter);
+    s(v.request_interrupt);
+    s(v.next_video_mode); s(v.video_mode);
+    s(v.selected_pen);
+    s(v.border_color);
+    s(v.pens);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::atom_state(stream& s, atom& sys) {
+    s(sys.counter_2_4khz);
+    s(sys.state_2_4khz);
+    s(sys.out_beep); s(sys.out_cass0); s(sys.out_cass1);
+    s(sys.scan_kbd_col);
+    s(sys.next_key_mask); s(sys.cur_key_mask);
+    s(sys.mmc_joymask); s(sys.mmc_cmd); s(sys.mmc_latch);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::bbcmicro_state(stream& s, bbcmicro& sys) {
+    s(sys.video.tick_period);
+    s(sys.video.tick_count);
+    s(sys.video.video_control);
+    s(sys.video.palette);
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::tape_state(stream& s, tapedeck& tape) {
+    // only restore the tape position into the same tape
+    char name[tapedeck::max_name_len] = { };
+    int size = 0;
+    int pos = 0;
+    if (tape.fp) {
+        size = tape.fs.size(tape.fp);
+        pos = tape.fs.get_pos(tape.fp);
+    }
+    if (s.writing) {
+        memcpy(name, tape.name, sizeof(name));
+    }
+    s.bytes(name, sizeof(name));
+    s(size);
+    if (!s.writing) {
+        name[sizeof(name)-1] = 0;
+        if (!tape.fp || (0 != strcmp(name, tape.name)) || (size != tape.fs.size(tape.fp))) {
+            return;
+        }
+    }
+    s(pos);
+    s(tape.playing);
+    s(tape.count);
+    tzx& t = tape.tzx;
+    s(t.level); s(t.stop_requested); s(t.num_data_blocks);
+    s(t.blk);
+    s(t.cur_state);
+    s(t.pulse_cycles); s(t.pulses_left);
+    s(t.data_bytes_left); s(t.data_started); s(t.data_byte); s(t.data_bits);
+    s(t.half_pulse); s(t.tone_len); s(t.sample_len);
+    s(t.loop_pos); s(t.loop_count);
+    if (!s.writing && (pos >= 0) && (pos <= size)) {
+        tape.fs.set_pos(tape.fp, pos);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+savestate::ram_state(stream& s, breadboard& board, const uint64_t (&mask)[2]) {
+    // a sequence of (first page, number of pages, page data) runs
+    uint8_t* ram = &board.ram[0][0];
+    const int num_pages = board.ram_size() / ram_page_size;
+    if (s.writing) {
+        int page = 0;
+        while (page < num_pages) {
+            if (mask[page>>6] & (uint64_t(1)<<(page & 63))) {
+                uint16_t first = uint16_t(page);
+                while ((page < num_pages) && (mask[page>>6] & (uint64_t(1)<<(page & 63)))) {
+                    page++;
+                }
+                uint16_t num = uint16_t(page - first);
+                s(first);
+                s(num);
+                s.bytes(ram + first * ram_page_size, num * ram_page_size);
+            }
+            else {
+                page++;
+            }
+        }
+    }
+    else {
+        while ((s.pos + 4) <= s.size) {
+            uint16_t first = 0, num = 0;
+            s(first);
+            s(num);
+            const int num_bytes = num * ram_page_size;
+            if (((first + num) > num_pages) || ((s.pos + num_bytes) > s.size)) {
+                break;
+            }
+            s.bytes(ram + first * ram_page_size, num_bytes);
+        }
+    }
+}
+
+} // namespace YAKC
@@ -0,0 +1,143 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::savestate
+    @brief versioned, chunked machine state snapshots
+
+    A savestate is a small header followed by a sequence of tagged
+    chunks, one chunk per chip or system, plus chunks for the RAM which
+    is actually used by the emulated system:
+
+    - header: magic, format version, header size, system model, OS ROM
+    - chunk: 4-byte tag, 2-byte chunk version, 2 bytes reserved,
+      4-byte payload size, payload
+
+    Chunk payloads are a flat sequence of fields. New fields are only ever
+    appended to the end of a chunk (and the chunk version bumped), when
+    reading, fields beyond the end of an older chunk keep their power-on
+    values, and trailing fields of a newer chunk are ignored. Unknown
+    chunks are skipped. Only a change of the header format version breaks
+    compatibility. Because of this append-only rule, the chunk version is
+    informational (for inspecting savestates), it is not checked when
+    reading, and a change which can't be expressed by appending fields
+    needs a new chunk tag.
+
+    The RAM chunk contains only the 1 KByte pages which are populated
+    in the current system configuration (for instance 48 KByte
+    on a ZX Spectrum 48K, but all 128 KByte on a 128K), KC85 module RAM
+    is written into separate chunks.
+
+    Applying a savestate powers on the saved system (the ROMs must
+    be loaded), and then overwrites the chip and system state.
+
+    The tape itself is not part of a savestate, the tape chunk only
+    contains the tape name and size, and the position and playback state
+    of the tape deck and TZX player. It is only applied if the same tape
+    is inserted when the savestate is loaded.
+
+    A savestate written without RAM only contains the chip and system
+    state, the rewinder uses this and keeps track of the RAM itself.
+*/
+#include "yakc/yakc.h"
+
+namespace YAKC {
+
+class savestate {
+public:
+    /// 'YKST'
+    static const uint32_t magic = 0x54534B59;
+    /// the header format version
+    static const uint16_t version = 1;
+
+    /// write a savestate to buffer, return required size (call with nullptr to query size)
+    static int write(const yakc& emu, uint8_t* buf, int buf_size, bool with_ram=true);
+    /// apply a savestate from buffer, return false if not a valid savestate
+    static bool apply(const uint8_t* buf, int buf_size, yakc& emu);
+    /// test if buffer starts with a compatible savestate header
+    static bool is_savestate(const uint8_t* buf, int buf_size);
+    /// write savestate to a file
+    static bool save(const yakc& emu, const char* path);
+    /// load savestate from a file
+    static bool load(const char* path, yakc& emu);
+
+    /// build a chunk tag from 4 characters
+    static constexpr uint32_t tag(char a, char b, char c, char d) {
+        return uint32_t(uint8_t(a)) | (uint32_t(uint8_t(b))<<8) | (uint32_t(uint8_t(c))<<16) | (uint32_t(uint8_t(d))<<24);
+    }
+
+    /// reads or writes the fields of a chunk
+    class stream {
+    public:
+        /// construct a writing stream (buf may be nullptr to only count bytes)
+        stream(uint8_t* buf, int buf_size);
+        /// construct a reading stream
+        stream(const uint8_t* buf, int buf_size);
+        /// read or write a plain-data field
+        template<typename T> void operator()(T& val);
+        /// read or write a bool field (as 1 byte)
+        void operator()(bool& val);
+        /// read or write a block of bytes
+        void bytes(void* ptr, int num_bytes);
+        /// read or write a counter
+        void operator()(counter& c);
+
+        const bool writing;
+        uint8_t* wr_buf = nullptr;
+        const uint8_t* rd_buf = nullptr;
+        int size = 0;
+        int pos = 0;
+    };
+
+private:
+    struct header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t header_size;
+        uint32_t model;
+        uint32_t os;
+    };
+    struct chunk_header {
+        uint32_t tag;
+        uint16_t version;
+        uint16_t reserved;
+        uint32_t size;
+    };
+    /// get the populated 1 KByte pages of the breadboard RAM for a system
+    static void ram_pages(system model, uint64_t (&mask)[2]);
+    /// apply a single chunk
+    static void apply_chunk(const chunk_header& hdr, const uint8_t* payload, yakc& emu);
+
+    static void emu_state(stream& s, yakc& emu);
+    static void clock_state(stream& s, clock& clk);
+    static void z80_state(stream& s, z80& cpu);
+    static void mos6502_state(stream& s, mos6502& cpu);
+    static void z80int_state(stream& s, z80int& intctrl);
+    static void z80ctc_state(stream& s, z80ctc& ctc);
+    static void z80pio_state(stream& s, z80pio& pio);
+    static void i8255_state(stream& s, i8255& ppi);
+    static void mos6522_state(stream& s, mos6522& via);
+    static void mc6845_state(stream& s, mc6845& crtc);
+    static void mc6847_state(stream& s, mc6847& vdg);
+    static void sound_state(stream& s, sound& snd);
+    static void ay8910_state(stream& s, ay8910& ay);
+    static void beeper_state(stream& s, beeper& bp);
+    static void speaker_state(stream& s, speaker& spk);
+    static void crt_state(stream& s, crt& c);
+    static void kc85_state(stream& s, kc85& kc);
+    static void z1013_state(stream& s, z1013& sys);
+    static void z9001_state(stream& s, z9001& sys);
+    static void zx_state(stream& s, zx& sys);
+    static void cpc_state(stream& s, cpc& sys);
+    static void atom_state(stream& s, atom& sys);
+    static void bbcmicro_state(stream& s, bbcmicro& sys);
+    static void tape_state(stream& s, tapedeck& tape);
+    static void ram_state(stream& s, breadboard& board, const uint64_t (&mask)[2]);
+};
+
+//------------------------------------------------------------------------------
+template<typename T> inline void
+savestate::stream::operator()(T& val) {
+    this->bytes(&val, sizeof(T));
+}
+
+} // namespace YAKC
@@ -269,6 +269,7 @@ snapshot::apply_intctrl_state(const state_t::intctrl_t& src, z80int& dst) {
     dst.int_requested = 0 != src.requested;
     dst.int_request_data = src.request_data;
     dst.int_pending = 0 != src.pending;
+    dst.update_chain_state();
 }
 
 //------------------------------------------------------------------------------
@@ -334,8 +335,8 @@ snapshot::apply_pio_state(const state_t& state, yakc& emu) {
 //------------------------------------------------------------------------------
 void
 snapshot::write_memory_state(const yakc& emu, state_t& state) {
-    static_assert(sizeof(emu.board.ram) == sizeof(state.ram), "Breadboard RAM size mismatch");
-    memcpy(state.ram, emu.board.ram, sizeof(emu.board.ram));
+    static_assert(breadboard::max_ram_banks*breadboard::ram_bank_size == sizeof(state.ram), "Breadboard RAM size mismatch");
+    memcpy(state.ram, emu.board.ram, emu.board.ram_size());
     if (emu.is_system(system::any_kc85)) {
         // copy content of KC85 RAM modules
         const kc85& kc = emu.kc85;
@@ -353,8 +354,15 @@ snapshot::write_memory_state(const yakc& emu, state_t& state) {
 //------------------------------------------------------------------------------
 void
 snapshot::apply_memory_state(const state_t& state, yakc& emu) {
-    static_assert(sizeof(emu.board.ram) == sizeof(state.ram), "Breadboard RAM size mismatch");
-    memcpy(emu.board.ram, state.ram, sizeof(emu.board.ram));
+    static_assert(breadboard::max_ram_banks*breadboard::ram_bank_size == sizeof(state.ram), "Breadboard RAM size mismatch");
+    // the snapshot's system model may need a different number of RAM banks,
+    // the framebuffer size only depends on the system family, so it must not
+    // move (the video code holds on to the framebuffer pointer), the memory
+    // mapping for the new RAM is rebuilt in on_context_switched()
+    const uint32_t* rgba8_buffer = emu.board.rgba8_buffer;
+    emu.alloc_board(emu.model);
+    YAKC_ASSERT(rgba8_buffer == emu.board.rgba8_buffer);
+    memcpy(emu.board.ram, state.ram, emu.board.ram_size());
     if (emu.is_system(system::any_kc85)) {
         // copy content of KC85 RAM modules
         kc85& kc = emu.kc85;
@@ -11,7 +11,6 @@ void
 z1013::init(breadboard* b, rom_images* r) {
     this->board = b;
     this->roms = r;
-    this->rgba8_buffer = this->board->rgba8_buffer;
 }
 
 //------------------------------------------------------------------------------
@@ -83,13 +82,14 @@ z1013::poweron(system m) {
     }
     this->init_keymaps();
     this->on = true;
+    this->rgba8_buffer = this->board->rgba8_buffer;
     this->kbd_column_nr_requested = 0;
     this->kbd_8x8_requested = false;
     this->next_kbd_column_bits = 0;
     this->kbd_column_bits = 0;
 
     // map memory
-    clear(this->board->ram, sizeof(this->board->ram));
+    clear(this->board->ram, this->board->ram_size());
     this->init_memory_mapping();
 
     // initialize the clock, the z1013_01 runs at 1MHz, all others at 2MHz
@@ -130,18 +130,20 @@ z1013::step(uint64_t start_tick, uint64_t end_tick) {
     auto& cpu = this->board->z80;
     auto& dbg = this->board->dbg;
     auto& clk = this->board->clck;
-    uint64_t cur_tick = start_tick;
-    while (cur_tick < end_tick) {
+    this->cur_tick = start_tick;
+    this->end_tick = end_tick;
+    while (this->cur_tick < end_tick) {
         uint32_t ticks = cpu.step(this);
         ticks += cpu.handle_irq(this);
         clk.step(this, ticks);
         if (dbg.step(cpu.PC, ticks)) {
             return end_tick;
         }
-        cur_tick += ticks;
+        this->cur_tick += ticks;
     }
+    this->end_tick = this->cur_tick;
     this->decode_video();
-    return cur_tick;
+    return this->cur_tick;
 }
 
 //------------------------------------------------------------------------------
@@ -165,6 +167,15 @@ z1013::step_debug() {
     return uint32_t(all_ticks);
 }
 
+//------------------------------------------------------------------------------
+int
+z1013::cpu_block_budget() {
+    // the Z1013 has no timed events, block instructions may run
+    // until the end of the current step() call
+    const int budget = int(this->end_tick - this->cur_tick);
+    return this->board->clck.cycles_until_timer(budget);
+}
+
 //------------------------------------------------------------------------------
 void
 z1013::cpu_out(uword port, ubyte val) {
@@ -394,6 +405,8 @@ z1013::init_keymap_8x8() {
 //------------------------------------------------------------------------------
 void
 z1013::decode_video() {
+    // the whole frame is decoded at once
+    this->board->num_scanlines += display_height;
     uint32_t* dst = rgba8_buffer;
     const ubyte* src = this->board->ram[vidmem_page];
     const ubyte* font = this->roms->ptr(rom_images::z1013_font);
@@ -440,9 +453,9 @@ z1013::quickload(filesystem* fs, const char* name, filetype type, bool start) {
             static const int buf_size = 1024;
             uint8_t buf[buf_size];
             fs->read(fp, buf, buf_size);
-            for (int i = 0; (i < buf_size) && (addr < end_addr); i++) {
-                mem.w8(addr++, buf[i]);
-            }
+            const int num = (end_addr - addr) < buf_size ? (end_addr - addr) : buf_size;
+            mem.write(addr, buf, num);
+            addr += num;
         }
     }
     fs->close(fp);
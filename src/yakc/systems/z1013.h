@@ -89,6 +89,8 @@ public:
     virtual ubyte pio_in(int pio_id, int port_id) override;
     /// interrupt request callback
     virtual void irq(bool b) override;
+    /// block instruction budget callback
+    virtual int cpu_block_budget() override;
 
     /// initialize the key translation table for the basic 8x4 keyboard (z1013.01)
     void init_keymap_8x4();
@@ -106,6 +108,8 @@ public:
     system cur_model = system::z1013_01;
     os_rom cur_os = os_rom::z1013_mon202;
     bool on = false;
+    uint64_t cur_tick = 0;
+    uint64_t end_tick = 0;
     ubyte kbd_column_nr_requested = 0;      // requested keyboard matrix column number (0..7)
     bool kbd_8x8_requested = false;         // bit 4 in PIO-B written
     uint64_t next_kbd_column_bits = 0;
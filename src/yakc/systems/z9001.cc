@@ -27,7 +27,6 @@ void
 z9001::init(breadboard* b, rom_images* r) {
     this->board = b;
     this->roms = r;
-    this->rgba8_buffer = this->board->rgba8_buffer;
 
     // setup the key map which translates ASCII to keyboard matrix bits
     const char* kbd_matrix =
@@ -136,6 +135,7 @@ z9001::on_context_switched() {
     pio1.int_ctrl.connect_irq_device(&pio2.int_ctrl);
     pio2.int_ctrl.connect_irq_device(&ctc.channels[0].int_ctrl);
     ctc.init_daisychain(nullptr);
+    ctc.update(this);
 }
 
 //------------------------------------------------------------------------------
@@ -154,11 +154,10 @@ z9001::poweron(system m, os_rom os) {
     this->keybuf.init(4);
     this->ctc0_mode = z80ctc::RESET;
     this->ctc0_constant = 0;
+    this->rgba8_buffer = this->board->rgba8_buffer;
 
     // map memory
-    for (int i = 0; i < breadboard::num_ram_banks; i++) {
-        memcpy(this->board->ram[i], this->board->random, breadboard::ram_bank_size);
-    }
+    fill_random(this->board->ram, this->board->ram_size());
     this->init_memory_mapping();
 
     // initialize the clock at 2.4576 MHz
@@ -221,6 +220,7 @@ z9001::step(uint64_t start_tick, uint64_t end_tick) {
     auto& dbg = this->board->dbg;
     this->handle_key();
     this->cur_tick = start_tick;
+    this->end_tick = end_tick;
     while (this->cur_tick < end_tick) {
         uint32_t ticks = cpu.step(this);
         ticks += cpu.handle_irq(this);
@@ -228,10 +228,13 @@ z9001::step(uint64_t start_tick, uint64_t end_tick) {
         this->board->z80ctc.step(this, ticks);
         this->board->speaker.step(ticks);
         if (dbg.step(cpu.PC, ticks)) {
+            this->board->z80ctc.update(this);
             return end_tick;
         }
         this->cur_tick += ticks;
     }
+    this->end_tick = this->cur_tick;
+    this->board->z80ctc.update(this);
     this->decode_video();
     return this->cur_tick;
 }
@@ -254,6 +257,7 @@ z9001::step_debug() {
         all_ticks += ticks;
     }
     while ((old_pc == cpu.PC) && !cpu.INV);    
+    this->board->z80ctc.update(this);
     this->decode_video();
     return uint32_t(all_ticks);
 }
@@ -463,6 +467,16 @@ z9001::ctc_zcto(int ctc_id, int chn_id) {
     }
 }
 
+//------------------------------------------------------------------------------
+int
+z9001::cpu_block_budget() {
+    // block instructions may run until the next clock timer
+    // or CTC timer event, or the end of the current step() call
+    int budget = int(this->end_tick - this->cur_tick);
+    budget = this->board->clck.cycles_until_timer(budget);
+    return this->board->z80ctc.ticks_until_event(budget);
+}
+
 //------------------------------------------------------------------------------
 void
 z9001::irq(bool b) {
@@ -527,6 +541,8 @@ z9001::border_color(float& out_red, float& out_green, float& out_blue) {
 //------------------------------------------------------------------------------
 void
 z9001::decode_video() {
+    // the whole frame is decoded at once
+    this->board->num_scanlines += display_height;
 
     // FIXME: there's also a 40x20 display mode
     uint32_t* dst = this->rgba8_buffer;
@@ -622,9 +638,9 @@ z9001::quickload(filesystem* fs, const char* name, filetype type, bool start) {
                 static const int block_size = 129;
                 uint8_t block[block_size];
                 fs->read(fp, block, block_size);
-                for (int i = 1; (i < block_size) && (addr < end_addr); i++) {
-                    mem.w8(addr++, block[i]);
-                }
+                const int num = (end_addr - addr) < (block_size - 1) ? (end_addr - addr) : (block_size - 1);
+                mem.write(addr, block + 1, num);
+                addr += num;
             }
         }
     }
@@ -639,9 +655,9 @@ z9001::quickload(filesystem* fs, const char* name, filetype type, bool start) {
                 static const int buf_size = 1024;
                 uint8_t buf[buf_size];
                 fs->read(fp, buf, buf_size);
-                for (int i = 0; (i < buf_size) && (addr < end_addr); i++) {
-                    mem.w8(addr++, buf[i]);
-                }
+                const int num = (end_addr - addr) < buf_size ? (end_addr - addr) : buf_size;
+                mem.write(addr, buf, num);
+                addr += num;
             }
         }
     }
@@ -72,6 +72,8 @@ public:
     virtual void irq(bool b) override;
     /// clock timer triggered
     virtual void timer(int timer_id) override;
+    /// block instruction budget callback
+    virtual int cpu_block_budget() override;
 
     /// put a key as ASCII code
     void put_key(ubyte ascii);
@@ -94,6 +96,7 @@ public:
     os_rom cur_os = os_rom::kc87_os_2;
     bool on = false;
     uint64_t cur_tick = 0;
+    uint64_t end_tick = 0;
 
     keybuffer keybuf;
     uint64_t key_mask = 0;              // (column<<8)|line bits for currently pressed key
@@ -28,11 +28,11 @@ uint32_t zx::palette[8] = {
 
 //------------------------------------------------------------------------------
 void
-zx::init(breadboard* b, rom_images* r) {
-    YAKC_ASSERT(b && r);
+zx::init(breadboard* b, rom_images* r, tapedeck* t) {
+    YAKC_ASSERT(b && r && t);
     this->board = b;
     this->roms = r;
-    this->rgba8_buffer = this->board->rgba8_buffer;
+    this->tape = t;
     // setup key translation table
     this->init_keymap();
 }
@@ -144,6 +144,7 @@ zx::init_keymap() {
 void
 zx::init_memory_map() {
     z80& cpu = this->board->z80;
+    cpu.mem.begin_remap();
     cpu.mem.unmap_all();
     if (system::zxspectrum48k == this->cur_model) {
         // 48k RAM between 0x4000 and 0xFFFF
@@ -164,12 +165,38 @@ zx::init_memory_map() {
         YAKC_ASSERT(this->roms->has(rom_images::zx128k_1) && (this->roms->size(rom_images::zx128k_1) == 0x4000));
         cpu.mem.map(0, 0x0000, 0x4000, this->roms->ptr(rom_images::zx128k_0), false);
     }
+    cpu.mem.end_remap();
+}
+
+//------------------------------------------------------------------------------
+void
+zx::update_128k_paging() {
+    auto& mem = this->board->z80.mem;
+    const uint8_t val = this->last_7ffd_out;
+    mem.begin_remap();
+
+    // only last memory bank is mappable
+    mem.map(0, 0xC000, 0x4000, this->board->ram[val & 0x7], true);
+
+    // ROM0 or ROM1
+    if (val & (1<<4)) {
+        // bit 4 set: ROM1
+        mem.map(0, 0x0000, 0x4000, this->roms->ptr(rom_images::zx128k_1), false);
+    }
+    else {
+        // bit 4 clear: ROM0
+        mem.map(0, 0x0000, 0x4000, this->roms->ptr(rom_images::zx128k_0), false);
+    }
+    mem.end_remap();
 }
 
 //------------------------------------------------------------------------------
 void
 zx::on_context_switched() {
-    // FIXME!
+    this->init_memory_map();
+    if (system::zxspectrum128k == this->cur_model) {
+        this->update_128k_paging();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -185,6 +212,7 @@ zx::poweron(system m) {
     this->scanline_counter = 0;
     this->blink_counter = 0;
     this->memory_paging_disabled = false;
+    this->last_7ffd_out = 0;
     this->joy_mask = 0;
     this->next_kbd_mask = 0;
     this->cur_kbd_mask = 0;
@@ -195,9 +223,10 @@ zx::poweron(system m) {
         this->display_ram_bank = 5;
     }
     this->on = true;
+    this->rgba8_buffer = this->board->rgba8_buffer;
 
     // map memory
-    clear(this->board->ram, sizeof(this->board->ram));
+    clear(this->board->ram, this->board->ram_size());
     this->init_memory_map();
 
     // initialize the system clock and PAL-line timer
@@ -220,6 +249,7 @@ zx::poweron(system m) {
     if (system::zxspectrum128k == this->cur_model) {
         this->board->ay8910.init(cpu_khz, cpu_khz/2, SOUND_SAMPLE_RATE);
     }
+    this->tape->tzx.freq_khz = cpu_khz;
 
     // cpu start state
     this->board->z80.init();
@@ -242,6 +272,7 @@ zx::reset() {
         this->board->ay8910.reset();
     }
     this->memory_paging_disabled = false;
+    this->last_7ffd_out = 0;
     this->joy_mask = 0;
     this->next_kbd_mask = 0;
     this->cur_kbd_mask = 0;
@@ -266,9 +297,15 @@ zx::step(uint64_t start_tick, uint64_t end_tick) {
             ticks += cpu.handle_irq(this);
             this->board->clck.step(this, ticks);
             this->board->beeper.step(ticks);
+            if (this->tape->is_playing()) {
+                this->tape->step(ticks);
+            }
             if (dbg.step(cpu.PC, ticks)) {
                 return end_tick;
             }
+            if (cpu.PC == ld_bytes_trap) {
+                this->ld_bytes();
+            }
             cur_tick += ticks;
         }
     }
@@ -279,9 +316,15 @@ zx::step(uint64_t start_tick, uint64_t end_tick) {
             this->board->clck.step(this, ticks);
             this->board->beeper.step(ticks);
             this->board->ay8910.step(ticks);
+            if (this->tape->is_playing()) {
+                this->tape->step(ticks);
+            }
             if (dbg.step(cpu.PC, ticks)) {
                 return end_tick;
             }
+            if (cpu.PC == ld_bytes_trap) {
+                this->ld_bytes();
+            }
             cur_tick += ticks;
         }
     }
@@ -304,7 +347,13 @@ zx::step_debug() {
         if (system::zxspectrum128k == this->cur_model) {
             this->board->ay8910.step(ticks);
         }
+        if (this->tape->is_playing()) {
+            this->tape->step(ticks);
+        }
         dbg.step(cpu.PC, ticks);
+        if (cpu.PC == ld_bytes_trap) {
+            this->ld_bytes();
+        }
         all_ticks += ticks;
     }
     while ((old_pc == cpu.PC) && !cpu.INV);    
@@ -335,21 +384,8 @@ zx::cpu_out(uword port, ubyte val) {
             if (!this->memory_paging_disabled) {
                 // bit 3 defines the video scanout memory bank (5 or 7)
                 this->display_ram_bank = (val & (1<<3)) ? 7 : 5;
-
-                auto& mem = this->board->z80.mem;
-
-                // only last memory bank is mappable
-                mem.map(0, 0xC000, 0x4000, this->board->ram[val & 0x7], true);
-
-                // ROM0 or ROM1
-                if (val & (1<<4)) {
-                    // bit 4 set: ROM1
-                    mem.map(0, 0x0000, 0x4000, this->roms->ptr(rom_images::zx128k_1), false);
-                }
-                else {
-                    // bit 4 clear: ROM0
-                    mem.map(0, 0x0000, 0x4000, this->roms->ptr(rom_images::zx128k_0), false);
-                }
+                this->last_7ffd_out = val;
+                this->update_128k_paging();
             }
             if (val & (1<<5)) {
                 // bit 5 prevents further changes to memory pages
@@ -369,6 +405,13 @@ zx::cpu_out(uword port, ubyte val) {
 
 }
 
+//------------------------------------------------------------------------------
+int
+zx::cpu_block_budget() {
+    // block instructions may run until the next scanline (max 228 T-states)
+    return this->board->clck.cycles_until_timer(228);
+}
+
 //------------------------------------------------------------------------------
 void
 zx::put_input(ubyte ascii, ubyte joy_mask) {
@@ -395,8 +438,13 @@ zx::cpu_in(uword port) {
     // keyboard
     if ((port & 0xFF) == 0xFE) {
         ubyte val = 0;
-        // MIC/EAR flags -> bit 6
-        if (this->last_fe_out & (1<<3|1<<4)) {
+        // EAR input from a playing tape, otherwise MIC/EAR flags -> bit 6
+        if (this->tape->is_playing()) {
+            if (this->tape->tzx.level) {
+                val |= (1<<6);
+            }
+        }
+        else if (this->last_fe_out & (1<<3|1<<4)) {
             val |= (1<<6);
         }
 
@@ -466,6 +514,7 @@ zx::scanline() {
     // one PAL line takes 224 T-states on 48K, and 228 T-states on 128K
     // one PAL frame is 312 lines on 48K, and 311 lines on 128K
     //
+    this->board->num_scanlines++;
     const uint32_t frame_scanlines = this->cur_model == system::zxspectrum128k ? 311 : 312;
     const uint32_t top_border = this->cur_model == system::zxspectrum128k ? 63 : 64;
 
@@ -666,7 +715,7 @@ zx::quickload(filesystem* fs, const char* name, filetype type, bool start) {
                 }
             }
             uint8_t* dst_ptr;
-            if (-1 == page_index) {
+            if ((-1 == page_index) || (page_index >= this->board->num_ram_banks)) {
                 dst_ptr = this->board->junk;
             }
             else {
@@ -698,10 +747,9 @@ zx::quickload(filesystem* fs, const char* name, filetype type, bool start) {
                             YAKC_ASSERT(0 != count);
                             uint8_t data = val[3];
                             src_pos += 4;
-                            for (int i = 0; i < count; i++) {
-                                YAKC_ASSERT(dst_ptr < dst_end_ptr);
-                                *dst_ptr++ = data;
-                            }
+                            YAKC_ASSERT((dst_ptr + count) <= dst_end_ptr);
+                            memset(dst_ptr, data, count);
+                            dst_ptr += count;
                         }
                         else {
                             // single ED
@@ -776,4 +824,69 @@ error:
     return false;
 }
 
+//------------------------------------------------------------------------------
+void
+zx::ld_bytes() {
+    // trapped LD-BYTES ROM routine: A is the expected flag byte,
+    // IX the load address, DE the number of bytes, and the carry flag
+    // is set for LOAD and cleared for VERIFY
+    //
+    // standard speed blocks are loaded instantly, for all other
+    // blocks the tape starts playing and the ROM reads the signal
+    auto& cpu = this->board->z80;
+    auto& tzx = this->tape->tzx;
+    if (!tzx.is_valid()) {
+        return;
+    }
+    if ((system::zxspectrum128k == this->cur_model) && !(this->last_7ffd_out & (1<<4))) {
+        // 128K editor ROM is paged in, this isn't LD-BYTES
+        return;
+    }
+    if (!tzx.data_block_ready() || (tzx::standard != tzx.blk.id)) {
+        this->tape->play();
+        return;
+    }
+    bool success = false;
+    const uint8_t flag = tzx.read_u8();
+    if (flag == cpu.A) {
+        const bool verify = !(cpu.F & z80::CF);
+        uint8_t parity = flag;
+        success = true;
+        while ((cpu.DE > 0) && (tzx.data_left() > 0)) {
+            const uint8_t val = tzx.read_u8();
+            parity ^= val;
+            if (verify) {
+                if (cpu.mem.r8(cpu.IX) != val) {
+                    success = false;
+                    break;
+                }
+            }
+            else {
+                cpu.mem.w8(cpu.IX, val);
+            }
+            cpu.IX++;
+            cpu.DE--;
+        }
+        if (success && (0 == cpu.DE) && (tzx.data_left() > 0)) {
+            // the last byte is the checksum
+            parity ^= tzx.read_u8();
+            success = (0 == parity);
+        }
+        else {
+            success = false;
+        }
+    }
+    tzx.finish_block();
+    this->tape->inc_counter(1);
+    if (success) {
+        cpu.F |= z80::CF;
+    }
+    else {
+        cpu.F &= ~z80::CF;
+    }
+    // continue at SA/LD-RET, which restores the border color,
+    // enables interrupts and returns to the caller
+    cpu.PC = ld_bytes_ret;
+}
+
 } // namespace YAKC
@@ -9,6 +9,7 @@
 #include "yakc/systems/rom_images.h"
 #include "yakc/core/filesystem.h"
 #include "yakc/core/filetypes.h"
+#include "yakc/peripherals/tapedeck.h"
 
 namespace YAKC {
 
@@ -18,13 +19,17 @@ public:
     breadboard* board = nullptr;
     /// rom image storage
     rom_images* roms = nullptr;
+    /// tapedeck
+    class tapedeck* tape = nullptr;
 
     /// one-time setup
-    void init(breadboard* board, rom_images* roms);
+    void init(breadboard* board, rom_images* roms, class tapedeck* tape);
     /// check if required roms are loaded
     static bool check_roms(const rom_images& roms, system model, os_rom os);
     /// initialize the memory map
     void init_memory_map();
+    /// update the Spectrum 128K memory paging from the last 0x7FFD out value
+    void update_128k_paging();
     /// initialize the keyboard matrix mapping table
     void init_keymap();
     /// initialize a single entry in the key-map table
@@ -55,6 +60,8 @@ public:
     const void* framebuffer(int& out_width, int& out_height);
     /// file quickloading
     bool quickload(filesystem* fs, const char* name, filetype type, bool start);    
+    /// the trapped LD-BYTES ROM routine for TZX tapes
+    void ld_bytes();
 
     /// the z80 out callback
     virtual void cpu_out(uword port, ubyte val) override;
@@ -62,6 +69,8 @@ public:
     virtual ubyte cpu_in(uword port) override;
     /// interrupt request callback
     virtual void irq(bool b) override;
+    /// block instruction budget callback
+    virtual int cpu_block_budget() override;
     /// clock timer-trigger callback
     virtual void timer(int timer_id) override;
 
@@ -72,7 +81,10 @@ public:
 
     system cur_model = system::zxspectrum48k;
     bool on = false;
+    static const uint16_t ld_bytes_trap = 0x0556;   // LD-BYTES in the 48K ROM
+    static const uint16_t ld_bytes_ret = 0x053F;    // SA/LD-RET in the 48K ROM
     bool memory_paging_disabled = false;
+    uint8_t last_7ffd_out = 0;          // last OUT value to 0x7FFD port (128K memory paging)
     uint8_t last_fe_out = 0;            // last OUT value to xxFE port
     uint8_t blink_counter = 0;          // increased by one every vblank
     uint16_t scanline_counter = 0;
@@ -9,7 +9,6 @@ namespace YAKC {
 void
 yakc::init(const ext_funcs& sys_funcs) {
     func = sys_funcs;
-    fill_random(this->board.random, sizeof(this->board.random));
     this->cpu_ahead = false;
     this->cpu_behind = false;
     this->abs_cycle_count = 0;
@@ -17,7 +16,7 @@ yakc::init(const ext_funcs& sys_funcs) {
     this->kc85.init(&this->board, &this->roms);
     this->z1013.init(&this->board, &this->roms);
     this->z9001.init(&this->board, &this->roms);
-    this->zx.init(&this->board, &this->roms);
+    this->zx.init(&this->board, &this->roms, &this->tapedeck);
     this->cpc.init(&this->board, &this->roms, &this->tapedeck);
     this->atom.init(&this->board, &this->roms, &this->tapedeck);
     this->bbcmicro.init(&this->board, &this->roms);
@@ -29,6 +28,12 @@ yakc::add_rom(rom_images::rom type, const uint8_t* ptr, int size) {
     this->roms.add(type, ptr, size);
 }
 
+//------------------------------------------------------------------------------
+void
+yakc::add_roms(const rom_repository& repo) {
+    repo.share(this->roms);
+}
+
 //------------------------------------------------------------------------------
 bool
 yakc::check_roms(system m, os_rom os) {
@@ -67,6 +72,7 @@ yakc::poweron(system m, os_rom rom) {
     this->os = rom;
     this->abs_cycle_count = 0;
     this->overflow_cycles = 0;
+    this->alloc_board(m);
     if (this->is_system(system::any_kc85)) {
         this->kc85.poweron(m, rom);
     }
@@ -88,6 +94,14 @@ yakc::poweron(system m, os_rom rom) {
     else if (this->is_system(system::bbcmicro_b)) {
         this->bbcmicro.poweron(m);
     }
+    // the CPC selects its I/O devices by the high port byte
+    this->board.z80.port_stats_shift = this->is_system(system::any_cpc) ? 8 : 0;
+    if (cpu_model::z80 == this->cpu_type()) {
+        this->board.dbg.attach_cpu(&this->board.z80);
+    }
+    else {
+        this->board.dbg.attach_cpu(&this->board.mos6502);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -114,6 +128,80 @@ yakc::poweroff() {
     if (this->bbcmicro.on) {
         this->bbcmicro.poweroff();
     }
+    // the CPUs must not keep pointers into freed RAM banks
+    this->board.z80.mem.unmap_all();
+    this->board.mos6502.mem.unmap_all();
+    this->board.free_memory();
+}
+
+//------------------------------------------------------------------------------
+void
+yakc::alloc_board(system m) {
+    int num_banks = 0;
+    int fb_width = 0;
+    int fb_height = 0;
+    switch (m) {
+        case system::kc85_2:
+        case system::kc85_3:
+            num_banks = kc85_video::irm0_page + 1;
+            fb_width = kc85_video::display_width;
+            fb_height = kc85_video::display_height;
+            break;
+        case system::kc85_4:
+            num_banks = kc85_video::irm0_page + 4;
+            fb_width = kc85_video::display_width;
+            fb_height = kc85_video::display_height;
+            break;
+        case system::z1013_01:
+        case system::z1013_16:
+        case system::z1013_64:
+            num_banks = z1013::vidmem_page + 1;
+            fb_width = z1013::display_width;
+            fb_height = z1013::display_height;
+            break;
+        case system::z9001:
+        case system::kc87:
+            num_banks = z9001::color_ram_page + 1;
+            fb_width = z9001::display_width;
+            fb_height = z9001::display_height;
+            break;
+        case system::zxspectrum48k:
+            num_banks = 3;
+            fb_width = zx::display_width;
+            fb_height = zx::display_height;
+            break;
+        case system::zxspectrum128k:
+            num_banks = 8;
+            fb_width = zx::display_width;
+            fb_height = zx::display_height;
+            break;
+        case system::cpc464:
+        case system::kccompact:
+            num_banks = 4;
+            // debug video mode can be switched on at any time
+            fb_width = cpc_video::dbg_max_display_width;
+            fb_height = cpc_video::dbg_max_display_height;
+            break;
+        case system::cpc6128:
+            num_banks = 8;
+            fb_width = cpc_video::dbg_max_display_width;
+            fb_height = cpc_video::dbg_max_display_height;
+            break;
+        case system::acorn_atom:
+            num_banks = 4;
+            fb_width = mc6847::disp_width_with_border;
+            fb_height = mc6847::disp_height_with_border;
+            break;
+        case system::bbcmicro_b:
+            num_banks = 2;
+            fb_width = bbcmicro_video::display_width;
+            fb_height = bbcmicro_video::display_height;
+            break;
+        default:
+            YAKC_ASSERT(false);
+            break;
+    }
+    this->board.alloc_memory(num_banks, fb_width, fb_height);
 }
 
 //------------------------------------------------------------------------------
@@ -164,6 +252,9 @@ yakc::clear_daisychain() {
 void
 yakc::on_context_switched() {
     this->clear_daisychain();
+    // memory content has been replaced behind the CPU's back
+    this->board.z80.mem.mark_dirty(0x0000, 0x10000);
+    this->board.mos6502.mem.mark_dirty(0x0000, 0x10000);
     if (this->is_system(system::any_kc85)) {
         this->kc85.on_context_switched();
     }
@@ -202,7 +293,13 @@ yakc::is_system(system model, system mask) {
 //------------------------------------------------------------------------------
 cpu_model
 yakc::cpu_type() const {
-    if (this->is_system(system::bbcmicro_b) || this->is_system(system::acorn_atom)) {
+    return cpu_type(this->model);
+}
+
+//------------------------------------------------------------------------------
+cpu_model
+yakc::cpu_type(system model) {
+    if (is_system(model, system::bbcmicro_b) || is_system(model, system::acorn_atom)) {
         return cpu_model::mos6502;
     }
     else {
@@ -261,11 +358,63 @@ yakc::step(int micro_secs, uint64_t audio_cycle_count) {
         }
         YAKC_ASSERT(this->abs_cycle_count >= abs_end_cycles);
         this->overflow_cycles = uint32_t(this->abs_cycle_count - abs_end_cycles);
+        if (this->capture.is_active()) {
+            int w, h;
+            const void* fb = this->framebuffer(w, h);
+            this->capture.push_frame(fb, w, h);
+        }
+        if (this->rewinder.is_valid() && this->switchedon()) {
+            this->rewinder.record(*this);
+        }
     }
     else {
         this->abs_cycle_count = abs_end_cycles;
         this->overflow_cycles = 0;
     }
+    this->stats.num_frames++;
+    if (this->cpu_ahead) {
+        this->stats.num_cpu_ahead++;
+    }
+    if (this->cpu_behind) {
+        this->stats.num_cpu_behind++;
+    }
+    this->update_stats();
+}
+
+//------------------------------------------------------------------------------
+void
+yakc::update_stats() {
+    auto& s = this->stats;
+    const auto& b = this->board;
+    s.num_instructions = b.z80.num_ops + b.mos6502.num_ops;
+    s.num_interrupts = b.z80.num_irqs + b.mos6502.num_irqs;
+    s.num_remaps = b.z80.mem.num_remaps + b.mos6502.mem.num_remaps;
+    s.num_scanlines = b.num_scanlines;
+    s.num_audio_samples = b.beeper.num_samples + b.speaker.num_samples + b.ay8910.num_samples;
+    static_assert(sizeof(s.port_reads) == sizeof(b.z80.port_reads), "port counter size mismatch");
+    memcpy(s.port_reads, b.z80.port_reads, sizeof(s.port_reads));
+    memcpy(s.port_writes, b.z80.port_writes, sizeof(s.port_writes));
+    if (cpu_model::z80 != this->cpu_type()) {
+        s.ports = stats::no_ports;
+    }
+    else {
+        s.ports = b.z80.port_stats_shift ? stats::port_high_byte : stats::port_low_byte;
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+yakc::reset_stats() {
+    auto& b = this->board;
+    b.z80.num_ops = b.mos6502.num_ops = 0;
+    b.z80.num_irqs = b.mos6502.num_irqs = 0;
+    b.z80.mem.num_remaps = b.mos6502.mem.num_remaps = 0;
+    b.num_scanlines = 0;
+    b.beeper.num_samples = b.speaker.num_samples = b.ay8910.num_samples = 0;
+    clear(b.z80.port_reads, sizeof(b.z80.port_reads));
+    clear(b.z80.port_writes, sizeof(b.z80.port_writes));
+    this->stats.reset();
+    this->update_stats();
 }
 
 //------------------------------------------------------------------------------
@@ -408,25 +557,35 @@ yakc::border_color(float& out_red, float& out_green, float& out_blue) {
 //------------------------------------------------------------------------------
 void
 yakc::fill_sound_samples(float* buffer, int num_samples) {
+    bool valid = false;
     if (!this->board.dbg.active) {
+        valid = true;
         if (this->kc85.on) {
-            return this->kc85.decode_audio(buffer, num_samples);
+            this->kc85.decode_audio(buffer, num_samples);
         }
         else if (this->z9001.on) {
-            return this->z9001.decode_audio(buffer, num_samples);
+            this->z9001.decode_audio(buffer, num_samples);
         }
         else if (this->zx.on) {
-            return this->zx.decode_audio(buffer, num_samples);
+            this->zx.decode_audio(buffer, num_samples);
         }
         else if (this->cpc.on) {
-            return this->cpc.decode_audio(buffer, num_samples);
+            this->cpc.decode_audio(buffer, num_samples);
         }
         else if (this->atom.on) {
-            return this->atom.decode_audio(buffer, num_samples);
+            this->atom.decode_audio(buffer, num_samples);
+        }
+        else {
+            valid = false;
         }
     }
-    // fallthrough: all systems off, or debugging active: return silence
-    clear(buffer, num_samples * sizeof(float));
+    if (!valid) {
+        // all systems off, or debugging active: return silence
+        clear(buffer, num_samples * sizeof(float));
+    }
+    if (this->capture.is_active()) {
+        this->capture.push_audio(buffer, num_samples);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -460,6 +619,38 @@ yakc::framebuffer(int& out_width, int& out_height) {
     }
 }
 
+//------------------------------------------------------------------------------
+bool
+yakc::start_capture(const char* video_path, const char* audio_path, capture::video_format fmt, int fps) {
+    return this->capture.start(video_path, audio_path, fmt, fps);
+}
+
+//------------------------------------------------------------------------------
+void
+yakc::stop_capture() {
+    this->capture.stop();
+}
+
+//------------------------------------------------------------------------------
+void
+yakc::start_rewind(int budget_bytes) {
+    this->rewinder.init(budget_bytes);
+}
+
+//------------------------------------------------------------------------------
+void
+yakc::stop_rewind() {
+    this->rewinder.discard();
+    this->board.z80.mem.set_dirty_tracking(false, memory::dirty_rewinder);
+    this->board.mos6502.mem.set_dirty_tracking(false, memory::dirty_rewinder);
+}
+
+//------------------------------------------------------------------------------
+bool
+yakc::rewind(int num_frames) {
+    return this->rewinder.is_valid() && this->rewinder.step_back(num_frames, *this);
+}
+
 //------------------------------------------------------------------------------
 bool
 yakc::quickload(const char* name, filetype type, bool start) {
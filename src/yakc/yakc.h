@@ -7,7 +7,11 @@
 #include "yakc/core/core.h"
 #include "yakc/systems/breadboard.h"
 #include "yakc/systems/rom_images.h"
+#include "yakc/systems/rom_repository.h"
 #include "yakc/core/filesystem.h"
+#include "yakc/core/capture.h"
+#include "yakc/core/stats.h"
+#include "yakc/systems/rewinder.h"
 #include "yakc/peripherals/tapedeck.h"
 #include "yakc/systems/kc85.h"
 #include "yakc/systems/z1013.h"
@@ -23,8 +27,10 @@ class yakc {
 public:
     /// one-time init
     void init(const ext_funcs& funcs);
-    /// add a ROM image
+    /// add a ROM image (the data is copied)
     void add_rom(rom_images::rom type, const uint8_t* ptr, int size);
+    /// reference all ROM images of a ROM repository (not copied, the repository must outlive the emu)
+    void add_roms(const rom_repository& repo);
     /// check if the required ROM images for a model/os combination are loaded
     bool check_roms(system model, os_rom os=os_rom::none);
     /// poweron one of the emus
@@ -33,10 +39,16 @@ public:
     void poweroff();
     /// reset the emu
     void reset();
+    /// allocate the breadboard RAM banks and framebuffer for a system (called by poweron)
+    void alloc_board(system m);
     /// process one frame, up to absolute number of cycles
     void step(int micro_secs, uint64_t audio_cycle_count);
     /// step over one instruction and return number of cycles (called by debuggers)
     uint32_t step_debug();
+    /// collect the chip counters into the stats block (called by step())
+    void update_stats();
+    /// clear the stats block and all chip counters
+    void reset_stats();
 
     /// put key and joystick input
     void put_input(uint8_t ascii, uint8_t joy0_kbd_mask, uint8_t joy0_pad_mask=0);
@@ -53,6 +65,18 @@ public:
     /// get pointer to emulator framebuffer, its width, and height
     const void* framebuffer(int& out_width, int& out_height);
 
+    /// start capturing video frames and/or audio to files (see capture.h)
+    bool start_capture(const char* video_path, const char* audio_path, capture::video_format fmt=capture::video_format::y4m, int fps=50);
+    /// stop capturing and close capture files
+    void stop_capture();
+
+    /// start recording each frame for rewinding (see rewinder.h)
+    void start_rewind(int budget_bytes=rewinder::default_budget);
+    /// stop recording frames and free the rewind buffer
+    void stop_rewind();
+    /// return to a recorded frame (0 is the last recorded frame), newer frames are dropped
+    bool rewind(int num_frames);
+
     /// clear the current interrupt daisychain
     void clear_daisychain();
     /// do a partial init after applying a snapshot
@@ -66,6 +90,8 @@ public:
     static bool is_system(system model, system mask);
     /// get the cpu model of the current system
     cpu_model cpu_type() const;
+    /// get the cpu model of any system
+    static cpu_model cpu_type(system model);
     /// get human-readable info about current system
     const char* system_info() const;
     /// get current border color
@@ -86,6 +112,9 @@ public:
     class rom_images roms;
     class filesystem filesystem;
     class tapedeck tapedeck;
+    class capture capture;
+    class rewinder rewinder;
+    class stats stats;
 
     bool cpu_ahead = false;                 // cpu would have been ahead of max_cycle_count
     bool cpu_behind = false;                // cpu would have been behind of min_cycle_count
@@ -0,0 +1,760 @@
+//------------------------------------------------------------------------------
+//  yakc_headless Main.cc
+//  Command line driver without any Oryol dependencies, runs an emulated
+//  system for a number of frames (or until a breakpoint is hit), and
+//  can dump the framebuffer, audio, savestates, timing stats, emulator
+//  counters, a cycle profile and disassembly listings.
+//------------------------------------------------------------------------------
+#include "yakc/yakc.h"
+#include "yakc/systems/savestate.h"
+#include "yakc/chips/listing.h"
+#include "yakc/roms/rom_dumps.h"
+#include <stdio.h>
+#include <ctype.h>
+#include <chrono>
+
+using namespace YAKC;
+
+namespace {
+
+/// command line options
+struct options {
+    YAKC::system sys = system::none;
+    os_rom os = os_rom::none;
+    const char* rom_dir = nullptr;
+    const char* rom_pack = nullptr;
+    const char* write_rom_pack = nullptr;
+    const char* load_path = nullptr;
+    filetype load_type = filetype::none;
+    bool load_start = true;
+    int load_frame = 0;
+    const char* input_text = nullptr;
+    const char* input_file = nullptr;
+    const char* state_in = nullptr;
+    const char* state_out = nullptr;
+    const char* screenshot = nullptr;
+    const char* video = nullptr;
+    const char* audio = nullptr;
+    const char* profile = nullptr;
+    const char* hotspots = nullptr;
+    bool video_raw = false;
+    int frames = 50;
+    int fps = 50;
+    int until_pc = -1;
+    bool stats = false;
+    const char* stats_out = nullptr;
+    const char* disasm = nullptr;
+    int disasm_start = 0x0000;
+    int disasm_end = 0xFFFF;
+    const char* disasm_image = nullptr;
+    int disasm_base = 0x0000;
+    const char* symbols = nullptr;
+};
+
+/// text input playback state (same timing as the Oryol keyboard playback)
+struct text_input {
+    const char* text = nullptr;
+    int pos = 0;
+    int len = 0;
+    int counter = 0;
+    bool pressed = false;
+    uint8_t chr = 0;
+};
+
+rom_repository roms;
+yakc emu;
+uint8_t* input_file_data = nullptr;
+
+//------------------------------------------------------------------------------
+void
+assert_msg(const char* cond, const char* msg, const char* file, int line, const char* func) {
+    fprintf(stderr, "assert failed: '%s' in %s(%d) %s: %s\n", cond, file, line, func, msg ? msg : "");
+    abort();
+}
+
+//------------------------------------------------------------------------------
+void
+usage() {
+    fprintf(stderr,
+        "usage: yakc_headless --system SYS [options]\n\n"
+        "  --system SYS         kc85_2, kc85_3, kc85_4, z1013_01, z1013_16, z1013_64,\n"
+        "                       z9001, kc87, zxspectrum48k, zxspectrum128k, cpc464,\n"
+        "                       cpc6128, kccompact, bbcmicro_b, acorn_atom\n"
+        "  --os OS              operating system ROM (default depends on system)\n"
+        "  --roms DIR           directory with ROM image files\n"
+        "  --rom-pack FILE      ROM pack file\n"
+        "  --write-rom-pack FILE\n"
+        "                       write all loaded ROM images into a ROM pack file\n"
+        "  --load FILE          quickload a program or insert a tape\n"
+        "  --type TYPE          file type of --load (default: from file extension)\n"
+        "  --no-start           don't start the quickloaded program\n"
+        "  --load-at N          load after N frames, so the OS can boot first (default 0)\n"
+        "  --input TEXT         type text into the keyboard after the --load-at frame\n"
+        "  --input-file FILE    type text file into the keyboard\n"
+        "  --state-in FILE      apply a savestate after poweron\n"
+        "  --state-out FILE     write a savestate at exit\n"
+        "  --frames N           number of frames to run (default 50)\n"
+        "  --fps N              frames per second (default 50)\n"
+        "  --until-pc ADDR      stop when the CPU reaches a hex address\n"
+        "  --screenshot FILE    write the final framebuffer as PPM image\n"
+        "  --video FILE         capture video frames (YUV4MPEG2)\n"
+        "  --video-raw          capture raw RGBA8 frames instead of YUV4MPEG2\n"
+        "  --audio FILE         capture audio (16-bit mono WAV)\n"
+        "  --profile FILE       write the profiled call stacks from the --load-at frame on\n"
+        "                       as collapsed stacks (for flame graph tools)\n"
+        "  --hotspots FILE      write the 50 most executed addresses from the --load-at frame on\n"
+        "  --stats              print timing stats\n"
+        "  --stats-out FILE     write the emulator counters in Prometheus text exposition format\n"
+        "                       (I/O ports by low address byte, by high byte on the CPC,\n"
+        "                       none on the 6502 systems)\n"
+        "  --disasm FILE        write a disassembly listing of the memory at exit\n"
+        "  --disasm-range START-END\n"
+        "                       hex address range of --disasm (default 0000-FFFF)\n"
+        "  --disasm-image FILE  disassemble a ROM image file instead, without running\n"
+        "                       the emulation (the CPU type is taken from --system)\n"
+        "  --disasm-base ADDR   hex address where --disasm-image is mapped (default 0000)\n"
+        "  --symbols FILE       symbol file for --disasm ('ADDR NAME' or 'NAME = ADDR' lines)\n\n"
+        "exit code is 0 on success, 1 on error, and 2 if the --until-pc\n"
+        "address wasn't reached\n");
+}
+
+//------------------------------------------------------------------------------
+bool
+parse_args(int argc, char* argv[], options& opts) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* val = (i + 1) < argc ? argv[i + 1] : nullptr;
+        bool has_val = true;
+        if (0 == strcmp(arg, "--no-start")) {
+            opts.load_start = false;
+            has_val = false;
+        }
+        else if (0 == strcmp(arg, "--video-raw")) {
+            opts.video_raw = true;
+            has_val = false;
+        }
+        else if (0 == strcmp(arg, "--stats")) {
+            opts.stats = true;
+            has_val = false;
+        }
+        else if (!val) {
+            fprintf(stderr, "missing value for '%s'\n", arg);
+            return false;
+        }
+        else if (0 == strcmp(arg, "--system")) {
+            opts.sys = system_from_string(val);
+        }
+        else if (0 == strcmp(arg, "--os")) {
+            opts.os = os_from_string(val);
+            if (os_rom::none == opts.os) {
+                fprintf(stderr, "unknown os '%s'\n", val);
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "--roms")) {
+            opts.rom_dir = val;
+        }
+        else if (0 == strcmp(arg, "--rom-pack")) {
+            opts.rom_pack = val;
+        }
+        else if (0 == strcmp(arg, "--write-rom-pack")) {
+            opts.write_rom_pack = val;
+        }
+        else if (0 == strcmp(arg, "--load")) {
+            opts.load_path = val;
+        }
+        else if (0 == strcmp(arg, "--type")) {
+            opts.load_type = filetype_from_string(val);
+            if (filetype::none == opts.load_type) {
+                fprintf(stderr, "unknown file type '%s'\n", val);
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "--load-at")) {
+            opts.load_frame = atoi(val);
+        }
+        else if (0 == strcmp(arg, "--input")) {
+            opts.input_text = val;
+        }
+        else if (0 == strcmp(arg, "--input-file")) {
+            opts.input_file = val;
+        }
+        else if (0 == strcmp(arg, "--state-in")) {
+            opts.state_in = val;
+        }
+        else if (0 == strcmp(arg, "--state-out")) {
+            opts.state_out = val;
+        }
+        else if (0 == strcmp(arg, "--frames")) {
+            opts.frames = atoi(val);
+        }
+        else if (0 == strcmp(arg, "--fps")) {
+            opts.fps = atoi(val);
+        }
+        else if (0 == strcmp(arg, "--until-pc")) {
+            opts.until_pc = int(strtol(val, nullptr, 16)) & 0xFFFF;
+        }
+        else if (0 == strcmp(arg, "--screenshot")) {
+            opts.screenshot = val;
+        }
+        else if (0 == strcmp(arg, "--video")) {
+            opts.video = val;
+        }
+        else if (0 == strcmp(arg, "--audio")) {
+            opts.audio = val;
+        }
+        else if (0 == strcmp(arg, "--profile")) {
+            opts.profile = val;
+        }
+        else if (0 == strcmp(arg, "--hotspots")) {
+            opts.hotspots = val;
+        }
+        else if (0 == strcmp(arg, "--stats-out")) {
+            opts.stats_out = val;
+        }
+        else if (0 == strcmp(arg, "--disasm")) {
+            opts.disasm = val;
+        }
+        else if (0 == strcmp(arg, "--disasm-range")) {
+            char* end = nullptr;
+            opts.disasm_start = int(strtol(val, &end, 16));
+            opts.disasm_end = (end && (*end == '-')) ? int(strtol(end + 1, nullptr, 16)) : -1;
+            if ((opts.disasm_start < 0) || (opts.disasm_start > opts.disasm_end) || (opts.disasm_end > 0xFFFF)) {
+                fprintf(stderr, "invalid --disasm-range '%s'\n", val);
+                return false;
+            }
+        }
+        else if (0 == strcmp(arg, "--disasm-image")) {
+            opts.disasm_image = val;
+        }
+        else if (0 == strcmp(arg, "--disasm-base")) {
+            opts.disasm_base = int(strtol(val, nullptr, 16)) & 0xFFFF;
+        }
+        else if (0 == strcmp(arg, "--symbols")) {
+            opts.symbols = val;
+        }
+        else {
+            fprintf(stderr, "unknown option '%s'\n", arg);
+            return false;
+        }
+        if (has_val) {
+            i++;
+        }
+    }
+    if ((system::none == opts.sys) || (int(opts.sys) & (int(opts.sys) - 1))) {
+        fprintf(stderr, "--system must name a single system\n");
+        return false;
+    }
+    if (opts.disasm_image && !opts.disasm) {
+        fprintf(stderr, "--disasm-image needs --disasm\n");
+        return false;
+    }
+    if ((opts.frames <= 0) || (opts.fps <= 0) || (opts.load_frame < 0) || (opts.load_frame >= opts.frames)) {
+        fprintf(stderr, "--frames and --fps must be > 0, --load-at must be in 0..frames-1\n");
+        return false;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+os_rom
+default_os(YAKC::system sys) {
+    switch (sys) {
+        case system::kc85_2:    return os_rom::caos_hc900;
+        case system::kc85_3:    return os_rom::caos_3_1;
+        case system::kc85_4:    return os_rom::caos_4_2;
+        case system::z1013_01:  return os_rom::z1013_mon202;
+        case system::z1013_16:
+        case system::z1013_64:  return os_rom::z1013_mon_a2;
+        case system::z9001:     return os_rom::z9001_os_1_2;
+        case system::kc87:      return os_rom::kc87_os_2;
+        default:                return os_rom::none;
+    }
+}
+
+//------------------------------------------------------------------------------
+uint8_t*
+load_file(const char* path, int& out_size) {
+    // returns nullptr for empty files too, out_size is 0 in that
+    // case and -1 if the file can't be read
+    out_size = -1;
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        return nullptr;
+    }
+    fseek(fp, 0, SEEK_END);
+    const int size = int(ftell(fp));
+    fseek(fp, 0, SEEK_SET);
+    uint8_t* data = nullptr;
+    if (0 == size) {
+        out_size = 0;
+    }
+    else if (size > 0) {
+        // one extra byte for a terminating zero (text files)
+        data = (uint8_t*) malloc(size + 1);
+        if (1 == fread(data, size, 1, fp)) {
+            data[size] = 0;
+            out_size = size;
+        }
+        else {
+            free(data);
+            data = nullptr;
+        }
+    }
+    fclose(fp);
+    return data;
+}
+
+//------------------------------------------------------------------------------
+bool
+init_roms(const options& opts) {
+    // only the KC85/3 ROMs are built-in, like in the regular app
+    emu.add_rom(rom_images::caos31, dump_caos31, sizeof(dump_caos31));
+    emu.add_rom(rom_images::kc85_basic_rom, dump_basic_c0, sizeof(dump_basic_c0));
+    if (opts.rom_pack && (0 == roms.load_pack(opts.rom_pack))) {
+        fprintf(stderr, "no valid ROM images in '%s'\n", opts.rom_pack);
+        return false;
+    }
+    if (opts.rom_dir) {
+        roms.load_dir(opts.rom_dir);
+    }
+    if (roms.num_rejected > 0) {
+        fprintf(stderr, "warning: %d ROM images failed validation\n", roms.num_rejected);
+    }
+    if (opts.write_rom_pack && !roms.write_pack(opts.write_rom_pack)) {
+        fprintf(stderr, "failed to write '%s'\n", opts.write_rom_pack);
+        return false;
+    }
+    // the ROM images are referenced, not copied
+    emu.add_roms(roms);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+bool
+has_ext(const char* path, const char* ext) {
+    const int len = int(strlen(path));
+    const int ext_len = int(strlen(ext));
+    if (len < ext_len) {
+        return false;
+    }
+    for (int i = 0; i < ext_len; i++) {
+        if (tolower(path[len - ext_len + i]) != ext[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+filetype
+guess_filetype(const char* path) {
+    // same rules as the Oryol FileLoader
+    if (has_ext(path, ".txt")) {
+        return filetype::text;
+    }
+    else if (has_ext(path, ".tap")) {
+        if (emu.is_system(system::any_zx)) {
+            return filetype::zx_tap;
+        }
+        else if (emu.is_system(system::any_cpc)) {
+            return filetype::cpc_tap;
+        }
+        else if (emu.is_system(system::acorn_atom)) {
+            return filetype::atom_tap;
+        }
+        else {
+            return filetype::kc_tap;
+        }
+    }
+    else if (has_ext(path, ".tzx")) {
+        return filetype::zx_tzx;
+    }
+    else if (has_ext(path, ".cdt")) {
+        return filetype::cpc_cdt;
+    }
+    else if (has_ext(path, ".kcc")) {
+        return filetype::kcc;
+    }
+    else if (has_ext(path, ".z80")) {
+        return emu.is_system(system::any_zx) ? filetype::zx_z80 : filetype::kc_z80;
+    }
+    else if (has_ext(path, ".sna")) {
+        return filetype::cpc_sna;
+    }
+    else if (has_ext(path, ".bin")) {
+        return filetype::raw;
+    }
+    return filetype::none;
+}
+
+//------------------------------------------------------------------------------
+const char*
+tape_load_cmd() {
+    // the BASIC command which loads and starts a program from tape
+    if (emu.is_system(system::any_cpc)) {
+        return "run\"\n\n";
+    }
+    else if (emu.is_system(system::acorn_atom)) {
+        return "*LOAD\n\n";
+    }
+    else if (emu.is_system(system::zxspectrum48k)) {
+        // 'j' is the LOAD keyword
+        return "j\"\"\n";
+    }
+    else if (emu.is_system(system::zxspectrum128k)) {
+        // select 'Tape Loader' in the start menu
+        return "\n";
+    }
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+bool
+load(const options& opts, text_input& input) {
+    int size = 0;
+    uint8_t* data = load_file(opts.load_path, size);
+    if (!data) {
+        fprintf(stderr, "failed to load '%s'\n", opts.load_path);
+        return false;
+    }
+    filetype type = opts.load_type;
+    if (filetype::none == type) {
+        type = guess_filetype(opts.load_path);
+        if (filetype::none == type) {
+            fprintf(stderr, "unknown file type of '%s', use --type\n", opts.load_path);
+            free(data);
+            return false;
+        }
+    }
+    bool ok = true;
+    if (filetype::text == type) {
+        // keep the file data for keyboard playback
+        if (input_file_data) {
+            free(input_file_data);
+        }
+        input_file_data = data;
+        input.text = (const char*) data;
+        input.len = size;
+        return true;
+    }
+    else if (filetype_quickloadable(type)) {
+        const char* name = opts.load_path;
+        ok = emu.filesystem.add_external(name, data, size);
+        if (ok) {
+            ok = emu.quickload(name, type, opts.load_start);
+            if (emu.filesystem.exists(name)) {
+                emu.filesystem.rm(name);
+            }
+        }
+    }
+    else {
+        // tape files are copied into the tape deck
+        ok = emu.tapedeck.insert_tape(opts.load_path, type, data, size);
+        if (ok && opts.load_start && !input.text) {
+            input.text = tape_load_cmd();
+            input.len = input.text ? int(strlen(input.text)) : 0;
+        }
+    }
+    free(data);
+    if (!ok) {
+        fprintf(stderr, "failed to load '%s' into %s\n", opts.load_path, string_from_system(emu.model));
+    }
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+void
+handle_input(text_input& input) {
+    // alternate between key press and key release, 4 frames each
+    if (input.text && (input.pos < input.len)) {
+        if (input.counter-- <= 0) {
+            input.pressed = !input.pressed;
+            input.counter = 4;
+            if (input.pressed) {
+                do {
+                    input.chr = input.text[input.pos++];
+                }
+                while (((input.chr == '\t') || (input.chr == '\r')) && (input.pos < input.len));
+                if (input.chr == '\n') {
+                    input.chr = 0x0D;
+                }
+            }
+            else {
+                input.chr = 0;
+            }
+        }
+        emu.put_input(input.chr, 0);
+    }
+    else {
+        emu.put_input(0, 0);
+    }
+}
+
+//------------------------------------------------------------------------------
+bool
+write_ppm(const char* path) {
+    int w = 0, h = 0;
+    const uint8_t* pixels = (const uint8_t*) emu.framebuffer(w, h);
+    if (!pixels) {
+        return false;
+    }
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        return false;
+    }
+    fprintf(fp, "P6\n%d %d\n255\n", w, h);
+    const int num_pixels = w * h;
+    for (int i = 0; i < num_pixels; i++, pixels += 4) {
+        // framebuffer is RGBA8
+        fwrite(pixels, 3, 1, fp);
+    }
+    const bool ok = 0 == ferror(fp);
+    fclose(fp);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+bool
+write_profile(const char* path, bool hotspots) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        return false;
+    }
+    const profiler& prof = emu.board.dbg.prof;
+    if (hotspots) {
+        prof.write_hotspots(fp, 50);
+    }
+    else {
+        prof.write_collapsed(fp);
+    }
+    const bool ok = 0 == ferror(fp);
+    fclose(fp);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+bool
+write_stats(const char* path) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        return false;
+    }
+    emu.stats.write(fp);
+    const bool ok = 0 == ferror(fp);
+    fclose(fp);
+    return ok;
+}
+
+//------------------------------------------------------------------------------
+bool
+write_listing(const options& opts, cpu_model cpu) {
+    listing lst;
+    if (opts.symbols && (lst.load_symbols(opts.symbols) < 0)) {
+        fprintf(stderr, "failed to load symbols '%s'\n", opts.symbols);
+        return false;
+    }
+    if (opts.disasm_image) {
+        int size = 0;
+        uint8_t* data = load_file(opts.disasm_image, size);
+        if (!data) {
+            if (0 == size) {
+                fprintf(stderr, "'%s' is empty\n", opts.disasm_image);
+            }
+            else {
+                fprintf(stderr, "failed to load '%s'\n", opts.disasm_image);
+            }
+            return false;
+        }
+        if (size > (0x10000 - opts.disasm_base)) {
+            size = 0x10000 - opts.disasm_base;
+        }
+        lst.disassemble(cpu, data, size, uint16_t(opts.disasm_base));
+        free(data);
+    }
+    else {
+        const memory& mem = (cpu_model::mos6502 == cpu) ? emu.board.mos6502.mem : emu.board.z80.mem;
+        lst.disassemble(cpu, mem, uint16_t(opts.disasm_start), opts.disasm_end - opts.disasm_start + 1);
+    }
+    FILE* fp = fopen(opts.disasm, "w");
+    if (!fp) {
+        fprintf(stderr, "failed to write '%s'\n", opts.disasm);
+        return false;
+    }
+    lst.write(fp);
+    const bool ok = 0 == ferror(fp);
+    fclose(fp);
+    if (!ok) {
+        fprintf(stderr, "failed to write '%s'\n", opts.disasm);
+    }
+    return ok;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+int
+main(int argc, char* argv[]) {
+    options opts;
+    if (!parse_args(argc, argv, opts)) {
+        usage();
+        return 1;
+    }
+    ext_funcs funcs;
+    funcs.assertmsg_func = assert_msg;
+    funcs.malloc_func = malloc;
+    funcs.free_func = free;
+    emu.init(funcs);
+    if (opts.disasm_image) {
+        // ROM image listings don't need a running system
+        return write_listing(opts, yakc::cpu_type(opts.sys)) ? 0 : 1;
+    }
+    if (!init_roms(opts)) {
+        return 1;
+    }
+
+    if (os_rom::none == opts.os) {
+        opts.os = default_os(opts.sys);
+    }
+    if (!emu.check_roms(opts.sys, opts.os)) {
+        fprintf(stderr, "missing ROM images for %s, use --roms\n", string_from_system(opts.sys));
+        return 1;
+    }
+    emu.poweron(opts.sys, opts.os);
+    if (opts.state_in && !savestate::load(opts.state_in, emu)) {
+        fprintf(stderr, "failed to apply savestate '%s'\n", opts.state_in);
+        return 1;
+    }
+
+    text_input input;
+    if (opts.input_text) {
+        input.text = opts.input_text;
+        input.len = int(strlen(opts.input_text));
+    }
+    else if (opts.input_file) {
+        int size = 0;
+        input_file_data = load_file(opts.input_file, size);
+        if (!input_file_data) {
+            fprintf(stderr, "failed to load '%s'\n", opts.input_file);
+            return 1;
+        }
+        input.text = (const char*) input_file_data;
+        input.len = size;
+    }
+    if (opts.until_pc >= 0) {
+        emu.board.dbg.enable_breakpoint(uint16_t(opts.until_pc));
+    }
+    if (opts.video || opts.audio) {
+        // no realtime deadline, so don't drop frames or samples
+        emu.capture.blocking = true;
+        const auto fmt = opts.video_raw ? capture::video_format::rgba8 : capture::video_format::y4m;
+        if (!emu.start_capture(opts.video, opts.audio, fmt, opts.fps)) {
+            fprintf(stderr, "failed to start capturing\n");
+            return 1;
+        }
+    }
+
+    // run the emulation, the CPU isn't synchronized to audio playback,
+    // audio samples are only generated when capturing audio
+    const int frame_micro_secs = 1000000 / opts.fps;
+    // (the sound chips only output whole sample chunks)
+    const int max_samples = (SOUND_SAMPLE_RATE / opts.fps) + 2 * sound::chunk_size;
+    float* samples = (float*) malloc(max_samples * sizeof(float));
+    int sample_rest = 0;
+    int num_frames = 0;
+    int result = 0;
+    bool reached = false;
+    const uint64_t start_cycles = emu.abs_cycle_count;
+    const auto start_time = std::chrono::steady_clock::now();
+    double emu_time = 0.0;
+    for (num_frames = 0; num_frames < opts.frames; num_frames++) {
+        if (opts.load_path && (num_frames == opts.load_frame) && !load(opts, input)) {
+            result = 1;
+            break;
+        }
+        if (num_frames >= opts.load_frame) {
+            handle_input(input);
+        }
+        if ((opts.profile || opts.hotspots) && (num_frames == opts.load_frame)) {
+            emu.board.dbg.prof.start(emu.cpu_type());
+        }
+        const auto frame_start = std::chrono::steady_clock::now();
+        emu.step(frame_micro_secs, 0);
+        const double frame_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - frame_start).count();
+        emu.stats.add_frame_time(float(frame_time * 1000.0));
+        emu_time += frame_time;
+        if (opts.audio) {
+            sample_rest += SOUND_SAMPLE_RATE;
+            const int num_samples = ((sample_rest / opts.fps) / sound::chunk_size) * sound::chunk_size;
+            if (num_samples > 0) {
+                sample_rest -= num_samples * opts.fps;
+                emu.fill_sound_samples(samples, num_samples);
+            }
+        }
+        if (emu.board.dbg.active) {
+            reached = true;
+            num_frames++;
+            break;
+        }
+    }
+    const double wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    free(samples);
+    emu.stop_capture();
+
+    if ((opts.until_pc >= 0) && (0 == result)) {
+        if (reached) {
+            printf("reached PC=%04X after %d frames\n", opts.until_pc, num_frames);
+        }
+        else {
+            printf("PC=%04X not reached after %d frames\n", opts.until_pc, num_frames);
+            result = 2;
+        }
+    }
+    if (opts.screenshot && !write_ppm(opts.screenshot)) {
+        fprintf(stderr, "failed to write '%s'\n", opts.screenshot);
+        result = 1;
+    }
+    if (opts.state_out && !savestate::save(emu, opts.state_out)) {
+        fprintf(stderr, "failed to write savestate '%s'\n", opts.state_out);
+        result = 1;
+    }
+    if (opts.profile && !write_profile(opts.profile, false)) {
+        fprintf(stderr, "failed to write '%s'\n", opts.profile);
+        result = 1;
+    }
+    if (opts.hotspots && !write_profile(opts.hotspots, true)) {
+        fprintf(stderr, "failed to write '%s'\n", opts.hotspots);
+        result = 1;
+    }
+    if (opts.stats_out && !write_stats(opts.stats_out)) {
+        fprintf(stderr, "failed to write '%s'\n", opts.stats_out);
+        result = 1;
+    }
+    if (opts.disasm && !write_listing(opts, emu.cpu_type())) {
+        result = 1;
+    }
+    if (opts.stats) {
+        const double sim_time = double(num_frames) / double(opts.fps);
+        printf("system:        %s\n", string_from_system(emu.model));
+        printf("frames:        %d\n", num_frames);
+        const uint64_t num_cycles = emu.abs_cycle_count - start_cycles;
+        printf("cpu cycles:    %llu\n", (unsigned long long) num_cycles);
+        printf("emulated time: %.3f s\n", sim_time);
+        printf("wall time:     %.3f s (%.3f s in emulator)\n", wall_time, emu_time);
+        if (emu_time > 0.0) {
+            printf("speed:         %.2fx realtime, %.2f MHz\n",
+                sim_time / emu_time, double(num_cycles) / emu_time / 1000000.0);
+        }
+        if (opts.video || opts.audio) {
+            printf("capture:       %u frames (%u dropped, %u resized), %u samples (%u dropped)\n",
+                uint32_t(emu.capture.frames_written), uint32_t(emu.capture.frames_dropped),
+                uint32_t(emu.capture.frames_resized),
+                uint32_t(emu.capture.samples_written), uint32_t(emu.capture.samples_dropped));
+        }
+    }
+    emu.poweroff();
+    if (input_file_data) {
+        free(input_file_data);
+    }
+    return result;
+}
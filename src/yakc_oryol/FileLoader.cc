@@ -127,10 +127,12 @@ FileLoader::LoadTape(const Item& item) {
     IO::Load(strBuilder.GetString(),
         // load succeeded
         [this, item](IO::LoadResult ioResult) {
-            this->FileData = std::move(ioResult.Data);
-            this->Info = parseHeader(this->FileData, item);
+            // remove the old tape before its data is released
+            this->emu->tapedeck.remove_tape();
+            this->TapeData = std::move(ioResult.Data);
+            this->Info = parseHeader(this->TapeData, item);
             this->State = Ready;
-            this->emu->tapedeck.insert_tape(item.Name.AsCStr(), item.Type, this->FileData.Data(), this->FileData.Size());
+            this->emu->tapedeck.insert_external_tape(item.Name.AsCStr(), item.Type, this->TapeData.Data(), this->TapeData.Size());
         },
         // load failed
         [this](const URL& url, IOStatus::Code ioStatus) {
@@ -218,6 +220,12 @@ FileLoader::parseHeader(const Buffer& data, const Item& item) {
                 info.Type = filetype::kc_tap;
             }
         }
+        else if (strb.Contains(".TZX") || strb.Contains(".tzx")) {
+            info.Type = filetype::zx_tzx;
+        }
+        else if (strb.Contains(".CDT") || strb.Contains(".cdt")) {
+            info.Type = filetype::cpc_cdt;
+        }
         else if (strb.Contains(".KCC") || strb.Contains(".kcc")) {
             info.Type = filetype::kcc;
         }
@@ -286,6 +294,14 @@ FileLoader::parseHeader(const Buffer& data, const Item& item) {
         const cpctap_header* hdr = (const cpctap_header*) ptr;
         info.Name = String((const char*)hdr->name, 0, 16);
     }
+    else if (filetype::zx_tzx == info.Type) {
+        info.Name = item.Filename;
+        info.RequiredSystem = system::any_zx;
+    }
+    else if (filetype::cpc_cdt == info.Type) {
+        info.Name = item.Filename;
+        info.RequiredSystem = system::any_cpc;
+    }
     else if (filetype::atom_tap == info.Type) {
         const atomtap_header* hdr = (const atomtap_header*) ptr;
         info.Name = String((const char*)hdr->name, 0, 16);
@@ -303,13 +319,15 @@ FileLoader::quickload(yakc* emu, const FileInfo& info, const Buffer& data, bool
         // and caught from the outside
         newState = FileLoader::TextReady;
     }
-    else {
+    else if (!data.Empty()) {
         o_assert(info.Filename.IsValid());
-        auto fp = emu->filesystem.open(info.Filename.AsCStr(), filesystem::mode::write);
-        if (fp) {
-            emu->filesystem.write(fp, data.Data(), data.Size());
-            emu->filesystem.close(fp);
-            emu->quickload(info.Filename.AsCStr(), info.Type, autostart);
+        // the file data is only referenced, the quickload happens right away
+        const char* name = info.Filename.AsCStr();
+        if (emu->filesystem.add_external(name, data.Data(), data.Size())) {
+            emu->quickload(name, info.Type, autostart);
+            if (emu->filesystem.exists(name)) {
+                emu->filesystem.rm(name);
+            }
             emu->enable_joystick(true);
             if (!autostart) {
                 newState = FileLoader::Ready;
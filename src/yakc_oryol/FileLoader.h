@@ -81,6 +81,8 @@ public:
     void load(const Item& item, bool autostart);
 
     Oryol::Buffer FileData;
+    /// the current tape image, referenced by the tape deck without copying
+    Oryol::Buffer TapeData;
 private:
     yakc* emu = nullptr;
 };
@@ -7,21 +7,38 @@ namespace YAKC {
 
 //------------------------------------------------------------------------------
 SnapshotStorage::SnapshotStorage() {
-    memset(&this->snapshots, 0, sizeof(this->snapshots));
+    // empty
+}
+
+//------------------------------------------------------------------------------
+SnapshotStorage::~SnapshotStorage() {
+    for (auto& snapshot : this->snapshots) {
+        if (snapshot.data) {
+            YAKC_FREE(snapshot.data);
+            snapshot.data = nullptr;
+        }
+    }
 }
 
 //------------------------------------------------------------------------------
 void
 SnapshotStorage::TakeSnapshot(const yakc& emu, int slotIndex) {
     YAKC_ASSERT((slotIndex >= 0) && (slotIndex < MaxNumSnapshots));
-    snapshot::take_snapshot(emu, this->snapshots[slotIndex]);
+    auto& snapshot = this->snapshots[slotIndex];
+    if (snapshot.data) {
+        YAKC_FREE(snapshot.data);
+    }
+    snapshot.size = savestate::write(emu, nullptr, 0);
+    snapshot.data = (uint8_t*) YAKC_MALLOC(snapshot.size);
+    savestate::write(emu, snapshot.data, snapshot.size);
 }
 
 //------------------------------------------------------------------------------
 bool
 SnapshotStorage::HasSnapshot(int slotIndex) const {
     YAKC_ASSERT((slotIndex >= 0) && (slotIndex < MaxNumSnapshots));
-    return snapshot::is_snapshot(this->snapshots[slotIndex]);
+    const auto& snapshot = this->snapshots[slotIndex];
+    return savestate::is_savestate(snapshot.data, snapshot.size);
 }
 
 //------------------------------------------------------------------------------
@@ -39,7 +56,8 @@ SnapshotStorage::HasSnapshots() const {
 void
 SnapshotStorage::ApplySnapshot(int slotIndex, yakc& emu) {
     YAKC_ASSERT((slotIndex >= 0) && (slotIndex < MaxNumSnapshots));
-    snapshot::apply_snapshot(this->snapshots[slotIndex], emu);
+    const auto& snapshot = this->snapshots[slotIndex];
+    savestate::apply(snapshot.data, snapshot.size, emu);
 }
 
 } // namespace YAKC
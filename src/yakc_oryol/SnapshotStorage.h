@@ -3,9 +3,13 @@
 /**
     @class YAKC::SnapshotStorage
     @brief simple class to store machine state snapshots
+
+    Snapshots are stored in the chunked savestate format (see
+    savestate.h), so that they work for all emulated systems, and
+    only need as much memory as the emulated system has RAM.
 */
 #include "yakc/yakc.h"
-#include "yakc/systems/snapshot.h"
+#include "yakc/systems/savestate.h"
 
 namespace YAKC {
 
@@ -16,6 +20,8 @@ public:
 
     /// constructor
     SnapshotStorage();
+    /// destructor
+    ~SnapshotStorage();
     /// take a snapshot
     void TakeSnapshot(const yakc& emu, int slotIndex);
     /// test if any valid snapshots exist
@@ -25,7 +31,10 @@ public:
     /// apply a snapshot
     void ApplySnapshot(int slotIndex, yakc& emu);
 
-    snapshot::state_t snapshots[MaxNumSnapshots];
+    struct Snapshot {
+        uint8_t* data = nullptr;
+        int size = 0;
+    } snapshots[MaxNumSnapshots];
 };
 
 } // namespace YAKC
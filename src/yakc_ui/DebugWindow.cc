@@ -4,7 +4,6 @@
 #include "DebugWindow.h"
 #include "IMUI/IMUI.h"
 #include "yakc_ui/UI.h"
-#include "Disasm.h"
 #include "Util.h"
 
 using namespace Oryol;
@@ -114,16 +113,22 @@ DebugWindow::draw6502RegisterTable(yakc& emu) {
 //------------------------------------------------------------------------------
 void
 DebugWindow::drawControls(yakc& emu) {
-    uint16_t bp_addr = 0xFFFF;
-    if (emu.board.dbg.breakpoint_enabled()) {
-        bp_addr = emu.board.dbg.breakpoint_addr();
-    }
-    if (Util::InputHex16("", bp_addr)) {
-        if (bp_addr != 0xFFFF) {
-            emu.board.dbg.enable_breakpoint(bp_addr);
+    auto& dbg = emu.board.dbg;
+    if (Util::InputHex16("bp", this->bpAddr)) {
+        if (this->bpAddr != 0xFFFF) {
+            dbg.enable_breakpoint(this->bpAddr);
         }
-        else {
-            emu.board.dbg.disable_breakpoint();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("clear bps")) {
+        dbg.clear_breakpoints();
+        this->bpAddr = 0xFFFF;
+    }
+    ImGui::SameLine();
+    if (Util::InputHex16("watch", this->watchAddr)) {
+        dbg.clear_watchpoints();
+        if (this->watchAddr != 0xFFFF) {
+            dbg.add_watchpoint(this->watchAddr, 1, cpudbg::watch_read|cpudbg::watch_write);
         }
     }
     ImGui::SameLine();
@@ -135,6 +140,12 @@ DebugWindow::drawControls(yakc& emu) {
         }
     }
     ImGui::Checkbox("break on invalid opcode", &emu.board.z80.break_on_invalid_opcode);
+    if (dbg.active && (dbg.last_watch_hit.mode != 0)) {
+        const auto& hit = dbg.last_watch_hit;
+        ImGui::Text("watch: %s %04X=%02X at %04X",
+            (hit.mode & cpudbg::watch_write) ? "write" : ((hit.mode & cpudbg::watch_read) ? "read" : "exec"),
+            hit.addr, hit.value, hit.pc);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -152,22 +163,21 @@ DebugWindow::drawMainContent(yakc& emu, uint16_t start_addr, int num_lines) {
     const float cell_width = glyph_width * 3; // "FF " we include trailing space in the width to easily catch clicks everywhere
     ImGuiListClipper clipper(line_total_count, line_height);
 
-    Disasm disasm;
-    uint16_t cur_addr = start_addr;
-
-    // set cur_addr to start of displayed region
-    for (int line_i = cpudbg::history_size; line_i < clipper.DisplayStart; line_i++) {
-        cur_addr += disasm.Disassemble(emu, cur_addr);
-    }
+    // the lines after the PC history are looked up in the line index
+    DisasmCache& cache = DisasmCache::Shared;
+    cache.Update(emu);
+    const int num_code_lines = line_total_count > cpudbg::history_size ? line_total_count - cpudbg::history_size : 0;
+    this->lineIndex.Update(cache, emu, start_addr, num_code_lines);
 
     // display only visible items
     for (int line_i = clipper.DisplayStart; line_i < clipper.DisplayEnd; line_i++) {
-        uint16_t op_addr, op_cycles, num_bytes;
+        uint16_t op_addr, num_bytes;
+        uint32_t op_cycles;
         if (line_i < cpudbg::history_size) {
             auto hist_item = emu.board.dbg.get_pc_history(line_i);
             op_addr = hist_item.pc;
             op_cycles = hist_item.cycles;
-            num_bytes = disasm.Disassemble(emu, hist_item.pc);
+            num_bytes = cache.Length(emu, hist_item.pc);
             if (emu.board.dbg.is_breakpoint(hist_item.pc)) {
                 ImGui::PushStyleColor(ImGuiCol_Text, UI::EnabledBreakpointColor);
             }
@@ -176,25 +186,25 @@ DebugWindow::drawMainContent(yakc& emu, uint16_t start_addr, int num_lines) {
             }
         }
         else {
-            op_addr = cur_addr;
+            op_addr = this->lineIndex.Addr(line_i - cpudbg::history_size);
             op_cycles = 0;
-            num_bytes = disasm.Disassemble(emu, op_addr);
+            num_bytes = cache.Length(emu, op_addr);
             bool inv = emu.cpu_type() == cpu_model::z80 ? emu.board.z80.INV : false;
-            if ((cur_addr == start_addr) && inv) {
+            if ((op_addr == start_addr) && inv) {
                 // invalid/non-implemented opcode hit
                 ImGui::PushStyleColor(ImGuiCol_Text, UI::InvalidOpCodeColor);
             }
-            else if (emu.board.dbg.is_breakpoint(cur_addr)) {
+            else if (emu.board.dbg.is_breakpoint(op_addr)) {
                 ImGui::PushStyleColor(ImGuiCol_Text, UI::EnabledBreakpointColor);
             }
-            else if (cur_addr == start_addr) {
+            else if (op_addr == start_addr) {
                 ImGui::PushStyleColor(ImGuiCol_Text, UI::EnabledColor);
             }
             else {
                 ImGui::PushStyleColor(ImGuiCol_Text, UI::DefaultTextColor);
             }
-            cur_addr += num_bytes;
         }
+        const char* text = cache.Text(emu, op_addr);
 
         // wrap current PC into 2 separator lines
         if ((line_i == cpudbg::history_size) || (line_i == cpudbg::history_size+1)) {
@@ -218,21 +228,21 @@ DebugWindow::drawMainContent(yakc& emu, uint16_t start_addr, int num_lines) {
         for (int n = 0; n < num_bytes; n++) {
             ImGui::SameLine(line_start_x + cell_width * n);
             if (emu.cpu_type() == cpu_model::z80) {
-                ImGui::Text("%02X ", emu.board.z80.mem.r8(op_addr++));
+                ImGui::Text("%02X ", emu.board.z80.mem.r8_untrapped(op_addr++));
             }
             else {
-                ImGui::Text("%02X ", emu.board.mos6502.mem.r8(op_addr++));
+                ImGui::Text("%02X ", emu.board.mos6502.mem.r8_untrapped(op_addr++));
             }
         }
 
         // print disassembled instruction
         float offset = line_start_x + cell_width * 4 + glyph_width * 2;
         ImGui::SameLine(offset);
-        ImGui::Text("%s", disasm.Result());
+        ImGui::Text("%s", text);
         if (op_cycles > 0) {
             offset += glyph_width * 24;
             ImGui::SameLine(offset);
-            ImGui::Text("%d", op_cycles);
+            ImGui::Text("%u", op_cycles);
         }
         ImGui::PopStyleColor();
     }
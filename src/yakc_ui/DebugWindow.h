@@ -5,6 +5,7 @@
     @brief implement the step-debugger window
 */
 #include "yakc_ui/WindowBase.h"
+#include "yakc_ui/DisasmCache.h"
 
 namespace YAKC {
 
@@ -25,6 +26,10 @@ public:
     void drawMainContent(yakc& emu, uint16_t start_addr, int num_lines);
     /// draw control buttons
     void drawControls(yakc& emu);
+
+    uint16_t bpAddr = 0xFFFF;
+    uint16_t watchAddr = 0xFFFF;
+    DisasmCache::LineIndex lineIndex;
 };
 
 } // namespace YAKC
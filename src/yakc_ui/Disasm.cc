@@ -2,8 +2,8 @@
 //  Disasm.cc
 //------------------------------------------------------------------------------
 #include "Disasm.h"
-#include "z80dasm.h"
-#include "mos6502dasm.h"
+#include "yakc/chips/z80dasm.h"
+#include "yakc/chips/mos6502dasm.h"
 #include "Core/Memory/Memory.h"
 
 using namespace Oryol;
@@ -23,10 +23,10 @@ ubyte
 Disasm::fetch(uword base, int offset, void* userdata) {
     Disasm* self = (Disasm*) userdata;
     if (self->emu->cpu_type() == cpu_model::mos6502) {
-        return self->emu->board.mos6502.mem.r8(base + offset);
+        return self->emu->board.mos6502.mem.r8_untrapped(base + offset);
     }
     else {
-        return self->emu->board.z80.mem.r8(base + offset);
+        return self->emu->board.z80.mem.r8_untrapped(base + offset);
     }
 }
 
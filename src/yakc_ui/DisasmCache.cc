@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+//  DisasmCache.cc
+//------------------------------------------------------------------------------
+#include "DisasmCache.h"
+#include <string.h>
+
+namespace YAKC {
+
+DisasmCache DisasmCache::Shared;
+
+// longest Z80 instruction is 4 bytes
+static const int max_instr_bytes = 4;
+
+//------------------------------------------------------------------------------
+DisasmCache::~DisasmCache() {
+    for (int i = 0; i < num_pages; i++) {
+        if (this->pages[i]) {
+            YAKC_FREE(this->pages[i]);
+            this->pages[i] = nullptr;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+DisasmCache::Update(yakc& emu) {
+    if (emu.model != this->model) {
+        this->model = emu.model;
+        this->Invalidate();
+    }
+    memory& mem = (emu.cpu_type() == cpu_model::mos6502) ? emu.board.mos6502.mem : emu.board.z80.mem;
+    if (!mem.dirty_tracking) {
+        mem.set_dirty_tracking(true);
+        this->Invalidate();
+    }
+    const uint64_t dirty = mem.take_dirty_pages();
+    for (int i = 0; i < num_pages; i++) {
+        const uint8_t* ptr = mem.read_ptr(i * memory::page::size);
+        if ((ptr != this->pagePtrs[i]) || (dirty & (uint64_t(1)<<i))) {
+            this->pagePtrs[i] = ptr;
+            this->invalidate(i);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+DisasmCache::Invalidate() {
+    for (int i = 0; i < num_pages; i++) {
+        this->invalidate(i);
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+DisasmCache::invalidate(int page_index) {
+    YAKC_ASSERT((page_index >= 0) && (page_index < num_pages));
+    if (this->pages[page_index]) {
+        clear(this->pages[page_index], memory::page::size * sizeof(entry));
+    }
+    // instructions at the end of the previous page may reach into this page
+    entry* prev = this->pages[(page_index + num_pages - 1) % num_pages];
+    if (prev) {
+        clear(prev + memory::page::size - (max_instr_bytes - 1), (max_instr_bytes - 1) * sizeof(entry));
+    }
+    this->pageGeneration[page_index] = ++this->generation;
+}
+
+//------------------------------------------------------------------------------
+const DisasmCache::entry&
+DisasmCache::lookup(const yakc& emu, uword addr) {
+    const int page_index = addr >> memory::page::shift;
+    if (!this->pages[page_index]) {
+        const int size = memory::page::size * sizeof(entry);
+        this->pages[page_index] = (entry*) YAKC_MALLOC(size);
+        clear(this->pages[page_index], size);
+    }
+    entry& e = this->pages[page_index][addr & memory::page::mask];
+    if (0 == e.length) {
+        const uword num_bytes = this->disasm.Disassemble(emu, addr);
+        YAKC_ASSERT((num_bytes > 0) && (num_bytes <= max_instr_bytes));
+        strncpy(e.text, this->disasm.Result(), max_text - 1);
+        e.text[max_text - 1] = 0;
+        e.length = uint8_t(num_bytes);
+    }
+    return e;
+}
+
+//------------------------------------------------------------------------------
+uword
+DisasmCache::Length(const yakc& emu, uword addr) {
+    return this->lookup(emu, addr).length;
+}
+
+//------------------------------------------------------------------------------
+const char*
+DisasmCache::Text(const yakc& emu, uword addr) {
+    return this->lookup(emu, addr).text;
+}
+
+//------------------------------------------------------------------------------
+void
+DisasmCache::LineIndex::Update(DisasmCache& cache, const yakc& emu, uword start_addr, int num_lines) {
+    bool rebuild = !this->valid || (start_addr != this->startAddr) || (num_lines != this->addrs.Size());
+    for (int i = 0; (i < num_pages) && !rebuild; i++) {
+        if ((this->pageMask & (uint64_t(1)<<i)) && (cache.pageGeneration[i] > this->generation)) {
+            rebuild = true;
+        }
+    }
+    if (rebuild) {
+        this->addrs.Clear();
+        this->pageMask = 0;
+        uword addr = start_addr;
+        for (int line = 0; line < num_lines; line++) {
+            this->addrs.Add(addr);
+            const uword num_bytes = cache.Length(emu, addr);
+            this->pageMask |= uint64_t(1)<<(addr >> memory::page::shift);
+            this->pageMask |= uint64_t(1)<<(uword(addr + num_bytes - 1) >> memory::page::shift);
+            addr += num_bytes;
+        }
+        this->startAddr = start_addr;
+        this->generation = cache.generation;
+        this->valid = true;
+    }
+}
+
+//------------------------------------------------------------------------------
+uword
+DisasmCache::LineIndex::Addr(int line) const {
+    return this->addrs[line];
+}
+
+} // namespace YAKC
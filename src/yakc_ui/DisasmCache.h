@@ -0,0 +1,76 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class YAKC::DisasmCache
+    @brief cached disassembly for the debugger windows
+
+    Disassembled instructions (text and length) are cached per address
+    in blocks of one memory page, which are allocated when first used.
+    Update() must be called each frame before the lookups, it throws
+    away the blocks of pages which have been written (through the
+    dirty-page tracking of class memory) or remapped since the last call.
+
+    A LineIndex keeps the start addresses of a range of disassembly
+    lines, so that a clipped list view can jump straight to its first
+    visible line. It is only rebuilt when the start address or number
+    of lines changes, or when a page it covers has been invalidated.
+*/
+#include "yakc/yakc.h"
+#include "Disasm.h"
+#include "Core/Containers/Array.h"
+
+namespace YAKC {
+
+class DisasmCache {
+public:
+    /// destructor
+    ~DisasmCache();
+
+    /// drop written or remapped pages, call once per frame before lookups
+    void Update(yakc& emu);
+    /// drop all cached instructions
+    void Invalidate();
+    /// get the length of the instruction at addr
+    uword Length(const yakc& emu, uword addr);
+    /// get the disassembled instruction at addr
+    const char* Text(const yakc& emu, uword addr);
+
+    /// the start addresses of a range of disassembly lines
+    class LineIndex {
+    public:
+        /// rebuild the line addresses if needed
+        void Update(DisasmCache& cache, const yakc& emu, uword start_addr, int num_lines);
+        /// get start address of a line
+        uword Addr(int line) const;
+    private:
+        Oryol::Array<uword> addrs;
+        uword startAddr = 0;
+        uint64_t pageMask = 0;
+        uint32_t generation = 0;
+        bool valid = false;
+    };
+
+    /// the cache shared by all debugger windows
+    static DisasmCache Shared;
+
+private:
+    static const int num_pages = memory::num_pages;
+    static const int max_text = 23;
+    struct entry {
+        char text[max_text];
+        uint8_t length;         // 0 if not disassembled yet
+    };
+    /// lookup an instruction, disassemble on cache miss
+    const entry& lookup(const yakc& emu, uword addr);
+    /// drop a page (and instructions reaching into it from the previous page)
+    void invalidate(int page_index);
+
+    entry* pages[num_pages] = { };
+    const uint8_t* pagePtrs[num_pages] = { };
+    uint32_t pageGeneration[num_pages] = { };
+    uint32_t generation = 0;
+    system model = system::none;
+    Disasm disasm;
+};
+
+} // namespace YAKC
@@ -4,7 +4,7 @@
 #include "DisasmWindow.h"
 #include "IMUI/IMUI.h"
 #include "Util.h"
-#include "Disasm.h"
+#include "DisasmCache.h"
 
 using namespace Oryol;
 
@@ -31,7 +31,7 @@ DisasmWindow::Draw(yakc& emu) {
 
 //------------------------------------------------------------------------------
 void
-DisasmWindow::drawMainContent(const yakc& emu, uword start_addr, int num_lines) {
+DisasmWindow::drawMainContent(yakc& emu, uword start_addr, int num_lines) {
     // this is a modified version of ImGuiMemoryEditor.h
     ImGui::BeginChild("##scrolling", ImVec2(0, -ImGui::GetItemsLineHeightWithSpacing()));
 
@@ -43,16 +43,17 @@ DisasmWindow::drawMainContent(const yakc& emu, uword start_addr, int num_lines)
     const float cell_width = glyph_width * 3;
     ImGuiListClipper clipper(num_lines, line_height);
 
-    // skip hidden line
-    Disasm disasm;
-    uword cur_addr = start_addr;
-    for (int line_i = 0; (line_i < clipper.DisplayStart) && (line_i < num_lines); line_i++) {
-        cur_addr += disasm.Disassemble(emu, cur_addr);
-    }
+    // the line index gives the address of the first visible line without
+    // disassembling all the hidden lines before it
+    DisasmCache& cache = DisasmCache::Shared;
+    cache.Update(emu);
+    this->lineIndex.Update(cache, emu, start_addr, num_lines);
 
     // display only visible items
     for (int line_i = clipper.DisplayStart; line_i < clipper.DisplayEnd; line_i++) {
-        const uword num_bytes = disasm.Disassemble(emu, cur_addr);
+        uword cur_addr = this->lineIndex.Addr(line_i);
+        const uword num_bytes = cache.Length(emu, cur_addr);
+        const char* text = cache.Text(emu, cur_addr);
 
         // draw the address
         ImGui::Text("%04X: ", cur_addr);
@@ -64,17 +65,17 @@ DisasmWindow::drawMainContent(const yakc& emu, uword start_addr, int num_lines)
             ImGui::SameLine(line_start_x + cell_width * n);
             uint8_t val = 0x00;
             if (emu.cpu_type() == cpu_model::mos6502) {
-                val = emu.board.mos6502.mem.r8(cur_addr++);
+                val = emu.board.mos6502.mem.r8_untrapped(cur_addr++);
             }
             else {
-                val = emu.board.z80.mem.r8(cur_addr++);
+                val = emu.board.z80.mem.r8_untrapped(cur_addr++);
             }
             ImGui::Text("%02X ", val);
         }
 
         // print disassembled instruction
         ImGui::SameLine(line_start_x + cell_width * 4 + glyph_width * 2);
-        ImGui::Text("%s", disasm.Result());
+        ImGui::Text("%s", text);
     }
     clipper.End();
     ImGui::PopStyleVar(2);
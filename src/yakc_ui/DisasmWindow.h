@@ -5,6 +5,7 @@
     @brief a disassembler window
 */
 #include "yakc_ui/WindowBase.h"
+#include "yakc_ui/DisasmCache.h"
 
 namespace YAKC {
 
@@ -17,12 +18,13 @@ public:
     virtual bool Draw(yakc& emu) override;
 
     /// draw the main window content, starting at given address
-    void drawMainContent(const yakc& emu, uword start_addr, int num_lines);
+    void drawMainContent(yakc& emu, uword start_addr, int num_lines);
     /// draw control buttons
     void drawControls();
 
     uint16_t startAddr = 0;
     uint16_t numLines = 64;
+    DisasmCache::LineIndex lineIndex;
 };
 
 } // namespace YAKC
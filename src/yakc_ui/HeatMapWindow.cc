@@ -0,0 +1,165 @@
+//------------------------------------------------------------------------------
+//  HeatMapWindow.cc
+//------------------------------------------------------------------------------
+#include "HeatMapWindow.h"
+#include "IMUI/IMUI.h"
+#include "yakc_ui/UI.h"
+#include <math.h>
+
+using namespace Oryol;
+
+namespace YAKC {
+
+static const int left_padding = 40;
+static const float canvas_width = 384.0f;
+static const float canvas_height = 256.0f;
+
+//------------------------------------------------------------------------------
+void
+HeatMapWindow::Setup(yakc& emu) {
+    this->setName("Memory Heat Map");
+    this->start(emu);
+}
+
+//------------------------------------------------------------------------------
+void
+HeatMapWindow::start(yakc& emu) {
+    emu.board.dbg.start_heatmap(this->perAddress);
+    this->numCells = this->perAddress ? max_cells : heatmap::num_pages;
+    clear(this->prevCounts, sizeof(this->prevCounts));
+    clear(this->heat, sizeof(this->heat));
+}
+
+//------------------------------------------------------------------------------
+uint64_t
+HeatMapWindow::count(const heatmap& hm, heatmap::type t, int cell) const {
+    if (!this->perAddress) {
+        return hm.page_count(t, cell);
+    }
+    const int addr = cell * cell_size;
+    if (heatmap::remap == t) {
+        return hm.page_count(t, addr>>heatmap::page_shift);
+    }
+    uint64_t sum = 0;
+    for (int i = 0; i < cell_size; i++) {
+        sum += hm.addr_count(t, addr + i);
+    }
+    return sum;
+}
+
+//------------------------------------------------------------------------------
+void
+HeatMapWindow::update(const heatmap& hm) {
+    for (int t = 0; t < heatmap::num_types; t++) {
+        for (int i = 0; i < this->numCells; i++) {
+            const uint64_t cur = this->count(hm, (heatmap::type)t, i);
+            const float delta = float(cur - this->prevCounts[t][i]);
+            this->prevCounts[t][i] = cur;
+            this->heat[t][i] = this->heat[t][i] * this->decay + delta;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+void
+HeatMapWindow::drawCells(const heatmap& hm) {
+    // the heat is shown on a log scale relative to the hottest cell
+    float scale[heatmap::num_types];
+    for (int t = 0; t < heatmap::num_types; t++) {
+        float max_heat = 0.0f;
+        for (int i = 0; i < this->numCells; i++) {
+            if (this->heat[t][i] > max_heat) {
+                max_heat = this->heat[t][i];
+            }
+        }
+        scale[t] = (max_heat > 0.0f) ? 1.0f / logf(1.0f + max_heat) : 0.0f;
+    }
+
+    ImDrawList* l = ImGui::GetWindowDrawList();
+    const ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+    const int num_cols = this->perAddress ? (heatmap::num_addrs / heatmap::num_pages / cell_size) : 8;
+    const int num_rows = this->numCells / num_cols;
+    const int row_bytes = heatmap::num_addrs / num_rows;
+    const float cell_w = canvas_width / num_cols;
+    const float cell_h = canvas_height / num_rows;
+    const int label_step = this->perAddress ? 8 : 1;
+    char str[16];
+    for (int row = 0; row < num_rows; row += label_step) {
+        snprintf(str, sizeof(str), "%04X", row * row_bytes);
+        l->AddText(ImVec2(canvas_pos.x, canvas_pos.y + row * cell_h), UI::CanvasTextColor, str);
+    }
+    for (int i = 0; i < this->numCells; i++) {
+        const float x = canvas_pos.x + left_padding + (i % num_cols) * cell_w;
+        const float y = canvas_pos.y + (i / num_cols) * cell_h;
+        const ImVec2 a(x, y);
+        const ImVec2 b(x + cell_w - 1.0f, y + cell_h - 1.0f);
+        // red: writes, green: reads, blue: executed instructions
+        const ImVec4 c(logf(1.0f + this->heat[heatmap::write][i]) * scale[heatmap::write],
+                       logf(1.0f + this->heat[heatmap::read][i]) * scale[heatmap::read],
+                       logf(1.0f + this->heat[heatmap::exec][i]) * scale[heatmap::exec],
+                       1.0f);
+        l->AddRectFilled(a, b, ImGui::ColorConvertFloat4ToU32(c));
+        // yellow frame: bank switching
+        const float remap = logf(1.0f + this->heat[heatmap::remap][i]) * scale[heatmap::remap];
+        if (remap > 0.0f) {
+            l->AddRect(a, b, ImGui::ColorConvertFloat4ToU32(ImVec4(1.0f, 1.0f, 0.0f, remap)));
+        }
+        if (ImGui::IsMouseHoveringRect(a, b)) {
+            const int addr = i * (heatmap::num_addrs / this->numCells);
+            ImGui::SetTooltip("%04X-%04X\nreads: %llu\nwrites: %llu\nexec: %llu\nremaps: %llu",
+                addr, addr + (heatmap::num_addrs / this->numCells) - 1,
+                (unsigned long long)this->count(hm, heatmap::read, i),
+                (unsigned long long)this->count(hm, heatmap::write, i),
+                (unsigned long long)this->count(hm, heatmap::exec, i),
+                (unsigned long long)this->count(hm, heatmap::remap, i));
+        }
+    }
+    ImGui::Dummy(ImVec2(left_padding + canvas_width, canvas_height));
+}
+
+//------------------------------------------------------------------------------
+bool
+HeatMapWindow::Draw(yakc& emu) {
+    ImGui::SetNextWindowSize(ImVec2(left_padding + canvas_width + 16.0f, canvas_height + 110.0f), ImGuiSetCond_Always);
+    if (ImGui::Begin(this->title.AsCStr(), &this->Visible, ImGuiWindowFlags_NoResize|ImGuiWindowFlags_ShowBorders)) {
+        const heatmap& hm = emu.board.dbg.heat;
+        bool enabled = hm.enabled;
+        if (ImGui::Checkbox("Enabled", &enabled)) {
+            if (enabled) {
+                this->start(emu);
+            }
+            else {
+                emu.board.dbg.stop_heatmap();
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::Checkbox("Per Address", &this->perAddress)) {
+            this->start(emu);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Clear")) {
+            emu.board.dbg.heat.clear_counters();
+            clear(this->prevCounts, sizeof(this->prevCounts));
+            clear(this->heat, sizeof(this->heat));
+        }
+        ImGui::SliderFloat("Decay", &this->decay, 0.0f, 0.99f);
+        ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "write");
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "read");
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(0.3f, 0.3f, 1.0f, 1.0f), "exec");
+        ImGui::SameLine();
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "bank switch");
+        if (hm.enabled) {
+            this->update(hm);
+        }
+        this->drawCells(hm);
+    }
+    ImGui::End();
+    if (!this->Visible) {
+        emu.board.dbg.stop_heatmap();
+    }
+    return this->Visible;
+}
+
+} // namespace YAKC
@@ -0,0 +1,46 @@
+#pragma once
+//------------------------------------------------------------------------------
+/**
+    @class HeatMapWindow
+    @brief visualize recent memory reads, writes, execution and bank switching
+
+    Shows the difference of the heatmap counters (see yakc/core/heatmap.h)
+    since the last frame, blended into a slowly decaying per-cell 'heat'
+    value: one cell per 1 KByte page, or with per-address counting
+    enabled, one cell per 16 bytes.
+*/
+#include "yakc_ui/WindowBase.h"
+
+namespace YAKC {
+
+class HeatMapWindow : public WindowBase {
+    OryolClassDecl(HeatMapWindow);
+public:
+    /// setup the window
+    virtual void Setup(yakc& emu) override;
+    /// draw method
+    virtual bool Draw(yakc& emu) override;
+
+    /// bytes per cell with per-address counters
+    static const int cell_size = 16;
+    /// max number of cells
+    static const int max_cells = heatmap::num_addrs / cell_size;
+
+private:
+    /// start or restart counting
+    void start(yakc& emu);
+    /// update the per-cell heat from the counters
+    void update(const heatmap& hm);
+    /// draw the heat map cells
+    void drawCells(const heatmap& hm);
+    /// get counter of a cell
+    uint64_t count(const heatmap& hm, heatmap::type t, int cell) const;
+
+    bool perAddress = false;
+    float decay = 0.9f;
+    int numCells = heatmap::num_pages;
+    uint64_t prevCounts[heatmap::num_types][max_cells];
+    float heat[heatmap::num_types][max_cells];
+};
+
+} // namespace YAKC
@@ -14,12 +14,68 @@ InfoWindow::Setup(yakc& emu) {
     this->setName("System Info");
 }
 
+//------------------------------------------------------------------------------
+static void
+counter(const char* name, uint64_t total, uint64_t num_frames) {
+    ImGui::Text("%s", name);
+    ImGui::SameLine(160.0f);
+    ImGui::Text("%12llu", (unsigned long long)total);
+    ImGui::SameLine(280.0f);
+    ImGui::Text("%10.1f/frame", num_frames ? double(total) / double(num_frames) : 0.0);
+}
+
+//------------------------------------------------------------------------------
+void
+InfoWindow::drawStats(yakc& emu) {
+    const stats& s = emu.stats;
+    counter("frames:", s.num_frames, 0);
+    counter("instructions:", s.num_instructions, s.num_frames);
+    counter("interrupts:", s.num_interrupts, s.num_frames);
+    counter("memory remaps:", s.num_remaps, s.num_frames);
+    counter("video scanlines:", s.num_scanlines, s.num_frames);
+    counter("audio samples:", s.num_audio_samples, s.num_frames);
+    counter("cpu ahead:", s.num_cpu_ahead, s.num_frames);
+    counter("cpu behind:", s.num_cpu_behind, s.num_frames);
+    ImGui::Text("frame time (last %d frames):", s.num_frame_times());
+    ImGui::Text("  p50: %.2fms  p90: %.2fms  p99: %.2fms  max: %.2fms",
+        s.frame_time_percentile(50.0f), s.frame_time_percentile(90.0f),
+        s.frame_time_percentile(99.0f), s.frame_time_percentile(100.0f));
+    if (stats::no_ports == s.ports) {
+        ImGui::Text("I/O ports: none (memory-mapped I/O)");
+    }
+    else {
+        ImGui::Text("I/O ports (reads/writes):");
+        int num_ports = 0;
+        char name[8];
+        for (int port = 0; port < stats::num_ports; port++) {
+            if (s.port_reads[port] || s.port_writes[port]) {
+                s.port_name(port, name, sizeof(name));
+                ImGui::Text("  %s: %llu / %llu", name,
+                    (unsigned long long)s.port_reads[port],
+                    (unsigned long long)s.port_writes[port]);
+                num_ports++;
+            }
+        }
+        if (0 == num_ports) {
+            ImGui::Text("  none");
+        }
+    }
+    if (ImGui::Button("Reset Stats")) {
+        emu.reset_stats();
+    }
+}
+
 //------------------------------------------------------------------------------
 bool
 InfoWindow::Draw(yakc& emu) {
     ImGui::SetNextWindowSize(ImVec2(540, 440), ImGuiSetCond_Once);
     if (ImGui::Begin(this->title.AsCStr(), &this->Visible, ImGuiWindowFlags_ShowBorders)) {
-        ImGui::TextWrapped("%s", emu.system_info());
+        if (ImGui::CollapsingHeader("System", "#info_system", true, true)) {
+            ImGui::TextWrapped("%s", emu.system_info());
+        }
+        if (ImGui::CollapsingHeader("Emulator Stats", "#info_stats", true, false)) {
+            this->drawStats(emu);
+        }
     }
     ImGui::End();
     return this->Visible;
@@ -2,7 +2,7 @@
 //------------------------------------------------------------------------------
 /**
     @class YAKC::InfoWindow
-    @brief show quick info about currently emulated system
+    @brief show quick info about currently emulated system, and the emulator stats
 */
 #include "yakc_ui/WindowBase.h"
 
@@ -15,6 +15,8 @@ public:
     virtual void Setup(yakc& emu) override;
     /// draw method
     virtual bool Draw(yakc& emu) override;
+    /// draw the emulator stats panel
+    void drawStats(yakc& emu);
 };
 
 } // namespace YAKC
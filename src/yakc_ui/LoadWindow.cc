@@ -54,6 +54,8 @@ LoadWindow::Draw(yakc& emu) {
                 "CPC SNA",
                 "CPC TAP",
                 "ATOM TAP",
+                "ZX TZX",
+                "CPC CDT",
                 "TEXT"
             };
             static_assert(int(sizeof(typeNames)/sizeof(const char*)) == int(filetype::num), "FileType mismatch");
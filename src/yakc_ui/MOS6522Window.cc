@@ -19,7 +19,7 @@ MOS6522Window::Setup(yakc& emu) {
 bool
 MOS6522Window::Draw(yakc& emu) {
     const mos6522& via = emu.board.mos6522;
-    ImGui::SetNextWindowSize(ImVec2(200, 292), ImGuiSetCond_Once);
+    ImGui::SetNextWindowSize(ImVec2(200, 324), ImGuiSetCond_Once);
     if (ImGui::Begin(this->title.AsCStr(), &this->Visible, ImGuiWindowFlags_ShowBorders)) {
         ImGui::Text("A OUT:     0x%02X", via.out_a);
         ImGui::Text("A IN:      0x%02X", via.in_a);
@@ -39,6 +39,8 @@ MOS6522Window::Draw(yakc& emu) {
         ImGui::Text("T2LH:      0x%02X", via.t2lh);
         ImGui::Text("T1:      0x%04X", via.t1);
         ImGui::Text("T2:      0x%04X", via.t2);
+        ImGui::Text("IFR:       0x%02X", via.ifr);
+        ImGui::Text("IER:       0x%02X", via.ier);
     }
     ImGui::End();
     return this->Visible;
@@ -19,10 +19,10 @@ static ubyte
 read_func(void* userdata, uword addr) {
     yakc* emu = (yakc*) userdata;
     if (emu->cpu_type() == cpu_model::z80) {
-        return emu->board.z80.mem.r8(addr);
+        return emu->board.z80.mem.r8_untrapped(addr);
     }
     else {
-        return emu->board.mos6502.mem.r8(addr);
+        return emu->board.mos6502.mem.r8_untrapped(addr);
     }
 }
 
@@ -31,10 +31,10 @@ static void
 write_func(void* userdata, uword addr, ubyte value) {
     yakc* emu = (yakc*) userdata;
     if (emu->cpu_type() == cpu_model::z80) {
-        emu->board.z80.mem.w8(addr, value);
+        emu->board.z80.mem.w8io_untrapped(addr, value);
     }
     else {
-        emu->board.mos6502.mem.w8io(addr, value);
+        emu->board.mos6502.mem.w8io_untrapped(addr, value);
     }
 }
 
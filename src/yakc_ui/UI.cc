@@ -5,6 +5,7 @@
 #include "Util.h"
 #include "MemoryWindow.h"
 #include "MemoryMapWindow.h"
+#include "HeatMapWindow.h"
 #include "DebugWindow.h"
 #include "DisasmWindow.h"
 #include "PIOWindow.h"
@@ -446,6 +447,9 @@ UI::OnFrame(yakc& emu) {
                 if (ImGui::MenuItem("Memory Editor")) {
                     this->OpenWindow(emu, MemoryWindow::Create());
                 }
+                if (ImGui::MenuItem("Memory Heat Map")) {
+                    this->OpenWindow(emu, HeatMapWindow::Create());
+                }
                 if (emu.is_system(system::any_kc85)) {
                     if (ImGui::MenuItem("Scan for Commands...")) {
                         this->OpenWindow(emu, CommandWindow::Create());
@@ -456,29 +460,48 @@ UI::OnFrame(yakc& emu) {
                         emu.cpc.video.debug_video = !emu.cpc.video.debug_video;
                     }
                 }
-                if (!(emu.is_system(system::any_zx) || emu.is_system(system::any_cpc))) {
-                    if (ImGui::BeginMenu("Take Snapshot")) {
+                if (ImGui::BeginMenu("Take Snapshot")) {
+                    for (int i = 0; i < SnapshotStorage::MaxNumSnapshots; i++) {
+                        strBuilder.Format(32, "Snapshot %d", i);
+                        if (ImGui::MenuItem(strBuilder.AsCStr())) {
+                            this->snapshotStorage.TakeSnapshot(emu, i);
+                        }
+                    }
+                    ImGui::EndMenu();
+                }
+                if (this->snapshotStorage.HasSnapshots()) {
+                    if (ImGui::BeginMenu("Apply Snapshot")) {
                         for (int i = 0; i < SnapshotStorage::MaxNumSnapshots; i++) {
-                            strBuilder.Format(32, "Snapshot %d", i);
-                            if (ImGui::MenuItem(strBuilder.AsCStr())) {
-                                this->snapshotStorage.TakeSnapshot(emu, i);
+                            if (this->snapshotStorage.HasSnapshot(i)) {
+                                strBuilder.Format(32, "Snapshot %d", i);
+                                if (ImGui::MenuItem(strBuilder.AsCStr())) {
+                                    this->snapshotStorage.ApplySnapshot(i, emu);
+                                }
                             }
                         }
                         ImGui::EndMenu();
                     }
-                    if (this->snapshotStorage.HasSnapshots()) {
-                        if (ImGui::BeginMenu("Apply Snapshot")) {
-                            for (int i = 0; i < SnapshotStorage::MaxNumSnapshots; i++) {
-                                if (this->snapshotStorage.HasSnapshot(i)) {
-                                    strBuilder.Format(32, "Snapshot %d", i);
-                                    if (ImGui::MenuItem(strBuilder.AsCStr())) {
-                                        this->snapshotStorage.ApplySnapshot(i, emu);
-                                    }
-                                }
-                            }
-                            ImGui::EndMenu();
+                }
+                if (ImGui::BeginMenu("Rewind")) {
+                    const bool recording = emu.rewinder.is_valid();
+                    if (ImGui::MenuItem("Record Frames", nullptr, recording)) {
+                        if (recording) {
+                            emu.stop_rewind();
                         }
+                        else {
+                            emu.start_rewind();
+                        }
+                    }
+                    if (ImGui::MenuItem("Step Back 1 Frame", nullptr, false, recording)) {
+                        emu.rewind(1);
                     }
+                    if (ImGui::MenuItem("Step Back 1 Second", nullptr, false, recording)) {
+                        emu.rewind(50);
+                    }
+                    if (recording) {
+                        ImGui::Text("%d frames, %d KBytes", emu.rewinder.num_frames(), emu.rewinder.bytes_used() / 1024);
+                    }
+                    ImGui::EndMenu();
                 }
                 ImGui::EndMenu();
             }
@@ -11,6 +11,7 @@
 #include "IO/IO.h"
 #include "HttpFS/HTTPFileSystem.h"
 #include "yakc/yakc.h"
+#include "yakc/systems/rom_repository.h"
 #include "yakc_oryol/Draw.h"
 #include "yakc_oryol/Audio.h"
 #include "yakc_oryol/Keyboard.h"
@@ -35,6 +36,7 @@ public:
     AppState::Code OnCleanup();
     void initRoms();
     void initModules();
+    void initRomModule(rom_images::rom rom, kc85_exp::module_type type, uint8_t addrMask, const char* help);
 
     yakc emu;
     Draw draw;
@@ -48,6 +50,9 @@ public:
 OryolMain(YakcApp);
 
 YakcApp* YakcApp::self = nullptr;
+#if !ORYOL_EMSCRIPTEN
+static rom_repository romRepository;
+#endif
 
 //------------------------------------------------------------------------------
 AppState::Code
@@ -164,6 +169,7 @@ YakcApp::OnRunning() {
         this->draw.UpdateParams(true, true, glm::vec2(1.0f/64.0f));
     #endif
     this->ui.EmulationTime = Clock::Since(emu_start_time);
+    this->emu.stats.add_frame_time(float(this->ui.EmulationTime.AsMilliSeconds()));
     this->audio.Update();
     int width = 0;
     int height = 0;
@@ -202,94 +208,37 @@ YakcApp::initRoms() {
     this->emu.add_rom(rom_images::caos31, dump_caos31, sizeof(dump_caos31));
     this->emu.add_rom(rom_images::kc85_basic_rom, dump_basic_c0, sizeof(dump_basic_c0));
 
-    // async-load optional ROMs
-    IO::Load("rom:hc900.852", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::hc900, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:caos22.852", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::caos22, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:caos34.853", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::caos34, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:caos42c.854", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::caos42c, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:caos42e.854", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::caos42e, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:z1013_mon202.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::z1013_mon202, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:z1013_mon_a2.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::z1013_mon_a2, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:z1013_font.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::z1013_font, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:z9001_os12_1.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::z9001_os12_1, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:z9001_os12_2.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::z9001_os12_2, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:z9001_font.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::z9001_font, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:z9001_basic.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::z9001_basic, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:kc87_os_2.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::kc87_os_2, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:z9001_basic_507_511.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::z9001_basic_507_511, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:kc87_font_2.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::kc87_font_2, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:amstrad_zx48k.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::zx48k, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:amstrad_zx128k_0.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::zx128k_0, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:amstrad_zx128k_1.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::zx128k_1, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:cpc464_os.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::cpc464_os, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:cpc464_basic.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::cpc464_basic, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:cpc6128_os.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::cpc6128_os, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:cpc6128_basic.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::cpc6128_basic, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:kcc_os.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::kcc_os, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:kcc_bas.bin", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::kcc_basic, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:bbc_b_os12.rom", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::bbcmicro_b_os, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:bbc_b_basic2.rom", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::bbcmicro_b_basic, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:abasic.ic20", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::atom_basic, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:afloat.ic21", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::atom_float, ioRes.Data.Data(), ioRes.Data.Size());
-    });
-    IO::Load("rom:dosrom.u15", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::atom_dos, ioRes.Data.Data(), ioRes.Data.Size());
-    });
+    #if !ORYOL_EMSCRIPTEN
+    // optional local ROM directory or ROM pack file, the ROM images
+    // are referenced, not copied
+    const char* romPath = getenv("YAKC_ROMS");
+    if (romPath) {
+        if (0 == romRepository.load_pack(romPath)) {
+            romRepository.load_dir(romPath);
+        }
+        if (romRepository.num_rejected > 0) {
+            Log::Warn("%d ROM images in '%s' failed validation\n", romRepository.num_rejected, romPath);
+        }
+        this->emu.add_roms(romRepository);
+    }
+    #endif
+
+    // async-load missing optional ROMs (module ROMs are loaded in initModules)
+    for (int i = 0; i < rom_images::num_roms; i++) {
+        const rom_images::rom type = (rom_images::rom) i;
+        if (this->emu.roms.has(type) ||
+            (rom_images::forth == type) || (rom_images::develop == type) ||
+            (rom_images::kc85_basic_mod == type) || (rom_images::texor == type)) {
+            continue;
+        }
+        StringBuilder url("rom:");
+        url.Append(rom_repository::info(type).filename);
+        IO::Load(url.GetString(), [this, type](IO::LoadResult ioRes) {
+            if (!this->emu.roms.has(type)) {
+                this->emu.add_rom(type, ioRes.Data.Data(), ioRes.Data.Size());
+            }
+        });
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -322,54 +271,58 @@ YakcApp::initModules() {
         "...where [SLOT] is 08 or 0C.\n");
 
     // M026 FORTH
-    IO::Load("rom:forth.853", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::forth, ioRes.Data.Data(), ioRes.Data.Size());
-        this->emu.kc85.exp.register_rom_module(kc85_exp::m026_forth, 0xE0,
-            this->emu.roms.ptr(rom_images::forth), this->emu.roms.size(rom_images::forth),
-            "FORTH language expansion module.\n\n"
-            "First deactivate the BASIC ROM with:\n"
-            "SWITCH 02 00\n\n"
-            "Then activate FORTH with:\n"
-            "SWITCH [SLOT] C1\n\n"
-            "...where [SLOT] is 08 or 0C");
-    });
+    this->initRomModule(rom_images::forth, kc85_exp::m026_forth, 0xE0,
+        "FORTH language expansion module.\n\n"
+        "First deactivate the BASIC ROM with:\n"
+        "SWITCH 02 00\n\n"
+        "Then activate FORTH with:\n"
+        "SWITCH [SLOT] C1\n\n"
+        "...where [SLOT] is 08 or 0C");
 
     // M027 DEVELOPMENT
-    IO::Load("rom:develop.853", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::develop, ioRes.Data.Data(), ioRes.Data.Size());
-        this->emu.kc85.exp.register_rom_module(kc85_exp::m027_development, 0xE0,
-            this->emu.roms.ptr(rom_images::develop), this->emu.roms.size(rom_images::develop),
-            "Assembler/disassembler expansion module.\n\n"
-            "First deactivate the BASIC ROM with:\n"
-            "SWITCH 02 00\n\n"
-            "Then activate the module with:\n"
-            "SWITCH [SLOT] C1\n\n"
-            "...where [SLOT] is 08 or 0C");
-    });
+    this->initRomModule(rom_images::develop, kc85_exp::m027_development, 0xE0,
+        "Assembler/disassembler expansion module.\n\n"
+        "First deactivate the BASIC ROM with:\n"
+        "SWITCH 02 00\n\n"
+        "Then activate the module with:\n"
+        "SWITCH [SLOT] C1\n\n"
+        "...where [SLOT] is 08 or 0C");
 
     // M006 BASIC (+ HC-CAOS 901)
-    IO::Load("rom:m006.rom", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::kc85_basic_mod, ioRes.Data.Data(), ioRes.Data.Size());
-        this->emu.kc85.exp.register_rom_module(kc85_exp::m006_basic, 0xC0,
-            this->emu.roms.ptr(rom_images::kc85_basic_mod), this->emu.roms.size(rom_images::kc85_basic_mod),
-            "BASIC + HC-901 CAOS for KC85/2.\n\n"
-            "Activate with:\n"
-            "JUMP [SLOT]\n\n"
-            "...where [SLOT] is 08 or 0C");
-    });
+    this->initRomModule(rom_images::kc85_basic_mod, kc85_exp::m006_basic, 0xC0,
+        "BASIC + HC-901 CAOS for KC85/2.\n\n"
+        "Activate with:\n"
+        "JUMP [SLOT]\n\n"
+        "...where [SLOT] is 08 or 0C");
 
     // M012 TEXOR
-    IO::Load("rom:texor.rom", [this](IO::LoadResult ioRes) {
-        this->emu.add_rom(rom_images::texor, ioRes.Data.Data(), ioRes.Data.Size());
-        this->emu.kc85.exp.register_rom_module(kc85_exp::m012_texor, 0xE0,
-            this->emu.roms.ptr(rom_images::texor), this->emu.roms.size(rom_images::texor),
-            "TEXOR text processing software.\n\n"
-            "First deactivate the BASIC ROM with:\n"
-            "SWITCH 02 00\n\n"
-            "Then activate the module with:\n"
-            "SWITCH [SLOT] C1\n\n"
-            "...where [SLOT] is 08 or 0C");
-    });
+    this->initRomModule(rom_images::texor, kc85_exp::m012_texor, 0xE0,
+        "TEXOR text processing software.\n\n"
+        "First deactivate the BASIC ROM with:\n"
+        "SWITCH 02 00\n\n"
+        "Then activate the module with:\n"
+        "SWITCH [SLOT] C1\n\n"
+        "...where [SLOT] is 08 or 0C");
+}
+
+//------------------------------------------------------------------------------
+void
+YakcApp::initRomModule(rom_images::rom rom, kc85_exp::module_type type, uint8_t addrMask, const char* help) {
+    // register the module right away if the ROM is available locally,
+    // otherwise after it has been loaded from the webserver
+    if (this->emu.roms.has(rom)) {
+        this->emu.kc85.exp.register_rom_module(type, addrMask,
+            this->emu.roms.ptr(rom), this->emu.roms.size(rom), help);
+    }
+    else {
+        StringBuilder url("rom:");
+        url.Append(rom_repository::info(rom).filename);
+        IO::Load(url.GetString(), [this, rom, type, addrMask, help](IO::LoadResult ioRes) {
+            this->emu.add_rom(rom, ioRes.Data.Data(), ioRes.Data.Size());
+            this->emu.kc85.exp.register_rom_module(type, addrMask,
+                this->emu.roms.ptr(rom), this->emu.roms.size(rom), help);
+        });
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -472,6 +425,14 @@ EMSCRIPTEN_KEEPALIVE void yakc_quickload(const char* name, const char* filename,
                 else if (app->emu.is_system(system::acorn_atom)) {
                     cmd = "*LOAD\n\n";
                 }
+                else if (app->emu.is_system(system::zxspectrum48k)) {
+                    // 'j' is the LOAD keyword
+                    cmd = "j\"\"\n";
+                }
+                else if (app->emu.is_system(system::zxspectrum128k)) {
+                    // select 'Tape Loader' in the start menu
+                    cmd = "\n";
+                }
                 Buffer buf;
                 buf.Add((const uint8_t*)cmd.AsCStr(), cmd.Length()+1);
                 app->keyboard.StartPlayback(std::move(buf));
@@ -507,6 +468,14 @@ EMSCRIPTEN_KEEPALIVE int yakc_loadfile(const char* filename, const uint8_t* data
                 else if (app->emu.is_system(system::acorn_atom)) {
                     cmd = "*LOAD\n\n";
                 }
+                else if (app->emu.is_system(system::zxspectrum48k)) {
+                    // 'j' is the LOAD keyword
+                    cmd = "j\"\"\n";
+                }
+                else if (app->emu.is_system(system::zxspectrum128k)) {
+                    // select 'Tape Loader' in the start menu
+                    cmd = "\n";
+                }
                 Buffer buf;
                 buf.Add((const uint8_t*)cmd.AsCStr(), cmd.Length()+1);
                 app->keyboard.StartPlayback(std::move(buf));